@@ -279,11 +279,51 @@ out:
 }
 
 
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+static int
+glfs_seek (struct glfs_fd *glfd, off_t offset, gf_seek_what_t what,
+	   off_t *off)
+{
+	int              ret = -1;
+	xlator_t        *subvol = NULL;
+	struct stat      sb = {0, };
+
+	subvol = glfs_fd_subvol (glfd);
+	if (!subvol) {
+		errno = EIO;
+		goto out;
+	}
+
+	ret = syncop_seek (subvol, glfd->fd, offset, what, off);
+	if (ret == 0 || errno != EOPNOTSUPP)
+		goto out;
+
+	/* no hole information below, the whole file is data */
+	ret = glfs_fstat (glfd, &sb);
+	if (ret)
+		goto out;
+
+	if (offset >= sb.st_size) {
+		ret = -1;
+		errno = ENXIO;
+		goto out;
+	}
+
+	*off = (what == GF_SEEK_DATA) ? offset : sb.st_size;
+out:
+	return ret;
+}
+#endif
+
+
 off_t
 glfs_lseek (struct glfs_fd *glfd, off_t offset, int whence)
 {
 	struct stat sb = {0, };
 	int         ret = -1;
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+	off_t       off = -1;
+#endif
 
 	__glfs_entry_fd (glfd);
 
@@ -302,6 +342,16 @@ glfs_lseek (struct glfs_fd *glfd, off_t offset, int whence)
 		}
 		glfd->offset = sb.st_size + offset;
 		break;
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+	case SEEK_DATA:
+	case SEEK_HOLE:
+		ret = glfs_seek (glfd, offset, (whence == SEEK_DATA) ?
+				 GF_SEEK_DATA : GF_SEEK_HOLE, &off);
+		if (ret)
+			return -1;
+		glfd->offset = off;
+		break;
+#endif
 	}
 
 	return glfd->offset;
@@ -859,6 +909,69 @@ glfs_ftruncate_async (struct glfs_fd *glfd, off_t offset,
 }
 
 
+int
+glfs_fallocate (struct glfs_fd *glfd, int keep_size, off_t offset, size_t len)
+{
+	int              ret = -1;
+	xlator_t        *subvol = NULL;
+
+	__glfs_entry_fd (glfd);
+
+	subvol = glfs_fd_subvol (glfd);
+	if (!subvol) {
+		ret = -1;
+		errno = EIO;
+		goto out;
+	}
+
+	ret = syncop_fallocate (subvol, glfd->fd, keep_size, offset, len);
+out:
+	return ret;
+}
+
+
+int
+glfs_discard (struct glfs_fd *glfd, off_t offset, size_t len)
+{
+	int              ret = -1;
+	xlator_t        *subvol = NULL;
+
+	__glfs_entry_fd (glfd);
+
+	subvol = glfs_fd_subvol (glfd);
+	if (!subvol) {
+		ret = -1;
+		errno = EIO;
+		goto out;
+	}
+
+	ret = syncop_discard (subvol, glfd->fd, offset, len);
+out:
+	return ret;
+}
+
+
+int
+glfs_zerofill (struct glfs_fd *glfd, off_t offset, off_t len)
+{
+	int              ret = -1;
+	xlator_t        *subvol = NULL;
+
+	__glfs_entry_fd (glfd);
+
+	subvol = glfs_fd_subvol (glfd);
+	if (!subvol) {
+		ret = -1;
+		errno = EIO;
+		goto out;
+	}
+
+	ret = syncop_zerofill (subvol, glfd->fd, offset, len);
+out:
+	return ret;
+}
+
+
 int
 glfs_access (struct glfs *fs, const char *path, int mode)
 {
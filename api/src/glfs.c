@@ -510,6 +510,19 @@ glfs_set_logging (struct glfs *fs, const char *logfile, int loglevel)
 }
 
 
+int
+glfs_set_event_threads (struct glfs *fs, int count)
+{
+	int  ret = -1;
+
+	ret = event_pool_set_threadcount (fs->ctx->event_pool, count);
+	if (ret)
+		errno = EINVAL;
+
+	return ret;
+}
+
+
 int
 glfs_init_wait (struct glfs *fs)
 {
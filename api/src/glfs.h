@@ -191,6 +191,35 @@ int glfs_set_volfile_server (glfs_t *fs, const char *transport,
 int glfs_set_logging (glfs_t *fs, const char *logfile, int loglevel);
 
 
+/*
+  SYNOPSIS
+
+  glfs_set_event_threads: Specify the number of network event threads.
+
+  DESCRIPTION
+
+  This function sets how many threads dispatch network events (replies
+  from the bricks and the management daemon) for the virtual mount.
+  It can be called before or after glfs_init(), but the count can only
+  grow once glfs_init() has been called. The volume option
+  client.event-threads overrides this value.
+
+  PARAMETERS
+
+  @fs: The 'virtual mount' object to be configured.
+
+  @count: Number of event threads, 1 (the default) to 32.
+
+  RETURN VALUES
+
+   0 : Success.
+  -1 : Failure. @errno will be set with the type of failure.
+
+*/
+
+int glfs_set_event_threads (glfs_t *fs, int count);
+
+
 /*
   SYNOPSIS
 
@@ -357,6 +386,15 @@ int glfs_ftruncate (glfs_fd_t *fd, off_t length);
 int glfs_ftruncate_async (glfs_fd_t *fd, off_t length, glfs_io_cbk fn,
 			  void *data);
 
+/*
+ * glfs_fallocate() grows the file unless @keep_size is set; glfs_discard()
+ * never changes the file size. EOPNOTSUPP when a brick cannot do it.
+ */
+
+int glfs_fallocate (glfs_fd_t *fd, int keep_size, off_t offset, size_t len);
+int glfs_discard (glfs_fd_t *fd, off_t offset, size_t len);
+int glfs_zerofill (glfs_fd_t *fd, off_t offset, off_t len);
+
 int glfs_lstat (glfs_t *fs, const char *path, struct stat *buf);
 int glfs_stat (glfs_t *fs, const char *path, struct stat *buf);
 int glfs_fstat (glfs_fd_t *fd, struct stat *buf);
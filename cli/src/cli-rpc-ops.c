@@ -4875,6 +4875,9 @@ cli_print_volume_status_clients (dict_t *dict, gf_boolean_t notbrick)
         char            *clientname = NULL;
         uint64_t        bytesread = 0;
         uint64_t        byteswrite = 0;
+        uint64_t        requests = 0;
+        uint64_t        throttled = 0;
+        int             outstanding = 0;
         char            key[1024] = {0,};
         int             i = 0;
         int             j = 0;
@@ -4937,10 +4940,12 @@ cli_print_volume_status_clients (dict_t *dict, gf_boolean_t notbrick)
                 if (client_count == 0)
                         continue;
 
-                cli_out ("%-48s %15s %15s", "Hostname", "BytesRead",
-                         "BytesWritten");
-                cli_out ("%-48s %15s %15s", "--------", "---------",
-                         "------------");
+                cli_out ("%-48s %15s %15s %12s %11s %9s", "Hostname",
+                         "BytesRead", "BytesWritten", "Requests",
+                         "Outstanding", "Throttled");
+                cli_out ("%-48s %15s %15s %12s %11s %9s", "--------",
+                         "---------", "------------", "--------",
+                         "-----------", "---------");
                 for (j =0; j < client_count; j++) {
                         memset (key, 0, sizeof (key));
                         snprintf (key, sizeof (key),
@@ -4963,8 +4968,30 @@ cli_print_volume_status_clients (dict_t *dict, gf_boolean_t notbrick)
                         if (ret)
                                 goto out;
 
-                        cli_out ("%-48s %15"PRIu64" %15"PRIu64,
-                                 clientname, bytesread, byteswrite);
+                        /* Bricks running an older version do not send the
+                         * request counters; show them as 0. */
+                        requests = 0;
+                        memset (key, 0, sizeof (key));
+                        snprintf (key, sizeof (key),
+                                  "brick%d.client%d.requests", i, j);
+                        ret = dict_get_uint64 (dict, key, &requests);
+
+                        outstanding = 0;
+                        memset (key, 0, sizeof (key));
+                        snprintf (key, sizeof (key),
+                                  "brick%d.client%d.outstanding", i, j);
+                        ret = dict_get_int32 (dict, key, &outstanding);
+
+                        throttled = 0;
+                        memset (key, 0, sizeof (key));
+                        snprintf (key, sizeof (key),
+                                  "brick%d.client%d.throttled", i, j);
+                        ret = dict_get_uint64 (dict, key, &throttled);
+
+                        cli_out ("%-48s %15"PRIu64" %15"PRIu64" %12"PRIu64
+                                 " %11d %9"PRIu64, clientname, bytesread,
+                                 byteswrite, requests, outstanding,
+                                 throttled);
                 }
         }
 out:
@@ -679,6 +679,9 @@ cli_xml_output_vol_status_clients (xmlTextWriterPtr writer, dict_t *dict,
         char            *hostname = NULL;
         uint64_t        bytes_read = 0;
         uint64_t        bytes_write = 0;
+        uint64_t        requests = 0;
+        uint64_t        throttled = 0;
+        int             outstanding = 0;
         char            key[1024] = {0,};
         int             i = 0;
 
@@ -733,6 +736,37 @@ cli_xml_output_vol_status_clients (xmlTextWriterPtr writer, dict_t *dict,
                                                        "%"PRIu64, bytes_write);
                 XML_RET_CHECK_AND_GOTO (ret, out);
 
+                /* the request counters are missing from older bricks */
+                requests = 0;
+                memset (key, 0, sizeof (key));
+                snprintf (key, sizeof (key), "brick%d.client%d.requests",
+                          brick_index, i);
+                ret = dict_get_uint64 (dict, key, &requests);
+                ret = xmlTextWriterWriteFormatElement (writer,
+                                                       (xmlChar *)"requests",
+                                                       "%"PRIu64, requests);
+                XML_RET_CHECK_AND_GOTO (ret, out);
+
+                outstanding = 0;
+                memset (key, 0, sizeof (key));
+                snprintf (key, sizeof (key), "brick%d.client%d.outstanding",
+                          brick_index, i);
+                ret = dict_get_int32 (dict, key, &outstanding);
+                ret = xmlTextWriterWriteFormatElement (writer,
+                                                       (xmlChar *)"outstanding",
+                                                       "%d", outstanding);
+                XML_RET_CHECK_AND_GOTO (ret, out);
+
+                throttled = 0;
+                memset (key, 0, sizeof (key));
+                snprintf (key, sizeof (key), "brick%d.client%d.throttled",
+                          brick_index, i);
+                ret = dict_get_uint64 (dict, key, &throttled);
+                ret = xmlTextWriterWriteFormatElement (writer,
+                                                       (xmlChar *)"throttled",
+                                                       "%"PRIu64, throttled);
+                XML_RET_CHECK_AND_GOTO (ret, out);
+
                 /* </client> */
                 ret = xmlTextWriterEndElement (writer);
                 XML_RET_CHECK_AND_GOTO (ret, out);
@@ -0,0 +1,171 @@
+/*
+   Copyright (c) 2013 Red Hat, Inc. <http://www.redhat.com>
+   This file is part of GlusterFS.
+
+   This file is licensed to you under your choice of the GNU Lesser
+   General Public License, version 3 or any later version (LGPLv3 or
+   later), or the GNU General Public License, version 2 (GPLv2), in all
+   cases as published by the Free Software Foundation.
+*/
+
+/* ctx-bm: measures what the inode and fd context lookups cost a fop.
+ *
+ * A graph of --xlators xlators is built in memory, every xlator stores a
+ * context on one inode and one fd, and then each simulated fop has every
+ * xlator fetch both contexts back, the way a wind through a real graph
+ * does. Build it against the libglusterfs trees to compare.
+ */
+
+#ifndef _CONFIG_H
+#define _CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <argp.h>
+#include <time.h>
+
+#include "glusterfs.h"
+#include "globals.h"
+#include "xlator.h"
+#include "inode.h"
+#include "fd.h"
+#include "graph-utils.h"
+
+struct state {
+        int       xl_count;
+        long int  count;
+};
+
+
+static error_t
+parse_opts (int key, char *arg, struct argp_state *_state)
+{
+        struct state *state = _state->input;
+
+        switch (key) {
+        case 'x':
+                state->xl_count = atoi (arg);
+                if (state->xl_count <= 0) {
+                        fprintf (stderr, "incorrect xlator count: %s\n", arg);
+                        return -1;
+                }
+                break;
+        case 'c':
+                state->count = strtol (arg, NULL, 0);
+                if (state->count <= 0) {
+                        fprintf (stderr, "incorrect count: %s\n", arg);
+                        return -1;
+                }
+                break;
+        case ARGP_KEY_NO_ARGS:
+                break;
+        case ARGP_KEY_ARG:
+                break;
+        }
+
+        return 0;
+}
+
+
+static double
+ns_since (struct timespec *start)
+{
+        struct timespec stop;
+
+        clock_gettime (CLOCK_MONOTONIC, &stop);
+
+        return ((stop.tv_sec - start->tv_sec) * 1e9 +
+                (stop.tv_nsec - start->tv_nsec));
+}
+
+
+int
+main (int argc, char *argv[])
+{
+        struct state       state = {20, 1000000};
+        glusterfs_ctx_t   *ctx = NULL;
+        glusterfs_graph_t *graph = NULL;
+        xlator_t         **xls = NULL;
+        inode_table_t     *table = NULL;
+        inode_t           *inode = NULL;
+        fd_t              *fd = NULL;
+        struct timespec    start;
+        uint64_t           value = 0;
+        uint64_t           sum = 0;
+        double             ns = 0;
+        long int           i = 0;
+        int                j = 0;
+        struct argp_option options[] = {
+                {"xlators", 'x', "COUNT", 0,
+                 "number of xlators in the graph [default: 20]"},
+                {"count", 'c', "COUNT", 0,
+                 "number of fops to simulate [default: 1000000]"},
+                {0, 0, 0, 0, 0}
+        };
+        struct argp argp = {
+                options,
+                parse_opts,
+                "",
+                "ctx-bm - inode/fd context lookup cost per fop"
+        };
+
+        if (argp_parse (&argp, argc, argv, 0, 0, &state) != 0) {
+                fprintf (stderr, "argp_parse() failed\n");
+                return 1;
+        }
+
+        ctx = glusterfs_ctx_new ();
+        if (!ctx || glusterfs_globals_init (ctx))
+                return 1;
+        THIS->ctx = ctx;
+
+        graph = glusterfs_graph_new ();
+        xls = calloc (state.xl_count, sizeof (*xls));
+        if (!graph || !xls)
+                return 1;
+
+        for (j = 0; j < state.xl_count; j++) {
+                xls[j] = calloc (1, sizeof (xlator_t));
+                if (!xls[j])
+                        return 1;
+                xls[j]->name = "ctx-bm";
+                xls[j]->ctx = ctx;
+                xls[j]->graph = graph;
+                glusterfs_graph_set_first (graph, xls[j]);
+        }
+
+        /* the table belongs to the top of the graph, as with fuse/server */
+        table = inode_table_new (0, graph->first);
+        if (!table)
+                return 1;
+
+        inode = inode_new (table);
+        fd = fd_create (inode, 0);
+        if (!inode || !fd)
+                return 1;
+
+        for (j = 0; j < state.xl_count; j++) {
+                inode_ctx_put (inode, xls[j], j + 1);
+                fd_ctx_set (fd, xls[j], j + 1);
+        }
+
+        clock_gettime (CLOCK_MONOTONIC, &start);
+        for (i = 0; i < state.count; i++) {
+                for (j = 0; j < state.xl_count; j++) {
+                        inode_ctx_get (inode, xls[j], &value);
+                        sum += value;
+                        fd_ctx_get (fd, xls[j], &value);
+                        sum += value;
+                }
+        }
+        ns = ns_since (&start);
+
+        fprintf (stdout, "xlators=%d, fops=%ld, ns/fop=%.1f, "
+                 "ns/lookup=%.2f (sum=%"PRIu64")\n", state.xl_count,
+                 state.count, ns / state.count,
+                 ns / (state.count * state.xl_count * 2.0), sum);
+
+        return 0;
+}
@@ -0,0 +1,206 @@
+/*
+   Copyright (c) 2013 Red Hat, Inc. <http://www.redhat.com>
+   This file is part of GlusterFS.
+
+   This file is licensed to you under your choice of the GNU Lesser
+   General Public License, version 3 or any later version (LGPLv3 or
+   later), or the GNU General Public License, version 2 (GPLv2), in all
+   cases as published by the Free Software Foundation.
+*/
+
+/* dict-bm: dict cost of a lookup carrying xattrs.
+ *
+ * Each simulated lookup fills an xdata dict with --keys xattr-like keys
+ * (afr changelogs, dht layout, quota/marker contributions...), has
+ * --probes xlators each look up every key plus one that is absent, and
+ * then sends the dict over the wire: serialize and unserialize. Build it
+ * against the libglusterfs trees to compare.
+ */
+
+#ifndef _CONFIG_H
+#define _CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <argp.h>
+#include <time.h>
+
+#include "glusterfs.h"
+#include "globals.h"
+#include "dict.h"
+#include "mem-pool.h"
+
+struct state {
+        int       keys;
+        int       probes;
+        long int  count;
+};
+
+static const char *key_fmts[] = {
+        "trusted.afr.patchy-client-%d",
+        "trusted.glusterfs.quota.%08d-contri",
+        "trusted.glusterfs.dht.%d",
+        "trusted.gfid.%d",
+        "trusted.glusterfs.%d.xtime",
+        "glusterfs.entrylk-count.%d",
+};
+
+
+static error_t
+parse_opts (int key, char *arg, struct argp_state *_state)
+{
+        struct state *state = _state->input;
+
+        switch (key) {
+        case 'k':
+                state->keys = atoi (arg);
+                if (state->keys <= 0) {
+                        fprintf (stderr, "incorrect key count: %s\n", arg);
+                        return -1;
+                }
+                break;
+        case 'p':
+                state->probes = atoi (arg);
+                if (state->probes < 0) {
+                        fprintf (stderr, "incorrect probe count: %s\n", arg);
+                        return -1;
+                }
+                break;
+        case 'c':
+                state->count = strtol (arg, NULL, 0);
+                if (state->count <= 0) {
+                        fprintf (stderr, "incorrect count: %s\n", arg);
+                        return -1;
+                }
+                break;
+        case ARGP_KEY_NO_ARGS:
+                break;
+        case ARGP_KEY_ARG:
+                break;
+        }
+
+        return 0;
+}
+
+
+static double
+ns_since (struct timespec *start)
+{
+        struct timespec stop;
+
+        clock_gettime (CLOCK_MONOTONIC, &stop);
+
+        return ((stop.tv_sec - start->tv_sec) * 1e9 +
+                (stop.tv_nsec - start->tv_nsec));
+}
+
+
+int
+main (int argc, char *argv[])
+{
+        struct state      state = {24, 4, 100000};
+        glusterfs_ctx_t  *ctx = NULL;
+        char            **keys = NULL;
+        dict_t           *xdata = NULL;
+        dict_t           *reply = NULL;
+        char             *buf = NULL;
+        u_int             len = 0;
+        struct timespec   start;
+        double            get_ns = 0;
+        double            total_ns = 0;
+        long int          hits = 0;
+        long int          i = 0;
+        int               j = 0;
+        int               k = 0;
+        struct argp_option options[] = {
+                {"keys", 'k', "COUNT", 0,
+                 "number of xattrs in each dict [default: 24]"},
+                {"probes", 'p', "COUNT", 0,
+                 "number of xlators looking up every key [default: 4]"},
+                {"count", 'c', "COUNT", 0,
+                 "number of lookups to simulate [default: 100000]"},
+                {0, 0, 0, 0, 0}
+        };
+        struct argp argp = {
+                options,
+                parse_opts,
+                "",
+                "dict-bm - dict cost of an xattr carrying lookup"
+        };
+
+        if (argp_parse (&argp, argc, argv, 0, 0, &state) != 0) {
+                fprintf (stderr, "argp_parse() failed\n");
+                return 1;
+        }
+
+        ctx = glusterfs_ctx_new ();
+        if (!ctx || glusterfs_globals_init (ctx))
+                return 1;
+        THIS->ctx = ctx;
+
+        ctx->dict_pool = mem_pool_new (dict_t, 1024);
+        ctx->dict_pair_pool = mem_pool_new (data_pair_t, 4096);
+        ctx->dict_data_pool = mem_pool_new (data_t, 4096);
+        if (!ctx->dict_pool || !ctx->dict_pair_pool || !ctx->dict_data_pool)
+                return 1;
+
+        keys = calloc (state.keys + 1, sizeof (*keys));
+        if (!keys)
+                return 1;
+
+        for (j = 0; j <= state.keys; j++) {
+                /* the last one is never set, it is the miss every
+                   xlator probes for */
+                if (gf_asprintf (&keys[j], key_fmts[j % 6], j) < 0)
+                        return 1;
+        }
+
+        clock_gettime (CLOCK_MONOTONIC, &start);
+        for (i = 0; i < state.count; i++) {
+                struct timespec get_start;
+
+                xdata = dict_new ();
+                if (!xdata)
+                        return 1;
+
+                for (j = 0; j < state.keys; j++) {
+                        if (dict_set_static_bin (xdata, keys[j], keys[j], 12))
+                                return 1;
+                }
+
+                clock_gettime (CLOCK_MONOTONIC, &get_start);
+                for (k = 0; k < state.probes; k++) {
+                        for (j = 0; j <= state.keys; j++) {
+                                if (dict_get (xdata, keys[j]))
+                                        hits++;
+                        }
+                }
+                get_ns += ns_since (&get_start);
+
+                if (dict_allocate_and_serialize (xdata, &buf, &len))
+                        return 1;
+
+                reply = dict_new ();
+                if (!reply || dict_unserialize (buf, len, &reply))
+                        return 1;
+                reply->extra_free = buf;
+
+                if (dict_get (reply, keys[0]))
+                        hits++;
+
+                dict_unref (reply);
+                dict_unref (xdata);
+        }
+        total_ns = ns_since (&start);
+
+        fprintf (stdout, "keys=%d, probes=%d, lookups=%ld, ns/lookup=%.1f, "
+                 "ns/get=%.2f (hits=%ld)\n", state.keys, state.probes,
+                 state.count, total_ns / state.count,
+                 state.probes ?
+                 get_ns / ((double)state.count * state.probes *
+                           (state.keys + 1)) : 0.0, hits);
+
+        return 0;
+}
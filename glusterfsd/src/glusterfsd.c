@@ -166,6 +166,8 @@ static struct argp_option gf_options[] = {
          "Brick Port to be registered with Gluster portmapper" },
 	{"fopen-keep-cache", ARGP_FOPEN_KEEP_CACHE_KEY, 0, 0,
 	 "Do not purge the cache on file open"},
+        {"event-threads", ARGP_EVENT_THREADS_KEY, "N", 0,
+         "Use N threads to dispatch network events [default: 1]"},
 
         {0, 0, 0, 0, "Fuse options:"},
         {"direct-io-mode", ARGP_DIRECT_IO_MODE_KEY, "BOOL", OPTION_ARG_OPTIONAL,
@@ -951,6 +953,16 @@ parse_opts (int key, char *arg, struct argp_state *state)
         case ARGP_FUSE_MOUNTOPTS_KEY:
                 cmd_args->fuse_mountopts = gf_strdup (arg);
                 break;
+
+        case ARGP_EVENT_THREADS_KEY:
+                if (!gf_string2int (arg, &cmd_args->event_threads) &&
+                    cmd_args->event_threads > 0 &&
+                    cmd_args->event_threads <= EVENT_MAX_THREADS)
+                        break;
+
+                argp_failure (state, -1, 0,
+                              "invalid event thread count %s", arg);
+                break;
 	}
 
         return 0;
@@ -999,6 +1011,8 @@ cleanup_and_exit (int signum)
 
         glusterfs_pidfile_cleanup (ctx);
 
+        gf_log_flush ();
+
         exit (0);
 #if 0
         /* TODO: Properly do cleanup_and_exit(), with synchronization */
@@ -1901,6 +1915,10 @@ main (int argc, char *argv[])
         if (ret)
                 goto out;
 
+        if (ctx->cmd_args.event_threads)
+                event_pool_set_threadcount (ctx->event_pool,
+                                            ctx->cmd_args.event_threads);
+
         ret = event_dispatch (ctx->event_pool);
 
 out:
@@ -84,6 +84,7 @@ enum argp_option_keys {
 	ARGP_FUSE_CONGESTION_THRESHOLD_KEY = 162,
         ARGP_INODE32_KEY                  = 163,
 	ARGP_FUSE_MOUNTOPTS_KEY		  = 164,
+        ARGP_EVENT_THREADS_KEY            = 165,
 };
 
 struct _gfd_vol_top_priv_t {
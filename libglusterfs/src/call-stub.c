@@ -2130,6 +2130,217 @@ out:
         return stub;
 }
 
+call_stub_t *
+fop_fallocate_stub (call_frame_t *frame, fop_fallocate_t fn,
+                    fd_t *fd, int32_t keep_size, off_t offset,
+                    size_t len, dict_t *xdata)
+{
+        call_stub_t *stub = NULL;
+
+        GF_VALIDATE_OR_GOTO ("call-stub", frame, out);
+        GF_VALIDATE_OR_GOTO ("call-stub", fn, out);
+
+        stub = stub_new (frame, 1, GF_FOP_FALLOCATE);
+        GF_VALIDATE_OR_GOTO ("call-stub", stub, out);
+
+        stub->fn.fallocate = fn;
+
+        if (fd)
+                stub->args.fd = fd_ref (fd);
+
+        stub->args.flags = keep_size;
+        stub->args.offset = offset;
+        stub->args.size = len;
+
+        if (xdata)
+                stub->args.xdata = dict_ref (xdata);
+out:
+        return stub;
+}
+
+
+call_stub_t *
+fop_fallocate_cbk_stub (call_frame_t *frame, fop_fallocate_cbk_t fn,
+                        int32_t op_ret, int32_t op_errno,
+                        struct iatt *statpre, struct iatt *statpost,
+                        dict_t *xdata)
+{
+        call_stub_t *stub = NULL;
+
+        GF_VALIDATE_OR_GOTO ("call-stub", frame, out);
+
+        stub = stub_new (frame, 0, GF_FOP_FALLOCATE);
+        GF_VALIDATE_OR_GOTO ("call-stub", stub, out);
+
+        stub->fn_cbk.fallocate = fn;
+        stub->args_cbk.op_ret = op_ret;
+        stub->args_cbk.op_errno = op_errno;
+        if (statpre)
+                stub->args_cbk.prestat = *statpre;
+        if (statpost)
+                stub->args_cbk.poststat = *statpost;
+        if (xdata)
+                stub->args_cbk.xdata = dict_ref (xdata);
+out:
+        return stub;
+}
+
+call_stub_t *
+fop_discard_stub (call_frame_t *frame, fop_discard_t fn,
+                  fd_t *fd, off_t offset, size_t len, dict_t *xdata)
+{
+        call_stub_t *stub = NULL;
+
+        GF_VALIDATE_OR_GOTO ("call-stub", frame, out);
+        GF_VALIDATE_OR_GOTO ("call-stub", fn, out);
+
+        stub = stub_new (frame, 1, GF_FOP_DISCARD);
+        GF_VALIDATE_OR_GOTO ("call-stub", stub, out);
+
+        stub->fn.discard = fn;
+
+        if (fd)
+                stub->args.fd = fd_ref (fd);
+
+        stub->args.offset = offset;
+        stub->args.size = len;
+
+        if (xdata)
+                stub->args.xdata = dict_ref (xdata);
+out:
+        return stub;
+}
+
+
+call_stub_t *
+fop_discard_cbk_stub (call_frame_t *frame, fop_discard_cbk_t fn,
+                      int32_t op_ret, int32_t op_errno,
+                      struct iatt *statpre, struct iatt *statpost,
+                      dict_t *xdata)
+{
+        call_stub_t *stub = NULL;
+
+        GF_VALIDATE_OR_GOTO ("call-stub", frame, out);
+
+        stub = stub_new (frame, 0, GF_FOP_DISCARD);
+        GF_VALIDATE_OR_GOTO ("call-stub", stub, out);
+
+        stub->fn_cbk.discard = fn;
+        stub->args_cbk.op_ret = op_ret;
+        stub->args_cbk.op_errno = op_errno;
+        if (statpre)
+                stub->args_cbk.prestat = *statpre;
+        if (statpost)
+                stub->args_cbk.poststat = *statpost;
+        if (xdata)
+                stub->args_cbk.xdata = dict_ref (xdata);
+out:
+        return stub;
+}
+
+call_stub_t *
+fop_zerofill_stub (call_frame_t *frame, fop_zerofill_t fn,
+                   fd_t *fd, off_t offset, off_t len, dict_t *xdata)
+{
+        call_stub_t *stub = NULL;
+
+        GF_VALIDATE_OR_GOTO ("call-stub", frame, out);
+        GF_VALIDATE_OR_GOTO ("call-stub", fn, out);
+
+        stub = stub_new (frame, 1, GF_FOP_ZEROFILL);
+        GF_VALIDATE_OR_GOTO ("call-stub", stub, out);
+
+        stub->fn.zerofill = fn;
+
+        if (fd)
+                stub->args.fd = fd_ref (fd);
+
+        stub->args.offset = offset;
+        stub->args.size = len;
+
+        if (xdata)
+                stub->args.xdata = dict_ref (xdata);
+out:
+        return stub;
+}
+
+
+call_stub_t *
+fop_zerofill_cbk_stub (call_frame_t *frame, fop_zerofill_cbk_t fn,
+                       int32_t op_ret, int32_t op_errno,
+                       struct iatt *statpre, struct iatt *statpost,
+                       dict_t *xdata)
+{
+        call_stub_t *stub = NULL;
+
+        GF_VALIDATE_OR_GOTO ("call-stub", frame, out);
+
+        stub = stub_new (frame, 0, GF_FOP_ZEROFILL);
+        GF_VALIDATE_OR_GOTO ("call-stub", stub, out);
+
+        stub->fn_cbk.zerofill = fn;
+        stub->args_cbk.op_ret = op_ret;
+        stub->args_cbk.op_errno = op_errno;
+        if (statpre)
+                stub->args_cbk.prestat = *statpre;
+        if (statpost)
+                stub->args_cbk.poststat = *statpost;
+        if (xdata)
+                stub->args_cbk.xdata = dict_ref (xdata);
+out:
+        return stub;
+}
+
+
+call_stub_t *
+fop_seek_stub (call_frame_t *frame, fop_seek_t fn,
+               fd_t *fd, off_t offset, gf_seek_what_t what, dict_t *xdata)
+{
+        call_stub_t *stub = NULL;
+
+        GF_VALIDATE_OR_GOTO ("call-stub", frame, out);
+        GF_VALIDATE_OR_GOTO ("call-stub", fn, out);
+
+        stub = stub_new (frame, 1, GF_FOP_SEEK);
+        GF_VALIDATE_OR_GOTO ("call-stub", stub, out);
+
+        stub->fn.seek = fn;
+
+        if (fd)
+                stub->args.fd = fd_ref (fd);
+
+        stub->args.offset = offset;
+        stub->args.what = what;
+
+        if (xdata)
+                stub->args.xdata = dict_ref (xdata);
+out:
+        return stub;
+}
+
+
+call_stub_t *
+fop_seek_cbk_stub (call_frame_t *frame, fop_seek_cbk_t fn,
+                   int32_t op_ret, int32_t op_errno, off_t offset,
+                   dict_t *xdata)
+{
+        call_stub_t *stub = NULL;
+
+        GF_VALIDATE_OR_GOTO ("call-stub", frame, out);
+
+        stub = stub_new (frame, 0, GF_FOP_SEEK);
+        GF_VALIDATE_OR_GOTO ("call-stub", stub, out);
+
+        stub->fn_cbk.seek = fn;
+        stub->args_cbk.op_ret = op_ret;
+        stub->args_cbk.op_errno = op_errno;
+        stub->args_cbk.offset = offset;
+        if (xdata)
+                stub->args_cbk.xdata = dict_ref (xdata);
+out:
+        return stub;
+}
+
 
 static void
 call_resume_wind (call_stub_t *stub)
@@ -2347,6 +2558,27 @@ call_resume_wind (call_stub_t *stub)
 				   stub->args.fd, &stub->args.stat,
 				   stub->args.valid, stub->args.xdata);
                 break;
+        case GF_FOP_FALLOCATE:
+                stub->fn.fallocate (stub->frame, stub->frame->this,
+                                    stub->args.fd, stub->args.flags,
+                                    stub->args.offset, stub->args.size,
+                                    stub->args.xdata);
+                break;
+        case GF_FOP_DISCARD:
+                stub->fn.discard (stub->frame, stub->frame->this,
+                                  stub->args.fd, stub->args.offset,
+                                  stub->args.size, stub->args.xdata);
+                break;
+        case GF_FOP_ZEROFILL:
+                stub->fn.zerofill (stub->frame, stub->frame->this,
+                                   stub->args.fd, stub->args.offset,
+                                   stub->args.size, stub->args.xdata);
+                break;
+        case GF_FOP_SEEK:
+                stub->fn.seek (stub->frame, stub->frame->this,
+                               stub->args.fd, stub->args.offset,
+                               stub->args.what, stub->args.xdata);
+                break;
         default:
                 gf_log_callingfn ("call-stub", GF_LOG_ERROR,
                                   "Invalid value of FOP (%d)",
@@ -2541,6 +2773,22 @@ call_resume_unwind (call_stub_t *stub)
 		STUB_UNWIND (stub, fsetattr, &stub->args_cbk.prestat,
 			     &stub->args_cbk.poststat, stub->args_cbk.xdata);
                 break;
+        case GF_FOP_FALLOCATE:
+                STUB_UNWIND (stub, fallocate, &stub->args_cbk.prestat,
+                             &stub->args_cbk.poststat, stub->args_cbk.xdata);
+                break;
+        case GF_FOP_DISCARD:
+                STUB_UNWIND (stub, discard, &stub->args_cbk.prestat,
+                             &stub->args_cbk.poststat, stub->args_cbk.xdata);
+                break;
+        case GF_FOP_ZEROFILL:
+                STUB_UNWIND (stub, zerofill, &stub->args_cbk.prestat,
+                             &stub->args_cbk.poststat, stub->args_cbk.xdata);
+                break;
+        case GF_FOP_SEEK:
+                STUB_UNWIND (stub, seek, stub->args_cbk.offset,
+                             stub->args_cbk.xdata);
+                break;
         default:
                 gf_log_callingfn ("call-stub", GF_LOG_ERROR,
                                   "Invalid value of FOP (%d)",
@@ -2675,3 +2923,345 @@ call_unwind_error (call_stub_t *stub, int op_ret, int op_errno)
         return;
 
 }
+
+
+compound_args_t *
+compound_args_new (void)
+{
+        return GF_CALLOC (1, sizeof (compound_args_t),
+                          gf_common_mt_compound_args_t);
+}
+
+
+int
+compound_fop_supported (glusterfs_fop_t fop)
+{
+        switch (fop) {
+        case GF_FOP_LOOKUP:
+        case GF_FOP_GETXATTR:
+        case GF_FOP_SETXATTR:
+        case GF_FOP_CREATE:
+        case GF_FOP_OPEN:
+        case GF_FOP_READ:
+        case GF_FOP_WRITE:
+        case GF_FOP_INODELK:
+        case GF_FOP_FINODELK:
+        case GF_FOP_XATTROP:
+        case GF_FOP_FXATTROP:
+                return 1;
+        default:
+                return 0;
+        }
+}
+
+
+int
+compound_args_add (compound_args_t *args, call_stub_t *fop)
+{
+        int ret = -1;
+
+        GF_VALIDATE_OR_GOTO ("call-stub", args, out);
+        GF_VALIDATE_OR_GOTO ("call-stub", fop, out);
+
+        if (args->count == GF_COMPOUND_MAX_LINKS) {
+                gf_log ("call-stub", GF_LOG_WARNING,
+                        "compound call already has %d fops", args->count);
+                goto out;
+        }
+
+        if (!fop->wind || !compound_fop_supported (fop->fop)) {
+                gf_log ("call-stub", GF_LOG_WARNING,
+                        "%s cannot be part of a compound call",
+                        gf_fop_list[fop->fop]);
+                goto out;
+        }
+
+        args->links[args->count].fop   = fop;
+        args->links[args->count].args  = args;
+        args->links[args->count].index = args->count;
+        args->count++;
+
+        ret = 0;
+out:
+        return ret;
+}
+
+
+void
+compound_args_destroy (compound_args_t *args)
+{
+        int i = 0;
+
+        if (!args)
+                return;
+
+        for (i = 0; i < args->count; i++) {
+                if (args->links[i].fop)
+                        call_stub_destroy (args->links[i].fop);
+                if (args->links[i].reply)
+                        call_stub_destroy (args->links[i].reply);
+        }
+
+        GF_FREE (args);
+}
+
+
+int
+compound_link_op_ret (compound_args_t *args, int index, int *op_errno)
+{
+        call_stub_t *reply = NULL;
+
+        reply = args->links[index].reply;
+        if (!reply) {
+                *op_errno = ENOMEM;
+                return -1;
+        }
+
+        *op_errno = reply->args_cbk.op_errno;
+        return reply->args_cbk.op_ret;
+}
+
+
+static int
+compound_link_unwound (call_frame_t *frame, xlator_t *this,
+                       compound_link_t *link, call_stub_t *reply)
+{
+        link->reply = reply;
+
+        return link->done (frame, this, link->args, link->index);
+}
+
+
+static int32_t
+compound_lookup_link_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                          int32_t op_ret, int32_t op_errno, inode_t *inode,
+                          struct iatt *buf, dict_t *xdata,
+                          struct iatt *postparent)
+{
+        return compound_link_unwound (frame, this, cookie,
+                                      fop_lookup_cbk_stub (frame, NULL, op_ret,
+                                                           op_errno, inode, buf,
+                                                           xdata, postparent));
+}
+
+
+static int32_t
+compound_getxattr_link_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                            int32_t op_ret, int32_t op_errno, dict_t *dict,
+                            dict_t *xdata)
+{
+        return compound_link_unwound (frame, this, cookie,
+                                      fop_getxattr_cbk_stub (frame, NULL,
+                                                             op_ret, op_errno,
+                                                             dict, xdata));
+}
+
+
+static int32_t
+compound_setxattr_link_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                            int32_t op_ret, int32_t op_errno, dict_t *xdata)
+{
+        return compound_link_unwound (frame, this, cookie,
+                                      fop_setxattr_cbk_stub (frame, NULL,
+                                                             op_ret, op_errno,
+                                                             xdata));
+}
+
+
+static int32_t
+compound_create_link_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                          int32_t op_ret, int32_t op_errno, fd_t *fd,
+                          inode_t *inode, struct iatt *buf,
+                          struct iatt *preparent, struct iatt *postparent,
+                          dict_t *xdata)
+{
+        return compound_link_unwound (frame, this, cookie,
+                                      fop_create_cbk_stub (frame, NULL, op_ret,
+                                                           op_errno, fd, inode,
+                                                           buf, preparent,
+                                                           postparent, xdata));
+}
+
+
+static int32_t
+compound_open_link_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                        int32_t op_ret, int32_t op_errno, fd_t *fd,
+                        dict_t *xdata)
+{
+        return compound_link_unwound (frame, this, cookie,
+                                      fop_open_cbk_stub (frame, NULL, op_ret,
+                                                         op_errno, fd, xdata));
+}
+
+
+static int32_t
+compound_readv_link_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                         int32_t op_ret, int32_t op_errno, struct iovec *vector,
+                         int32_t count, struct iatt *stbuf,
+                         struct iobref *iobref, dict_t *xdata)
+{
+        return compound_link_unwound (frame, this, cookie,
+                                      fop_readv_cbk_stub (frame, NULL, op_ret,
+                                                          op_errno, vector,
+                                                          count, stbuf, iobref,
+                                                          xdata));
+}
+
+
+static int32_t
+compound_writev_link_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                          int32_t op_ret, int32_t op_errno,
+                          struct iatt *prebuf, struct iatt *postbuf,
+                          dict_t *xdata)
+{
+        return compound_link_unwound (frame, this, cookie,
+                                      fop_writev_cbk_stub (frame, NULL, op_ret,
+                                                           op_errno, prebuf,
+                                                           postbuf, xdata));
+}
+
+
+static int32_t
+compound_inodelk_link_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                           int32_t op_ret, int32_t op_errno, dict_t *xdata)
+{
+        return compound_link_unwound (frame, this, cookie,
+                                      fop_inodelk_cbk_stub (frame, NULL,
+                                                            op_ret, op_errno,
+                                                            xdata));
+}
+
+
+static int32_t
+compound_finodelk_link_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                            int32_t op_ret, int32_t op_errno, dict_t *xdata)
+{
+        return compound_link_unwound (frame, this, cookie,
+                                      fop_finodelk_cbk_stub (frame, NULL,
+                                                             op_ret, op_errno,
+                                                             xdata));
+}
+
+
+static int32_t
+compound_xattrop_link_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                           int32_t op_ret, int32_t op_errno, dict_t *xattr,
+                           dict_t *xdata)
+{
+        call_stub_t *reply = NULL;
+
+        /* fop_xattrop_cbk_stub () does not keep the xattrs */
+        reply = fop_xattrop_cbk_stub (frame, NULL, op_ret, op_errno, xdata);
+        if (reply && xattr)
+                reply->args_cbk.xattr = dict_ref (xattr);
+
+        return compound_link_unwound (frame, this, cookie, reply);
+}
+
+
+static int32_t
+compound_fxattrop_link_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                            int32_t op_ret, int32_t op_errno, dict_t *xattr,
+                            dict_t *xdata)
+{
+        return compound_link_unwound (frame, this, cookie,
+                                      fop_fxattrop_cbk_stub (frame, NULL,
+                                                             op_ret, op_errno,
+                                                             xattr, xdata));
+}
+
+
+int
+compound_link_wind (call_frame_t *frame, xlator_t *subvol,
+                    compound_args_t *args, int index,
+                    compound_link_done_t done)
+{
+        compound_link_t *link = NULL;
+        call_stub_t     *stub = NULL;
+
+        link = &args->links[index];
+        link->done = done;
+        stub = link->fop;
+
+        switch (stub->fop) {
+        case GF_FOP_LOOKUP:
+                STACK_WIND_COOKIE (frame, compound_lookup_link_cbk, link,
+                                   subvol, subvol->fops->lookup,
+                                   &stub->args.loc, stub->args.xdata);
+                break;
+        case GF_FOP_GETXATTR:
+                STACK_WIND_COOKIE (frame, compound_getxattr_link_cbk, link,
+                                   subvol, subvol->fops->getxattr,
+                                   &stub->args.loc, stub->args.name,
+                                   stub->args.xdata);
+                break;
+        case GF_FOP_SETXATTR:
+                STACK_WIND_COOKIE (frame, compound_setxattr_link_cbk, link,
+                                   subvol, subvol->fops->setxattr,
+                                   &stub->args.loc, stub->args.xattr,
+                                   stub->args.flags, stub->args.xdata);
+                break;
+        case GF_FOP_CREATE:
+                STACK_WIND_COOKIE (frame, compound_create_link_cbk, link,
+                                   subvol, subvol->fops->create,
+                                   &stub->args.loc, stub->args.flags,
+                                   stub->args.mode, stub->args.umask,
+                                   stub->args.fd, stub->args.xdata);
+                break;
+        case GF_FOP_OPEN:
+                STACK_WIND_COOKIE (frame, compound_open_link_cbk, link,
+                                   subvol, subvol->fops->open,
+                                   &stub->args.loc, stub->args.flags,
+                                   stub->args.fd, stub->args.xdata);
+                break;
+        case GF_FOP_READ:
+                STACK_WIND_COOKIE (frame, compound_readv_link_cbk, link,
+                                   subvol, subvol->fops->readv,
+                                   stub->args.fd, stub->args.size,
+                                   stub->args.offset, stub->args.flags,
+                                   stub->args.xdata);
+                break;
+        case GF_FOP_WRITE:
+                STACK_WIND_COOKIE (frame, compound_writev_link_cbk, link,
+                                   subvol, subvol->fops->writev,
+                                   stub->args.fd, stub->args.vector,
+                                   stub->args.count, stub->args.offset,
+                                   stub->args.flags, stub->args.iobref,
+                                   stub->args.xdata);
+                break;
+        case GF_FOP_INODELK:
+                STACK_WIND_COOKIE (frame, compound_inodelk_link_cbk, link,
+                                   subvol, subvol->fops->inodelk,
+                                   stub->args.volume, &stub->args.loc,
+                                   stub->args.cmd, &stub->args.lock,
+                                   stub->args.xdata);
+                break;
+        case GF_FOP_FINODELK:
+                STACK_WIND_COOKIE (frame, compound_finodelk_link_cbk, link,
+                                   subvol, subvol->fops->finodelk,
+                                   stub->args.volume, stub->args.fd,
+                                   stub->args.cmd, &stub->args.lock,
+                                   stub->args.xdata);
+                break;
+        case GF_FOP_XATTROP:
+                STACK_WIND_COOKIE (frame, compound_xattrop_link_cbk, link,
+                                   subvol, subvol->fops->xattrop,
+                                   &stub->args.loc, stub->args.optype,
+                                   stub->args.xattr, stub->args.xdata);
+                break;
+        case GF_FOP_FXATTROP:
+                STACK_WIND_COOKIE (frame, compound_fxattrop_link_cbk, link,
+                                   subvol, subvol->fops->fxattrop,
+                                   stub->args.fd, stub->args.optype,
+                                   stub->args.xattr, stub->args.xdata);
+                break;
+        default:
+                /* compound_args_add () keeps these out */
+                gf_log (subvol->name, GF_LOG_ERROR,
+                        "%s cannot be part of a compound call",
+                        gf_fop_list[stub->fop]);
+                return done (frame, frame->this, args, index);
+        }
+
+        return 0;
+}
@@ -69,6 +69,10 @@ typedef struct {
 		fop_fxattrop_t fxattrop;
 		fop_setattr_t setattr;
 		fop_fsetattr_t fsetattr;
+		fop_fallocate_t fallocate;
+		fop_discard_t discard;
+		fop_zerofill_t zerofill;
+		fop_seek_t seek;
 	} fn;
 
 	union {
@@ -113,6 +117,10 @@ typedef struct {
 		fop_fxattrop_cbk_t fxattrop;
 		fop_setattr_cbk_t setattr;
 		fop_fsetattr_cbk_t fsetattr;
+		fop_fallocate_cbk_t fallocate;
+		fop_discard_cbk_t discard;
+		fop_zerofill_cbk_t zerofill;
+		fop_seek_cbk_t seek;
 	} fn_cbk;
 
 	struct {
@@ -142,6 +150,7 @@ typedef struct {
 		gf_xattrop_flags_t optype;
 		int valid;
 		struct iatt stat;
+		gf_seek_what_t what;
 		dict_t *xdata;
 	} args;
 
@@ -167,6 +176,7 @@ typedef struct {
 		gf_dirent_t entries;
 		uint32_t weak_checksum;
 		uint8_t *strong_checksum;
+		off_t offset;
 		dict_t *xdata;
 	} args_cbk;
 } call_stub_t;
@@ -713,7 +723,104 @@ fop_fsetattr_cbk_stub (call_frame_t *frame,
                        struct iatt *statpre,
                        struct iatt *statpost, dict_t *xdata);
 
+call_stub_t *
+fop_fallocate_stub (call_frame_t *frame,
+                    fop_fallocate_t fn,
+                    fd_t *fd,
+                    int32_t keep_size, off_t offset,
+                    size_t len, dict_t *xdata);
+
+call_stub_t *
+fop_fallocate_cbk_stub (call_frame_t *frame,
+                        fop_fallocate_cbk_t fn,
+                        int32_t op_ret,
+                        int32_t op_errno,
+                        struct iatt *statpre,
+                        struct iatt *statpost, dict_t *xdata);
+
+call_stub_t *
+fop_discard_stub (call_frame_t *frame,
+                  fop_discard_t fn,
+                  fd_t *fd,
+                  off_t offset,
+                  size_t len, dict_t *xdata);
+
+call_stub_t *
+fop_discard_cbk_stub (call_frame_t *frame,
+                      fop_discard_cbk_t fn,
+                      int32_t op_ret,
+                      int32_t op_errno,
+                      struct iatt *statpre,
+                      struct iatt *statpost, dict_t *xdata);
+
+call_stub_t *
+fop_zerofill_stub (call_frame_t *frame,
+                   fop_zerofill_t fn,
+                   fd_t *fd,
+                   off_t offset,
+                   off_t len, dict_t *xdata);
+
+call_stub_t *
+fop_zerofill_cbk_stub (call_frame_t *frame,
+                       fop_zerofill_cbk_t fn,
+                       int32_t op_ret,
+                       int32_t op_errno,
+                       struct iatt *statpre,
+                       struct iatt *statpost, dict_t *xdata);
+
+call_stub_t *
+fop_seek_stub (call_frame_t *frame,
+               fop_seek_t fn,
+               fd_t *fd,
+               off_t offset,
+               gf_seek_what_t what, dict_t *xdata);
+
+call_stub_t *
+fop_seek_cbk_stub (call_frame_t *frame,
+                   fop_seek_cbk_t fn,
+                   int32_t op_ret,
+                   int32_t op_errno,
+                   off_t offset, dict_t *xdata);
+
 void call_resume (call_stub_t *stub);
 void call_stub_destroy (call_stub_t *stub);
 void call_unwind_error (call_stub_t *stub, int op_ret, int op_errno);
+
+/* compound fops: an ordered list of fops handed down as one call, so that
+   protocol/client can send them to the brick in a single round trip. Each
+   link is built with the usual fop_<fop>_stub () (the fn argument is not
+   used) and, once it has run, carries its results in an unwind stub. */
+
+#define GF_COMPOUND_MAX_LINKS 16
+
+typedef int (*compound_link_done_t) (call_frame_t *frame, xlator_t *this,
+                                     compound_args_t *args, int index);
+
+typedef struct {
+        call_stub_t          *fop;    /* arguments, a wind stub */
+        call_stub_t          *reply;  /* results, NULL until the link ran */
+        compound_args_t      *args;
+        int                   index;
+        compound_link_done_t  done;
+} compound_link_t;
+
+struct _compound_args {
+        int              count;
+        compound_link_t  links[GF_COMPOUND_MAX_LINKS];
+};
+
+compound_args_t *compound_args_new (void);
+int compound_args_add (compound_args_t *args, call_stub_t *fop);
+void compound_args_destroy (compound_args_t *args);
+
+int compound_fop_supported (glusterfs_fop_t fop);
+
+/* winds link @index of @args to @subvol; when it unwinds, its results are
+   saved in link->reply and @done is called in the winding frame */
+int compound_link_wind (call_frame_t *frame, xlator_t *subvol,
+                        compound_args_t *args, int index,
+                        compound_link_done_t done);
+
+/* result of a link which has run, -1 with op_errno set otherwise */
+int compound_link_op_ret (compound_args_t *args, int index, int *op_errno);
 #endif
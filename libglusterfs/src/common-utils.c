@@ -513,8 +513,11 @@ gf_print_trace (int32_t signum, glusterfs_ctx_t *ctx)
          * crashes and prints the backtrace in the log-file, then the previous
          * log information will still be in the buffer itself. So flush the
          * contents of the buffer to the log file before printing the backtrace
-         * which helps in debugging.
+         * which helps in debugging. With asynchronous logging the messages
+         * the threads queued are written out first, the logger thread may
+         * not get to them anymore.
          */
+        gf_log_flush ();
         fflush (ctx->log.gf_log_logfile);
         /* Pending frames, (if any), list them in order */
         ret = write (fd, "pending frames:\n", 16);
@@ -26,6 +26,7 @@
 #endif
 
 #include "xlator.h"
+#include "call-stub.h"
 
 /* _CBK function section */
 
@@ -462,6 +463,54 @@ default_getspec_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
         return 0;
 }
 
+int32_t
+default_compound_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                      int32_t op_ret, int32_t op_errno,
+                      compound_args_t *args, dict_t *xdata)
+{
+        STACK_UNWIND_STRICT (compound, frame, op_ret, op_errno, args, xdata);
+        return 0;
+}
+
+int32_t
+default_fallocate_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                       int32_t op_ret, int32_t op_errno, struct iatt *pre,
+                       struct iatt *post, dict_t *xdata)
+{
+        STACK_UNWIND_STRICT (fallocate, frame, op_ret, op_errno, pre, post,
+                             xdata);
+        return 0;
+}
+
+int32_t
+default_discard_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                     int32_t op_ret, int32_t op_errno, struct iatt *pre,
+                     struct iatt *post, dict_t *xdata)
+{
+        STACK_UNWIND_STRICT (discard, frame, op_ret, op_errno, pre, post,
+                             xdata);
+        return 0;
+}
+
+int32_t
+default_zerofill_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                      int32_t op_ret, int32_t op_errno, struct iatt *pre,
+                      struct iatt *post, dict_t *xdata)
+{
+        STACK_UNWIND_STRICT (zerofill, frame, op_ret, op_errno, pre, post,
+                             xdata);
+        return 0;
+}
+
+int32_t
+default_seek_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                  int32_t op_ret, int32_t op_errno, off_t offset,
+                  dict_t *xdata)
+{
+        STACK_UNWIND_STRICT (seek, frame, op_ret, op_errno, offset, xdata);
+        return 0;
+}
+
 /* RESUME */
 
 int32_t
@@ -862,6 +911,46 @@ default_fsetattr_resume (call_frame_t *frame, xlator_t *this, fd_t *fd,
         return 0;
 }
 
+int32_t
+default_fallocate_resume (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                          int32_t keep_size, off_t offset, size_t len,
+                          dict_t *xdata)
+{
+        STACK_WIND (frame, default_fallocate_cbk, FIRST_CHILD (this),
+                    FIRST_CHILD (this)->fops->fallocate, fd, keep_size,
+                    offset, len, xdata);
+        return 0;
+}
+
+int32_t
+default_discard_resume (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                        off_t offset, size_t len, dict_t *xdata)
+{
+        STACK_WIND (frame, default_discard_cbk, FIRST_CHILD (this),
+                    FIRST_CHILD (this)->fops->discard, fd, offset, len,
+                    xdata);
+        return 0;
+}
+
+int32_t
+default_zerofill_resume (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                         off_t offset, off_t len, dict_t *xdata)
+{
+        STACK_WIND (frame, default_zerofill_cbk, FIRST_CHILD (this),
+                    FIRST_CHILD (this)->fops->zerofill, fd, offset, len,
+                    xdata);
+        return 0;
+}
+
+int32_t
+default_seek_resume (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                     off_t offset, gf_seek_what_t what, dict_t *xdata)
+{
+        STACK_WIND (frame, default_seek_cbk, FIRST_CHILD (this),
+                    FIRST_CHILD (this)->fops->seek, fd, offset, what, xdata);
+        return 0;
+}
+
 /* FOPS */
 
 int32_t
@@ -1266,6 +1355,46 @@ default_fsetattr (call_frame_t *frame, xlator_t *this, fd_t *fd,
         return 0;
 }
 
+int32_t
+default_fallocate (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                   int32_t keep_size, off_t offset, size_t len, dict_t *xdata)
+{
+        STACK_WIND_TAIL (frame, FIRST_CHILD (this),
+                         FIRST_CHILD (this)->fops->fallocate, fd, keep_size,
+                         offset, len, xdata);
+        return 0;
+}
+
+int32_t
+default_discard (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                 off_t offset, size_t len, dict_t *xdata)
+{
+        STACK_WIND_TAIL (frame, FIRST_CHILD (this),
+                         FIRST_CHILD (this)->fops->discard, fd, offset, len,
+                         xdata);
+        return 0;
+}
+
+int32_t
+default_zerofill (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                  off_t offset, off_t len, dict_t *xdata)
+{
+        STACK_WIND_TAIL (frame, FIRST_CHILD (this),
+                         FIRST_CHILD (this)->fops->zerofill, fd, offset, len,
+                         xdata);
+        return 0;
+}
+
+int32_t
+default_seek (call_frame_t *frame, xlator_t *this, fd_t *fd,
+              off_t offset, gf_seek_what_t what, dict_t *xdata)
+{
+        STACK_WIND_TAIL (frame, FIRST_CHILD (this),
+                         FIRST_CHILD (this)->fops->seek, fd, offset, what,
+                         xdata);
+        return 0;
+}
+
 
 int32_t
 default_forget (xlator_t *this, inode_t *inode)
@@ -1306,6 +1435,36 @@ default_getspec (call_frame_t *frame, xlator_t *this, const char *key,
         return 0;
 }
 
+/* Compound call */
+
+/* An xlator which does not know about compound calls cannot just pass them
+   down, it would miss the fops inside. Run them one after the other through
+   the xlator's own fops instead. */
+static int
+default_compound_link_done (call_frame_t *frame, xlator_t *this,
+                            compound_args_t *args, int index)
+{
+        if (index + 1 < args->count)
+                return compound_link_wind (frame, this, args, index + 1,
+                                           default_compound_link_done);
+
+        STACK_UNWIND_STRICT (compound, frame, 0, 0, args, NULL);
+        return 0;
+}
+
+int32_t
+default_compound (call_frame_t *frame, xlator_t *this, compound_args_t *args,
+                  dict_t *xdata)
+{
+        if (!args->count) {
+                STACK_UNWIND_STRICT (compound, frame, 0, 0, args, NULL);
+                return 0;
+        }
+
+        return compound_link_wind (frame, this, args, 0,
+                                   default_compound_link_done);
+}
+
 /* notify */
 int
 default_notify (xlator_t *this, int32_t event, void *data, ...)
@@ -44,6 +44,17 @@ get_new_data ()
         return data;
 }
 
+static int32_t
+dict_hash_size_for (int32_t count)
+{
+        int32_t size = DICT_HASH_MIN_SIZE;
+
+        while (size < count)
+                size <<= 1;
+
+        return size;
+}
+
 dict_t *
 get_new_dict_full (int size_hint)
 {
@@ -53,29 +64,16 @@ get_new_dict_full (int size_hint)
                 return NULL;
         }
 
-        dict->hash_size = size_hint;
-        if (size_hint == 1) {
-                /*
-                 * This is the only case we ever see currently.  If we ever
-                 * need to support resizing the hash table, the resize function
-                 * will have to take into account the possibility that
-                 * "members" is not separately allocated (i.e. don't just call
-                 * realloc() blindly.
-                 */
+        if (size_hint <= 1) {
+                /* small dict, see DICT_SMALL_MAX_KEYS */
+                dict->hash_size = 1;
                 dict->members = &dict->members_internal;
         }
         else {
-                /*
-                 * We actually need to allocate space for size_hint *pointers*
-                 * but we actually allocate space for one *structure*.  Since
-                 * a data_pair_t consists of five pointers, we're wasting four
-                 * pointers' worth for N=1, and will overrun what we allocated
-                 * for N>5.  If anybody ever starts using size_hint, we'll need
-                 * to fix this.
-                 */
-                GF_ASSERT (size_hint <=
-                           (sizeof(data_pair_t) / sizeof(data_pair_t *)));
-                dict->members = mem_get0 (THIS->ctx->dict_pair_pool);
+                dict->hash_size = dict_hash_size_for (size_hint);
+                dict->members = GF_CALLOC (dict->hash_size,
+                                           sizeof (data_pair_t *),
+                                           gf_common_mt_dict_members);
                 if (!dict->members) {
                         mem_put (dict);
                         return NULL;
@@ -148,6 +146,9 @@ data_destroy (data_t *data)
                         }
                 }
 
+                if (data->parent)
+                        data_unref (data->parent);
+
                 data->len = 0xbabababa;
                 if (!data->is_const)
                         mem_put (data);
@@ -188,6 +189,27 @@ err_out:
         return NULL;
 }
 
+static inline uint32_t
+dict_key_hash (char *key)
+{
+        return SuperFastHash (key, strlen (key));
+}
+
+static data_pair_t *
+__dict_lookup_hashed (dict_t *this, char *key, uint32_t hash)
+{
+        data_pair_t *pair = NULL;
+
+        pair = this->members[hash & (this->hash_size - 1)];
+        for (; pair != NULL; pair = pair->hash_next) {
+                if ((pair->key_hash == hash) && pair->key &&
+                    !strcmp (pair->key, key))
+                        return pair;
+        }
+
+        return NULL;
+}
+
 static data_pair_t *
 _dict_lookup (dict_t *this, char *key)
 {
@@ -197,15 +219,45 @@ _dict_lookup (dict_t *this, char *key)
                 return NULL;
         }
 
-        int hashval = SuperFastHash (key, strlen (key)) % this->hash_size;
-        data_pair_t *pair;
+        return __dict_lookup_hashed (this, key, dict_key_hash (key));
+}
 
-        for (pair = this->members[hashval]; pair != NULL; pair = pair->hash_next) {
-                if (pair->key && !strcmp (pair->key, key))
-                        return pair;
+/* Moves a dict past DICT_SMALL_MAX_KEYS onto a bucket array, and doubles
+   that array as it fills up. Only the cached key hashes are used, keys
+   are never rehashed. Failing to grow is not an error, lookups just walk
+   longer chains. */
+static void
+__dict_rehash (dict_t *this)
+{
+        data_pair_t  **members = NULL;
+        data_pair_t   *pair = NULL;
+        int32_t        size = 0;
+
+        if (this->hash_size == 1) {
+                if (this->count <= DICT_SMALL_MAX_KEYS)
+                        return;
+                size = dict_hash_size_for (this->count);
+        } else {
+                if (this->count <= this->hash_size)
+                        return;
+                size = this->hash_size * 2;
         }
 
-        return NULL;
+        members = GF_CALLOC (size, sizeof (*members),
+                             gf_common_mt_dict_members);
+        if (!members)
+                return;
+
+        for (pair = this->members_list; pair; pair = pair->next) {
+                pair->hash_next = members[pair->key_hash & (size - 1)];
+                members[pair->key_hash & (size - 1)] = pair;
+        }
+
+        if (this->members != &this->members_internal)
+                GF_FREE (this->members);
+
+        this->members = members;
+        this->hash_size = size;
 }
 
 int32_t
@@ -231,14 +283,35 @@ dict_lookup (dict_t *this, char *key, data_t **data)
         return 0;
 }
 
+/* Keys inside this->backing belong to the unserialized buffer. */
+static inline gf_boolean_t
+dict_key_is_backed (dict_t *this, char *key)
+{
+        if (!this->backing)
+                return _gf_false;
+
+        return ((key >= this->backing->data) &&
+                (key < (this->backing->data + this->backing->len)));
+}
+
+static inline void
+dict_key_free (dict_t *this, char *key)
+{
+        if (!dict_key_is_backed (this, key))
+                GF_FREE (key);
+}
+
+/* @key_static: @key lies within this->backing and is used as is */
 static int32_t
-_dict_set (dict_t *this, char *key, data_t *value, gf_boolean_t replace)
+_dict_set (dict_t *this, char *key, data_t *value, gf_boolean_t replace,
+           gf_boolean_t key_static)
 {
         int hashval;
         data_pair_t *pair;
         char key_free = 0;
-        int tmp = 0;
+        uint32_t hash = 0;
         int ret = 0;
+        data_t *copy = NULL;
 
         if (!key) {
                 ret = gf_asprintf (&key, "ref:%p", value);
@@ -249,12 +322,23 @@ _dict_set (dict_t *this, char *key, data_t *value, gf_boolean_t replace)
                 key_free = 1;
         }
 
-        tmp = SuperFastHash (key, strlen (key));
-        hashval = (tmp % this->hash_size);
+        /* A value pointing into another dict's buffer would keep all of
+           that buffer alive for as long as this dict holds it: take a copy
+           of its bytes instead. */
+        if (value->parent && (value->parent != this->backing)) {
+                value = copy = data_copy (value);
+                if (!value) {
+                        if (key_free)
+                                GF_FREE (key);
+                        return -1;
+                }
+        }
+
+        hash = dict_key_hash (key);
 
         /* Search for a existing key if 'replace' is asked for */
         if (replace) {
-                pair = _dict_lookup (this, key);
+                pair = __dict_lookup_hashed (this, key, hash);
 
                 if (pair) {
                         data_t *unref_data = pair->value;
@@ -272,6 +356,8 @@ _dict_set (dict_t *this, char *key, data_t *value, gf_boolean_t replace)
                 if (!pair) {
                         if (key_free)
                                 GF_FREE (key);
+                        if (copy)
+                                data_destroy (copy);
                         return -1;
                 }
         }
@@ -285,6 +371,9 @@ _dict_set (dict_t *this, char *key, data_t *value, gf_boolean_t replace)
                 pair->key = key;
                 key_free = 0;
         }
+        else if (key_static) {
+                pair->key = key;
+        }
         else {
                 pair->key = (char *) GF_CALLOC (1, strlen (key) + 1,
                                                 gf_common_mt_char);
@@ -295,12 +384,16 @@ _dict_set (dict_t *this, char *key, data_t *value, gf_boolean_t replace)
                         else {
                                 mem_put (pair);
                         }
+                        if (copy)
+                                data_destroy (copy);
                         return -1;
                 }
                 strcpy (pair->key, key);
         }
         pair->value = data_ref (value);
+        pair->key_hash = hash;
 
+        hashval = hash & (this->hash_size - 1);
         pair->hash_next = this->members[hashval];
         this->members[hashval] = pair;
 
@@ -311,6 +404,8 @@ _dict_set (dict_t *this, char *key, data_t *value, gf_boolean_t replace)
         this->members_list = pair;
         this->count++;
 
+        __dict_rehash (this);
+
         if (key_free)
                 GF_FREE (key);
         return 0;
@@ -331,7 +426,7 @@ dict_set (dict_t *this,
 
         LOCK (&this->lock);
 
-        ret = _dict_set (this, key, value, 1);
+        ret = _dict_set (this, key, value, 1, _gf_false);
 
         UNLOCK (&this->lock);
 
@@ -352,7 +447,7 @@ dict_add (dict_t *this, char *key, data_t *value)
 
         LOCK (&this->lock);
 
-        ret = _dict_set (this, key, value, 0);
+        ret = _dict_set (this, key, value, 0, _gf_false);
 
         UNLOCK (&this->lock);
 
@@ -394,12 +489,13 @@ dict_del (dict_t *this, char *key)
 
         LOCK (&this->lock);
 
-        int hashval = SuperFastHash (key, strlen (key)) % this->hash_size;
+        uint32_t hash = dict_key_hash (key);
+        int hashval = hash & (this->hash_size - 1);
         data_pair_t *pair = this->members[hashval];
         data_pair_t *prev = NULL;
 
         while (pair) {
-                if (strcmp (pair->key, key) == 0) {
+                if ((pair->key_hash == hash) && (strcmp (pair->key, key) == 0)) {
                         if (prev)
                                 prev->hash_next = pair->hash_next;
                         else
@@ -415,7 +511,7 @@ dict_del (dict_t *this, char *key)
                         if (pair->next)
                                 pair->next->prev = pair->prev;
 
-                        GF_FREE (pair->key);
+                        dict_key_free (this, pair->key);
                         if (pair == &this->free_pair) {
                                 this->free_pair_in_use = _gf_false;
                         }
@@ -451,7 +547,7 @@ dict_destroy (dict_t *this)
         while (prev) {
                 pair = pair->next;
                 data_unref (prev->value);
-                GF_FREE (prev->key);
+                dict_key_free (this, prev->key);
                 if (prev != &this->free_pair) {
                         mem_put (prev);
                 }
@@ -459,12 +555,15 @@ dict_destroy (dict_t *this)
         }
 
         if (this->members != &this->members_internal) {
-                mem_put (this->members);
+                GF_FREE (this->members);
         }
 
         GF_FREE (this->extra_free);
         free (this->extra_stdfree);
 
+        if (this->backing)
+                data_unref (this->backing);
+
         if (!this->is_static)
                 mem_put (this);
 
@@ -2462,19 +2561,10 @@ out:
 }
 
 
-/**
- * dict_unserialize - unserialize a buffer into a dict
- *
- * @buf:  buf containing serialized dict
- * @size: size of the @buf
- * @fill: dict to fill in
- *
- * @return: success: 0
- *          failure: -errno
- */
-
-int32_t
-dict_unserialize (char *orig_buf, int32_t size, dict_t **fill)
+/* @backing: when set, @orig_buf is its data and keys/values point into it */
+static int32_t
+_dict_unserialize (char *orig_buf, int32_t size, dict_t **fill,
+                   data_t *backing)
 {
         char   *buf = NULL;
         int     ret   = -1;
@@ -2580,11 +2670,26 @@ dict_unserialize (char *orig_buf, int32_t size, dict_t **fill)
                 }
                 value = get_new_data ();
                 value->len  = vallen;
-                value->data = memdup (buf, vallen);
-                value->is_static = 0;
+
+                if (!backing) {
+                        value->data = memdup (buf, vallen);
+                        value->is_static = 0;
+                        buf += vallen;
+
+                        dict_add (*fill, key, value);
+                        continue;
+                }
+
+                value->data = buf;
+                value->is_static = 1;
+                value->parent = data_ref (backing);
                 buf += vallen;
 
-                dict_add (*fill, key, value);
+                LOCK (&(*fill)->lock);
+                {
+                        _dict_set (*fill, key, value, 0, _gf_true);
+                }
+                UNLOCK (&(*fill)->lock);
         }
 
         ret = 0;
@@ -2593,6 +2698,134 @@ out:
 }
 
 
+/**
+ * dict_unserialize - unserialize a buffer into a dict
+ *
+ * @buf:  buf containing serialized dict
+ * @size: size of the @buf
+ * @fill: dict to fill in
+ *
+ * @return: success: 0
+ *          failure: -errno
+ */
+
+int32_t
+dict_unserialize (char *orig_buf, int32_t size, dict_t **fill)
+{
+        return _dict_unserialize (orig_buf, size, fill, NULL);
+}
+
+
+/**
+ * dict_unserialize_nocopy - unserialize a buffer into a dict, in place
+ *
+ * Keys and values of @fill point into @buf instead of being copied out of
+ * it. Each value holds a ref on @buf, so it stays valid past the dict;
+ * set on another dict, a value is copied so as not to pin @buf there.
+ * Anything set on the dict later is copied as usual.
+ *
+ * @buf:  buf containing serialized dict, allocated by libc. It belongs to
+ *        the dict from here on, even on failure.
+ * @size: size of the @buf
+ * @fill: dict to fill in
+ *
+ * @return: success: 0
+ *          failure: -errno
+ */
+
+int32_t
+dict_unserialize_nocopy (char *buf, int32_t size, dict_t **fill)
+{
+        data_t *backing = NULL;
+        int32_t ret     = -1;
+
+        if (!buf || !fill || !*fill || (*fill)->backing) {
+                /* no (single) buffer to point into, copy */
+                ret = dict_unserialize (buf, size, fill);
+                free (buf);
+                goto out;
+        }
+
+        backing = get_new_data ();
+        if (!backing) {
+                free (buf);
+                goto out;
+        }
+
+        backing->data = buf;
+        backing->len = size;
+        backing->is_stdalloc = 1;
+        (*fill)->backing = data_ref (backing);
+
+        ret = _dict_unserialize (buf, size, fill, backing);
+out:
+        return ret;
+}
+
+
+/**
+ * dict_add_backed - add a pair whose key and value point into @backing
+ *
+ * Like the pairs of dict_unserialize_nocopy (), but for buffers which are
+ * not a serialized dict. @backing becomes the buffer of @this on the first
+ * call, later calls have to pass the same one.
+ *
+ * @key:    '\0' terminated, inside @backing
+ * @val:    @vallen bytes inside @backing
+ *
+ * @return: success: 0
+ *          failure: -1
+ */
+
+int32_t
+dict_add_backed (dict_t *this, data_t *backing, char *key, char *val,
+                 int32_t vallen)
+{
+        data_t  *value = NULL;
+        int32_t  ret   = -1;
+
+        if (!this || !backing || !key || !val) {
+                gf_log_callingfn ("dict", GF_LOG_WARNING,
+                                  "!this || !backing || !key || !val");
+                goto out;
+        }
+
+        if (this->backing && (this->backing != backing)) {
+                gf_log_callingfn ("dict", GF_LOG_WARNING,
+                                  "dict is backed by another buffer");
+                goto out;
+        }
+
+        if ((key < backing->data) || (key >= backing->data + backing->len)) {
+                gf_log_callingfn ("dict", GF_LOG_WARNING,
+                                  "key is not inside the backing buffer");
+                goto out;
+        }
+
+        value = get_new_data ();
+        if (!value)
+                goto out;
+
+        value->len = vallen;
+        value->data = val;
+        value->is_static = 1;
+        value->parent = data_ref (backing);
+
+        LOCK (&this->lock);
+        {
+                if (!this->backing)
+                        this->backing = data_ref (backing);
+                ret = _dict_set (this, key, value, 0, _gf_true);
+        }
+        UNLOCK (&this->lock);
+
+        if (ret < 0)
+                data_destroy (value);
+out:
+        return ret;
+}
+
+
 /**
  * dict_allocate_and_serialize - serialize a dictionary into an allocated buffer
  *
@@ -62,6 +62,28 @@ typedef struct _data_pair data_pair_t;
                                                                         \
         } while (0)
 
+/* Same as above, but @buff has to come from libc (XDR decoding allocates
+   opaques that way) and is handed over to the dict: the caller's pointer
+   is reset, so its usual free () becomes a no-op. */
+#define GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY(xl,to,buff,len,ret,ope,labl) do { \
+                if (!len)                                               \
+                        break;                                          \
+                to = dict_new();                                        \
+                GF_VALIDATE_OR_GOTO (xl->name, to, labl);               \
+                                                                        \
+                ret = dict_unserialize_nocopy (buff, len, &to);          \
+                buff = NULL;                                            \
+                if (ret < 0) {                                          \
+                        gf_log (xl->name, GF_LOG_WARNING,               \
+                                "failed to unserialize dictionary (%s)", \
+                                (#to));                                 \
+                                                                        \
+                        ope = EINVAL;                                   \
+                        goto labl;                                      \
+                }                                                       \
+                                                                        \
+        } while (0)
+
 struct _data {
         unsigned char  is_static:1;
         unsigned char  is_const:1;
@@ -70,6 +92,7 @@ struct _data {
         char          *data;
         int32_t        refcount;
         gf_lock_t      lock;
+        struct _data  *parent;  /* buffer ->data points into, ref'd */
 };
 
 struct _data_pair {
@@ -78,8 +101,15 @@ struct _data_pair {
         struct _data_pair *next;
         data_t            *value;
         char              *key;
+        uint32_t           key_hash; /* SuperFastHash of key, computed once */
 };
 
+/* Dicts up to this many keys stay on the single internal bucket, where the
+   cached hashes make a walk cheaper than indexing. Past it they switch to a
+   power-of-two bucket array, doubled whenever count exceeds hash_size. */
+#define DICT_SMALL_MAX_KEYS     8
+#define DICT_HASH_MIN_SIZE      32
+
 struct _dict {
         unsigned char   is_static:1;
         int32_t         hash_size;
@@ -93,6 +123,8 @@ struct _dict {
         data_pair_t    *members_internal;
         data_pair_t     free_pair;
         gf_boolean_t    free_pair_in_use;
+        data_t         *backing; /* unserialized buffer that keys and values
+                                    point into, see dict_unserialize_nocopy */
 };
 
 
@@ -111,6 +143,9 @@ int dict_reset (dict_t *dict);
 int32_t dict_serialized_length (dict_t *dict);
 int32_t dict_serialize (dict_t *dict, char *buf);
 int32_t dict_unserialize (char *buf, int32_t size, dict_t **fill);
+int32_t dict_unserialize_nocopy (char *buf, int32_t size, dict_t **fill);
+int32_t dict_add_backed (dict_t *this, data_t *backing, char *key,
+                         char *val, int32_t vallen);
 
 int32_t dict_allocate_and_serialize (dict_t *this, char **buf, u_int *length);
 
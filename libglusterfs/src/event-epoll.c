@@ -30,6 +30,8 @@
 #ifdef HAVE_SYS_EPOLL_H
 #include <sys/epoll.h>
 
+#define EVENT_EPOLL_BATCH  256
+
 
 static int
 __event_getindex (struct event_pool *event_pool, int fd, int idx)
@@ -138,6 +140,8 @@ event_register_epoll (struct event_pool *event_pool, int fd,
                 event_pool->reg[idx].events = EPOLLPRI;
                 event_pool->reg[idx].handler = handler;
                 event_pool->reg[idx].data = data;
+                event_pool->reg[idx].in_handler = 0;
+                event_pool->reg[idx].gen = ++event_pool->gen;
 
                 switch (poll_in) {
                 case 1:
@@ -173,7 +177,7 @@ event_register_epoll (struct event_pool *event_pool, int fd,
 
                 event_pool->changed = 1;
 
-                epoll_event.events = event_pool->reg[idx].events;
+                epoll_event.events = event_pool->reg[idx].events | EPOLLONESHOT;
                 ev_data->fd = fd;
                 ev_data->idx = idx;
 
@@ -244,8 +248,18 @@ event_unregister_epoll (struct event_pool *event_pool, int fd, int idx_hint)
                         goto unlock;
                 }
 
-                epoll_event.events = event_pool->reg[lastidx].events;
-                ev_data->fd = event_pool->reg[lastidx].fd;
+                /* just replace the unregistered idx by last one */
+                event_pool->reg[idx] = event_pool->reg[lastidx];
+                event_pool->used--;
+
+                /* a disarmed fd being handled right now gets the new idx
+                   when its handler re-arms it, re-arming it here would
+                   let a second thread into the same handler */
+                if (event_pool->reg[idx].in_handler)
+                        goto unlock;
+
+                epoll_event.events = event_pool->reg[idx].events | EPOLLONESHOT;
+                ev_data->fd = event_pool->reg[idx].fd;
                 ev_data->idx = idx;
 
                 ret = epoll_ctl (event_pool->fd, EPOLL_CTL_MOD, ev_data->fd,
@@ -253,14 +267,10 @@ event_unregister_epoll (struct event_pool *event_pool, int fd, int idx_hint)
                 if (ret == -1) {
                         gf_log ("epoll", GF_LOG_ERROR,
                                 "fail to modify fd(=%d) index %d to %d (%s)",
-                                ev_data->fd, event_pool->used, idx,
+                                ev_data->fd, lastidx, idx,
                                 strerror (errno));
                         goto unlock;
                 }
-
-                /* just replace the unregistered idx by last one */
-                event_pool->reg[idx] = event_pool->reg[lastidx];
-                event_pool->used--;
         }
 unlock:
         pthread_mutex_unlock (&event_pool->mutex);
@@ -327,7 +337,14 @@ event_select_on_epoll (struct event_pool *event_pool, int fd, int idx_hint,
                         break;
                 }
 
-                epoll_event.events = event_pool->reg[idx].events;
+                /* the new event mask is picked up when the running
+                   handler re-arms the fd */
+                if (event_pool->reg[idx].in_handler) {
+                        ret = 0;
+                        goto unlock;
+                }
+
+                epoll_event.events = event_pool->reg[idx].events | EPOLLONESHOT;
                 ev_data->fd = fd;
                 ev_data->idx = idx;
 
@@ -347,6 +364,28 @@ out:
 }
 
 
+static int
+__event_rearm_epoll (struct event_pool *event_pool, int fd, int idx)
+{
+        struct epoll_event  epoll_event = {0, };
+        struct event_data  *ev_data = (void *)&epoll_event.data;
+        int                 ret = -1;
+
+        epoll_event.events = event_pool->reg[idx].events | EPOLLONESHOT;
+        ev_data->fd = fd;
+        ev_data->idx = idx;
+
+        ret = epoll_ctl (event_pool->fd, EPOLL_CTL_MOD, fd, &epoll_event);
+        if (ret == -1) {
+                gf_log ("epoll", GF_LOG_ERROR,
+                        "failed to re-arm fd(=%d) events to %d (%s)",
+                        fd, epoll_event.events, strerror (errno));
+        }
+
+        return ret;
+}
+
+
 static int
 event_dispatch_epoll_handler (struct event_pool *event_pool,
                               struct epoll_event *events, int i)
@@ -356,6 +395,7 @@ event_dispatch_epoll_handler (struct event_pool *event_pool,
         void               *data = NULL;
         int                 idx = -1;
         int                 ret = -1;
+        uint64_t            gen = 0;
 
 
         event_data = (void *)&events[i].data;
@@ -374,24 +414,57 @@ event_dispatch_epoll_handler (struct event_pool *event_pool,
                         goto unlock;
                 }
 
+                /* select_on or unregister may have re-armed the fd
+                   between epoll_wait() returning it and us getting
+                   here, and another worker already owns it. The fd is
+                   level-triggered, so the owner's re-arm reports it
+                   again; this event can be dropped. */
+                if (event_pool->reg[idx].in_handler)
+                        goto unlock;
+
                 handler = event_pool->reg[idx].handler;
                 data = event_pool->reg[idx].data;
+                gen = event_pool->reg[idx].gen;
+
+                event_pool->reg[idx].in_handler = 1;
         }
 unlock:
         pthread_mutex_unlock (&event_pool->mutex);
 
-        if (handler)
-                ret = handler (event_data->fd, event_data->idx, data,
-                               (events[i].events & (EPOLLIN|EPOLLPRI)),
-                               (events[i].events & (EPOLLOUT)),
-                               (events[i].events & (EPOLLERR|EPOLLHUP)));
+        if (!handler)
+                goto out;
+
+        ret = handler (event_data->fd, event_data->idx, data,
+                       (events[i].events & (EPOLLIN|EPOLLPRI)),
+                       (events[i].events & (EPOLLOUT)),
+                       (events[i].events & (EPOLLERR|EPOLLHUP)));
+
+        /* in_handler was claimed under the pool lock, a concurrent
+           delivery of this fd was dropped above */
+        pthread_mutex_lock (&event_pool->mutex);
+        {
+                idx = __event_getindex (event_pool, event_data->fd, idx);
+
+                /* unregistered (and possibly re-registered as a new
+                   connection) from within the handler */
+                if (idx == -1 || event_pool->reg[idx].gen != gen)
+                        goto post_unlock;
+
+                event_pool->reg[idx].in_handler = 0;
+
+                __event_rearm_epoll (event_pool, event_data->fd, idx);
+        }
+post_unlock:
+        pthread_mutex_unlock (&event_pool->mutex);
+out:
         return ret;
 }
 
 
-static int
-event_dispatch_epoll (struct event_pool *event_pool)
+static void *
+event_dispatch_epoll_worker (void *data)
 {
+        struct event_pool  *event_pool = data;
         struct epoll_event *events = NULL;
         int                 size = 0;
         int                 i = 0;
@@ -399,34 +472,27 @@ event_dispatch_epoll (struct event_pool *event_pool)
 
         GF_VALIDATE_OR_GOTO ("event", event_pool, out);
 
+        events = GF_CALLOC (EVENT_EPOLL_BATCH, sizeof (*events),
+                            gf_common_mt_epoll_event);
+        if (!events)
+                goto out;
+
         while (1) {
                 pthread_mutex_lock (&event_pool->mutex);
                 {
                         while (event_pool->used == 0)
                                 pthread_cond_wait (&event_pool->cond,
                                                    &event_pool->mutex);
-
-                        if (event_pool->used > event_pool->evcache_size) {
-                                GF_FREE (event_pool->evcache);
-
-                                event_pool->evcache = events = NULL;
-
-                                event_pool->evcache_size =
-                                        event_pool->used + 256;
-
-                                events = GF_CALLOC (event_pool->evcache_size,
-                                                    sizeof (struct epoll_event),
-                                                    gf_common_mt_epoll_event);
-                                if (!events)
-                                        break;
-
-                                event_pool->evcache = events;
-                        }
                 }
                 pthread_mutex_unlock (&event_pool->mutex);
 
-                ret = epoll_wait (event_pool->fd, event_pool->evcache,
-                                  event_pool->evcache_size, -1);
+                /* with several workers take one event per wakeup, a
+                   worker sitting on a batch would serialize fds other
+                   workers could be handling */
+                size = (event_pool->activethreadcount > 1) ?
+                        1 : EVENT_EPOLL_BATCH;
+
+                ret = epoll_wait (event_pool->fd, events, size, -1);
 
                 if (ret == 0)
                         /* timeout */
@@ -436,17 +502,116 @@ event_dispatch_epoll (struct event_pool *event_pool)
                         /* sys call */
                         continue;
 
-                size = ret;
+                if (ret == -1) {
+                        gf_log ("epoll", GF_LOG_ERROR,
+                                "epoll_wait on fd(=%d) failed (%s)",
+                                event_pool->fd, strerror (errno));
+                        break;
+                }
 
-                for (i = 0; i < size; i++) {
-                        if (!events || !events[i].events)
+                for (i = 0; i < ret; i++) {
+                        if (!events[i].events)
                                 continue;
 
-                        ret = event_dispatch_epoll_handler (event_pool,
-                                                            events, i);
+                        event_dispatch_epoll_handler (event_pool, events, i);
                 }
         }
 
+        GF_FREE (events);
+out:
+        return NULL;
+}
+
+
+static int
+__event_start_workers_epoll (struct event_pool *event_pool, int count)
+{
+        int  i = 0;
+        int  ret = 0;
+
+        for (i = event_pool->activethreadcount; i < count; i++) {
+                ret = pthread_create (&event_pool->pollers[i], NULL,
+                                      event_dispatch_epoll_worker, event_pool);
+                if (ret) {
+                        gf_log ("epoll", GF_LOG_WARNING,
+                                "failed to start epoll worker thread %d (%s)",
+                                i, strerror (ret));
+                        break;
+                }
+
+                event_pool->activethreadcount++;
+        }
+
+        if (event_pool->activethreadcount > 1)
+                gf_log ("epoll", GF_LOG_INFO, "%d epoll worker threads running",
+                        event_pool->activethreadcount);
+
+        return ret;
+}
+
+
+static int
+event_reconfigure_threads_epoll (struct event_pool *event_pool, int count)
+{
+        int ret = 0;
+
+        pthread_mutex_lock (&event_pool->mutex);
+        {
+                event_pool->eventthreadcount = count;
+
+                /* not dispatching yet, workers start in event_dispatch */
+                if (!event_pool->activethreadcount)
+                        goto unlock;
+
+                if (count < event_pool->activethreadcount) {
+                        gf_log ("epoll", GF_LOG_INFO,
+                                "cannot reduce running epoll worker threads "
+                                "from %d to %d",
+                                event_pool->activethreadcount, count);
+                        goto unlock;
+                }
+
+                ret = __event_start_workers_epoll (event_pool, count);
+        }
+unlock:
+        pthread_mutex_unlock (&event_pool->mutex);
+
+        return ret;
+}
+
+
+static int
+event_dispatch_epoll (struct event_pool *event_pool)
+{
+        int                 count = 0;
+        int                 i = 0;
+        int                 ret = -1;
+
+        GF_VALIDATE_OR_GOTO ("event", event_pool, out);
+
+        pthread_mutex_lock (&event_pool->mutex);
+        {
+                /* the calling thread is worker 0 */
+                event_pool->pollers[0] = pthread_self ();
+                event_pool->activethreadcount = 1;
+
+                __event_start_workers_epoll (event_pool,
+                                             event_pool->eventthreadcount);
+        }
+        pthread_mutex_unlock (&event_pool->mutex);
+
+        event_dispatch_epoll_worker (event_pool);
+
+        pthread_mutex_lock (&event_pool->mutex);
+        {
+                count = event_pool->activethreadcount;
+        }
+        pthread_mutex_unlock (&event_pool->mutex);
+
+        for (i = 1; i < count; i++)
+                pthread_join (event_pool->pollers[i], NULL);
+
+        ret = 0;
 out:
         return ret;
 }
@@ -457,7 +622,8 @@ struct event_ops event_ops_epoll = {
         .event_register   = event_register_epoll,
         .event_select_on  = event_select_on_epoll,
         .event_unregister = event_unregister_epoll,
-        .event_dispatch   = event_dispatch_epoll
+        .event_dispatch   = event_dispatch_epoll,
+        .event_reconfigure_threads = event_reconfigure_threads_epoll
 };
 
 #endif
@@ -54,10 +54,45 @@ event_pool_new (int count)
                         event_pool->ops = &event_ops_poll;
         }
 
+        if (event_pool)
+                event_pool->eventthreadcount = 1;
+
         return event_pool;
 }
 
 
+int
+event_pool_set_threadcount (struct event_pool *event_pool, int count)
+{
+        int ret = -1;
+
+        GF_VALIDATE_OR_GOTO ("event", event_pool, out);
+
+        if (count < 1 || count > EVENT_MAX_THREADS) {
+                gf_log ("event", GF_LOG_WARNING,
+                        "invalid event thread count %d (valid range: 1-%d)",
+                        count, EVENT_MAX_THREADS);
+                goto out;
+        }
+
+        if (event_pool->ops->event_reconfigure_threads) {
+                ret = event_pool->ops->event_reconfigure_threads (event_pool,
+                                                                  count);
+                goto out;
+        }
+
+        pthread_mutex_lock (&event_pool->mutex);
+        {
+                event_pool->eventthreadcount = count;
+        }
+        pthread_mutex_unlock (&event_pool->mutex);
+
+        ret = 0;
+out:
+        return ret;
+}
+
+
 int
 event_register (struct event_pool *event_pool, int fd,
                 event_handler_t handler,
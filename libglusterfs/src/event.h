@@ -17,6 +17,9 @@
 #endif
 
 #include <pthread.h>
+#include <stdint.h>
+
+#define EVENT_MAX_THREADS  32
 
 struct event_pool;
 struct event_ops;
@@ -41,6 +44,8 @@ struct event_pool {
 		int events;
 		void *data;
 		event_handler_t handler;
+		int in_handler;
+		uint64_t gen;
 	} *reg;
 
 	int used;
@@ -51,6 +56,13 @@ struct event_pool {
 
 	void *evcache;
 	int evcache_size;
+
+	/* number of threads running event_dispatch () on this pool;
+	   honoured only by the epoll backend */
+	int eventthreadcount;
+	int activethreadcount;
+	pthread_t pollers[EVENT_MAX_THREADS];
+	uint64_t gen;
 };
 
 struct event_ops {
@@ -66,9 +78,13 @@ struct event_ops {
         int (*event_unregister) (struct event_pool *event_pool, int fd, int idx);
 
         int (*event_dispatch) (struct event_pool *event_pool);
+
+        int (*event_reconfigure_threads) (struct event_pool *event_pool,
+                                          int count);
 };
 
 struct event_pool * event_pool_new (int count);
+int event_pool_set_threadcount (struct event_pool *event_pool, int count);
 int event_select_on (struct event_pool *event_pool, int fd, int idx,
 		     int poll_in, int poll_out);
 int event_register (struct event_pool *event_pool, int fd,
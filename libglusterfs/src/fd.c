@@ -595,7 +595,7 @@ __fd_create (inode_t *inode, uint64_t pid)
         if (!fd)
                 goto out;
 
-        fd->xl_count = inode->table->xl->graph->xl_count + 1;
+        fd->xl_count = inode->table->ctxcount;
 
         fd->_ctx = GF_CALLOC (1, (sizeof (struct _fd_ctx) * fd->xl_count),
                               gf_common_mt_fd_ctx);
@@ -803,6 +803,38 @@ fd_list_empty (inode_t *inode)
 }
 
 
+/* Same slot layout as the inode's _ctx: the xlators of the inode table's
+   graph index straight by xl_id, everything else scans the spare slots at
+   the end, which grow on demand. */
+static int
+__fd_ctx_index (fd_t *fd, xlator_t *xlator, int *free_idx)
+{
+        int index = 0;
+
+        if (free_idx)
+                *free_idx = -1;
+
+        index = inode_table_ctx_slot (fd->inode->table, xlator);
+        if (index >= 0) {
+                if (free_idx)
+                        *free_idx = index;
+                if (fd->_ctx[index].xl_key == xlator)
+                        return index;
+                return -1;
+        }
+
+        for (index = fd->inode->table->ctxcount - INODE_CTX_SPARE_SLOTS;
+             index < fd->xl_count; index++) {
+                if (fd->_ctx[index].xl_key == xlator)
+                        return index;
+                if (!fd->_ctx[index].key && free_idx && (*free_idx == -1))
+                        *free_idx = index;
+        }
+
+        return -1;
+}
+
+
 int
 __fd_ctx_set (fd_t *fd, xlator_t *xlator, uint64_t value)
 {
@@ -816,23 +848,14 @@ __fd_ctx_set (fd_t *fd, xlator_t *xlator, uint64_t value)
 	if (!fd || !xlator)
 		return -1;
 
-        for (index = 0; index < fd->xl_count; index++) {
-                if (!fd->_ctx[index].key) {
-                        if (set_idx == -1)
-                                set_idx = index;
-                        /* dont break, to check if key already exists
-                           further on */
-                }
-                if (fd->_ctx[index].xl_key == xlator) {
-                        set_idx = index;
-                        break;
-                }
-        }
+        index = __fd_ctx_index (fd, xlator, &set_idx);
+        if (index != -1)
+                set_idx = index;
 
         if (set_idx == -1) {
                 set_idx = fd->xl_count;
 
-                new_xl_count = fd->xl_count + xlator->graph->xl_count;
+                new_xl_count = fd->xl_count + fd->inode->table->ctxcount;
 
                 tmp = GF_REALLOC (fd->_ctx,
                                   (sizeof (struct _fd_ctx)
@@ -896,12 +919,8 @@ __fd_ctx_get (fd_t *fd, xlator_t *xlator, uint64_t *value)
         if (!fd || !xlator)
                 return -1;
 
-        for (index = 0; index < fd->xl_count; index++) {
-                if (fd->_ctx[index].xl_key == xlator)
-                        break;
-        }
-
-        if (index == fd->xl_count) {
+        index = __fd_ctx_index (fd, xlator, NULL);
+        if (index == -1) {
                 ret = -1;
                 goto out;
         }
@@ -941,12 +960,8 @@ __fd_ctx_del (fd_t *fd, xlator_t *xlator, uint64_t *value)
         if (!fd || !xlator)
                 return -1;
 
-        for (index = 0; index < fd->xl_count; index++) {
-                if (fd->_ctx[index].xl_key == xlator)
-                        break;
-        }
-
-        if (index == fd->xl_count) {
+        index = __fd_ctx_index (fd, xlator, NULL);
+        if (index == -1) {
                 ret = -1;
                 goto out;
         }
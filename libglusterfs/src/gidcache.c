@@ -18,6 +18,48 @@
  */
 #define BUCKET_START(p,n)       ((p) + ((n) * AUX_GID_CACHE_ASSOC))
 
+gf_groups_t *gf_groups_new(int count)
+{
+	gf_groups_t *groups;
+
+	groups = GF_MALLOC(sizeof(*groups) + count * sizeof(gid_t),
+			   gf_common_mt_groups_t);
+	if (!groups)
+		return NULL;
+
+	groups->gs_ref = 1;
+	groups->gs_count = count;
+
+	return groups;
+}
+
+gf_groups_t *gf_groups_ref(gf_groups_t *groups)
+{
+	__sync_fetch_and_add(&groups->gs_ref, 1);
+
+	return groups;
+}
+
+void gf_groups_unref(gf_groups_t *groups)
+{
+	if (__sync_sub_and_fetch(&groups->gs_ref, 1) == 0)
+		GF_FREE(groups);
+}
+
+/*
+ * Drop what a cache entry holds.
+ */
+static void gid_list_free(gid_list_t *agl)
+{
+	if (agl->gl_groups)
+		gf_groups_unref(agl->gl_groups);
+	else
+		GF_FREE(agl->gl_list);
+
+	agl->gl_groups = NULL;
+	agl->gl_list = NULL;
+}
+
 /*
  * Initialize the cache.
  */
@@ -149,10 +191,10 @@ int gid_cache_add(gid_cache_t *cache, gid_list_t *gl)
 		/* cache full, evict the first (LRU) entry */
 		i = 0;
 		agl = BUCKET_START(cache->gc_cache, bucket);
-		GF_FREE(agl->gl_list);
+		gid_list_free(agl);
 	} else if (agl->gl_list) {
 		/* evict the old entry we plan to reuse */
-		GF_FREE(agl->gl_list);
+		gid_list_free(agl);
 	}
 
 	/*
@@ -169,6 +211,7 @@ int gid_cache_add(gid_cache_t *cache, gid_list_t *gl)
 	agl->gl_id = gl->gl_id;
 	agl->gl_count = gl->gl_count;
 	agl->gl_list = gl->gl_list;
+	agl->gl_groups = gl->gl_groups;
 	agl->gl_deadline = now + cache->gc_max_age;
 
 	UNLOCK(&cache->gc_lock);
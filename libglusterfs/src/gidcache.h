@@ -30,11 +30,31 @@
 #define AUX_GID_CACHE_BUCKETS   256
 #define AUX_GID_CACHE_SIZE      (AUX_GID_CACHE_ASSOC * AUX_GID_CACHE_BUCKETS)
 
+/*
+ * A refcounted list of supplementary groups. Call stacks with more groups
+ * than they hold inline point to one of these, and the cache hands out the
+ * lists it keeps, so neither copy_frame() nor a cache hit has to copy them.
+ */
+typedef struct {
+	int32_t		gs_ref;
+	int		gs_count;
+	gid_t		gs_gids[];
+} gf_groups_t;
+
+gf_groups_t *gf_groups_new(int count);
+gf_groups_t *gf_groups_ref(gf_groups_t *);
+void gf_groups_unref(gf_groups_t *);
+
+/*
+ * gl_groups, when set, is what gl_list points into and the cache owns a
+ * ref on it rather than gl_list itself.
+ */
 typedef struct {
 	uint64_t	gl_id;
 	int		gl_count;
 	gid_t		*gl_list;
 	time_t		gl_deadline;
+	gf_groups_t	*gl_groups;
 } gid_list_t;
 
 typedef struct {
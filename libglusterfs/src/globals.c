@@ -67,6 +67,11 @@ const char *gf_fop_list[GF_FOP_MAXVALUE] = {
         [GF_FOP_RELEASE]     = "RELEASE",
         [GF_FOP_RELEASEDIR]  = "RELEASEDIR",
         [GF_FOP_FREMOVEXATTR]= "FREMOVEXATTR",
+        [GF_FOP_COMPOUND]    = "COMPOUND",
+        [GF_FOP_FALLOCATE]   = "FALLOCATE",
+        [GF_FOP_DISCARD]     = "DISCARD",
+        [GF_FOP_ZEROFILL]    = "ZEROFILL",
+        [GF_FOP_SEEK]        = "SEEK",
 };
 /* THIS */
 
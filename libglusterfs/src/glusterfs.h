@@ -196,6 +196,11 @@ typedef enum {
         GF_FOP_RELEASEDIR,
         GF_FOP_GETSPEC,
         GF_FOP_FREMOVEXATTR,
+        GF_FOP_COMPOUND,
+        GF_FOP_FALLOCATE,
+        GF_FOP_DISCARD,
+        GF_FOP_ZEROFILL,
+        GF_FOP_SEEK,
         GF_FOP_MAXVALUE,
 } glusterfs_fop_t;
 
@@ -265,6 +270,12 @@ typedef enum {
 } gf_xattrop_flags_t;
 
 
+typedef enum {
+        GF_SEEK_DATA,
+        GF_SEEK_HOLE
+} gf_seek_what_t;
+
+
 #define GF_SET_IF_NOT_PRESENT 0x1 /* default behaviour */
 #define GF_SET_OVERWRITE      0x2 /* Overwrite with the buf given */
 #define GF_SET_DIR_ONLY       0x4
@@ -311,6 +322,7 @@ struct _cmd_args {
         int              mac_compat;
 	int		 fopen_keep_cache;
 	int		 gid_timeout;
+        int              event_threads;
 	struct list_head xlator_options;  /* list of xlator_option_t */
 
 	/* fuse options */
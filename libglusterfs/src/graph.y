@@ -180,7 +180,7 @@ new_volume (char *name)
 
         construct->first = curr;
 
-        construct->xl_count++;
+        curr->xl_id = construct->xl_count++;
 
         gf_log ("parser", GF_LOG_TRACE, "New node for '%s'", name);
 
@@ -28,6 +28,23 @@
    move latest accessed dentry to list_head of inode
 */
 
+/* Locking:
+
+   table->lock (rwlock) protects the inode and dentry hashes and the dentry
+   tree. Lookups (inode_find, inode_grep, inode_path ...) take it shared,
+   anything which links, unlinks or retires takes it exclusive.
+
+   table->lru_lock protects the active, lru and purge lists and their sizes.
+
+   inode->ref and inode->nlookup are modified with atomic operations. Only
+   the 0 -> 1 and 1 -> 0 transitions of ref move an inode between lists:
+   0 -> 1 happens with table->lock held shared and table->lru_lock. 1 -> 0
+   does too when the inode just goes to the lru list; when it has to be
+   retired, or lose stale dentries, it happens with table->lock held
+   exclusive. Every other inode_ref/inode_unref does not take any table
+   lock.
+*/
+
 #define INODE_DUMP_LIST(head, key_buf, key_prefix, list_type)           \
         {                                                               \
                 int i = 1;                                              \
@@ -49,11 +66,12 @@ inode_table_prune (inode_table_t *table);
 void
 fd_dump (struct list_head *head, char *prefix);
 
+/* @mod is always a power of two */
 static int
 hash_dentry (inode_t *parent, const char *name, int mod)
 {
-        int hash = 0;
-        int ret = 0;
+        unsigned long hash = 0;
+        int           ret = 0;
 
         hash = *name;
         if (hash) {
@@ -61,20 +79,134 @@ hash_dentry (inode_t *parent, const char *name, int mod)
                         hash = (hash << 5) - hash + *name;
                 }
         }
-        ret = (hash + (unsigned long)parent) % mod;
+        hash += ((unsigned long)parent >> 4);
+        hash ^= (hash >> 16);
+
+        ret = hash & (mod - 1);
 
         return ret;
 }
 
 
+/* @mod is always a power of two */
 static int
 hash_gfid (uuid_t uuid, int mod)
 {
         int ret = 0;
 
-        ret = uuid[15] + (uuid[14] << 8);
+        ret = uuid[15] + (uuid[14] << 8) + (uuid[13] << 16) +
+                ((uint32_t)uuid[12] << 24);
 
-        return ret;
+        return ret & (mod - 1);
+}
+
+
+static inline int
+inode_ref_get_unless_zero (inode_t *inode)
+{
+        uint32_t ref = 0;
+
+        do {
+                ref = inode->ref;
+                if (!ref)
+                        return 0;
+        } while (!__sync_bool_compare_and_swap (&inode->ref, ref, ref + 1));
+
+        return 1;
+}
+
+
+static inline int
+inode_ref_put_unless_last (inode_t *inode)
+{
+        uint32_t ref = 0;
+
+        do {
+                ref = inode->ref;
+                if (ref <= 1)
+                        return 0;
+        } while (!__sync_bool_compare_and_swap (&inode->ref, ref, ref - 1));
+
+        return 1;
+}
+
+
+static struct list_head *
+__inode_hash_buckets_new (size_t size)
+{
+        struct list_head *buckets = NULL;
+        size_t            i = 0;
+
+        buckets = GF_CALLOC (size, sizeof (*buckets), gf_common_mt_list_head);
+        if (!buckets)
+                return NULL;
+
+        for (i = 0; i < size; i++)
+                INIT_LIST_HEAD (&buckets[i]);
+
+        return buckets;
+}
+
+
+/* Doubles the gfid hash. Called with table->lock held exclusive. Failing
+   to grow only costs longer chains, so errors are not propagated. */
+static void
+__inode_table_grow_inode_hash (inode_table_t *table)
+{
+        struct list_head *buckets = NULL;
+        inode_t          *inode = NULL;
+        inode_t          *tmp = NULL;
+        size_t            size = 0;
+        size_t            i = 0;
+
+        size = table->inode_hashsize * 2;
+
+        buckets = __inode_hash_buckets_new (size);
+        if (!buckets)
+                return;
+
+        for (i = 0; i < table->inode_hashsize; i++) {
+                list_for_each_entry_safe (inode, tmp, &table->inode_hash[i],
+                                          hash) {
+                        list_move (&inode->hash,
+                                   &buckets[hash_gfid (inode->gfid, size)]);
+                }
+        }
+
+        GF_FREE (table->inode_hash);
+        table->inode_hash = buckets;
+        table->inode_hashsize = size;
+}
+
+
+/* Doubles the dentry hash. Called with table->lock held exclusive. */
+static void
+__inode_table_grow_name_hash (inode_table_t *table)
+{
+        struct list_head *buckets = NULL;
+        dentry_t         *dentry = NULL;
+        dentry_t         *tmp = NULL;
+        size_t            size = 0;
+        size_t            i = 0;
+        int               hash = 0;
+
+        size = table->hashsize * 2;
+
+        buckets = __inode_hash_buckets_new (size);
+        if (!buckets)
+                return;
+
+        for (i = 0; i < table->hashsize; i++) {
+                list_for_each_entry_safe (dentry, tmp, &table->name_hash[i],
+                                          hash) {
+                        hash = hash_dentry (dentry->parent, dentry->name, size);
+                        list_move (&dentry->hash, &buckets[hash]);
+                }
+        }
+
+        GF_FREE (table->name_hash);
+        table->name_hash = buckets;
+        table->hashsize = size;
 }
 
 
@@ -90,6 +222,15 @@ __dentry_hash (dentry_t *dentry)
         }
 
         table = dentry->inode->table;
+
+        if (list_empty (&dentry->hash))
+                table->hashed_dentries++;
+
+        if ((table->hashed_dentries >
+             table->hashsize * INODE_HASH_LOAD_FACTOR) &&
+            (table->hashsize < INODE_HASH_MAX_SIZE))
+                __inode_table_grow_name_hash (table);
+
         hash = hash_dentry (dentry->parent, dentry->name,
                             table->hashsize);
 
@@ -118,6 +259,9 @@ __dentry_unhash (dentry_t *dentry)
                 return;
         }
 
+        if (!list_empty (&dentry->hash))
+                dentry->inode->table->hashed_dentries--;
+
         list_del_init (&dentry->hash);
 }
 
@@ -229,6 +373,9 @@ __inode_unhash (inode_t *inode)
                 return;
         }
 
+        if (!list_empty (&inode->hash))
+                inode->table->hashed_inodes--;
+
         list_del_init (&inode->hash);
 }
 
@@ -257,7 +404,16 @@ __inode_hash (inode_t *inode)
         }
 
         table = inode->table;
-        hash = hash_gfid (inode->gfid, 65536);
+
+        if (list_empty (&inode->hash))
+                table->hashed_inodes++;
+
+        if ((table->hashed_inodes >
+             table->inode_hashsize * INODE_HASH_LOAD_FACTOR) &&
+            (table->inode_hashsize < INODE_HASH_MAX_SIZE))
+                __inode_table_grow_inode_hash (table);
+
+        hash = hash_gfid (inode->gfid, table->inode_hashsize);
 
         list_del_init (&inode->hash);
         list_add (&inode->hash, &table->inode_hash[hash]);
@@ -310,7 +466,7 @@ __inode_destroy (inode_t *inode)
                 goto noctx;
         }
 
-        for (index = 0; index < inode->table->xl->graph->xl_count; index++) {
+        for (index = 0; index < inode->table->ctxcount; index++) {
                 if (inode->_ctx[index].xl_key) {
                         xl = (xlator_t *)(long)inode->_ctx[index].xl_key;
                         old_THIS = THIS;
@@ -329,6 +485,7 @@ noctx:
 }
 
 
+/* Called with table->lru_lock held. */
 static void
 __inode_activate (inode_t *inode)
 {
@@ -345,14 +502,22 @@ __inode_passivate (inode_t *inode)
 {
         dentry_t      *dentry = NULL;
         dentry_t      *t = NULL;
+        inode_table_t *table = NULL;
 
         if (!inode) {
                 gf_log_callingfn (THIS->name, GF_LOG_WARNING, "inode not found");
                 return;
         }
 
-        list_move_tail (&inode->list, &inode->table->lru);
-        inode->table->lru_size++;
+        table = inode->table;
+
+        pthread_mutex_lock (&table->lru_lock);
+        {
+                table->active_size--;
+                list_move_tail (&inode->list, &table->lru);
+                table->lru_size++;
+        }
+        pthread_mutex_unlock (&table->lru_lock);
 
         list_for_each_entry_safe (dentry, t, &inode->dentry_list, inode_list) {
                 if (!__is_dentry_hashed (dentry))
@@ -361,6 +526,17 @@ __inode_passivate (inode_t *inode)
 }
 
 
+/* Called with table->lru_lock held, which the caller has already used to
+   take @inode off the list it was on. */
+static void
+__inode_retire_list (inode_t *inode)
+{
+        list_move_tail (&inode->list, &inode->table->purge);
+        inode->table->purge_size++;
+}
+
+
+/* Called with table->lock held exclusive. */
 static void
 __inode_retire (inode_t *inode)
 {
@@ -372,9 +548,6 @@ __inode_retire (inode_t *inode)
                 return;
         }
 
-        list_move_tail (&inode->list, &inode->table->purge);
-        inode->table->purge_size++;
-
         __inode_unhash (inode);
 
         list_for_each_entry_safe (dentry, t, &inode->dentry_list, inode_list) {
@@ -383,65 +556,164 @@ __inode_retire (inode_t *inode)
 }
 
 
+/* Called with table->lock held exclusive. */
 static inode_t *
 __inode_unref (inode_t *inode)
 {
+        inode_table_t *table = NULL;
+        uint32_t       ref = 0;
+
         if (!inode)
                 return NULL;
 
         if (__is_root_gfid(inode->gfid))
                 return inode;
 
-        GF_ASSERT (inode->ref);
+        /* lockless inode_ref () may still bump a non-zero count */
+        do {
+                ref = inode->ref;
+                GF_ASSERT (ref);
+                if (!ref)
+                        return inode;
+        } while (!__sync_bool_compare_and_swap (&inode->ref, ref, ref - 1));
+
+        if (ref > 1)
+                return inode;
 
-        --inode->ref;
+        table = inode->table;
 
-        if (!inode->ref) {
-                inode->table->active_size--;
+        if (inode->nlookup) {
+                __inode_passivate (inode);
+        } else {
+                pthread_mutex_lock (&table->lru_lock);
+                {
+                        table->active_size--;
+                        __inode_retire_list (inode);
+                }
+                pthread_mutex_unlock (&table->lru_lock);
 
-                if (inode->nlookup)
-                        __inode_passivate (inode);
-                else
-                        __inode_retire (inode);
+                __inode_retire (inode);
         }
 
         return inode;
 }
 
 
+/* Called with table->lock held, shared or exclusive. */
 static inode_t *
 __inode_ref (inode_t *inode)
 {
+        inode_table_t *table = NULL;
+
         if (!inode)
                 return NULL;
 
-        if (!inode->ref) {
-                inode->table->lru_size--;
-                __inode_activate (inode);
+        if (inode_ref_get_unless_zero (inode))
+                return inode;
+
+        table = inode->table;
+
+        /* 0 -> 1, other shared holders of table->lock may race us here */
+        pthread_mutex_lock (&table->lru_lock);
+        {
+                if (!inode->ref) {
+                        table->lru_size--;
+                        __inode_activate (inode);
+                }
+                __sync_fetch_and_add (&inode->ref, 1);
         }
-        inode->ref++;
+        pthread_mutex_unlock (&table->lru_lock);
 
         return inode;
 }
 
 
+/* Called with table->lock held shared. Drops a ref of @inode, unless it
+   is the last one and the inode has to be retired or lose stale dentries,
+   which needs table->lock exclusive: returns 0 then. */
+static int
+__inode_unref_shared (inode_t *inode)
+{
+        inode_table_t *table = NULL;
+        dentry_t      *dentry = NULL;
+        uint32_t       ref = 0;
+
+        if (!inode->nlookup)
+                return 0;
+
+        list_for_each_entry (dentry, &inode->dentry_list, inode_list) {
+                if (!__is_dentry_hashed (dentry))
+                        return 0;
+        }
+
+        table = inode->table;
+
+        /* 0 -> 1 also takes lru_lock, the count cannot come back from 0
+           before the inode is on the lru list */
+        pthread_mutex_lock (&table->lru_lock);
+        {
+                do {
+                        ref = inode->ref;
+                        GF_ASSERT (ref);
+                        if (!ref)
+                                break;
+                } while (!__sync_bool_compare_and_swap (&inode->ref, ref,
+                                                        ref - 1));
+
+                if (ref == 1) {
+                        table->active_size--;
+                        list_move_tail (&inode->list, &table->lru);
+                        table->lru_size++;
+                }
+        }
+        pthread_mutex_unlock (&table->lru_lock);
+
+        return 1;
+}
+
+
+static inline int
+inode_table_needs_prune (inode_table_t *table)
+{
+        /* unlocked peek, prune re-checks under the locks */
+        return (table->purge_size ||
+                (table->lru_limit && table->lru_size > table->lru_limit));
+}
+
+
 inode_t *
 inode_unref (inode_t *inode)
 {
         inode_table_t *table = NULL;
+        int            done  = 0;
 
         if (!inode)
                 return NULL;
 
+        if (__is_root_gfid (inode->gfid))
+                return inode;
+
+        if (inode_ref_put_unless_last (inode))
+                return inode;
+
         table = inode->table;
 
-        pthread_mutex_lock (&table->lock);
+        pthread_rwlock_rdlock (&table->lock);
         {
-                inode = __inode_unref (inode);
+                done = __inode_unref_shared (inode);
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
-        inode_table_prune (table);
+        if (!done) {
+                pthread_rwlock_wrlock (&table->lock);
+                {
+                        inode = __inode_unref (inode);
+                }
+                pthread_rwlock_unlock (&table->lock);
+        }
+
+        if (inode_table_needs_prune (table))
+                inode_table_prune (table);
 
         return inode;
 }
@@ -455,13 +727,16 @@ inode_ref (inode_t *inode)
         if (!inode)
                 return NULL;
 
+        if (inode_ref_get_unless_zero (inode))
+                return inode;
+
         table = inode->table;
 
-        pthread_mutex_lock (&table->lock);
+        pthread_rwlock_rdlock (&table->lock);
         {
                 inode = __inode_ref (inode);
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
         return inode;
 }
@@ -529,7 +804,7 @@ __inode_create (inode_table_t *table)
         INIT_LIST_HEAD (&newi->dentry_list);
 
         newi->_ctx = GF_CALLOC (1, (sizeof (struct _inode_ctx) *
-                                    table->xl->graph->xl_count),
+                                    table->ctxcount),
                                 gf_common_mt_inode_ctx);
 
         if (newi->_ctx == NULL) {
@@ -539,8 +814,12 @@ __inode_create (inode_table_t *table)
                 goto out;
         }
 
-        list_add (&newi->list, &table->lru);
-        table->lru_size++;
+        pthread_mutex_lock (&table->lru_lock);
+        {
+                list_add (&newi->list, &table->lru);
+                table->lru_size++;
+        }
+        pthread_mutex_unlock (&table->lru_lock);
 
 out:
 
@@ -558,14 +837,16 @@ inode_new (inode_table_t *table)
                 return NULL;
         }
 
-        pthread_mutex_lock (&table->lock);
+        /* shared is enough, the new inode is on no hash yet. Holding it
+           keeps inode_table_prune () off the lru entry until it is ref'd */
+        pthread_rwlock_rdlock (&table->lock);
         {
                 inode = __inode_create (table);
                 if (inode != NULL) {
                         __inode_ref (inode);
                 }
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
         return inode;
 }
@@ -577,7 +858,7 @@ __inode_lookup (inode_t *inode)
         if (!inode)
                 return NULL;
 
-        inode->nlookup++;
+        __sync_fetch_and_add (&inode->nlookup, 1);
 
         return inode;
 }
@@ -586,15 +867,19 @@ __inode_lookup (inode_t *inode)
 static inode_t *
 __inode_forget (inode_t *inode, uint64_t nlookup)
 {
+        uint64_t old = 0;
+        uint64_t new = 0;
+
         if (!inode)
                 return NULL;
 
-        GF_ASSERT (inode->nlookup >= nlookup);
+        do {
+                old = inode->nlookup;
 
-        inode->nlookup -= nlookup;
+                GF_ASSERT (old >= nlookup);
 
-        if (!nlookup)
-                inode->nlookup = 0;
+                new = nlookup ? (old - nlookup) : 0;
+        } while (!__sync_bool_compare_and_swap (&inode->nlookup, old, new));
 
         return inode;
 }
@@ -635,7 +920,7 @@ inode_grep (inode_table_t *table, inode_t *parent, const char *name)
                 return NULL;
         }
 
-        pthread_mutex_lock (&table->lock);
+        pthread_rwlock_rdlock (&table->lock);
         {
                 dentry = __dentry_grep (table, parent, name);
 
@@ -645,7 +930,7 @@ inode_grep (inode_table_t *table, inode_t *parent, const char *name)
                 if (inode)
                         __inode_ref (inode);
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
         return inode;
 }
@@ -708,7 +993,7 @@ inode_grep_for_gfid (inode_table_t *table, inode_t *parent, const char *name,
                 return ret;
         }
 
-        pthread_mutex_lock (&table->lock);
+        pthread_rwlock_rdlock (&table->lock);
         {
                 dentry = __dentry_grep (table, parent, name);
 
@@ -721,7 +1006,7 @@ inode_grep_for_gfid (inode_table_t *table, inode_t *parent, const char *name,
                         ret = 0;
                 }
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
         return ret;
 }
@@ -758,7 +1043,7 @@ __inode_find (inode_table_t *table, uuid_t gfid)
         if (__is_root_gfid (gfid))
                 return table->root;
 
-        hash = hash_gfid (gfid, 65536);
+        hash = hash_gfid (gfid, table->inode_hashsize);
 
         list_for_each_entry (tmp, &table->inode_hash[hash], hash) {
                 if (uuid_compare (tmp->gfid, gfid) == 0) {
@@ -782,13 +1067,13 @@ inode_find (inode_table_t *table, uuid_t gfid)
                 return NULL;
         }
 
-        pthread_mutex_lock (&table->lock);
+        pthread_rwlock_rdlock (&table->lock);
         {
                 inode = __inode_find (table, gfid);
                 if (inode)
                         __inode_ref (inode);
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
         return inode;
 }
@@ -888,14 +1173,14 @@ inode_link (inode_t *inode, inode_t *parent, const char *name,
 
         table = inode->table;
 
-        pthread_mutex_lock (&table->lock);
+        pthread_rwlock_wrlock (&table->lock);
         {
                 linked_inode = __inode_link (inode, parent, name, iatt);
 
                 if (linked_inode)
                         __inode_ref (linked_inode);
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
         inode_table_prune (table);
 
@@ -915,11 +1200,11 @@ inode_lookup (inode_t *inode)
 
         table = inode->table;
 
-        pthread_mutex_lock (&table->lock);
+        pthread_rwlock_rdlock (&table->lock);
         {
                 __inode_lookup (inode);
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
         return 0;
 }
@@ -937,11 +1222,11 @@ inode_forget (inode_t *inode, uint64_t nlookup)
 
         table = inode->table;
 
-        pthread_mutex_lock (&table->lock);
+        pthread_rwlock_rdlock (&table->lock);
         {
                 __inode_forget (inode, nlookup);
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
         inode_table_prune (table);
 
@@ -1025,11 +1310,11 @@ inode_unlink (inode_t *inode, inode_t *parent, const char *name)
 
         table = inode->table;
 
-        pthread_mutex_lock (&table->lock);
+        pthread_rwlock_wrlock (&table->lock);
         {
                 __inode_unlink (inode, parent, name);
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
         inode_table_prune (table);
 }
@@ -1047,12 +1332,12 @@ inode_rename (inode_table_t *table, inode_t *srcdir, const char *srcname,
 
         table = inode->table;
 
-        pthread_mutex_lock (&table->lock);
+        pthread_rwlock_wrlock (&table->lock);
         {
                 __inode_link (inode, dstdir, dstname, iatt);
                 __inode_unlink (inode, srcdir, srcname);
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
         inode_table_prune (table);
 
@@ -1101,7 +1386,7 @@ inode_parent (inode_t *inode, uuid_t pargfid, const char *name)
 
         table = inode->table;
 
-        pthread_mutex_lock (&table->lock);
+        pthread_rwlock_rdlock (&table->lock);
         {
                 if (pargfid && !uuid_is_null (pargfid) && name) {
                         dentry = __dentry_search_for_inode (inode, pargfid, name);
@@ -1115,7 +1400,7 @@ inode_parent (inode_t *inode, uuid_t pargfid, const char *name)
                 if (parent)
                         __inode_ref (parent);
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
         return parent;
 }
@@ -1230,11 +1515,11 @@ inode_path (inode_t *inode, const char *name, char **bufp)
 
         table = inode->table;
 
-        pthread_mutex_lock (&table->lock);
+        pthread_rwlock_rdlock (&table->lock);
         {
                 ret = __inode_path (inode, name, bufp);
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
         return ret;
 }
@@ -1254,23 +1539,33 @@ inode_table_prune (inode_table_t *table)
 
         INIT_LIST_HEAD (&purge);
 
-        pthread_mutex_lock (&table->lock);
+        pthread_rwlock_wrlock (&table->lock);
         {
                 while (table->lru_limit
                        && table->lru_size > (table->lru_limit)) {
 
-                        entry = list_entry (table->lru.next, inode_t, list);
+                        pthread_mutex_lock (&table->lru_lock);
+                        {
+                                entry = list_entry (table->lru.next, inode_t,
+                                                    list);
+                                table->lru_size--;
+                                __inode_retire_list (entry);
+                        }
+                        pthread_mutex_unlock (&table->lru_lock);
 
-                        table->lru_size--;
                         __inode_retire (entry);
 
                         ret++;
                 }
 
-                list_splice_init (&table->purge, &purge);
-                table->purge_size = 0;
+                pthread_mutex_lock (&table->lru_lock);
+                {
+                        list_splice_init (&table->purge, &purge);
+                        table->purge_size = 0;
+                }
+                pthread_mutex_unlock (&table->lru_lock);
         }
-        pthread_mutex_unlock (&table->lock);
+        pthread_rwlock_unlock (&table->lock);
 
         {
                 list_for_each_entry_safe (del, tmp, &purge, list) {
@@ -1309,7 +1604,6 @@ inode_table_new (size_t lru_limit, xlator_t *xl)
 {
         inode_table_t *new = NULL;
         int            ret = -1;
-        int            i = 0;
 
         new = (void *)GF_CALLOC(1, sizeof (*new), gf_common_mt_inode_table_t);
         if (!new)
@@ -1319,7 +1613,12 @@ inode_table_new (size_t lru_limit, xlator_t *xl)
 
         new->lru_limit = lru_limit;
 
-        new->hashsize = 14057; /* TODO: Random Number?? */
+        new->ctxcount = xl->graph->xl_count + INODE_CTX_SPARE_SLOTS;
+
+        /* both hashes start small and double as they fill up, see
+           __inode_hash () and __dentry_hash () */
+        new->hashsize = DENTRY_HASH_MIN_SIZE;
+        new->inode_hashsize = INODE_HASH_MIN_SIZE;
 
         /* In case FUSE is initing the inode table. */
         if (lru_limit == 0)
@@ -1335,15 +1634,11 @@ inode_table_new (size_t lru_limit, xlator_t *xl)
         if (!new->dentry_pool)
                 goto out;
 
-        new->inode_hash = (void *)GF_CALLOC (65536,
-                                             sizeof (struct list_head),
-                                             gf_common_mt_list_head);
+        new->inode_hash = __inode_hash_buckets_new (new->inode_hashsize);
         if (!new->inode_hash)
                 goto out;
 
-        new->name_hash = (void *)GF_CALLOC (new->hashsize,
-                                            sizeof (struct list_head),
-                                            gf_common_mt_list_head);
+        new->name_hash = __inode_hash_buckets_new (new->hashsize);
         if (!new->name_hash)
                 goto out;
 
@@ -1354,15 +1649,6 @@ inode_table_new (size_t lru_limit, xlator_t *xl)
         if (!new->fd_mem_pool)
                 goto out;
 
-        for (i = 0; i < 65536; i++) {
-                INIT_LIST_HEAD (&new->inode_hash[i]);
-        }
-
-
-        for (i = 0; i < new->hashsize; i++) {
-                INIT_LIST_HEAD (&new->name_hash[i]);
-        }
-
         INIT_LIST_HEAD (&new->active);
         INIT_LIST_HEAD (&new->lru);
         INIT_LIST_HEAD (&new->purge);
@@ -1373,9 +1659,10 @@ inode_table_new (size_t lru_limit, xlator_t *xl)
                 ;
         }
 
-        __inode_table_init_root (new);
+        pthread_rwlock_init (&new->lock, NULL);
+        pthread_mutex_init (&new->lru_lock, NULL);
 
-        pthread_mutex_init (&new->lock, NULL);
+        __inode_table_init_root (new);
 
         ret = 0;
 out:
@@ -1455,31 +1742,64 @@ out:
 }
 
 
+/* Every xlator of the table's graph owns the _ctx slot at its xl_id, so
+   inodes and fds of @table reach it without a scan. Returns -1 for any
+   other xlator, which then has to look through the spare slots. */
 int
-__inode_ctx_set2 (inode_t *inode, xlator_t *xlator, uint64_t *value1_p,
-                  uint64_t *value2_p)
+inode_table_ctx_slot (inode_table_t *table, xlator_t *xlator)
+{
+        if (xlator->graph != table->xl->graph)
+                return -1;
+
+        if ((xlator->xl_id < 0) ||
+            (xlator->xl_id >= (table->ctxcount - INODE_CTX_SPARE_SLOTS)))
+                return -1;
+
+        return xlator->xl_id;
+}
+
+
+static int
+__inode_ctx_index (inode_t *inode, xlator_t *xlator, gf_boolean_t create)
 {
-        int ret = 0;
         int index = 0;
         int set_idx = -1;
 
-        if (!inode || !xlator)
+        index = inode_table_ctx_slot (inode->table, xlator);
+        if (index >= 0) {
+                if (create || (inode->_ctx[index].xl_key == xlator))
+                        return index;
                 return -1;
+        }
 
-        for (index = 0; index < xlator->graph->xl_count; index++) {
-                if (!inode->_ctx[index].xl_key) {
-                        if (set_idx == -1)
-                                set_idx = index;
-                        /* dont break, to check if key already exists
-                           further on */
-                }
-                if (inode->_ctx[index].xl_key == xlator) {
+        for (index = inode->table->ctxcount - INODE_CTX_SPARE_SLOTS;
+             index < inode->table->ctxcount; index++) {
+                if (inode->_ctx[index].xl_key == xlator)
+                        return index;
+                if (!inode->_ctx[index].xl_key && (set_idx == -1))
                         set_idx = index;
-                        break;
-                }
         }
 
+        return create ? set_idx : -1;
+}
+
+
+int
+__inode_ctx_set2 (inode_t *inode, xlator_t *xlator, uint64_t *value1_p,
+                  uint64_t *value2_p)
+{
+        int ret = 0;
+        int set_idx = -1;
+
+        if (!inode || !xlator)
+                return -1;
+
+        set_idx = __inode_ctx_index (inode, xlator, _gf_true);
         if (set_idx == -1) {
+                gf_log_callingfn (xlator->name, GF_LOG_ERROR,
+                                  "no inode ctx slot left for xlator outside "
+                                  "the graph (%d spare slots taken)",
+                                  INODE_CTX_SPARE_SLOTS);
                 ret = -1;
                 goto out;;
         }
@@ -1523,12 +1843,8 @@ __inode_ctx_get2 (inode_t *inode, xlator_t *xlator, uint64_t *value1,
         if (!inode || !xlator)
                 return -1;
 
-        for (index = 0; index < xlator->graph->xl_count; index++) {
-                if (inode->_ctx[index].xl_key == xlator)
-                        break;
-        }
-
-        if (index == xlator->graph->xl_count) {
+        index = __inode_ctx_index (inode, xlator, _gf_false);
+        if (index == -1) {
                 ret = -1;
                 goto out;
         }
@@ -1575,12 +1891,8 @@ inode_ctx_del2 (inode_t *inode, xlator_t *xlator, uint64_t *value1,
 
         LOCK (&inode->lock);
         {
-                for (index = 0; index < xlator->graph->xl_count; index++) {
-                        if (inode->_ctx[index].xl_key == xlator)
-                                break;
-                }
-
-                if (index == xlator->graph->xl_count) {
+                index = __inode_ctx_index (inode, xlator, _gf_false);
+                if (index == -1) {
                         ret = -1;
                         goto unlock;
                 }
@@ -1628,14 +1940,14 @@ inode_dump (inode_t *inode, char *prefix)
                 gf_proc_dump_write("ref", "%u", inode->ref);
                 gf_proc_dump_write("ia_type", "%d", inode->ia_type);
                 if (inode->_ctx) {
-                        inode_ctx = GF_CALLOC (inode->table->xl->graph->xl_count,
+                        inode_ctx = GF_CALLOC (inode->table->ctxcount,
                                                sizeof (*inode_ctx),
                                                gf_common_mt_inode_ctx);
                         if (inode_ctx == NULL) {
                                 goto unlock;
                         }
 
-                        for (i = 0; i < inode->table->xl->graph->xl_count; i++) {
+                        for (i = 0; i < inode->table->ctxcount; i++) {
                                 inode_ctx[i] = inode->_ctx[i];
                         }
                 }
@@ -1652,7 +1964,7 @@ unlock:
         UNLOCK(&inode->lock);
 
         if (inode_ctx && (dump_options.xl_options.dump_inodectx == _gf_true)) {
-                for (i = 0; i < inode->table->xl->graph->xl_count; i++) {
+                for (i = 0; i < inode->table->ctxcount; i++) {
                         if (inode_ctx[i].xl_key) {
                                 xl = (xlator_t *)(long)inode_ctx[i].xl_key;
                                 if (xl->dumpops && xl->dumpops->inodectx)
@@ -1677,14 +1989,26 @@ inode_table_dump (inode_table_t *itable, char *prefix)
                 return;
 
         memset(key, 0, sizeof(key));
-        ret = pthread_mutex_trylock(&itable->lock);
+        ret = pthread_rwlock_tryrdlock(&itable->lock);
 
         if (ret != 0) {
                 return;
         }
 
+        ret = pthread_mutex_trylock(&itable->lru_lock);
+        if (ret != 0) {
+                pthread_rwlock_unlock(&itable->lock);
+                return;
+        }
+
         gf_proc_dump_build_key(key, prefix, "hashsize");
         gf_proc_dump_write(key, "%d", itable->hashsize);
+        gf_proc_dump_build_key(key, prefix, "inode_hashsize");
+        gf_proc_dump_write(key, "%d", itable->inode_hashsize);
+        gf_proc_dump_build_key(key, prefix, "hashed_inodes");
+        gf_proc_dump_write(key, "%d", itable->hashed_inodes);
+        gf_proc_dump_build_key(key, prefix, "hashed_dentries");
+        gf_proc_dump_write(key, "%d", itable->hashed_dentries);
         gf_proc_dump_build_key(key, prefix, "name");
         gf_proc_dump_write(key, "%s", itable->name);
 
@@ -1701,7 +2025,8 @@ inode_table_dump (inode_table_t *itable, char *prefix)
         INODE_DUMP_LIST(&itable->lru, key, prefix, "lru");
         INODE_DUMP_LIST(&itable->purge, key, prefix, "purge");
 
-        pthread_mutex_unlock(&itable->lock);
+        pthread_mutex_unlock(&itable->lru_lock);
+        pthread_rwlock_unlock(&itable->lock);
 }
 
 void
@@ -1749,10 +2074,16 @@ inode_table_dump_to_dict (inode_table_t *itable, char *prefix, dict_t *dict)
         inode_t         *inode = NULL;
         int             count = 0;
 
-        ret = pthread_mutex_trylock (&itable->lock);
+        ret = pthread_rwlock_tryrdlock (&itable->lock);
         if (ret)
                 return;
 
+        ret = pthread_mutex_trylock (&itable->lru_lock);
+        if (ret) {
+                pthread_rwlock_unlock (&itable->lock);
+                return;
+        }
+
         memset (key, 0, sizeof (key));
         snprintf (key, sizeof (key), "%s.itable.active_size", prefix);
         ret = dict_set_uint32 (dict, key, itable->active_size);
@@ -1795,7 +2126,8 @@ inode_table_dump_to_dict (inode_table_t *itable, char *prefix, dict_t *dict)
         }
 
 out:
-        pthread_mutex_unlock (&itable->lock);
+        pthread_mutex_unlock (&itable->lru_lock);
+        pthread_rwlock_unlock (&itable->lock);
 
         return;
 }
@@ -20,6 +20,14 @@
 #include <sys/types.h>
 
 #define DEFAULT_INODE_MEMPOOL_ENTRIES   32 * 1024
+#define INODE_HASH_MIN_SIZE             65536
+#define DENTRY_HASH_MIN_SIZE            16384
+#define INODE_HASH_MAX_SIZE             (1 << 24)
+#define INODE_HASH_LOAD_FACTOR          2
+/* _ctx slots past the graph's own, shared by xlators of other graphs
+   (fuse, gfapi, or a previous graph after a switch). Setting a ctx fails,
+   with an error logged, once they are all taken. */
+#define INODE_CTX_SPARE_SLOTS           4
 #define INODE_PATH_FMT "<gfid:%s>"
 struct _inode_table;
 typedef struct _inode_table inode_table_t;
@@ -37,8 +45,15 @@ typedef struct _dentry dentry_t;
 
 
 struct _inode_table {
-        pthread_mutex_t    lock;
-        size_t             hashsize;    /* bucket size of inode hash and dentry hash */
+        pthread_rwlock_t   lock;        /* hashes and dentry tree, shared
+                                           for lookups */
+        pthread_mutex_t    lru_lock;    /* active/lru/purge lists and sizes */
+        size_t             hashsize;    /* bucket size of dentry hash */
+        size_t             inode_hashsize; /* bucket size of inode hash */
+        uint32_t           hashed_inodes;  /* inodes in inode hash */
+        uint32_t           hashed_dentries; /* dentries in dentry hash */
+        int                ctxcount;    /* _ctx slots of each inode: one per
+                                           xlator of xl->graph, plus spares */
         char              *name;        /* name of the inode table, just for gf_log() */
         inode_t           *root;        /* root directory inode, with number 1 */
         xlator_t          *xl;          /* xlator to be called to do purge */
@@ -86,9 +101,10 @@ struct _inode {
         inode_table_t       *table;         /* the table this inode belongs to */
         uuid_t               gfid;
         gf_lock_t            lock;
-        uint64_t             nlookup;
+        uint64_t             nlookup;       /* atomic, see inode.c */
         uint32_t             fd_count;      /* Open fd count */
-        uint32_t             ref;           /* reference count on this inode */
+        uint32_t             ref;           /* reference count on this inode,
+                                               atomic, see inode.c */
         ia_type_t            ia_type;       /* what kind of file */
         struct list_head     fd_list;       /* list of open files on this inode */
         struct list_head     dentry_list;   /* list of directory entries for this inode */
@@ -179,6 +195,9 @@ inode_ctx_del2 (inode_t *inode, xlator_t *xlator, uint64_t *value1,
 inode_t *
 inode_resolve (inode_table_t *table, char *path);
 
+int
+inode_table_ctx_slot (inode_table_t *table, xlator_t *xlator);
+
 #define __inode_ctx_set(i,x,v_p) __inode_ctx_set2(i,x,v_p,0)
 #define inode_ctx_set(i,x,v_p) inode_ctx_set2(i,x,v_p,0)
 
@@ -32,8 +32,26 @@ struct iobuf_init_config gf_iobuf_init_config[] = {
         {128 * 1024, 32},
         {256 * 1024, 8},
         {1 * 1024 * 1024, 2},
+        {2 * 1024 * 1024, 2},
+        {4 * 1024 * 1024, 1},
 };
 
+/* the free iobufs of one thread, see GF_IOBUF_CACHE_DEPTH */
+struct iobuf_thread_cache {
+        struct list_head   list;        /* iobuf_pool->caches */
+        struct iobuf_pool *iobuf_pool;  /* NULL once the pool is gone */
+        size_t             bytes;
+        int                count[GF_VARIABLE_IOBUF_COUNT];
+        struct iobuf      *iobufs[GF_VARIABLE_IOBUF_COUNT][GF_IOBUF_CACHE_DEPTH];
+        uint64_t           hits[GF_VARIABLE_IOBUF_COUNT];
+};
+
+static pthread_once_t iobuf_cache_once = PTHREAD_ONCE_INIT;
+static pthread_key_t  iobuf_cache_key;
+static int            iobuf_cache_ready;
+
+void __iobuf_put (struct iobuf *iobuf, struct iobuf_arena *iobuf_arena);
+
 int
 gf_iobuf_get_arena_index (size_t page_size)
 {
@@ -154,6 +172,36 @@ out:
 }
 
 
+static void *
+iobuf_arena_mmap (size_t size)
+{
+        void *mem = MAP_FAILED;
+
+        if (size % GF_IOBUF_HUGEPAGE_SIZE)
+                goto out;
+
+#ifdef MAP_HUGETLB
+        /* only there when huge pages were reserved for us */
+        mem = mmap (NULL, size, PROT_READ|PROT_WRITE,
+                    MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+        if (mem != MAP_FAILED)
+                return mem;
+#endif
+
+out:
+        mem = mmap (NULL, size, PROT_READ|PROT_WRITE,
+                    MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+
+#ifdef MADV_HUGEPAGE
+        /* otherwise let transparent huge pages back it */
+        if (mem != MAP_FAILED && !(size % GF_IOBUF_HUGEPAGE_SIZE))
+                madvise (mem, size, MADV_HUGEPAGE);
+#endif
+
+        return mem;
+}
+
+
 struct iobuf_arena *
 __iobuf_arena_alloc (struct iobuf_pool *iobuf_pool, size_t page_size,
                      int32_t num_iobufs)
@@ -180,9 +228,7 @@ __iobuf_arena_alloc (struct iobuf_pool *iobuf_pool, size_t page_size,
 
         iobuf_arena->arena_size = rounded_size * num_iobufs;
 
-        iobuf_arena->mem_base = mmap (NULL, iobuf_arena->arena_size,
-                                      PROT_READ|PROT_WRITE,
-                                      MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+        iobuf_arena->mem_base = iobuf_arena_mmap (iobuf_arena->arena_size);
         if (iobuf_arena->mem_base == MAP_FAILED) {
                 gf_log (THIS->name, GF_LOG_WARNING, "maping failed");
                 goto err;
@@ -285,15 +331,165 @@ out:
 }
 
 
+/* Gives the iobufs of @cache back to their arenas. Called with
+   iobuf_pool->mutex held. */
+static void
+__iobuf_thread_cache_drain (struct iobuf_thread_cache *cache)
+{
+        struct iobuf_pool *iobuf_pool = NULL;
+        struct iobuf      *iobuf      = NULL;
+        int                i          = 0;
+
+        iobuf_pool = cache->iobuf_pool;
+
+        for (i = 0; i < GF_VARIABLE_IOBUF_COUNT; i++) {
+                while (cache->count[i]) {
+                        iobuf = cache->iobufs[i][--cache->count[i]];
+                        __iobuf_put (iobuf, iobuf->iobuf_arena);
+                }
+
+                iobuf_pool->stats[i].cache_hits += cache->hits[i];
+                cache->hits[i] = 0;
+        }
+
+        cache->bytes = 0;
+}
+
+
+static void
+iobuf_thread_cache_destroy (void *data)
+{
+        struct iobuf_thread_cache *cache      = data;
+        struct iobuf_pool         *iobuf_pool = NULL;
+
+        iobuf_pool = cache->iobuf_pool;
+        if (iobuf_pool) {
+                pthread_mutex_lock (&iobuf_pool->mutex);
+                {
+                        __iobuf_thread_cache_drain (cache);
+                        list_del (&cache->list);
+                }
+                pthread_mutex_unlock (&iobuf_pool->mutex);
+        }
+
+        FREE (cache);
+}
+
+
+static void
+iobuf_cache_init_once (void)
+{
+        if (pthread_key_create (&iobuf_cache_key,
+                                iobuf_thread_cache_destroy) == 0)
+                iobuf_cache_ready = 1;
+}
+
+
+/* The calling thread's cache, if it caches iobufs of @iobuf_pool. A
+   thread only caches for one pool, the first one it uses. */
+static struct iobuf_thread_cache *
+iobuf_thread_cache_get (struct iobuf_pool *iobuf_pool)
+{
+        struct iobuf_thread_cache *cache = NULL;
+
+        pthread_once (&iobuf_cache_once, iobuf_cache_init_once);
+        if (!iobuf_cache_ready)
+                return NULL;
+
+        cache = pthread_getspecific (iobuf_cache_key);
+        if (cache && cache->iobuf_pool)
+                return (cache->iobuf_pool == iobuf_pool) ? cache : NULL;
+
+        if (!cache) {
+                cache = CALLOC (1, sizeof (*cache));
+                if (!cache)
+                        return NULL;
+
+                if (pthread_setspecific (iobuf_cache_key, cache)) {
+                        FREE (cache);
+                        return NULL;
+                }
+        }
+
+        pthread_mutex_lock (&iobuf_pool->mutex);
+        {
+                list_add_tail (&cache->list, &iobuf_pool->caches);
+                cache->iobuf_pool = iobuf_pool;
+        }
+        pthread_mutex_unlock (&iobuf_pool->mutex);
+
+        return cache;
+}
+
+
+static struct iobuf *
+iobuf_thread_cache_pop (struct iobuf_pool *iobuf_pool, int index)
+{
+        struct iobuf_thread_cache *cache = NULL;
+        struct iobuf              *iobuf = NULL;
+
+        cache = iobuf_thread_cache_get (iobuf_pool);
+        if (!cache || !cache->count[index])
+                return NULL;
+
+        iobuf = cache->iobufs[index][--cache->count[index]];
+        cache->bytes -= iobuf->iobuf_arena->page_size;
+        cache->hits[index]++;
+
+        return iobuf;
+}
+
+
+static int
+iobuf_thread_cache_push (struct iobuf *iobuf)
+{
+        struct iobuf_thread_cache *cache       = NULL;
+        struct iobuf_arena        *iobuf_arena = NULL;
+        int                        index       = 0;
+
+        iobuf_arena = iobuf->iobuf_arena;
+
+        index = gf_iobuf_get_arena_index (iobuf_arena->page_size);
+        if (index == -1)
+                return -1;
+
+        cache = iobuf_thread_cache_get (iobuf_arena->iobuf_pool);
+        if (!cache)
+                return -1;
+
+        if (cache->count[index] == GF_IOBUF_CACHE_DEPTH ||
+            cache->bytes + iobuf_arena->page_size > GF_IOBUF_CACHE_BYTES)
+                return -1;
+
+        cache->iobufs[index][cache->count[index]++] = iobuf;
+        cache->bytes += iobuf_arena->page_size;
+
+        return 0;
+}
+
+
 void
 iobuf_pool_destroy (struct iobuf_pool *iobuf_pool)
 {
-        struct iobuf_arena *iobuf_arena = NULL;
-        struct iobuf_arena *tmp         = NULL;
-        int                 i           = 0;
+        struct iobuf_arena        *iobuf_arena = NULL;
+        struct iobuf_arena        *tmp         = NULL;
+        struct iobuf_thread_cache *cache       = NULL;
+        struct iobuf_thread_cache *tmp_cache   = NULL;
+        int                        i           = 0;
 
         GF_VALIDATE_OR_GOTO ("iobuf", iobuf_pool, out);
 
+        pthread_mutex_lock (&iobuf_pool->mutex);
+        {
+                list_for_each_entry_safe (cache, tmp_cache,
+                                          &iobuf_pool->caches, list) {
+                        __iobuf_thread_cache_drain (cache);
+                        list_del_init (&cache->list);
+                        cache->iobuf_pool = NULL;
+                }
+        }
+        pthread_mutex_unlock (&iobuf_pool->mutex);
+
         for (i = 0; i < IOBUF_ARENA_MAX_INDEX; i++) {
                 list_for_each_entry_safe (iobuf_arena, tmp,
                                           &iobuf_pool->arenas[i], list) {
@@ -349,6 +545,7 @@ iobuf_pool_new (void)
                 goto out;
 
         pthread_mutex_init (&iobuf_pool->mutex, NULL);
+        INIT_LIST_HEAD (&iobuf_pool->caches);
         for (i = 0; i <= IOBUF_ARENA_MAX_INDEX; i++) {
                 INIT_LIST_HEAD (&iobuf_pool->arenas[i]);
                 INIT_LIST_HEAD (&iobuf_pool->filled[i]);
@@ -362,6 +559,9 @@ iobuf_pool_new (void)
                 page_size = gf_iobuf_init_config[i].pagesize;
                 num_pages = gf_iobuf_init_config[i].num_pages;
 
+                if (page_size > GF_IOBUF_PREALLOC_MAX_PAGESIZE)
+                        continue;
+
                 iobuf_pool_add_arena (iobuf_pool, page_size, num_pages);
 
                 arena_size += page_size * num_pages;
@@ -456,6 +656,11 @@ __iobuf_select_arena (struct iobuf_pool *iobuf_pool, size_t page_size)
                 }
         }
 
+        if (iobuf_arena)
+                iobuf_pool->stats[index].hits++;
+        else
+                iobuf_pool->stats[index].misses++;
+
         if (!iobuf_arena) {
                 /* all arenas were full, find the right count to add */
                 iobuf_arena = __iobuf_pool_add_arena (iobuf_pool, page_size,
@@ -597,6 +802,14 @@ iobuf_get2 (struct iobuf_pool *iobuf_pool, size_t page_size)
                 return iobuf;
         }
 
+        iobuf = iobuf_thread_cache_pop (iobuf_pool,
+                                        gf_iobuf_get_arena_index (rounded_size));
+        if (iobuf) {
+                /* nobody else knows about a cached iobuf */
+                __iobuf_ref (iobuf);
+                return iobuf;
+        }
+
         pthread_mutex_lock (&iobuf_pool->mutex);
         {
                 /* most eligible arena for picking an iobuf */
@@ -620,31 +833,12 @@ struct iobuf *
 iobuf_get (struct iobuf_pool *iobuf_pool)
 {
         struct iobuf       *iobuf        = NULL;
-        struct iobuf_arena *iobuf_arena  = NULL;
 
         GF_VALIDATE_OR_GOTO ("iobuf", iobuf_pool, out);
 
-        pthread_mutex_lock (&iobuf_pool->mutex);
-        {
-                /* most eligible arena for picking an iobuf */
-                iobuf_arena = __iobuf_select_arena (iobuf_pool,
-                                                    iobuf_pool->default_page_size);
-                if (!iobuf_arena) {
-                        gf_log (THIS->name, GF_LOG_WARNING, "arena not found");
-                        goto unlock;
-                }
-
-                iobuf = __iobuf_get (iobuf_arena,
-                                     iobuf_pool->default_page_size);
-                if (!iobuf) {
-                        gf_log (THIS->name, GF_LOG_WARNING, "iobuf not found");
-                        goto unlock;
-                }
-
-                __iobuf_ref (iobuf);
-        }
-unlock:
-        pthread_mutex_unlock (&iobuf_pool->mutex);
+        iobuf = iobuf_get2 (iobuf_pool, iobuf_pool->default_page_size);
+        if (!iobuf)
+                gf_log (THIS->name, GF_LOG_WARNING, "iobuf not found");
 
 out:
         return iobuf;
@@ -714,6 +908,9 @@ iobuf_put (struct iobuf *iobuf)
                 return;
         }
 
+        if (!iobuf_thread_cache_push (iobuf))
+                return;
+
         pthread_mutex_lock (&iobuf_pool->mutex);
         {
                 __iobuf_put (iobuf, iobuf_arena);
@@ -1042,7 +1239,11 @@ void
 iobuf_stats_dump (struct iobuf_pool *iobuf_pool)
 {
         char               msg[1024];
+        char               key[GF_DUMP_MAX_BUF_LEN];
         struct iobuf_arena *trav = NULL;
+        struct iobuf_thread_cache *cache = NULL;
+        struct iobuf_class_stats   stats;
+        int                cached = 0;
         int                i = 1;
         int                j = 0;
         int                ret = -1;
@@ -1067,6 +1268,28 @@ iobuf_stats_dump (struct iobuf_pool *iobuf_pool)
         gf_proc_dump_write("iobuf_pool.request_misses", "%"PRId64,
                            iobuf_pool->request_misses);
 
+        for (j = 0; j < IOBUF_ARENA_MAX_INDEX; j++) {
+                stats = iobuf_pool->stats[j];
+                cached = 0;
+
+                /* live threads' counters are read behind their back */
+                list_for_each_entry (cache, &iobuf_pool->caches, list) {
+                        stats.cache_hits += cache->hits[j];
+                        cached += cache->count[j];
+                }
+
+                snprintf (msg, sizeof (msg), "iobuf_pool.class.%zu",
+                          gf_iobuf_init_config[j].pagesize);
+                gf_proc_dump_build_key (key, msg, "hits");
+                gf_proc_dump_write (key, "%"PRIu64, stats.hits);
+                gf_proc_dump_build_key (key, msg, "misses");
+                gf_proc_dump_write (key, "%"PRIu64, stats.misses);
+                gf_proc_dump_build_key (key, msg, "cache_hits");
+                gf_proc_dump_write (key, "%"PRIu64, stats.cache_hits);
+                gf_proc_dump_build_key (key, msg, "cached");
+                gf_proc_dump_write (key, "%d", cached);
+        }
+
         for (j = 0; j < IOBUF_ARENA_MAX_INDEX; j++) {
                 list_for_each_entry (trav, &iobuf_pool->arenas[j], list) {
                         snprintf(msg, sizeof(msg),
@@ -36,6 +36,18 @@
 
 #define GF_IOBUF_ALIGN_SIZE 512
 
+/* Free iobufs a thread keeps for itself per size class, so that most
+   iobuf_get2/iobuf_unref pairs never take iobuf_pool->mutex. A thread
+   holds at most GF_IOBUF_CACHE_BYTES in all its classes together. */
+#define GF_IOBUF_CACHE_DEPTH  8
+#define GF_IOBUF_CACHE_BYTES  (2 * GF_UNIT_MB)
+
+/* classes above this get their first arena when first asked for */
+#define GF_IOBUF_PREALLOC_MAX_PAGESIZE  (1 * GF_UNIT_MB)
+
+/* arenas of a multiple of this size are backed by huge pages if possible */
+#define GF_IOBUF_HUGEPAGE_SIZE  (2 * GF_UNIT_MB)
+
 /* one allocatable unit for the consumers of the IOBUF API */
 /* each unit hosts @page_size bytes of memory */
 struct iobuf;
@@ -104,6 +116,13 @@ struct iobuf_arena {
 };
 
 
+struct iobuf_class_stats {
+        uint64_t            hits;       /* an arena had a free iobuf */
+        uint64_t            misses;     /* an arena had to be added */
+        uint64_t            cache_hits; /* served from a thread cache */
+};
+
+
 struct iobuf_pool {
         pthread_mutex_t     mutex;
         size_t              arena_size; /* size of memory region in
@@ -123,6 +142,12 @@ struct iobuf_pool {
 
         uint64_t            request_misses; /* mostly the requests for higher
                                                value of iobufs */
+
+        struct iobuf_class_stats stats[GF_VARIABLE_IOBUF_COUNT];
+        /* per size class; cache_hits only has those of exited threads,
+           the live ones are summed from their caches */
+
+        struct list_head    caches;     /* thread caches using this pool */
 };
 
 
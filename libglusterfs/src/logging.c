@@ -26,6 +26,7 @@
 #include "logging.h"
 #include "defaults.h"
 #include "glusterfs.h"
+#include "hashfn.h"
 
 #ifdef GF_LINUX_HOST_OS
 #include <syslog.h>
@@ -105,10 +106,18 @@ gf_log_fini (void)
 void
 gf_log_globals_init (void *data)
 {
-        glusterfs_ctx_t *ctx = data;
+        glusterfs_ctx_t    *ctx = data;
+        pthread_condattr_t  attr;
 
         pthread_mutex_init (&ctx->log.logfile_mutex, NULL);
 
+        pthread_mutex_init (&ctx->log.rings_lock, NULL);
+        pthread_condattr_init (&attr);
+        pthread_condattr_setclock (&attr, CLOCK_MONOTONIC);
+        pthread_cond_init (&ctx->log.logger_cond, &attr);
+        pthread_condattr_destroy (&attr);
+        INIT_LIST_HEAD (&ctx->log.rings);
+
         ctx->log.loglevel         = GF_LOG_INFO;
         ctx->log.gf_log_syslog    = 1;
         ctx->log.sys_log_level    = GF_LOG_CRITICAL;
@@ -172,6 +181,474 @@ set_sys_log_level (gf_loglevel_t level)
         THIS->ctx->log.sys_log_level = level;
 }
 
+/* Asynchronous logging.
+ *
+ * Every thread that logs gets its own ring of ctx->log.buf_size bytes.
+ * The thread is the only writer and the logger thread the only reader of
+ * it, so queueing a message takes no lock, only ordered updates of head
+ * and tail. When the ring is full the message is dropped and counted,
+ * the logger reports the count. A thread repeating the same message is
+ * only told about once per GF_LOG_SUPPRESS_SECS, with a count.
+ */
+
+struct gf_log_rec {
+        uint32_t  len;          /* of msg, without the NUL */
+        int32_t   level;
+        char      msg[];
+};
+
+#define GF_LOG_REC_WRAP         -1     /* rest of the ring is unused */
+#define GF_LOG_REC_SIZE(len)    ((sizeof (struct gf_log_rec) + (len) + 1 + 7) \
+                                 & ~7)
+
+struct gf_log_ring {
+        struct list_head   list;        /* ctx->log.rings */
+        glusterfs_ctx_t   *ctx;
+        char              *buf;
+        uint32_t           size;
+        volatile uint64_t  head;        /* moved by the owning thread */
+        volatile uint64_t  tail;        /* moved by the logger */
+        uint64_t           dropped;
+        volatile char      dead;        /* nobody writes to it anymore */
+
+        /* repeat suppression, owning thread only */
+        uint32_t           last_hash;
+        gf_loglevel_t      last_level;
+        time_t             last_time;
+        uint32_t           repeats;
+};
+
+static pthread_key_t  gf_log_ring_key;
+static pthread_once_t gf_log_ring_once = PTHREAD_ONCE_INIT;
+static int            gf_log_ring_ready;
+
+static const char *gf_log_level_strings[] = {"", "M", "A", "C", "E", "W",
+                                             "N", "I", "D", "T", ""};
+
+
+static void
+gf_log_timestr (char *timestr, size_t size)
+{
+        struct timeval tv = {0,};
+
+        gettimeofday (&tv, NULL);
+        gf_time_fmt (timestr, size, tv.tv_sec, gf_timefmt_FT);
+        snprintf (timestr + strlen (timestr), size - strlen (timestr),
+                  ".%"GF_PRI_SUSECONDS, tv.tv_usec);
+}
+
+
+static uint32_t
+gf_log_msg_hash (const char *domain, const char *file, int line,
+                 const char *body)
+{
+        uint32_t hash = 0;
+
+        hash = SuperFastHash (body, strlen (body));
+        hash ^= SuperFastHash (domain, strlen (domain)) * 31;
+        hash ^= (uint32_t) (unsigned long) file + line;
+
+        return hash;
+}
+
+
+static int
+gf_log_ring_put (struct gf_log_ring *ring, gf_loglevel_t level,
+                 const char *msg)
+{
+        struct gf_log_rec *rec = NULL;
+        uint64_t           head = 0;
+        uint64_t           tail = 0;
+        uint32_t           offset = 0;
+        uint32_t           need = 0;
+        uint32_t           wrap = 0;
+        size_t             len = 0;
+
+        /* a message gets at most a quarter of the ring, the rest of it
+           is cut off */
+        len = strlen (msg);
+        if (GF_LOG_REC_SIZE (len) > ring->size / 4)
+                len = ring->size / 4 - sizeof (*rec) - 1;
+        need = GF_LOG_REC_SIZE (len);
+
+        head = ring->head;
+        tail = ring->tail;
+        /* the logger is done with everything before tail */
+        __sync_synchronize ();
+
+        offset = head & (ring->size - 1);
+        if (ring->size - offset < need)
+                wrap = ring->size - offset;
+
+        if (ring->size - (head - tail) < wrap + need) {
+                __sync_fetch_and_add (&ring->dropped, 1);
+                return -1;
+        }
+
+        if (wrap) {
+                rec = (struct gf_log_rec *) (ring->buf + offset);
+                rec->len = 0;
+                rec->level = GF_LOG_REC_WRAP;
+                head += wrap;
+                offset = 0;
+        }
+
+        rec = (struct gf_log_rec *) (ring->buf + offset);
+        rec->len = len;
+        rec->level = level;
+        memcpy (rec->msg, msg, len);
+        rec->msg[len] = '\0';
+
+        /* the record has to be visible before the head covers it */
+        __sync_synchronize ();
+        ring->head = head + need;
+
+        return 0;
+}
+
+
+static void
+gf_log_ring_put_repeats (struct gf_log_ring *ring)
+{
+        char timestr[256] = {0,};
+        char msg[512] = {0,};
+
+        if (!ring->repeats)
+                return;
+
+        gf_log_timestr (timestr, sizeof timestr);
+        snprintf (msg, sizeof msg, "[%s] %s [%s:%d:%s] 0-logging: last message "
+                  "repeated %u times", timestr,
+                  gf_log_level_strings[ring->last_level], "logging.c",
+                  __LINE__, __FUNCTION__, ring->repeats);
+
+        gf_log_ring_put (ring, ring->last_level, msg);
+        ring->repeats = 0;
+}
+
+
+static void
+gf_log_ring_retire (void *data)
+{
+        struct gf_log_ring *ring = data;
+
+        gf_log_ring_put_repeats (ring);
+
+        /* the logger frees it once it is drained */
+        __sync_synchronize ();
+        ring->dead = 1;
+}
+
+
+static void
+gf_log_ring_init_once (void)
+{
+        if (pthread_key_create (&gf_log_ring_key, gf_log_ring_retire) == 0)
+                gf_log_ring_ready = 1;
+}
+
+
+static struct gf_log_ring *
+gf_log_ring_get (glusterfs_ctx_t *ctx)
+{
+        struct gf_log_ring *ring = NULL;
+        struct gf_log_ring *old = NULL;
+
+        pthread_once (&gf_log_ring_once, gf_log_ring_init_once);
+        if (!gf_log_ring_ready)
+                return NULL;
+
+        ring = pthread_getspecific (gf_log_ring_key);
+        if (ring && ring->ctx == ctx && ring->size == ctx->log.buf_size)
+                return ring;
+
+        /* first message of this thread, or the size was changed */
+        old = ring;
+
+        ring = CALLOC (1, sizeof (*ring));
+        if (!ring)
+                return NULL;
+
+        ring->buf = MALLOC (ctx->log.buf_size);
+        if (!ring->buf) {
+                FREE (ring);
+                return NULL;
+        }
+        ring->size = ctx->log.buf_size;
+        ring->ctx = ctx;
+
+        pthread_mutex_lock (&ctx->log.rings_lock);
+        {
+                list_add_tail (&ring->list, &ctx->log.rings);
+        }
+        pthread_mutex_unlock (&ctx->log.rings_lock);
+
+        pthread_setspecific (gf_log_ring_key, ring);
+        if (old)
+                gf_log_ring_retire (old);
+
+        return ring;
+}
+
+
+/* Queues @msg for the logger. Returns -1 when logging is synchronous and
+   the caller has to write it out itself. */
+static int
+gf_log_queue (glusterfs_ctx_t *ctx, gf_loglevel_t level, const char *msg,
+              uint32_t hash, time_t now)
+{
+        struct gf_log_ring *ring = NULL;
+
+        if (!ctx->log.buf_size)
+                return -1;
+
+        ring = gf_log_ring_get (ctx);
+        if (!ring)
+                return -1;
+
+        if (hash == ring->last_hash && level == ring->last_level &&
+            (now - ring->last_time) < GF_LOG_SUPPRESS_SECS) {
+                ring->repeats++;
+                return 0;
+        }
+
+        gf_log_ring_put_repeats (ring);
+        ring->last_hash = hash;
+        ring->last_level = level;
+        ring->last_time = now;
+
+        gf_log_ring_put (ring, level, msg);
+
+        /* a wakeup lost to the race with the logger going idle only
+           delays the message by GF_LOG_LOGGER_WAIT_MS */
+        if (ctx->log.logger_idle)
+                pthread_cond_signal (&ctx->log.logger_cond);
+
+        return 0;
+}
+
+
+static void
+__gf_log_write (glusterfs_ctx_t *ctx, FILE *fp, gf_loglevel_t level,
+                const char *msg)
+{
+        fprintf (fp, "%s\n", msg);
+
+#ifdef GF_LINUX_HOST_OS
+        /* We want only serious log in 'syslog', not our debug
+           and trace logs */
+        if (ctx->log.gf_log_syslog && level &&
+            (level <= ctx->log.sys_log_level))
+                syslog ((level-1), "%s\n", msg);
+#endif
+}
+
+
+static int
+__gf_log_ring_drain (glusterfs_ctx_t *ctx, struct gf_log_ring *ring,
+                     FILE *fp)
+{
+        struct gf_log_rec *rec = NULL;
+        uint64_t           head = 0;
+        uint64_t           tail = 0;
+        uint32_t           offset = 0;
+        int                count = 0;
+
+        head = ring->head;
+        /* records are read only after the head that covers them */
+        __sync_synchronize ();
+        tail = ring->tail;
+
+        while (tail != head) {
+                offset = tail & (ring->size - 1);
+                rec = (struct gf_log_rec *) (ring->buf + offset);
+
+                if (rec->level == GF_LOG_REC_WRAP) {
+                        tail += ring->size - offset;
+                        continue;
+                }
+
+                __gf_log_write (ctx, fp, rec->level, rec->msg);
+                tail += GF_LOG_REC_SIZE (rec->len);
+                count++;
+        }
+
+        /* done with the records before the thread can reuse the space */
+        __sync_synchronize ();
+        ring->tail = tail;
+
+        return count;
+}
+
+
+/* Writes out everything queued so far. Drains are serialized by
+   ctx->log.logfile_mutex, rings_lock is only taken to look at the list:
+   threads only ever add their rings at its tail, so the rings up to the
+   last one seen under the lock stay put while they are drained. */
+static int
+gf_log_drain (glusterfs_ctx_t *ctx)
+{
+        struct gf_log_ring *ring = NULL;
+        struct gf_log_ring *last = NULL;
+        struct gf_log_ring *next = NULL;
+        FILE               *fp = NULL;
+        uint64_t            dropped = 0;
+        char                timestr[256] = {0,};
+        char                msg[512] = {0,};
+        char                dead = 0;
+        int                 count = 0;
+
+        pthread_mutex_lock (&ctx->log.logfile_mutex);
+        {
+                pthread_mutex_lock (&ctx->log.rings_lock);
+                {
+                        if (!list_empty (&ctx->log.rings)) {
+                                ring = list_entry (ctx->log.rings.next,
+                                                   struct gf_log_ring, list);
+                                last = list_entry (ctx->log.rings.prev,
+                                                   struct gf_log_ring, list);
+                        }
+                }
+                pthread_mutex_unlock (&ctx->log.rings_lock);
+
+                fp = ctx->log.logfile ? ctx->log.logfile : stderr;
+
+                while (ring) {
+                        next = NULL;
+                        if (ring != last)
+                                next = list_entry (ring->list.next,
+                                                   struct gf_log_ring, list);
+
+                        dead = ring->dead;
+                        __sync_synchronize ();
+                        count += __gf_log_ring_drain (ctx, ring, fp);
+
+                        dropped = __sync_fetch_and_and (&ring->dropped, 0);
+                        if (dropped) {
+                                gf_log_timestr (timestr, sizeof timestr);
+                                snprintf (msg, sizeof msg, "[%s] W [%s:%d:%s] "
+                                          "0-logging: log buffer full, "
+                                          "dropped %"PRIu64" messages",
+                                          timestr, "logging.c", __LINE__,
+                                          __FUNCTION__, dropped);
+                                __gf_log_write (ctx, fp, GF_LOG_WARNING, msg);
+                                count++;
+                        }
+
+                        /* dead was read before draining, nothing can have
+                           been queued after it */
+                        if (dead) {
+                                pthread_mutex_lock (&ctx->log.rings_lock);
+                                {
+                                        list_del (&ring->list);
+                                }
+                                pthread_mutex_unlock (&ctx->log.rings_lock);
+
+                                FREE (ring->buf);
+                                FREE (ring);
+                        }
+
+                        ring = next;
+                }
+
+                if (count)
+                        fflush (fp);
+        }
+        pthread_mutex_unlock (&ctx->log.logfile_mutex);
+
+        return count;
+}
+
+
+static void *
+gf_log_logger (void *data)
+{
+        glusterfs_ctx_t *ctx = data;
+        struct timespec  wait = {0,};
+
+        for (;;) {
+                if (gf_log_drain (ctx))
+                        continue;
+
+                clock_gettime (CLOCK_MONOTONIC, &wait);
+                wait.tv_nsec += GF_LOG_LOGGER_WAIT_MS * 1000000;
+                if (wait.tv_nsec >= 1000000000) {
+                        wait.tv_sec++;
+                        wait.tv_nsec -= 1000000000;
+                }
+
+                pthread_mutex_lock (&ctx->log.rings_lock);
+                {
+                        ctx->log.logger_idle = 1;
+                        pthread_cond_timedwait (&ctx->log.logger_cond,
+                                                &ctx->log.rings_lock, &wait);
+                        ctx->log.logger_idle = 0;
+                }
+                pthread_mutex_unlock (&ctx->log.rings_lock);
+        }
+
+        return NULL;
+}
+
+
+/* Switches to asynchronous logging with rings of @size bytes per thread,
+   or back to synchronous logging for a @size of 0. */
+int
+gf_log_set_buf_size (uint32_t size)
+{
+        glusterfs_ctx_t *ctx = NULL;
+        uint32_t         ring_size = 0;
+        int              ret = 0;
+
+        ctx = THIS->ctx;
+
+        if (size) {
+                if (size > GF_LOG_BUF_MAX_SIZE)
+                        size = GF_LOG_BUF_MAX_SIZE;
+                for (ring_size = GF_LOG_BUF_MIN_SIZE; ring_size < size; )
+                        ring_size <<= 1;
+        }
+
+        pthread_mutex_lock (&ctx->log.rings_lock);
+        {
+                if (ring_size && !ctx->log.logger_running) {
+                        ret = pthread_create (&ctx->log.logger, NULL,
+                                              gf_log_logger, ctx);
+                        if (ret == 0)
+                                ctx->log.logger_running = 1;
+                        else
+                                ring_size = 0;
+                }
+
+                ctx->log.buf_size = ring_size;
+        }
+        pthread_mutex_unlock (&ctx->log.rings_lock);
+
+        if (ret) {
+                gf_log ("logging", GF_LOG_ERROR, "failed to start the logger "
+                        "thread (%s), logging synchronously", strerror (ret));
+                return -1;
+        }
+
+        return 0;
+}
+
+
+/* Writes out whatever the threads have queued, for a process about to
+   exit or to print a backtrace. */
+void
+gf_log_flush (void)
+{
+        glusterfs_ctx_t *ctx = NULL;
+
+        ctx = THIS->ctx;
+        if (!ctx || !ctx->log.logger_running)
+                return;
+
+        gf_log_drain (ctx);
+}
+
+
 int
 _gf_log_nomem (const char *domain, const char *file,
                const char *function, int line, gf_loglevel_t level,
@@ -392,6 +869,11 @@ _gf_log_callingfn (const char *domain, const char *file, const char *function,
         strcpy (msg, str1);
         strcpy (msg + len, str2);
 
+        if (!gf_log_queue (ctx, level, msg,
+                           gf_log_msg_hash (domain, file, line, str2),
+                           tv.tv_sec))
+                goto out;
+
         pthread_mutex_lock (&ctx->log.logfile_mutex);
         {
                 if (ctx->log.logfile) {
@@ -536,6 +1018,11 @@ log:
         strcpy (msg, str1);
         strcpy (msg + len, str2);
 
+        if (!gf_log_queue (ctx, level, msg,
+                           gf_log_msg_hash (domain, file, line, str2),
+                           tv.tv_sec))
+                goto err;
+
         pthread_mutex_lock (&ctx->log.logfile_mutex);
         {
 
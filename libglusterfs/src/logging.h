@@ -21,6 +21,8 @@
 #include <stdarg.h>
 #include <pthread.h>
 
+#include "list.h"
+
 #ifdef GF_DARWIN_HOST_OS
 #define GF_PRI_FSBLK       "u"
 #define GF_PRI_DEV         PRId32
@@ -73,8 +75,22 @@ typedef struct gf_log_handle_ {
         char            *cmd_log_filename;
         FILE            *cmdlogfile;
 
+        /* asynchronous logging: every thread queues its messages on a
+           ring of buf_size bytes which the logger thread writes out */
+        uint32_t         buf_size;      /* 0 when logging synchronously */
+        char             logger_running;
+        char             logger_idle;
+        pthread_t        logger;
+        pthread_mutex_t  rings_lock;
+        pthread_cond_t   logger_cond;
+        struct list_head rings;
 } gf_log_handle_t;
 
+#define GF_LOG_BUF_MIN_SIZE     4096
+#define GF_LOG_BUF_MAX_SIZE     (16 * 1024 * 1024)
+#define GF_LOG_SUPPRESS_SECS    5     /* window for repeated messages */
+#define GF_LOG_LOGGER_WAIT_MS   100
+
 void gf_log_globals_init (void *ctx);
 int gf_log_init (void *data, const char *filename);
 
@@ -82,6 +98,9 @@ void gf_log_logrotate (int signum);
 
 void gf_log_cleanup (void);
 
+int gf_log_set_buf_size (uint32_t size);
+void gf_log_flush (void);
+
 int _gf_log (const char *domain, const char *file,
              const char *function, int32_t line, gf_loglevel_t level,
              const char *fmt, ...)
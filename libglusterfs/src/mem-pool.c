@@ -28,6 +28,33 @@
 #define GF_MEM_HEADER_MAGIC  0xCAFEBABE
 #define GF_MEM_TRAILER_MAGIC 0xBAADF00D
 
+/* While a chunk is handed out its list_head is unused, so the chunk head
+   remembers there which thread cache it was handed out from. */
+#define mem_pool_chunk_owner(head)       (((struct list_head *)(head))->prev)
+
+struct mem_pool_cache {
+        struct mem_pool        *pool;
+        int                     count;
+        void                   *chunks[GF_MEM_POOL_CACHE_SIZE];
+        uint64_t                hits;
+        uint64_t                misses;
+        uint64_t                cross_frees;
+};
+
+struct mem_pool_thread_cache {
+        struct list_head        list;
+        int                     size;
+        struct mem_pool_cache **caches;  /* indexed by pool->cache_index */
+};
+
+static pthread_once_t   mem_pool_cache_once = PTHREAD_ONCE_INIT;
+static pthread_key_t    mem_pool_cache_key;
+static pthread_mutex_t  mem_pool_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct list_head mem_pool_cache_list; /* all thread caches */
+static char            *mem_pool_cache_slots;
+static int              mem_pool_cache_nslots;
+static int              mem_pool_cache_ready;
+
 #define GLUSTERFS_ENV_MEM_ACCT_STR  "GLUSTERFS_DISABLE_MEM_ACCT"
 
 void
@@ -274,6 +301,277 @@ free:
 
 
 
+/* Hands the chunks of @cache back to its pool. Called with the pool lock
+   held. */
+static void
+__mem_pool_cache_drain (struct mem_pool *pool, struct mem_pool_cache *cache,
+                        int count)
+{
+        struct list_head *list = NULL;
+
+        while (count-- > 0 && cache->count) {
+                list = cache->chunks[--cache->count];
+
+                if (list < (struct list_head *)pool->pool ||
+                    list >= (struct list_head *)pool->pool_end) {
+                        pool->curr_stdalloc--;
+                        GF_FREE (list);
+                        continue;
+                }
+
+                INIT_LIST_HEAD (list);
+                list_add (list, &pool->list);
+                pool->hot_count--;
+                pool->cold_count++;
+        }
+}
+
+
+static void
+__mem_pool_cache_retire (struct mem_pool *pool, struct mem_pool_cache *cache)
+{
+        __mem_pool_cache_drain (pool, cache, cache->count);
+
+        pool->cache_hits += cache->hits;
+        pool->cache_misses += cache->misses;
+        pool->cache_cross_frees += cache->cross_frees;
+}
+
+
+static void
+mem_pool_thread_cache_destroy (void *data)
+{
+        struct mem_pool_thread_cache *tc = data;
+        struct mem_pool_cache        *cache = NULL;
+        int                           i = 0;
+
+        pthread_mutex_lock (&mem_pool_cache_lock);
+        {
+                list_del (&tc->list);
+
+                for (i = 0; i < tc->size; i++) {
+                        cache = tc->caches[i];
+                        if (!cache)
+                                continue;
+
+                        LOCK (&cache->pool->lock);
+                        {
+                                __mem_pool_cache_retire (cache->pool, cache);
+                        }
+                        UNLOCK (&cache->pool->lock);
+
+                        FREE (cache);
+                }
+        }
+        pthread_mutex_unlock (&mem_pool_cache_lock);
+
+        FREE (tc->caches);
+        FREE (tc);
+}
+
+
+static void
+mem_pool_cache_init_once (void)
+{
+        INIT_LIST_HEAD (&mem_pool_cache_list);
+
+        if (pthread_key_create (&mem_pool_cache_key,
+                                mem_pool_thread_cache_destroy) == 0)
+                mem_pool_cache_ready = 1;
+}
+
+
+static int
+mem_pool_cache_slot_get (void)
+{
+        char *slots = NULL;
+        int   slot = -1;
+        int   i = 0;
+
+        pthread_once (&mem_pool_cache_once, mem_pool_cache_init_once);
+        if (!mem_pool_cache_ready)
+                return -1;
+
+        pthread_mutex_lock (&mem_pool_cache_lock);
+        {
+                for (i = 0; i < mem_pool_cache_nslots; i++) {
+                        if (!mem_pool_cache_slots[i])
+                                break;
+                }
+
+                if (i == mem_pool_cache_nslots) {
+                        slots = REALLOC (mem_pool_cache_slots,
+                                         mem_pool_cache_nslots + 64);
+                        if (!slots)
+                                goto unlock;
+
+                        memset (slots + mem_pool_cache_nslots, 0, 64);
+                        mem_pool_cache_slots = slots;
+                        mem_pool_cache_nslots += 64;
+                }
+
+                mem_pool_cache_slots[i] = 1;
+                slot = i;
+        }
+unlock:
+        pthread_mutex_unlock (&mem_pool_cache_lock);
+
+        return slot;
+}
+
+
+/* Drops every thread's cache of @pool, which is about to be destroyed,
+   and gives up its slot. */
+static void
+mem_pool_cache_slot_put (struct mem_pool *pool)
+{
+        struct mem_pool_thread_cache *tc = NULL;
+        struct mem_pool_cache        *cache = NULL;
+        int                           slot = pool->cache_index;
+
+        if (slot < 0)
+                return;
+
+        pthread_mutex_lock (&mem_pool_cache_lock);
+        {
+                list_for_each_entry (tc, &mem_pool_cache_list, list) {
+                        if (slot >= tc->size || !tc->caches[slot])
+                                continue;
+
+                        cache = tc->caches[slot];
+                        tc->caches[slot] = NULL;
+
+                        LOCK (&pool->lock);
+                        {
+                                __mem_pool_cache_retire (pool, cache);
+                        }
+                        UNLOCK (&pool->lock);
+
+                        FREE (cache);
+                }
+
+                mem_pool_cache_slots[slot] = 0;
+        }
+        pthread_mutex_unlock (&mem_pool_cache_lock);
+
+        pool->cache_index = -1;
+}
+
+
+/* Returns the calling thread's cache for @pool, creating it on first use.
+   Only the owning thread ever touches its caches outside
+   mem_pool_cache_lock, except for mem_pool_destroy () which requires the
+   pool to be idle anyway. */
+static struct mem_pool_cache *
+mem_pool_cache_get (struct mem_pool *pool)
+{
+        struct mem_pool_thread_cache  *tc = NULL;
+        struct mem_pool_cache        **caches = NULL;
+        struct mem_pool_cache         *cache = NULL;
+        int                            slot = pool->cache_index;
+        int                            size = 0;
+
+        if (slot < 0)
+                return NULL;
+
+        tc = pthread_getspecific (mem_pool_cache_key);
+        if (tc && slot < tc->size && tc->caches[slot])
+                return tc->caches[slot];
+
+        if (!tc) {
+                tc = CALLOC (1, sizeof (*tc));
+                if (!tc)
+                        return NULL;
+
+                INIT_LIST_HEAD (&tc->list);
+                if (pthread_setspecific (mem_pool_cache_key, tc)) {
+                        FREE (tc);
+                        return NULL;
+                }
+
+                pthread_mutex_lock (&mem_pool_cache_lock);
+                {
+                        list_add (&tc->list, &mem_pool_cache_list);
+                }
+                pthread_mutex_unlock (&mem_pool_cache_lock);
+        }
+
+        cache = CALLOC (1, sizeof (*cache));
+        if (!cache)
+                return NULL;
+
+        cache->pool = pool;
+
+        pthread_mutex_lock (&mem_pool_cache_lock);
+        {
+                if (slot >= tc->size) {
+                        size = mem_pool_cache_nslots;
+                        caches = REALLOC (tc->caches, size * sizeof (*caches));
+                        if (!caches) {
+                                FREE (cache);
+                                cache = NULL;
+                                goto unlock;
+                        }
+
+                        memset (caches + tc->size, 0,
+                                (size - tc->size) * sizeof (*caches));
+                        tc->caches = caches;
+                        tc->size = size;
+                }
+
+                tc->caches[slot] = cache;
+        }
+unlock:
+        pthread_mutex_unlock (&mem_pool_cache_lock);
+
+        return cache;
+}
+
+
+void
+mem_pool_cache_stats (struct mem_pool *pool,
+                      struct mem_pool_cache_stats *stats)
+{
+        struct mem_pool_thread_cache *tc = NULL;
+        struct mem_pool_cache        *cache = NULL;
+        int                           slot = 0;
+
+        if (!pool || !stats)
+                return;
+
+        memset (stats, 0, sizeof (*stats));
+
+        LOCK (&pool->lock);
+        {
+                stats->hits = pool->cache_hits;
+                stats->misses = pool->cache_misses;
+                stats->cross_frees = pool->cache_cross_frees;
+        }
+        UNLOCK (&pool->lock);
+
+        slot = pool->cache_index;
+        if (slot < 0)
+                return;
+
+        /* counters of live threads are read without their owner's
+           cooperation, they are only approximate */
+        pthread_mutex_lock (&mem_pool_cache_lock);
+        {
+                list_for_each_entry (tc, &mem_pool_cache_list, list) {
+                        if (slot >= tc->size || !tc->caches[slot])
+                                continue;
+
+                        cache = tc->caches[slot];
+                        stats->hits += cache->hits;
+                        stats->misses += cache->misses;
+                        stats->cross_frees += cache->cross_frees;
+                        stats->cached += cache->count;
+                }
+        }
+        pthread_mutex_unlock (&mem_pool_cache_lock);
+}
+
+
 struct mem_pool *
 mem_pool_new_fn (unsigned long sizeof_type,
                  unsigned long count, char *name)
@@ -329,6 +627,8 @@ mem_pool_new_fn (unsigned long sizeof_type,
         mem_pool->pool = pool;
         mem_pool->pool_end = pool + (count * (padded_sizeof_type));
 
+        mem_pool->cache_index = mem_pool_cache_slot_get ();
+
         /* add this pool to the global list */
         ctx = THIS->ctx;
         if (!ctx)
@@ -358,6 +658,32 @@ mem_get0 (struct mem_pool *mem_pool)
         return ptr;
 }
 
+/* Moves up to a batch of free chunks from the pool into @cache. Called
+   with the pool lock held. */
+static void
+__mem_pool_cache_fill (struct mem_pool *mem_pool, struct mem_pool_cache *cache)
+{
+        struct list_head *list = NULL;
+        int               i = 0;
+
+        for (i = 0; i < GF_MEM_POOL_CACHE_BATCH; i++) {
+                if (!mem_pool->cold_count)
+                        break;
+
+                list = mem_pool->list.next;
+                list_del (list);
+
+                mem_pool->hot_count++;
+                mem_pool->cold_count--;
+
+                cache->chunks[cache->count++] = list;
+        }
+
+        if (mem_pool->max_alloc < mem_pool->hot_count)
+                mem_pool->max_alloc = mem_pool->hot_count;
+}
+
+
 void *
 mem_get (struct mem_pool *mem_pool)
 {
@@ -365,12 +691,36 @@ mem_get (struct mem_pool *mem_pool)
         void             *ptr = NULL;
         int             *in_use = NULL;
         struct mem_pool **pool_ptr = NULL;
+        struct mem_pool_cache *cache = NULL;
 
         if (!mem_pool) {
                 gf_log_callingfn ("mem-pool", GF_LOG_ERROR, "invalid argument");
                 return NULL;
         }
 
+        cache = mem_pool_cache_get (mem_pool);
+        if (cache) {
+                if (cache->count) {
+                        cache->hits++;
+                        goto cached;
+                }
+
+                cache->misses++;
+
+                LOCK (&mem_pool->lock);
+                {
+                        __mem_pool_cache_fill (mem_pool, cache);
+                        if (cache->count)
+                                mem_pool->alloc_count++;
+                }
+                UNLOCK (&mem_pool->lock);
+
+                if (cache->count)
+                        goto cached;
+
+                /* pool exhausted, fall back to the heap below */
+        }
+
         LOCK (&mem_pool->lock);
         {
                 mem_pool->alloc_count++;
@@ -429,10 +779,23 @@ mem_get (struct mem_pool *mem_pool)
 fwd_addr_out:
         pool_ptr = mem_pool_from_ptr (ptr);
         *pool_ptr = (struct mem_pool *)mem_pool;
+        mem_pool_chunk_owner (ptr) = (void *)cache;
         ptr = mem_pool_chunkhead2ptr (ptr);
         UNLOCK (&mem_pool->lock);
 
         return ptr;
+
+cached:
+        ptr = cache->chunks[--cache->count];
+
+        in_use = (ptr + GF_MEM_POOL_LIST_BOUNDARY + GF_MEM_POOL_PTR);
+        *in_use = 1;
+
+        pool_ptr = mem_pool_from_ptr (ptr);
+        *pool_ptr = (struct mem_pool *)mem_pool;
+        mem_pool_chunk_owner (ptr) = (void *)cache;
+
+        return mem_pool_chunkhead2ptr (ptr);
 }
 
 
@@ -463,6 +826,7 @@ mem_put (void *ptr)
         void   *head = NULL;
         struct mem_pool **tmp = NULL;
         struct mem_pool *pool = NULL;
+        struct mem_pool_cache *cache = NULL;
 
         if (!ptr) {
                 gf_log_callingfn ("mem-pool", GF_LOG_ERROR, "invalid argument");
@@ -483,6 +847,35 @@ mem_put (void *ptr)
                                   "mem-pool ptr is NULL");
                 return;
         }
+
+        cache = mem_pool_cache_get (pool);
+        if (cache) {
+                in_use = (head + GF_MEM_POOL_LIST_BOUNDARY + GF_MEM_POOL_PTR);
+                if (__is_member (pool, ptr) == 1 &&
+                    !is_mem_chunk_in_use (in_use)) {
+                        gf_log_callingfn ("mem-pool", GF_LOG_CRITICAL,
+                                          "mem_put called on freed ptr %p of "
+                                          "mem pool %p", ptr, pool);
+                        return;
+                }
+
+                if (mem_pool_chunk_owner (head) != (void *)cache)
+                        cache->cross_frees++;
+
+                if (cache->count == GF_MEM_POOL_CACHE_SIZE) {
+                        LOCK (&pool->lock);
+                        {
+                                __mem_pool_cache_drain (pool, cache,
+                                                        GF_MEM_POOL_CACHE_BATCH);
+                        }
+                        UNLOCK (&pool->lock);
+                }
+
+                *in_use = 0;
+                cache->chunks[cache->count++] = head;
+                return;
+        }
+
         LOCK (&pool->lock);
         {
 
@@ -542,6 +935,8 @@ mem_pool_destroy (struct mem_pool *pool)
 
         list_del (&pool->global_list);
 
+        mem_pool_cache_slot_put (pool);
+
         LOCK_DESTROY (&pool->lock);
         GF_FREE (pool->name);
         GF_FREE (pool->pool);
@@ -166,6 +166,12 @@ out:
         return dup_mem;
 }
 
+/* Chunks a thread keeps for itself per pool. mem_get/mem_put hit this
+   magazine first and only take mem_pool->lock to refill or drain half
+   of it at once. */
+#define GF_MEM_POOL_CACHE_SIZE  32
+#define GF_MEM_POOL_CACHE_BATCH (GF_MEM_POOL_CACHE_SIZE / 2)
+
 struct mem_pool {
         struct list_head  list;
         int               hot_count;
@@ -182,6 +188,20 @@ struct mem_pool {
         int               max_stdalloc;
         char             *name;
         struct list_head  global_list;
+        int               cache_index;  /* slot in each thread's cache
+                                           array, -1 if not cached */
+        /* counters of exited threads' caches, under lock */
+        uint64_t          cache_hits;
+        uint64_t          cache_misses;
+        uint64_t          cache_cross_frees;
+};
+
+struct mem_pool_cache_stats {
+        uint64_t          hits;          /* served from a thread cache */
+        uint64_t          misses;        /* thread cache had to refill */
+        uint64_t          cross_frees;   /* put by another thread than
+                                            the one which got it */
+        int               cached;        /* chunks sitting in caches */
 };
 
 struct mem_pool *
@@ -195,6 +215,9 @@ void *mem_get0 (struct mem_pool *pool);
 
 void mem_pool_destroy (struct mem_pool *pool);
 
+void mem_pool_cache_stats (struct mem_pool *pool,
+                           struct mem_pool_cache_stats *stats);
+
 void gf_mem_acct_enable_set (void *ctx);
 
 #endif /* _MEM_POOL_H */
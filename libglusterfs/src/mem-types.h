@@ -102,6 +102,9 @@ enum gf_common_mem_types_ {
         gf_common_mt_buffer_t             = 86,
         gf_common_mt_circular_buffer_t    = 87,
         gf_common_mt_eh_t                 = 88,
-        gf_common_mt_end                  = 89
+        gf_common_mt_dict_members         = 89,
+        gf_common_mt_groups_t             = 90,
+        gf_common_mt_compound_args_t      = 91,
+        gf_common_mt_end                  = 92
 };
 #endif
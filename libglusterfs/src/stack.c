@@ -43,6 +43,7 @@ create_frame (xlator_t *xl, call_pool_t *pool)
         stack->frames.root = stack;
         stack->frames.this = xl;
         stack->ctx = xl->ctx;
+        stack->groups = stack->groups_small;
 
         if (stack->ctx->measure_latency) {
                 if (gettimeofday (&stack->tv, NULL) == -1)
@@ -64,6 +65,66 @@ create_frame (xlator_t *xl, call_pool_t *pool)
         return &stack->frames;
 }
 
+/* Makes room for @ngrps groups in stack->groups, which the caller then
+   fills, and sets stack->ngrps. */
+int
+call_stack_alloc_groups (call_stack_t *stack, int ngrps)
+{
+        gf_groups_t *groups = NULL;
+        int          ret = 0;
+
+        if (ngrps > GF_SMALL_GROUP_COUNT) {
+                groups = gf_groups_new (ngrps);
+                if (!groups) {
+                        ngrps = 0;
+                        ret = -1;
+                }
+        }
+
+        if (stack->groups_large)
+                gf_groups_unref (stack->groups_large);
+
+        stack->groups_large = groups;
+        stack->groups = groups ? groups->gs_gids : stack->groups_small;
+        stack->ngrps = ngrps;
+
+        return ret;
+}
+
+
+int
+call_stack_set_groups (call_stack_t *stack, int ngrps, gid_t *groups)
+{
+        if (call_stack_alloc_groups (stack, ngrps))
+                return -1;
+
+        memcpy (stack->groups, groups, ngrps * sizeof (gid_t));
+
+        return 0;
+}
+
+
+/* Gives @stack the groups of @groups, by reference when they do not fit
+   inline. */
+void
+call_stack_share_groups (call_stack_t *stack, gf_groups_t *groups)
+{
+        if (groups->gs_count <= GF_SMALL_GROUP_COUNT) {
+                call_stack_set_groups (stack, groups->gs_count,
+                                       groups->gs_gids);
+                return;
+        }
+
+        gf_groups_ref (groups);
+        if (stack->groups_large)
+                gf_groups_unref (stack->groups_large);
+
+        stack->groups_large = groups;
+        stack->groups = groups->gs_gids;
+        stack->ngrps = groups->gs_count;
+}
+
+
 void
 gf_proc_dump_call_frame (call_frame_t *call_frame, const char *key_buf,...)
 {
@@ -36,6 +36,10 @@ typedef struct _call_pool_t call_pool_t;
 #include "common-utils.h"
 #include "globals.h"
 #include "lkowner.h"
+#include "gidcache.h"
+
+/* groups a call_stack_t holds inline, more go to a shared gf_groups_t */
+#define GF_SMALL_GROUP_COUNT 16
 
 #define NFS_PID 1
 #define LOW_PRIO_PROC_PID -1
@@ -99,7 +103,10 @@ struct _call_stack_t {
         gid_t                         gid;
         pid_t                         pid;
         uint16_t                      ngrps;
-        uint32_t                      groups[GF_MAX_AUX_GROUPS];
+        uint32_t                     *groups; /* groups_small or
+                                                 groups_large->gs_gids */
+        uint32_t                      groups_small[GF_SMALL_GROUP_COUNT];
+        gf_groups_t                  *groups_large;
         gf_lkowner_t                  lk_owner;
         glusterfs_ctx_t              *ctx;
 
@@ -171,6 +178,9 @@ STACK_DESTROY (call_stack_t *stack)
         LOCK_DESTROY (&stack->frames.lock);
         LOCK_DESTROY (&stack->stack_lock);
 
+        if (stack->groups_large)
+                gf_groups_unref (stack->groups_large);
+
         while (stack->frames.next) {
                 FRAME_DESTROY (stack->frames.next);
         }
@@ -393,8 +403,14 @@ copy_frame (call_frame_t *frame)
         newstack->ngrps = oldstack->ngrps;
         newstack->op  = oldstack->op;
         newstack->type = oldstack->type;
-        memcpy (newstack->groups, oldstack->groups,
-                sizeof (gid_t) * GF_MAX_AUX_GROUPS);
+        if (oldstack->groups_large) {
+                newstack->groups_large = gf_groups_ref (oldstack->groups_large);
+                newstack->groups = newstack->groups_large->gs_gids;
+        } else {
+                memcpy (newstack->groups_small, oldstack->groups_small,
+                        sizeof (gid_t) * oldstack->ngrps);
+                newstack->groups = newstack->groups_small;
+        }
         newstack->unique = oldstack->unique;
 
         newstack->frames.this = frame->this;
@@ -428,5 +444,8 @@ void gf_proc_dump_pending_frames(call_pool_t *call_pool);
 void gf_proc_dump_pending_frames_to_dict (call_pool_t *call_pool,
                                           dict_t *dict);
 call_frame_t *create_frame (xlator_t *xl, call_pool_t *pool);
+int call_stack_alloc_groups (call_stack_t *stack, int ngrps);
+int call_stack_set_groups (call_stack_t *stack, int ngrps, gid_t *groups);
+void call_stack_share_groups (call_stack_t *stack, gf_groups_t *groups);
 gf_boolean_t __is_fuse_call (call_frame_t *frame);
 #endif /* _STACK_H */
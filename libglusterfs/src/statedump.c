@@ -317,22 +317,35 @@ gf_proc_dump_mem_info_to_dict (dict_t *dict)
 void
 gf_proc_dump_mempool_info (glusterfs_ctx_t *ctx)
 {
-        struct mem_pool *pool = NULL;
+        struct mem_pool             *pool = NULL;
+        struct mem_pool_cache_stats  stats = {0, };
 
         gf_proc_dump_add_section ("mempool");
 
         list_for_each_entry (pool, &ctx->mempool_list, global_list) {
+                mem_pool_cache_stats (pool, &stats);
+
                 gf_proc_dump_write ("-----", "-----");
                 gf_proc_dump_write ("pool-name", "%s", pool->name);
-                gf_proc_dump_write ("hot-count", "%d", pool->hot_count);
+                gf_proc_dump_write ("hot-count", "%d",
+                                    pool->hot_count - stats.cached);
                 gf_proc_dump_write ("cold-count", "%d", pool->cold_count);
                 gf_proc_dump_write ("padded_sizeof", "%lu",
                                     pool->padded_sizeof_type);
-                gf_proc_dump_write ("alloc-count", "%"PRIu64, pool->alloc_count);
+                gf_proc_dump_write ("alloc-count", "%"PRIu64,
+                                    pool->alloc_count + stats.hits);
                 gf_proc_dump_write ("max-alloc", "%d", pool->max_alloc);
 
                 gf_proc_dump_write ("pool-misses", "%"PRIu64, pool->pool_misses);
                 gf_proc_dump_write ("max-stdalloc", "%d", pool->max_stdalloc);
+
+                gf_proc_dump_write ("thread-cached", "%d", stats.cached);
+                gf_proc_dump_write ("thread-cache-hits", "%"PRIu64,
+                                    stats.hits);
+                gf_proc_dump_write ("thread-cache-misses", "%"PRIu64,
+                                    stats.misses);
+                gf_proc_dump_write ("cross-thread-frees", "%"PRIu64,
+                                    stats.cross_frees);
         }
 }
 
@@ -343,11 +356,14 @@ gf_proc_dump_mempool_info_to_dict (glusterfs_ctx_t *ctx, dict_t *dict)
         char            key[GF_DUMP_MAX_BUF_LEN] = {0,};
         int             count = 0;
         int             ret = -1;
+        struct mem_pool_cache_stats stats = {0, };
 
         if (!ctx || !dict)
                 return;
 
         list_for_each_entry (pool, &ctx->mempool_list, global_list) {
+                mem_pool_cache_stats (pool, &stats);
+
                 memset (key, 0, sizeof (key));
                 snprintf (key, sizeof (key), "pool%d.name", count);
                 ret = dict_set_str (dict, key, pool->name);
@@ -356,7 +372,8 @@ gf_proc_dump_mempool_info_to_dict (glusterfs_ctx_t *ctx, dict_t *dict)
 
                 memset (key, 0, sizeof (key));
                 snprintf (key, sizeof (key), "pool%d.hotcount", count);
-                ret = dict_set_int32 (dict, key, pool->hot_count);
+                ret = dict_set_int32 (dict, key,
+                                      pool->hot_count - stats.cached);
                 if (ret)
                         return;
 
@@ -374,7 +391,8 @@ gf_proc_dump_mempool_info_to_dict (glusterfs_ctx_t *ctx, dict_t *dict)
 
                 memset (key, 0, sizeof (key));
                 snprintf (key, sizeof (key), "pool%d.alloccount", count);
-                ret = dict_set_uint64 (dict, key, pool->alloc_count);
+                ret = dict_set_uint64 (dict, key,
+                                       pool->alloc_count + stats.hits);
                 if (ret)
                         return;
 
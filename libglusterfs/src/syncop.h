@@ -136,6 +136,7 @@ struct syncargs {
         char               *errstr;
         dict_t             *dict;
         pthread_mutex_t     lock_dict;
+        off_t               offset;
 
 	syncbarrier_t       barrier;
 
@@ -245,6 +246,8 @@ static inline call_frame_t *
 syncop_create_frame (xlator_t *this)
 {
 	call_frame_t  *frame = NULL;
+        gid_t          groups[GF_MAX_AUX_GROUPS];
+        int            ngrps = 0;
 
 	frame = create_frame (this, this->ctx->pool);
 	if (!frame)
@@ -253,7 +256,9 @@ syncop_create_frame (xlator_t *this)
 	frame->root->pid = getpid();
 	frame->root->uid = geteuid ();
 	frame->root->gid = getegid ();
-        frame->root->ngrps = getgroups (GF_MAX_AUX_GROUPS, frame->root->groups);
+        ngrps = getgroups (GF_MAX_AUX_GROUPS, groups);
+        if (ngrps > 0)
+                call_stack_set_groups (frame->root, ngrps, groups);
 
 	return frame;
 }
@@ -320,6 +325,13 @@ int syncop_readv (xlator_t *subvol, fd_t *fd, size_t size, off_t off,
 int syncop_ftruncate (xlator_t *subvol, fd_t *fd, off_t offset);
 int syncop_truncate (xlator_t *subvol, loc_t *loc, off_t offset);
 
+int syncop_fallocate (xlator_t *subvol, fd_t *fd, int32_t keep_size,
+                      off_t offset, size_t len);
+int syncop_discard (xlator_t *subvol, fd_t *fd, off_t offset, size_t len);
+int syncop_zerofill (xlator_t *subvol, fd_t *fd, off_t offset, off_t len);
+int syncop_seek (xlator_t *subvol, fd_t *fd, off_t offset, gf_seek_what_t what,
+                 off_t *off);
+
 int syncop_unlink (xlator_t *subvol, loc_t *loc);
 int syncop_rmdir (xlator_t *subvol, loc_t *loc);
 
@@ -18,7 +18,117 @@
 #include "common-utils.h"
 #include "globals.h"
 
-#define TS(tv) ((((unsigned long long) tv.tv_sec) * 1000000) + (tv.tv_usec))
+#define GF_TIMER_MAX_TICKS  ((1ULL << (GF_TIMER_ROOT_BITS +               \
+                                       GF_TIMER_LEVELS *                  \
+                                       GF_TIMER_LEVEL_BITS)) - 1)
+
+#define LEVEL_SHIFT(l)      (GF_TIMER_ROOT_BITS + (l) * GF_TIMER_LEVEL_BITS)
+#define LEVEL_INDEX(t,l)    (((t) >> LEVEL_SHIFT (l)) & (GF_TIMER_LEVEL_SIZE - 1))
+
+#define GF_TIMER_TICK_US    (GF_TIMER_TICK_MS * 1000)
+
+static uint64_t
+gf_timer_now_us (void)
+{
+        struct timespec ts = {0, };
+
+        clock_gettime (CLOCK_MONOTONIC, &ts);
+
+        return (((uint64_t) ts.tv_sec) * 1000000) + (ts.tv_nsec / 1000);
+}
+
+static uint64_t
+gf_timer_now (void)
+{
+        return gf_timer_now_us () / GF_TIMER_TICK_US;
+}
+
+
+/* Called with reg->lock held. */
+static void
+__gf_timer_add (gf_timer_registry_t *reg, gf_timer_t *event)
+{
+        uint64_t          expires = 0;
+        uint64_t          idx = 0;
+        struct list_head *slot = NULL;
+        int               level = 0;
+
+        expires = event->expires;
+
+        if (expires < reg->base) {
+                /* already due, run it on the next tick */
+                slot = &reg->root[reg->base & (GF_TIMER_ROOT_SIZE - 1)];
+                goto add;
+        }
+
+        idx = expires - reg->base;
+        if (idx < GF_TIMER_ROOT_SIZE) {
+                slot = &reg->root[expires & (GF_TIMER_ROOT_SIZE - 1)];
+                goto add;
+        }
+
+        if (idx > GF_TIMER_MAX_TICKS) {
+                expires = reg->base + GF_TIMER_MAX_TICKS;
+                event->expires = expires;
+                idx = GF_TIMER_MAX_TICKS;
+        }
+
+        for (level = 0; level < GF_TIMER_LEVELS - 1; level++) {
+                if (idx < (1ULL << LEVEL_SHIFT (level + 1)))
+                        break;
+        }
+        slot = &reg->levels[level][LEVEL_INDEX (expires, level)];
+add:
+        list_add_tail (&event->list, slot);
+}
+
+
+/* Moves the timers of one slot of @level down the wheel. Returns the slot
+   index, a 0 means the next level has to cascade as well. Called with
+   reg->lock held. */
+static int
+__gf_timer_cascade (gf_timer_registry_t *reg, int level)
+{
+        gf_timer_t       *event = NULL;
+        gf_timer_t       *tmp = NULL;
+        struct list_head  head;
+        int               index = 0;
+
+        index = LEVEL_INDEX (reg->base, level);
+
+        INIT_LIST_HEAD (&head);
+        list_splice_init (&reg->levels[level][index], &head);
+
+        list_for_each_entry_safe (event, tmp, &head, list) {
+                list_del_init (&event->list);
+                __gf_timer_add (reg, event);
+        }
+
+        return index;
+}
+
+
+/* The tick gf_timer_proc has to be awake at: the first occupied root slot,
+   or the next cascade when only the upper levels hold timers. Called with
+   reg->lock held. */
+static uint64_t
+__gf_timer_next_tick (gf_timer_registry_t *reg)
+{
+        uint64_t tick = 0;
+        uint64_t cascade = 0;
+
+        /* a base sitting on the boundary still has its cascade to do */
+        cascade = (reg->base + GF_TIMER_ROOT_SIZE - 1) &
+                  ~((uint64_t) GF_TIMER_ROOT_SIZE - 1);
+
+        for (tick = reg->base; tick < cascade; tick++) {
+                if (!list_empty (&reg->root[tick & (GF_TIMER_ROOT_SIZE - 1)]))
+                        return tick;
+        }
+
+        return cascade;
+}
+
 
 gf_timer_t *
 gf_timer_call_after (glusterfs_ctx_t *ctx,
@@ -28,8 +138,7 @@ gf_timer_call_after (glusterfs_ctx_t *ctx,
 {
         gf_timer_registry_t *reg = NULL;
         gf_timer_t *event = NULL;
-        gf_timer_t *trav = NULL;
-        unsigned long long at = 0L;
+        uint64_t    expires = 0;
 
         if (ctx == NULL)
         {
@@ -48,26 +157,23 @@ gf_timer_call_after (glusterfs_ctx_t *ctx,
         if (!event) {
                 return NULL;
         }
-        gettimeofday (&event->at, NULL);
-        event->at.tv_usec = ((event->at.tv_usec + delta.tv_usec) % 1000000);
-        event->at.tv_sec += ((event->at.tv_usec + delta.tv_usec) / 1000000);
-        event->at.tv_sec += delta.tv_sec;
-        at = TS (event->at);
+
+        /* round up, a timer never fires early */
+        expires = gf_timer_now_us () + (((uint64_t) delta.tv_sec) * 1000000) +
+                  delta.tv_usec;
+
+        INIT_LIST_HEAD (&event->list);
+        event->expires = (expires + GF_TIMER_TICK_US - 1) / GF_TIMER_TICK_US;
         event->callbk = callbk;
         event->data = data;
         event->xl = THIS;
         pthread_mutex_lock (&reg->lock);
         {
-                trav = reg->active.prev;
-                while (trav != &reg->active) {
-                        if (TS (trav->at) < at)
-                                break;
-                        trav = trav->prev;
-                }
-                event->prev = trav;
-                event->next = event->prev->next;
-                event->prev->next = event;
-                event->next->prev = event;
+                __gf_timer_add (reg, event);
+                reg->pending++;
+
+                if (event->expires < reg->wakeup)
+                        pthread_cond_signal (&reg->cond);
         }
         pthread_mutex_unlock (&reg->lock);
         return event;
@@ -83,12 +189,8 @@ gf_timer_call_stale (gf_timer_registry_t *reg,
                 return 0;
         }
 
-        event->next->prev = event->prev;
-        event->prev->next = event->next;
-        event->next = &reg->stale;
-        event->prev = event->next->prev;
-        event->next->prev = event;
-        event->prev->next = event;
+        list_move_tail (&event->list, &reg->stale);
+        reg->pending--;
 
         return 0;
 }
@@ -114,8 +216,10 @@ gf_timer_call_cancel (glusterfs_ctx_t *ctx,
 
         pthread_mutex_lock (&reg->lock);
         {
-                event->next->prev = event->prev;
-                event->prev->next = event->next;
+                /* fired timers stay on stale until cancelled */
+                if (event->expires != (uint64_t) -1)
+                        reg->pending--;
+                list_del_init (&event->list);
         }
         pthread_mutex_unlock (&reg->lock);
 
@@ -123,11 +227,73 @@ gf_timer_call_cancel (glusterfs_ctx_t *ctx,
         return 0;
 }
 
+
+/* Runs every tick up to @now. Called with reg->lock held, which is
+   dropped around each callback. */
+static void
+__gf_timer_run (gf_timer_registry_t *reg, uint64_t now)
+{
+        struct list_head  work;
+        gf_timer_t       *event = NULL;
+        gf_timer_cbk_t    callbk = NULL;
+        void             *data = NULL;
+        xlator_t         *xl = NULL;
+        int               index = 0;
+        int               level = 0;
+
+        while (reg->base <= now) {
+                if (!reg->pending) {
+                        /* nothing to turn the wheel for */
+                        reg->base = now + 1;
+                        break;
+                }
+
+                index = reg->base & (GF_TIMER_ROOT_SIZE - 1);
+                if (!index) {
+                        for (level = 0; level < GF_TIMER_LEVELS; level++) {
+                                if (__gf_timer_cascade (reg, level))
+                                        break;
+                        }
+                }
+
+                /* a timer armed from a callback may hash to this very
+                   slot, one turn of the wheel later */
+                INIT_LIST_HEAD (&work);
+                list_splice_init (&reg->root[index], &work);
+                reg->base++;
+
+                while (!list_empty (&work)) {
+                        event = list_entry (work.next, gf_timer_t, list);
+                        gf_timer_call_stale (reg, event);
+                        event->expires = (uint64_t) -1;
+
+                        /* the event may be cancelled once the lock drops */
+                        callbk = event->callbk;
+                        data = event->data;
+                        xl = event->xl;
+
+                        pthread_mutex_unlock (&reg->lock);
+                        {
+                                if (xl)
+                                        THIS = xl;
+                                callbk (data);
+                        }
+                        pthread_mutex_lock (&reg->lock);
+                }
+        }
+}
+
 void *
 gf_timer_proc (void *ctx)
 {
         gf_timer_registry_t *reg = NULL;
-	const struct timespec sleepts = {.tv_sec = 1, .tv_nsec = 0, };
+        gf_timer_t          *event = NULL;
+        gf_timer_t          *tmp = NULL;
+        struct timespec      sleep_till = {0, };
+        uint64_t             now = 0;
+        uint64_t             ms = 0;
+        int                  i = 0;
+        int                  j = 0;
 
         if (ctx == NULL)
         {
@@ -141,50 +307,49 @@ gf_timer_proc (void *ctx)
                 return NULL;
         }
 
+        pthread_mutex_lock (&reg->lock);
         while (!reg->fin) {
-                unsigned long long now;
-                struct timeval now_tv;
-                gf_timer_t *event = NULL;
+                now = gf_timer_now ();
+                __gf_timer_run (reg, now);
 
-                gettimeofday (&now_tv, NULL);
-                now = TS (now_tv);
-                while (1) {
-                        unsigned long long at;
-                        char need_cbk = 0;
+                if (!reg->pending) {
+                        reg->wakeup = (uint64_t) -1;
+                        pthread_cond_wait (&reg->cond, &reg->lock);
+                        continue;
+                }
 
-                        pthread_mutex_lock (&reg->lock);
-                        {
-                                event = reg->active.next;
-                                at = TS (event->at);
-                                if (event != &reg->active && now >= at) {
-                                        need_cbk = 1;
-                                        gf_timer_call_stale (reg, event);
-                                }
-                        }
-                        pthread_mutex_unlock (&reg->lock);
-                        if (event->xl)
-                                THIS = event->xl;
-                        if (need_cbk)
-                                event->callbk  (event->data);
+                reg->wakeup = __gf_timer_next_tick (reg);
+                if (reg->wakeup <= gf_timer_now ())
+                        continue;
 
-                        else
-                                break;
-                }
-                nanosleep (&sleepts, NULL);
+                ms = reg->wakeup * GF_TIMER_TICK_MS;
+                sleep_till.tv_sec = ms / 1000;
+                sleep_till.tv_nsec = (ms % 1000) * 1000000;
+                pthread_cond_timedwait (&reg->cond, &reg->lock, &sleep_till);
         }
 
-        pthread_mutex_lock (&reg->lock);
-        {
-                while (reg->active.next != &reg->active) {
-                        gf_timer_call_cancel (ctx, reg->active.next);
+        list_for_each_entry_safe (event, tmp, &reg->stale, list) {
+                list_del (&event->list);
+                GF_FREE (event);
+        }
+        for (i = 0; i < GF_TIMER_ROOT_SIZE; i++) {
+                list_for_each_entry_safe (event, tmp, &reg->root[i], list) {
+                        list_del (&event->list);
+                        GF_FREE (event);
                 }
-
-                while (reg->stale.next != &reg->stale) {
-                        gf_timer_call_cancel (ctx, reg->stale.next);
+        }
+        for (i = 0; i < GF_TIMER_LEVELS; i++) {
+                for (j = 0; j < GF_TIMER_LEVEL_SIZE; j++) {
+                        list_for_each_entry_safe (event, tmp,
+                                                  &reg->levels[i][j], list) {
+                                list_del (&event->list);
+                                GF_FREE (event);
+                        }
                 }
         }
         pthread_mutex_unlock (&reg->lock);
         pthread_mutex_destroy (&reg->lock);
+        pthread_cond_destroy (&reg->cond);
         GF_FREE (((glusterfs_ctx_t *)ctx)->timer);
 
         return NULL;
@@ -193,6 +358,10 @@ gf_timer_proc (void *ctx)
 gf_timer_registry_t *
 gf_timer_registry_init (glusterfs_ctx_t *ctx)
 {
+        pthread_condattr_t attr;
+        int                i = 0;
+        int                j = 0;
+
         if (ctx == NULL) {
                 gf_log_callingfn ("timer", GF_LOG_ERROR, "invalid argument");
                 return NULL;
@@ -207,10 +376,23 @@ gf_timer_registry_init (glusterfs_ctx_t *ctx)
                         goto out;
 
                 pthread_mutex_init (&reg->lock, NULL);
-                reg->active.next = &reg->active;
-                reg->active.prev = &reg->active;
-                reg->stale.next = &reg->stale;
-                reg->stale.prev = &reg->stale;
+
+                /* timedwait deadlines are on the clock the wheel runs on */
+                pthread_condattr_init (&attr);
+                pthread_condattr_setclock (&attr, CLOCK_MONOTONIC);
+                pthread_cond_init (&reg->cond, &attr);
+                pthread_condattr_destroy (&attr);
+
+                INIT_LIST_HEAD (&reg->stale);
+                for (i = 0; i < GF_TIMER_ROOT_SIZE; i++)
+                        INIT_LIST_HEAD (&reg->root[i]);
+                for (i = 0; i < GF_TIMER_LEVELS; i++) {
+                        for (j = 0; j < GF_TIMER_LEVEL_SIZE; j++)
+                                INIT_LIST_HEAD (&reg->levels[i][j]);
+                }
+
+                reg->base = gf_timer_now ();
+                reg->wakeup = (uint64_t) -1;
 
                 ctx->timer = reg;
                 pthread_create (&reg->th, NULL, gf_timer_proc, ctx);
@@ -18,14 +18,27 @@
 
 #include "glusterfs.h"
 #include "xlator.h"
+#include "list.h"
 #include <sys/time.h>
 #include <pthread.h>
 
 typedef void (*gf_timer_cbk_t) (void *);
 
+/* Pending timers sit on a hierarchical timing wheel of 1ms ticks: the
+   first level has a slot per tick for the next 256ms, every further level
+   covers 64 times the span of the one below, and its slots are cascaded
+   down as the wheel turns. Insert and cancel are O(1). Timers further out
+   than the last level (~49 days) are clamped to it. */
+#define GF_TIMER_TICK_MS        1
+#define GF_TIMER_ROOT_BITS      8
+#define GF_TIMER_ROOT_SIZE      (1 << GF_TIMER_ROOT_BITS)
+#define GF_TIMER_LEVEL_BITS     6
+#define GF_TIMER_LEVEL_SIZE     (1 << GF_TIMER_LEVEL_BITS)
+#define GF_TIMER_LEVELS         4
+
 struct _gf_timer {
-        struct _gf_timer *next, *prev;
-        struct timeval    at;
+        struct list_head  list;      /* wheel slot, or reg->stale once fired */
+        uint64_t          expires;   /* in ticks */
         gf_timer_cbk_t    callbk;
         void             *data;
         xlator_t         *xl;
@@ -34,9 +47,14 @@ struct _gf_timer {
 struct _gf_timer_registry {
         pthread_t        th;
         char             fin;
-        struct _gf_timer stale;
-        struct _gf_timer active;
+        struct list_head stale;
+        struct list_head root[GF_TIMER_ROOT_SIZE];
+        struct list_head levels[GF_TIMER_LEVELS][GF_TIMER_LEVEL_SIZE];
+        uint64_t         base;       /* next tick to run */
+        uint64_t         wakeup;     /* tick gf_timer_proc sleeps until */
+        uint32_t         pending;    /* timers on the wheel */
         pthread_mutex_t  lock;
+        pthread_cond_t   cond;
 };
 
 typedef struct _gf_timer gf_timer_t;
@@ -52,6 +52,8 @@ struct _gf_dirent_t;
 typedef struct _gf_dirent_t gf_dirent_t;
 struct _loc;
 typedef struct _loc loc_t;
+struct _compound_args;
+typedef struct _compound_args compound_args_t;
 
 
 typedef int32_t (*event_notify_fn_t) (xlator_t *this, int32_t event, void *data,
@@ -417,6 +419,44 @@ typedef int32_t (*fop_fsetattr_cbk_t) (call_frame_t *frame,
                                        struct iatt *preop_stbuf,
                                        struct iatt *postop_stbuf, dict_t *xdata);
 
+typedef int32_t (*fop_compound_cbk_t) (call_frame_t *frame,
+                                       void *cookie,
+                                       xlator_t *this,
+                                       int32_t op_ret,
+                                       int32_t op_errno,
+                                       compound_args_t *args, dict_t *xdata);
+
+typedef int32_t (*fop_fallocate_cbk_t) (call_frame_t *frame,
+                                        void *cookie,
+                                        xlator_t *this,
+                                        int32_t op_ret,
+                                        int32_t op_errno,
+                                        struct iatt *preop_stbuf,
+                                        struct iatt *postop_stbuf, dict_t *xdata);
+
+typedef int32_t (*fop_discard_cbk_t) (call_frame_t *frame,
+                                      void *cookie,
+                                      xlator_t *this,
+                                      int32_t op_ret,
+                                      int32_t op_errno,
+                                      struct iatt *preop_stbuf,
+                                      struct iatt *postop_stbuf, dict_t *xdata);
+
+typedef int32_t (*fop_zerofill_cbk_t) (call_frame_t *frame,
+                                       void *cookie,
+                                       xlator_t *this,
+                                       int32_t op_ret,
+                                       int32_t op_errno,
+                                       struct iatt *preop_stbuf,
+                                       struct iatt *postop_stbuf, dict_t *xdata);
+
+typedef int32_t (*fop_seek_cbk_t) (call_frame_t *frame,
+                                   void *cookie,
+                                   xlator_t *this,
+                                   int32_t op_ret,
+                                   int32_t op_errno,
+                                   off_t offset, dict_t *xdata);
+
 typedef int32_t (*fop_lookup_t) (call_frame_t *frame,
                                  xlator_t *this,
                                  loc_t *loc,
@@ -634,6 +674,37 @@ typedef int32_t (*fop_fsetattr_t) (call_frame_t *frame,
                                    struct iatt *stbuf,
                                    int32_t valid, dict_t *xdata);
 
+typedef int32_t (*fop_compound_t) (call_frame_t *frame,
+                                   xlator_t *this,
+                                   compound_args_t *args, dict_t *xdata);
+
+/* keep_size: allocate without changing the file size (FALLOC_FL_KEEP_SIZE) */
+typedef int32_t (*fop_fallocate_t) (call_frame_t *frame,
+                                    xlator_t *this,
+                                    fd_t *fd,
+                                    int32_t keep_size,
+                                    off_t offset,
+                                    size_t len, dict_t *xdata);
+
+typedef int32_t (*fop_discard_t) (call_frame_t *frame,
+                                  xlator_t *this,
+                                  fd_t *fd,
+                                  off_t offset,
+                                  size_t len, dict_t *xdata);
+
+typedef int32_t (*fop_zerofill_t) (call_frame_t *frame,
+                                   xlator_t *this,
+                                   fd_t *fd,
+                                   off_t offset,
+                                   off_t len, dict_t *xdata);
+
+/* find the next data (GF_SEEK_DATA) or hole (GF_SEEK_HOLE) from offset */
+typedef int32_t (*fop_seek_t) (call_frame_t *frame,
+                               xlator_t *this,
+                               fd_t *fd,
+                               off_t offset,
+                               gf_seek_what_t what, dict_t *xdata);
+
 
 struct xlator_fops {
         fop_lookup_t         lookup;
@@ -678,6 +749,11 @@ struct xlator_fops {
         fop_setattr_t        setattr;
         fop_fsetattr_t       fsetattr;
         fop_getspec_t        getspec;
+        fop_compound_t       compound;
+        fop_fallocate_t      fallocate;
+        fop_discard_t        discard;
+        fop_zerofill_t       zerofill;
+        fop_seek_t           seek;
 
         /* these entries are used for a typechecking hack in STACK_WIND _only_ */
         fop_lookup_cbk_t         lookup_cbk;
@@ -722,6 +798,11 @@ struct xlator_fops {
         fop_setattr_cbk_t        setattr_cbk;
         fop_fsetattr_cbk_t       fsetattr_cbk;
         fop_getspec_cbk_t        getspec_cbk;
+        fop_compound_cbk_t       compound_cbk;
+        fop_fallocate_cbk_t      fallocate_cbk;
+        fop_discard_cbk_t        discard_cbk;
+        fop_zerofill_cbk_t       zerofill_cbk;
+        fop_seek_cbk_t           seek_cbk;
 };
 
 typedef int32_t (*cbk_forget_t) (xlator_t *this,
@@ -815,6 +896,8 @@ struct _xlator {
         eh_t               *history; /* event history context */
         glusterfs_ctx_t    *ctx;
         glusterfs_graph_t  *graph; /* not set for fuse */
+        int                 xl_id; /* index of this xlator's inode/fd ctx
+                                      slot, unique within graph */
         inode_table_t      *itable;
         char                init_succeeded;
         void               *private;
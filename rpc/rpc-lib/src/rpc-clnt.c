@@ -43,6 +43,25 @@ rpc_clnt_new_callid (struct rpc_clnt *clnt)
 }
 
 
+static inline struct list_head *
+__saved_frames_bucket (struct saved_frames *frames, uint32_t xid)
+{
+        return &frames->hash[xid & (SAVED_FRAMES_HASH_SIZE - 1)];
+}
+
+
+static void
+__saved_frame_unlink (struct saved_frames *frames,
+                      struct saved_frame *saved_frame)
+{
+        list_del_init (&saved_frame->list);
+        list_del_init (&saved_frame->hash);
+        frames->count--;
+}
+
+
+/* frames->sf is in the order the requests were sent, so only its head
+   has to be looked at */
 struct saved_frame *
 __saved_frames_get_timedout (struct saved_frames *frames, uint32_t timeout,
                              struct timeval *current)
@@ -53,8 +72,7 @@ __saved_frames_get_timedout (struct saved_frames *frames, uint32_t timeout,
 		tmp = list_entry (frames->sf.list.next, typeof (*tmp), list);
 		if ((tmp->saved_at.tv_sec + timeout) < current->tv_sec) {
 			bailout_frame = tmp;
-			list_del_init (&bailout_frame->list);
-			frames->count--;
+                        __saved_frame_unlink (frames, bailout_frame);
 		}
 	}
 
@@ -91,6 +109,7 @@ __saved_frames_put (struct saved_frames *frames, void *frame,
 
         memset (saved_frame, 0, sizeof (*saved_frame));
 	INIT_LIST_HEAD (&saved_frame->list);
+        INIT_LIST_HEAD (&saved_frame->hash);
 
 	saved_frame->capital_this = THIS;
 	saved_frame->frame        = frame;
@@ -102,6 +121,8 @@ __saved_frames_put (struct saved_frames *frames, void *frame,
         else
                 list_add_tail (&saved_frame->list, &frames->sf.list);
 
+        list_add (&saved_frame->hash,
+                  __saved_frames_bucket (frames, rpcreq->xid));
 	frames->count++;
 
 out:
@@ -118,8 +139,7 @@ saved_frames_delete (struct saved_frame *saved_frame,
 
         pthread_mutex_lock (&conn->lock);
         {
-                list_del_init (&saved_frame->list);
-                conn->saved_frames->count--;
+                __saved_frame_unlink (conn->saved_frames, saved_frame);
         }
         pthread_mutex_unlock (&conn->lock);
 
@@ -256,6 +276,7 @@ struct saved_frames *
 saved_frames_new (void)
 {
 	struct saved_frames *saved_frames = NULL;
+        int                  i            = 0;
 
 	saved_frames = GF_CALLOC (1, sizeof (*saved_frames),
                                   gf_common_mt_rpcclnt_savedframe_t);
@@ -265,11 +286,30 @@ saved_frames_new (void)
 
 	INIT_LIST_HEAD (&saved_frames->sf.list);
 	INIT_LIST_HEAD (&saved_frames->lk_sf.list);
+        for (i = 0; i < SAVED_FRAMES_HASH_SIZE; i++)
+                INIT_LIST_HEAD (&saved_frames->hash[i]);
 
 	return saved_frames;
 }
 
 
+static struct saved_frame *
+__saved_frame_lookup (struct saved_frames *frames, int64_t callid)
+{
+	struct saved_frame *tmp    = NULL;
+        struct list_head   *bucket = NULL;
+
+        bucket = __saved_frames_bucket (frames, callid);
+
+	list_for_each_entry (tmp, bucket, hash) {
+		if (tmp->rpcreq->xid == callid)
+                        return tmp;
+	}
+
+        return NULL;
+}
+
+
 int
 __saved_frame_copy (struct saved_frames *frames, int64_t callid,
                     struct saved_frame *saved_frame)
@@ -282,21 +322,11 @@ __saved_frame_copy (struct saved_frames *frames, int64_t callid,
                 goto out;
         }
 
-	list_for_each_entry (tmp, &frames->sf.list, list) {
-		if (tmp->rpcreq->xid == callid) {
-			*saved_frame = *tmp;
-                        ret = 0;
-			goto out;
-		}
-	}
-
-	list_for_each_entry (tmp, &frames->lk_sf.list, list) {
-		if (tmp->rpcreq->xid == callid) {
-			*saved_frame = *tmp;
-                        ret = 0;
-			goto out;
-		}
-	}
+        tmp = __saved_frame_lookup (frames, callid);
+        if (tmp) {
+                *saved_frame = *tmp;
+                ret = 0;
+        }
 
 out:
 	return ret;
@@ -307,28 +337,10 @@ struct saved_frame *
 __saved_frame_get (struct saved_frames *frames, int64_t callid)
 {
 	struct saved_frame *saved_frame = NULL;
-	struct saved_frame *tmp = NULL;
-
-	list_for_each_entry (tmp, &frames->sf.list, list) {
-		if (tmp->rpcreq->xid == callid) {
-			list_del_init (&tmp->list);
-			frames->count--;
-			saved_frame = tmp;
-			goto out;
-		}
-	}
 
-	list_for_each_entry (tmp, &frames->lk_sf.list, list) {
-		if (tmp->rpcreq->xid == callid) {
-			list_del_init (&tmp->list);
-			frames->count--;
-			saved_frame = tmp;
-			goto out;
-		}
-	}
-
-out:
+        saved_frame = __saved_frame_lookup (frames, callid);
 	if (saved_frame) {
+                __saved_frame_unlink (frames, saved_frame);
                 THIS  = saved_frame->capital_this;
         }
 
@@ -375,6 +387,7 @@ saved_frames_unwind (struct saved_frames *saved_frames)
                                        trav->rpcreq->conn->rpc_clnt->reqpool);
 
 		list_del_init (&trav->list);
+                list_del_init (&trav->hash);
                 mem_put (trav);
 	}
 }
@@ -49,6 +49,7 @@ struct saved_frame {
 			struct saved_frame *frame_prev;
 		};
 	};
+        struct list_head         hash;          /* in saved_frames->hash */
         void                    *capital_this;
 	void                    *frame;
 	struct timeval           saved_at;
@@ -56,10 +57,15 @@ struct saved_frame {
         rpc_transport_rsp_t      rsp;
 };
 
+/* xids are handed out sequentially, so the low bits spread outstanding
+   requests evenly over the buckets */
+#define SAVED_FRAMES_HASH_SIZE  1024
+
 struct saved_frames {
 	int64_t            count;
-	struct saved_frame sf;
+	struct saved_frame sf;          /* in the order sent, for call_bail */
 	struct saved_frame lk_sf;
+        struct list_head   hash[SAVED_FRAMES_HASH_SIZE];  /* by xid */
 };
 
 
@@ -415,6 +415,25 @@ fail:
 }
 
 
+/* Stops (@onoff set) or resumes reading requests from @this. */
+int32_t
+rpc_transport_throttle (rpc_transport_t *this, gf_boolean_t onoff)
+{
+        int32_t ret = -1;
+
+        GF_VALIDATE_OR_GOTO ("rpc_transport", this, out);
+
+        if (!this->ops->throttle) {
+                ret = -ENOSYS;
+                goto out;
+        }
+
+        ret = this->ops->throttle (this, onoff);
+out:
+        return ret;
+}
+
+
 int32_t
 rpc_transport_destroy (rpc_transport_t *this)
 {
@@ -207,6 +207,25 @@ struct rpc_transport {
 
         uint64_t                   total_bytes_read;
         uint64_t                   total_bytes_write;
+        uint64_t                   total_msgs_write;
+        uint64_t                   total_write_calls;
+
+        /* rpcsvc requests waiting for a worker, in arrival order. While
+           dispatch_busy is set one of them is queued or being run, and
+           dispatch_list links the transport in the worker queue. */
+        struct list_head           dispatch_queue;
+        struct list_head           dispatch_list;
+        char                       dispatch_busy;
+        /* bytes this transport may still dispatch in its round robin
+           turn */
+        int64_t                    dispatch_deficit;
+
+        /* rpcsvc requests received and not yet replied to. Reading is
+           paused (throttled) while it is at the rpcsvc limit. */
+        int                        outstanding_rpc_count;
+        char                       throttled;
+        uint64_t                   total_rpcs;
+        uint64_t                   throttle_count;
 
         struct list_head           list;
         int                        bind_insecure;
@@ -234,6 +253,7 @@ struct rpc_transport_ops {
         int32_t (*get_myaddr)     (rpc_transport_t *this, char *peeraddr,
                                    int addrlen, struct sockaddr_storage *sa,
                                    socklen_t sasize);
+        int32_t (*throttle)       (rpc_transport_t *this, gf_boolean_t onoff);
 };
 
 
@@ -246,6 +266,9 @@ rpc_transport_connect (rpc_transport_t *this, int port);
 int32_t
 rpc_transport_disconnect (rpc_transport_t *this);
 
+int32_t
+rpc_transport_throttle (rpc_transport_t *this, gf_boolean_t onoff);
+
 int32_t
 rpc_transport_destroy (rpc_transport_t *this);
 
@@ -33,6 +33,8 @@ typedef int (*rpcsvc_notify_t) (struct rpcsvc_state *, void *mydata,
 
 /* Contains global state required for all the RPC services.
  */
+#define RPCSVC_MAX_WORKER_THREADS       64
+
 typedef struct rpcsvc_state {
 
         /* Contains list of (program, version) handlers.
@@ -68,6 +70,21 @@ typedef struct rpcsvc_state {
         void                    *mydata; /* This is xlator */
         rpcsvc_notify_t          notifyfn;
         struct mem_pool         *rxpool;
+
+        /* requests handed off by the poll threads to a pool of workers,
+           worker_queue holds the transports with requests waiting */
+        pthread_mutex_t          worker_lock;
+        pthread_cond_t           worker_cond;
+        struct list_head         worker_queue;
+        int                      worker_threads;
+        int                      worker_running;
+        int                      worker_pending;
+        int                      worker_exit; /* rpcsvc_stop_workers () */
+        pthread_t                workers[RPCSVC_MAX_WORKER_THREADS];
+
+        /* requests a transport may have outstanding before reading from
+           it is paused, 0 for no limit */
+        int                      outstanding_rpc_limit;
 } rpcsvc_t;
 
 
@@ -265,6 +265,45 @@ out:
 }
 
 
+/* Accounts a request of @req->trans coming in (@delta 1) or going away
+ * (-1). Reading from the transport is paused while it has
+ * outstanding_rpc_limit requests or more, so one busy client cannot flood
+ * the brick at the expense of the others.
+ */
+static void
+rpcsvc_request_outstanding (rpcsvc_request_t *req, int delta)
+{
+        rpc_transport_t *trans    = NULL;
+        int              limit    = 0;
+        char             throttle = 0;
+
+        trans = req->trans;
+        limit = req->svc->outstanding_rpc_limit;
+        req->outstanding = (delta > 0);
+
+        pthread_mutex_lock (&trans->lock);
+        {
+                trans->outstanding_rpc_count += delta;
+                if (delta > 0)
+                        trans->total_rpcs++;
+
+                throttle = (limit &&
+                            (trans->outstanding_rpc_count >= limit));
+                if (throttle == trans->throttled)
+                        goto unlock;
+
+                if (rpc_transport_throttle (trans, throttle) != 0)
+                        goto unlock;
+
+                trans->throttled = throttle;
+                if (throttle)
+                        trans->throttle_count++;
+        }
+unlock:
+        pthread_mutex_unlock (&trans->lock);
+}
+
+
 void
 rpcsvc_request_destroy (rpcsvc_request_t *req)
 {
@@ -272,6 +311,9 @@ rpcsvc_request_destroy (rpcsvc_request_t *req)
                 goto out;
         }
 
+        if (req->outstanding)
+                rpcsvc_request_outstanding (req, -1);
+
         if (req->iobref) {
                 iobref_unref (req->iobref);
         }
@@ -319,6 +361,7 @@ rpcsvc_request_init (rpcsvc_t *svc, rpc_transport_t *trans,
 
         req->svc = svc;
         req->trans_private = msg->private;
+        req->private = NULL;
 
         INIT_LIST_HEAD (&req->txlist);
         req->payloadsize = 0;
@@ -457,6 +500,289 @@ rpcsvc_check_and_reply_error (int ret, call_frame_t *frame, void *opaque)
         return 0;
 }
 
+/* Runs the actor of a request taken off the worker queue. */
+static void
+rpcsvc_worker_dispatch (rpcsvc_t *svc, rpcsvc_request_t *req)
+{
+        rpcsvc_actor  actor_fn = NULL;
+        int           ret      = -1;
+
+        THIS = svc->mydata;
+
+        actor_fn = req->prog->actors[req->procnum].actor;
+        ret = actor_fn (req);
+
+        rpcsvc_check_and_reply_error (ret, NULL, req);
+}
+
+
+static int64_t
+rpcsvc_request_cost (rpcsvc_request_t *req)
+{
+        return RPCSVC_DRR_REQUEST_COST + iov_length (req->msg, req->count);
+}
+
+
+/* Next request of @trans which fits in what is left of its turn. */
+static rpcsvc_request_t *
+__rpcsvc_worker_next (rpcsvc_t *svc, rpc_transport_t *trans)
+{
+        rpcsvc_request_t *req  = NULL;
+        int64_t           cost = 0;
+
+        if (list_empty (&trans->dispatch_queue))
+                return NULL;
+
+        req = list_entry (trans->dispatch_queue.next, rpcsvc_request_t,
+                          dispatch);
+        cost = rpcsvc_request_cost (req);
+        if (cost > trans->dispatch_deficit)
+                return NULL;
+
+        trans->dispatch_deficit -= cost;
+        list_del_init (&req->dispatch);
+        svc->worker_pending--;
+
+        return req;
+}
+
+
+/* Puts @trans back in line if it still has requests waiting, what is left
+ * of its deficit then carries over to its next turn.
+ */
+static void
+__rpcsvc_worker_end_turn (rpcsvc_t *svc, rpc_transport_t *trans)
+{
+        if (list_empty (&trans->dispatch_queue)) {
+                trans->dispatch_busy = 0;
+                trans->dispatch_deficit = 0;
+                return;
+        }
+
+        list_add_tail (&trans->dispatch_list, &svc->worker_queue);
+        pthread_cond_signal (&svc->worker_cond);
+}
+
+
+static void *
+rpcsvc_worker (void *data)
+{
+        rpcsvc_t         *svc   = data;
+        rpc_transport_t  *trans = NULL;
+        rpcsvc_request_t *req   = NULL;
+
+        for (;;) {
+                pthread_mutex_lock (&svc->worker_lock);
+                {
+                        while (list_empty (&svc->worker_queue) &&
+                               !svc->worker_exit)
+                                pthread_cond_wait (&svc->worker_cond,
+                                                   &svc->worker_lock);
+
+                        /* only leave once everything queued has run */
+                        if (list_empty (&svc->worker_queue)) {
+                                pthread_mutex_unlock (&svc->worker_lock);
+                                break;
+                        }
+
+                        trans = list_entry (svc->worker_queue.next,
+                                            rpc_transport_t, dispatch_list);
+                        list_del_init (&trans->dispatch_list);
+                        trans->dispatch_deficit += RPCSVC_DRR_QUANTUM;
+
+                        /* the reply can free req, and with it its ref */
+                        rpc_transport_ref (trans);
+                }
+                pthread_mutex_unlock (&svc->worker_lock);
+
+                /* a transport is run by one worker at a time, so its
+                   requests are dispatched in the order they came in */
+                for (;;) {
+                        pthread_mutex_lock (&svc->worker_lock);
+                        {
+                                req = __rpcsvc_worker_next (svc, trans);
+                                if (!req)
+                                        __rpcsvc_worker_end_turn (svc, trans);
+                        }
+                        pthread_mutex_unlock (&svc->worker_lock);
+
+                        if (!req)
+                                break;
+
+                        rpcsvc_worker_dispatch (svc, req);
+                }
+
+                rpc_transport_unref (trans);
+        }
+
+        return NULL;
+}
+
+
+/* Hands @req to the workers. Returns -1 when it should be run inline,
+ * because there are no workers or they are backed up and no earlier
+ * request of the same transport is waiting. A transport with requests
+ * queued keeps going to the workers until they are all dispatched, so
+ * that its requests stay in order whatever the worker count is changed to.
+ */
+static int
+rpcsvc_worker_queue (rpcsvc_t *svc, rpcsvc_request_t *req,
+                     struct iobuf *hdr_iobuf)
+{
+        rpc_transport_t *trans = req->trans;
+        int              ret   = -1;
+
+        pthread_mutex_lock (&svc->worker_lock);
+        {
+                if (!trans->dispatch_busy) {
+                        if (!svc->worker_threads || !svc->worker_running ||
+                            svc->worker_exit)
+                                goto unlock;
+
+                        if (svc->worker_pending >=
+                            RPCSVC_WORKER_QUEUE_DEPTH * svc->worker_running)
+                                goto unlock;
+
+                        trans->dispatch_busy = 1;
+                        INIT_LIST_HEAD (&trans->dispatch_queue);
+                        list_add_tail (&trans->dispatch_list,
+                                       &svc->worker_queue);
+                        pthread_cond_signal (&svc->worker_cond);
+                }
+
+                if (hdr_iobuf)
+                        req->hdr_iobuf = iobuf_ref (hdr_iobuf);
+
+                list_add_tail (&req->dispatch, &trans->dispatch_queue);
+                svc->worker_pending++;
+                ret = 0;
+        }
+unlock:
+        pthread_mutex_unlock (&svc->worker_lock);
+
+        return ret;
+}
+
+
+static int
+rpcsvc_start_workers (rpcsvc_t *svc)
+{
+        int ret = 0;
+
+        pthread_mutex_lock (&svc->worker_lock);
+        {
+                while (svc->worker_running < svc->worker_threads) {
+                        ret = pthread_create (&svc->workers[svc->worker_running],
+                                              NULL, rpcsvc_worker, svc);
+                        if (ret) {
+                                gf_log (GF_RPCSVC, GF_LOG_WARNING,
+                                        "failed to start rpc worker thread "
+                                        "(%s)", strerror (ret));
+                                break;
+                        }
+
+                        svc->worker_running++;
+                }
+        }
+        pthread_mutex_unlock (&svc->worker_lock);
+
+        if (svc->worker_running)
+                gf_log (GF_RPCSVC, GF_LOG_INFO, "%d rpc worker threads running",
+                        svc->worker_running);
+
+        return ret;
+}
+
+
+/* Workers are only ever added, lowering the count takes effect on the next
+ * restart. With a count of 0 requests are run inline again, on each
+ * transport once those it has queued have been dispatched.
+ */
+int
+rpcsvc_set_worker_threads (rpcsvc_t *svc, dict_t *options)
+{
+        char    *threads_str = NULL;
+        int32_t  threads     = 0;
+
+        GF_ASSERT (svc);
+        GF_ASSERT (options);
+
+        if ((dict_get_str (options, "rpc-worker-threads", &threads_str) != 0)
+            || (gf_string2int32 (threads_str, &threads) != 0))
+                threads = 0;
+
+        if (threads < 0)
+                threads = 0;
+        if (threads > RPCSVC_MAX_WORKER_THREADS)
+                threads = RPCSVC_MAX_WORKER_THREADS;
+
+        pthread_mutex_lock (&svc->worker_lock);
+        {
+                svc->worker_threads = threads;
+        }
+        pthread_mutex_unlock (&svc->worker_lock);
+
+        return rpcsvc_start_workers (svc);
+}
+
+
+/* Lets the workers run what is queued, then waits for them to exit. From
+ * then on all requests are run inline.
+ */
+void
+rpcsvc_stop_workers (rpcsvc_t *svc)
+{
+        int running = 0;
+        int i       = 0;
+
+        GF_ASSERT (svc);
+
+        pthread_mutex_lock (&svc->worker_lock);
+        {
+                svc->worker_exit = 1;
+                running = svc->worker_running;
+                pthread_cond_broadcast (&svc->worker_cond);
+        }
+        pthread_mutex_unlock (&svc->worker_lock);
+
+        for (i = 0; i < running; i++)
+                pthread_join (svc->workers[i], NULL);
+
+        pthread_mutex_lock (&svc->worker_lock);
+        {
+                svc->worker_running = 0;
+        }
+        pthread_mutex_unlock (&svc->worker_lock);
+}
+
+
+/* A lowered limit applies to each transport from its next request on. */
+int
+rpcsvc_set_outstanding_rpc_limit (rpcsvc_t *svc, dict_t *options,
+                                  int defvalue)
+{
+        char    *limit_str = NULL;
+        int32_t  limit     = 0;
+
+        GF_ASSERT (svc);
+        GF_ASSERT (options);
+
+        if ((dict_get_str (options, "outstanding-rpc-limit",
+                           &limit_str) != 0) ||
+            (gf_string2int32 (limit_str, &limit) != 0))
+                limit = defvalue;
+
+        if (limit < 0)
+                limit = 0;
+        if (limit > RPCSVC_MAX_OUTSTANDING_RPC_LIMIT)
+                limit = RPCSVC_MAX_OUTSTANDING_RPC_LIMIT;
+
+        svc->outstanding_rpc_limit = limit;
+
+        return 0;
+}
+
+
 int
 rpcsvc_handle_rpc_call (rpcsvc_t *svc, rpc_transport_t *trans,
                         rpc_transport_pollin_t *msg)
@@ -505,10 +831,15 @@ rpcsvc_handle_rpc_call (rpcsvc_t *svc, rpc_transport_t *trans,
         if (!req)
                 goto err;
 
-        if (!rpcsvc_request_accepted (req))
-                goto err_reply;
+        if (rpcsvc_request_accepted (req))
+                actor = rpcsvc_program_actor (req);
+
+        /* a blocked lock request stays outstanding until the lock is
+           granted, counting it could stop the brick from reading the
+           unlock that grants it */
+        if (!actor || !actor->unthrottled)
+                rpcsvc_request_outstanding (req, 1);
 
-        actor = rpcsvc_program_actor (req);
         if (!actor)
                 goto err_reply;
 
@@ -545,9 +876,16 @@ rpcsvc_handle_rpc_call (rpcsvc_t *svc, rpc_transport_t *trans,
                                             (synctask_fn_t) actor_fn,
                                             rpcsvc_check_and_reply_error, NULL,
                                             req);
+                } else if (rpcsvc_worker_queue (svc, req,
+                                                msg->hdr_iobuf) == 0) {
+                        return 0;
                 } else {
+                        /* actors may keep pointing into the record (a
+                           compound call's write payloads) past returning */
+                        if (msg->hdr_iobuf)
+                                req->hdr_iobuf = iobuf_ref (msg->hdr_iobuf);
+
                         ret = actor_fn (req);
-                        req->hdr_iobuf = NULL;
                 }
         }
 
@@ -1863,10 +2201,13 @@ rpcsvc_init (xlator_t *xl, glusterfs_ctx_t *ctx, dict_t *options,
                 return NULL;
 
         pthread_mutex_init (&svc->rpclock, NULL);
+        pthread_mutex_init (&svc->worker_lock, NULL);
+        pthread_cond_init (&svc->worker_cond, NULL);
         INIT_LIST_HEAD (&svc->authschemes);
         INIT_LIST_HEAD (&svc->notify);
         INIT_LIST_HEAD (&svc->listeners);
         INIT_LIST_HEAD (&svc->programs);
+        INIT_LIST_HEAD (&svc->worker_queue);
 
         ret = rpcsvc_init_options (svc, options);
         if (ret == -1) {
@@ -1906,6 +2247,8 @@ rpcsvc_init (xlator_t *xl, glusterfs_ctx_t *ctx, dict_t *options,
                         "failed to register DUMP program");
                 goto free_svc;
         }
+
+        (void) rpcsvc_set_worker_threads (svc, options);
         ret = 0;
 free_svc:
         if (ret == -1) {
@@ -46,6 +46,21 @@
 #define RPCSVC_DEFAULT_MEMFACTOR        8
 #define RPCSVC_EVENTPOOL_SIZE_MULT      1024
 #define RPCSVC_POOLCOUNT_MULT           64
+
+/* Requests waiting for a worker, per worker, past which a request from a
+ * connection with nothing queued is run on the poll thread instead.
+ */
+#define RPCSVC_WORKER_QUEUE_DEPTH       1024
+
+/* Workers take turns between transports by deficit round robin: a turn
+ * allows a quantum worth of requests, each costing its size in bytes plus
+ * a fixed amount, so that small requests are not free either.
+ */
+#define RPCSVC_DRR_QUANTUM              (128 * GF_UNIT_KB)
+#define RPCSVC_DRR_REQUEST_COST         (1 * GF_UNIT_KB)
+
+#define RPCSVC_DEFAULT_OUTSTANDING_RPC_LIMIT 64
+#define RPCSVC_MAX_OUTSTANDING_RPC_LIMIT     65536
 #define RPCSVC_CONN_READ        (128 * GF_UNIT_KB)
 #define RPCSVC_PAGE_SIZE        (128 * GF_UNIT_KB)
 #define RPC_ROOT_UID             0
@@ -241,6 +256,12 @@ struct rpcsvc_request {
 
         /* we need to ref the 'iobuf' in case of 'synctasking' it */
         struct iobuf            *hdr_iobuf;
+
+        /* counted in trans->outstanding_rpc_count */
+        char                    outstanding;
+
+        /* in trans->dispatch_queue while waiting for a worker */
+        struct list_head        dispatch;
 };
 
 #define rpcsvc_request_program(req) ((rpcsvc_program_t *)((req)->prog))
@@ -336,6 +357,11 @@ typedef struct rpcsvc_actor_desc {
 
         /* Can actor be ran on behalf an unprivileged requestor? */
         gf_boolean_t            unprivileged;
+
+        /* Left out of the outstanding-rpc-limit count: requests that can
+         * wait for as long as others hold a lock, and pings.
+         */
+        gf_boolean_t            unthrottled;
 } rpcsvc_actor_t;
 
 /* Describes a program and its version along with the function pointers
@@ -441,6 +467,16 @@ rpcsvc_init (xlator_t *xl, glusterfs_ctx_t *ctx, dict_t *options,
 int
 rpcsvc_register_notify (rpcsvc_t *svc, rpcsvc_notify_t notify, void *mydata);
 
+int
+rpcsvc_set_worker_threads (rpcsvc_t *svc, dict_t *options);
+
+void
+rpcsvc_stop_workers (rpcsvc_t *svc);
+
+int
+rpcsvc_set_outstanding_rpc_limit (rpcsvc_t *svc, dict_t *options,
+                                  int defvalue);
+
 /* unregister a notification callback @notify with data @mydata from svc.
  * returns the number of notification callbacks unregistered.
  */
@@ -330,8 +330,9 @@ __gf_rdma_disconnect (rpc_transport_t *this)
 
 
 static int32_t
-gf_rdma_post_send (struct ibv_qp *qp, gf_rdma_post_t *post, int32_t len)
+gf_rdma_post_send (gf_rdma_peer_t *peer, gf_rdma_post_t *post, int32_t len)
 {
+        struct ibv_qp  *qp = peer->qp;
         struct ibv_sge list = {
                 .addr = (unsigned long) post->buf,
                 .length = len,
@@ -349,6 +350,11 @@ gf_rdma_post_send (struct ibv_qp *qp, gf_rdma_post_t *post, int32_t len)
         if (!qp)
                 return EINVAL;
 
+        /* the hca copies small messages out of the work request itself,
+         * saving the dma read of the post buffer. */
+        if (len <= peer->max_inline_data)
+                wr.send_flags |= IBV_SEND_INLINE;
+
         return ibv_post_send (qp, &wr, &bad_wr);
 }
 
@@ -401,7 +407,7 @@ __gf_rdma_send_error (gf_rdma_peer_t *peer, gf_rdma_ioq_t *entry,
 
         gf_rdma_post_ref (post);
 
-        ret = gf_rdma_post_send (peer->qp, post, len);
+        ret = gf_rdma_post_send (peer, post, len);
         if (!ret) {
                 ret = len;
         } else {
@@ -1086,7 +1092,7 @@ __gf_rdma_ioq_churn_request (gf_rdma_peer_t *peer, gf_rdma_ioq_t *entry,
 
         gf_rdma_post_ref (post);
 
-        ret = gf_rdma_post_send (peer->qp, post, len);
+        ret = gf_rdma_post_send (peer, post, len);
         if (!ret) {
                 ret = len;
         } else {
@@ -1195,7 +1201,7 @@ __gf_rdma_send_reply_inline (gf_rdma_peer_t *peer, gf_rdma_ioq_t *entry,
 
         gf_rdma_post_ref (post);
 
-        ret = gf_rdma_post_send (peer->qp, post, (buf - post->buf));
+        ret = gf_rdma_post_send (peer, post, (buf - post->buf));
         if (!ret) {
                 ret = send_size;
         } else {
@@ -1492,7 +1498,7 @@ __gf_rdma_send_reply_type_nomsg (gf_rdma_peer_t *peer, gf_rdma_ioq_t *entry,
                 goto out;
         }
 
-        ret = gf_rdma_post_send (peer->qp, post, (buf - post->buf));
+        ret = gf_rdma_post_send (peer, post, (buf - post->buf));
         if (ret) {
                 gf_log (GF_RDMA_LOG_NAME, GF_LOG_WARNING,
                         "posting a send request to client (%s) failed with "
@@ -1577,7 +1583,7 @@ __gf_rdma_send_reply_type_msg (gf_rdma_peer_t *peer, gf_rdma_ioq_t *entry,
         iov_unload (ptr, entry->proghdr, entry->proghdr_count);
         ptr += iov_length (entry->proghdr, entry->proghdr_count);
 
-        ret = gf_rdma_post_send (peer->qp, post, (ptr - post->buf));
+        ret = gf_rdma_post_send (peer, post, (ptr - post->buf));
         if (ret) {
                 gf_log (GF_RDMA_LOG_NAME, GF_LOG_WARNING,
                         "rdma send to client (%s) failed with ret = %d (%s)",
@@ -2332,7 +2338,8 @@ gf_rdma_create_qp (rpc_transport_t *this)
                         .max_send_wr  = peer->send_count,
                         .max_recv_wr  = peer->recv_count,
                         .max_send_sge = 2,
-                        .max_recv_sge = 1
+                        .max_recv_sge = 1,
+                        .max_inline_data = options->max_inline_data
                 },
                 .qp_type = IBV_QPT_RC
         };
@@ -2346,6 +2353,15 @@ gf_rdma_create_qp (rpc_transport_t *this)
         };
 
         peer->qp = ibv_create_qp (device->pd, &init_attr);
+        if (!peer->qp && init_attr.cap.max_inline_data) {
+                gf_log (GF_RDMA_LOG_NAME, GF_LOG_DEBUG,
+                        "%s: could not create QP with %d bytes of inline "
+                        "data, retrying without inline sends", this->name,
+                        init_attr.cap.max_inline_data);
+                init_attr.cap.max_inline_data = 0;
+                peer->qp = ibv_create_qp (device->pd, &init_attr);
+        }
+
         if (!peer->qp) {
                 gf_log (GF_RDMA_LOG_NAME,
                         GF_LOG_CRITICAL,
@@ -2366,6 +2382,9 @@ gf_rdma_create_qp (rpc_transport_t *this)
                 goto out;
         }
 
+        /* ibv_create_qp () updates cap with what the device granted */
+        peer->max_inline_data = init_attr.cap.max_inline_data;
+
         peer->local_lid = gf_rdma_get_local_lid (device->context,
                                                  options->port);
         peer->local_qpn = peer->qp->qp_num;
@@ -3425,17 +3444,71 @@ out:
 }
 
 
+static void
+gf_rdma_handle_recv_completion (gf_rdma_device_t *device, struct ibv_wc *wc)
+{
+        gf_rdma_post_t *post = NULL;
+        gf_rdma_peer_t *peer = NULL;
+
+        post = (gf_rdma_post_t *) (long) wc->wr_id;
+
+        pthread_mutex_lock (&device->qpreg.lock);
+        {
+                peer = __gf_rdma_lookup_peer (device, wc->qp_num);
+
+                /*
+                 * keep a refcount on transport so that it
+                 * does not get freed because of some error
+                 * indicated by wc->status till we are done
+                 * with usage of peer and thereby that of trans.
+                 */
+                if (peer != NULL) {
+                        rpc_transport_ref (peer->trans);
+                }
+        }
+        pthread_mutex_unlock (&device->qpreg.lock);
+
+        if (wc->status != IBV_WC_SUCCESS) {
+                gf_log (GF_RDMA_LOG_NAME, GF_LOG_ERROR,
+                        "recv work request on `%s' returned "
+                        "error (%d)", device->device_name,
+                        wc->status);
+                if (peer) {
+                        rpc_transport_unref (peer->trans);
+                        rpc_transport_disconnect (peer->trans);
+                }
+
+                if (post) {
+                        gf_rdma_post_unref (post);
+                }
+                return;
+        }
+
+        if (peer) {
+                gf_rdma_process_recv (peer, wc);
+                rpc_transport_unref (peer->trans);
+        } else {
+                gf_log (GF_RDMA_LOG_NAME,
+                        GF_LOG_DEBUG,
+                        "could not lookup peer for qp_num: %d",
+                        wc->qp_num);
+        }
+
+        gf_rdma_post_unref (post);
+}
+
+
 static void *
 gf_rdma_recv_completion_proc (void *data)
 {
         struct ibv_comp_channel *chan      = NULL;
         gf_rdma_device_t        *device    = NULL;;
-        gf_rdma_post_t          *post      = NULL;
-        gf_rdma_peer_t          *peer      = NULL;
         struct ibv_cq           *event_cq  = NULL;
-        struct ibv_wc            wc        = {0, };
+        struct ibv_wc            wc[GF_RDMA_CQ_POLL_BATCH];
         void                    *event_ctx = NULL;
         int32_t                  ret       = 0;
+        int                      i         = 0;
+        unsigned int             unacked   = 0;
 
         chan = data;
 
@@ -3450,6 +3523,14 @@ gf_rdma_recv_completion_proc (void *data)
 
                 device = event_ctx;
 
+                /* acknowledging takes a lock inside the verbs library, so
+                 * do it once for a batch of events instead of per event.
+                 * there is only one cq on this channel. */
+                if (++unacked >= GF_RDMA_CQ_ACK_BATCH) {
+                        ibv_ack_cq_events (event_cq, unacked);
+                        unacked = 0;
+                }
+
                 ret = ibv_req_notify_cq (event_cq, 0);
                 if (ret) {
                         gf_log (GF_RDMA_LOG_NAME, GF_LOG_ERROR,
@@ -3459,55 +3540,11 @@ gf_rdma_recv_completion_proc (void *data)
                         continue;
                 }
 
-                device = (gf_rdma_device_t *) event_ctx;
-
-                while ((ret = ibv_poll_cq (event_cq, 1, &wc)) > 0) {
-                        post = (gf_rdma_post_t *) (long) wc.wr_id;
-
-                        pthread_mutex_lock (&device->qpreg.lock);
-                        {
-                                peer = __gf_rdma_lookup_peer (device,
-                                                              wc.qp_num);
-
-                                /*
-                                 * keep a refcount on transport so that it
-                                 * does not get freed because of some error
-                                 * indicated by wc.status till we are done
-                                 * with usage of peer and thereby that of trans.
-                                 */
-                                if (peer != NULL) {
-                                        rpc_transport_ref (peer->trans);
-                                }
-                        }
-                        pthread_mutex_unlock (&device->qpreg.lock);
-
-                        if (wc.status != IBV_WC_SUCCESS) {
-                                gf_log (GF_RDMA_LOG_NAME, GF_LOG_ERROR,
-                                        "recv work request on `%s' returned "
-                                        "error (%d)", device->device_name,
-                                        wc.status);
-                                if (peer) {
-                                        rpc_transport_unref (peer->trans);
-                                        rpc_transport_disconnect (peer->trans);
-                                }
-
-                                if (post) {
-                                        gf_rdma_post_unref (post);
-                                }
-                                continue;
-                        }
-
-                        if (peer) {
-                                gf_rdma_process_recv (peer, &wc);
-                                rpc_transport_unref (peer->trans);
-                        } else {
-                                gf_log (GF_RDMA_LOG_NAME,
-                                        GF_LOG_DEBUG,
-                                        "could not lookup peer for qp_num: %d",
-                                        wc.qp_num);
-                        }
-
-                        gf_rdma_post_unref (post);
+                while ((ret = ibv_poll_cq (event_cq, GF_RDMA_CQ_POLL_BATCH,
+                                           wc)) > 0) {
+                        for (i = 0; i < ret; i++)
+                                gf_rdma_handle_recv_completion (device,
+                                                                &wc[i]);
                 }
 
                 if (ret < 0) {
@@ -3518,7 +3555,6 @@ gf_rdma_recv_completion_proc (void *data)
                                 device->device_name, ret, errno);
                         continue;
                 }
-                ibv_ack_cq_events (event_cq, 1);
         }
 
         return NULL;
@@ -3608,18 +3644,87 @@ out:
 }
 
 
+static void
+gf_rdma_handle_send_completion (gf_rdma_device_t *device, struct ibv_wc *wc)
+{
+        gf_rdma_post_t *post       = NULL;
+        gf_rdma_peer_t *peer       = NULL;
+        char            is_request = 0;
+        int32_t         ret        = 0, quota_ret = 0;
+
+        post = (gf_rdma_post_t *) (long) wc->wr_id;
+
+        pthread_mutex_lock (&device->qpreg.lock);
+        {
+                peer = __gf_rdma_lookup_peer (device, wc->qp_num);
+
+                /*
+                 * keep a refcount on transport so that it
+                 * does not get freed because of some error
+                 * indicated by wc->status, till we are done
+                 * with usage of peer and thereby that of trans.
+                 */
+                if (peer != NULL) {
+                        rpc_transport_ref (peer->trans);
+                }
+        }
+        pthread_mutex_unlock (&device->qpreg.lock);
+
+        if (wc->status != IBV_WC_SUCCESS) {
+                gf_rdma_handle_failed_send_completion (peer, wc);
+        } else {
+                gf_rdma_handle_successful_send_completion (peer, wc);
+        }
+
+        if (post) {
+                is_request = post->ctx.is_request;
+
+                ret = gf_rdma_post_unref (post);
+                if ((ret == 0)
+                    && (wc->status == IBV_WC_SUCCESS)
+                    && !is_request
+                    && (post->type == GF_RDMA_SEND_POST)
+                    && (peer != NULL)) {
+                        /* An GF_RDMA_RECV_POST can end up in
+                         * gf_rdma_send_completion_proc for
+                         * rdma-reads, and we do not take
+                         * quota for getting an GF_RDMA_RECV_POST.
+                         */
+
+                        /*
+                         * if it is request, quota is returned
+                         * after reply has come.
+                         */
+                        quota_ret = gf_rdma_quota_put (peer);
+                        if (quota_ret < 0) {
+                                gf_log ("rdma", GF_LOG_DEBUG,
+                                        "failed to send "
+                                        "message");
+                        }
+                }
+        }
+
+        if (peer) {
+                rpc_transport_unref (peer->trans);
+        } else {
+                gf_log (GF_RDMA_LOG_NAME, GF_LOG_DEBUG,
+                        "could not lookup peer for qp_num: %d",
+                        wc->qp_num);
+        }
+}
+
+
 static void *
 gf_rdma_send_completion_proc (void *data)
 {
         struct ibv_comp_channel *chan       = NULL;
-        gf_rdma_post_t          *post       = NULL;
-        gf_rdma_peer_t          *peer       = NULL;
         struct ibv_cq           *event_cq   = NULL;
         void                    *event_ctx  = NULL;
         gf_rdma_device_t        *device     = NULL;
-        struct ibv_wc            wc         = {0, };
-        char                     is_request = 0;
-        int32_t                  ret        = 0, quota_ret = 0;
+        struct ibv_wc            wc[GF_RDMA_CQ_POLL_BATCH];
+        int32_t                  ret        = 0;
+        int                      i          = 0;
+        unsigned int             unacked    = 0;
 
         chan = data;
         while (1) {
@@ -3633,6 +3738,11 @@ gf_rdma_send_completion_proc (void *data)
 
                 device = event_ctx;
 
+                if (++unacked >= GF_RDMA_CQ_ACK_BATCH) {
+                        ibv_ack_cq_events (event_cq, unacked);
+                        unacked = 0;
+                }
+
                 ret = ibv_req_notify_cq (event_cq, 0);
                 if (ret) {
                         gf_log (GF_RDMA_LOG_NAME,  GF_LOG_ERROR,
@@ -3642,67 +3752,11 @@ gf_rdma_send_completion_proc (void *data)
                         continue;
                 }
 
-                while ((ret = ibv_poll_cq (event_cq, 1, &wc)) > 0) {
-                        post = (gf_rdma_post_t *) (long) wc.wr_id;
-
-                        pthread_mutex_lock (&device->qpreg.lock);
-                        {
-                                peer = __gf_rdma_lookup_peer (device, wc.qp_num);
-
-                                /*
-                                 * keep a refcount on transport so that it
-                                 * does not get freed because of some error
-                                 * indicated by wc.status, till we are done
-                                 * with usage of peer and thereby that of trans.
-                                 */
-                                if (peer != NULL) {
-                                        rpc_transport_ref (peer->trans);
-                                }
-                        }
-                        pthread_mutex_unlock (&device->qpreg.lock);
-
-                        if (wc.status != IBV_WC_SUCCESS) {
-                                gf_rdma_handle_failed_send_completion (peer, &wc);
-                        } else {
-                                gf_rdma_handle_successful_send_completion (peer,
-                                                                           &wc);
-                        }
-
-                        if (post) {
-                                is_request = post->ctx.is_request;
-
-                                ret = gf_rdma_post_unref (post);
-                                if ((ret == 0)
-                                    && (wc.status == IBV_WC_SUCCESS)
-                                    && !is_request
-                                    && (post->type == GF_RDMA_SEND_POST)
-                                    && (peer != NULL)) {
-                                        /* An GF_RDMA_RECV_POST can end up in
-                                         * gf_rdma_send_completion_proc for
-                                         * rdma-reads, and we do not take
-                                         * quota for getting an GF_RDMA_RECV_POST.
-                                         */
-
-                                        /*
-                                         * if it is request, quota is returned
-                                         * after reply has come.
-                                         */
-                                        quota_ret = gf_rdma_quota_put (peer);
-                                        if (quota_ret < 0) {
-                                                gf_log ("rdma", GF_LOG_DEBUG,
-                                                        "failed to send "
-                                                        "message");
-                                        }
-                                }
-                        }
-
-                        if (peer) {
-                                rpc_transport_unref (peer->trans);
-                        } else {
-                                gf_log (GF_RDMA_LOG_NAME, GF_LOG_DEBUG,
-                                        "could not lookup peer for qp_num: %d",
-                                        wc.qp_num);
-                        }
+                while ((ret = ibv_poll_cq (event_cq, GF_RDMA_CQ_POLL_BATCH,
+                                           wc)) > 0) {
+                        for (i = 0; i < ret; i++)
+                                gf_rdma_handle_send_completion (device,
+                                                                &wc[i]);
                 }
 
                 if (ret < 0) {
@@ -3712,8 +3766,6 @@ gf_rdma_send_completion_proc (void *data)
                                 device->device_name, ret, errno);
                         continue;
                 }
-
-                ibv_ack_cq_events (event_cq, 1);
         }
 
         return NULL;
@@ -3736,6 +3788,7 @@ gf_rdma_options_init (rpc_transport_t *this)
         options->recv_size = GLUSTERFS_RDMA_INLINE_THRESHOLD;/*this->ctx->page_size * 4;  512 KB*/
         options->send_count = 4096;
         options->recv_count = 4096;
+        options->max_inline_data = GF_RDMA_MAX_INLINE_DATA;
 	options->attr_timeout = GF_RDMA_TIMEOUT;
 	options->attr_retry_cnt = GF_RDMA_RETRY_CNT;
 	options->attr_rnr_retry = GF_RDMA_RNR_RETRY;
@@ -3750,6 +3803,10 @@ gf_rdma_options_init (rpc_transport_t *this)
         if (temp)
 		options->recv_count = data_to_int32 (temp);
 
+        temp = dict_get (this->options, "transport.rdma.max-inline-data");
+        if (temp)
+                options->max_inline_data = data_to_int32 (temp);
+
 	temp = dict_get (this->options, "transport.rdma.attr-timeout");
 
 	if (temp)
@@ -5048,6 +5105,14 @@ struct volume_options options[] = {
                     "rdma-work-request-recv-count"},
           .type  = GF_OPTION_TYPE_INT,
         },
+        { .key   = {"transport.rdma.max-inline-data",
+                    "rdma-max-inline-data"},
+          .type  = GF_OPTION_TYPE_INT,
+          .min   = 0,
+          .max   = 1024,
+          .description = "messages up to this size are sent inline in the "
+                         "work request, 0 disables inline sends"
+        },
         { .key   = {"remote-port",
                     "transport.remote-port",
                     "transport.rdma.remote-port"},
@@ -41,6 +41,18 @@
 #define GF_RDMA_VERSION                1
 #define GF_RDMA_POOL_SIZE              512
 
+/* Messages up to this size are copied into the send work request
+ * (IBV_SEND_INLINE) instead of being fetched by the HCA through a DMA read
+ * of the registered post buffer. The device may grant less.
+ */
+#define GF_RDMA_MAX_INLINE_DATA        256
+
+/* Number of work completions reaped by a single ibv_poll_cq () call, and
+ * number of completion events collected before they are acknowledged.
+ */
+#define GF_RDMA_CQ_POLL_BATCH          32
+#define GF_RDMA_CQ_ACK_BATCH           64
+
 /* Additional attributes */
 #define GF_RDMA_TIMEOUT                14
 #define GF_RDMA_RETRY_CNT              7
@@ -144,6 +156,7 @@ struct __gf_rdma_options {
         int32_t  recv_count;
         uint64_t recv_size;
         uint64_t send_size;
+        int32_t  max_inline_data;
 	uint8_t  attr_timeout;
 	uint8_t  attr_retry_cnt;
 	uint8_t  attr_rnr_retry;
@@ -237,6 +250,7 @@ struct __gf_rdma_peer {
         int32_t send_count;
         int32_t recv_size;
         int32_t send_size;
+        int32_t max_inline_data;    /* as granted by the device for qp */
 
         int32_t quota;
         union {
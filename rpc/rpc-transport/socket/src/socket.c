@@ -44,6 +44,12 @@
 #define SSL_PRIVATE_KEY_OPT "transport.socket.ssl-private-key"
 #define SSL_CA_LIST_OPT     "transport.socket.ssl-ca-list"
 #define OWN_THREAD_OPT      "transport.socket.own-thread"
+#define SSL_KTLS_OPT        "transport.socket.ssl-ktls"
+
+/* once the kernel took over a direction of a TLS connection, the socket is
+   read or written like a plain one */
+#define ssl_sends(priv)     ((priv)->use_ssl && !(priv)->ktls_send)
+#define ssl_receives(priv)  ((priv)->use_ssl && !(priv)->ktls_recv)
 
 /* TBD: do automake substitutions etc. (ick) to set these. */
 #if !defined(DEFAULT_CERT_PATH)
@@ -257,6 +263,9 @@ ssl_setup_connection (rpc_transport_t *this, int server)
 	GF_VALIDATE_OR_GOTO(this->name,this->private,done);
 	priv = this->private;
 
+        priv->ktls_send = 0;
+        priv->ktls_recv = 0;
+
 	priv->ssl_ssl = SSL_new(priv->ssl_ctx);
 	if (!priv->ssl_ssl) {
 		gf_log(this->name,GF_LOG_ERROR,"SSL_new failed");
@@ -297,6 +306,19 @@ ssl_setup_connection (rpc_transport_t *this, int server)
 		NID_commonName, peer_CN, sizeof(peer_CN)-1);
 	peer_CN[sizeof(peer_CN)-1] = '\0';
 	gf_log(this->name,GF_LOG_INFO,"peer CN = %s", peer_CN);
+
+        if (priv->ssl_ktls) {
+                priv->ktls_send = BIO_get_ktls_send (
+                                        SSL_get_wbio (priv->ssl_ssl));
+                priv->ktls_recv = BIO_get_ktls_recv (
+                                        SSL_get_rbio (priv->ssl_ssl));
+                gf_log (this->name,
+                        (priv->ktls_send && priv->ktls_recv) ?
+                        GF_LOG_INFO : GF_LOG_WARNING,
+                        "kernel TLS for sending %s, for receiving %s",
+                        priv->ktls_send ? "on" : "off",
+                        priv->ktls_recv ? "on" : "off");
+        }
 	return 0;
 
 	/* Error paths. */
@@ -318,6 +340,8 @@ ssl_teardown_connection (socket_private_t *priv)
         SSL_clear(priv->ssl_ssl);
         SSL_free(priv->ssl_ssl);
         priv->ssl_ssl = NULL;
+        priv->ktls_send = 0;
+        priv->ktls_recv = 0;
 }
 
 
@@ -331,7 +355,7 @@ __socket_ssl_readv (rpc_transport_t *this, struct iovec *opvector, int opcount)
 	priv = this->private;
 	sock = priv->sock;
 
-	if (priv->use_ssl) {
+	if (ssl_receives (priv)) {
 		ret = ssl_read_one (this, opvector->iov_base, opvector->iov_len);
 	} else {
 		ret = readv (sock, opvector, opcount);
@@ -425,6 +449,68 @@ out:
 }
 
 
+/* Serves reads from priv->rbuf, refilling it with one large read when
+   it is empty. Reads at least as large as the buffer bypass it when it
+   is empty, so that bulk payloads still go straight into their iobufs.
+   While the records carry payloads (writes to a server, read replies to
+   a client) a refill only covers about a header, otherwise it would pull
+   the payload into rbuf and have it copied out again. */
+int
+__socket_buffered_read (rpc_transport_t *this, struct iovec *opvector,
+                        int opcount)
+{
+	socket_private_t   *priv = NULL;
+	size_t              req_len = 0;
+	size_t              fill_len = 0;
+	int                 ret = -1;
+
+	priv = this->private;
+	req_len = iov_length (opvector, opcount);
+
+	if (priv->rbuf_start == priv->rbuf_end) {
+                fill_len = priv->rbuf_size;
+                if (priv->incoming.vectored)
+                        fill_len = min (fill_len, GF_SOCKET_HDR_READ_SIZE);
+
+                if (req_len >= fill_len) {
+                        ret = __socket_ssl_readv (this, opvector, opcount);
+                        goto out;
+                }
+
+                if (!priv->rbuf) {
+                        priv->rbuf = GF_MALLOC (priv->rbuf_size,
+                                                gf_common_mt_char);
+                        if (!priv->rbuf) {
+                                ret = __socket_ssl_readv (this, opvector,
+                                                          opcount);
+                                goto out;
+                        }
+                }
+
+                ret = __socket_ssl_read (this, priv->rbuf, fill_len);
+                if (ret <= 0)
+                        goto out;
+
+                priv->rbuf_start = 0;
+                priv->rbuf_end = ret;
+	}
+
+        ret = iov_load (opvector, opcount, &priv->rbuf[priv->rbuf_start],
+                        min (req_len, (priv->rbuf_end - priv->rbuf_start)));
+        priv->rbuf_start += ret;
+out:
+	return ret;
+}
+
+
+/* to be called with priv->lock held */
+static int
+__socket_has_buffered_input (socket_private_t *priv)
+{
+        return (priv->connected == 1 && priv->rbuf_start < priv->rbuf_end);
+}
+
+
 /*
  * return value:
  *   0 = success (completed)
@@ -466,7 +552,8 @@ __socket_rwv (rpc_transport_t *this, struct iovec *vector, int count,
                         continue;
                 }
                 if (write) {
-			if (priv->use_ssl) {
+                        this->total_write_calls++;
+			if (ssl_sends (priv)) {
 				ret = ssl_write_one(this,
 					opvector->iov_base, opvector->iov_len);
 			}
@@ -480,7 +567,12 @@ __socket_rwv (rpc_transport_t *this, struct iovec *vector, int count,
                         }
                         this->total_bytes_write += ret;
                 } else {
-			ret = __socket_cached_read (this, opvector, opcount);
+                        if (priv->rbuf_size)
+                                ret = __socket_buffered_read (this, opvector,
+                                                              opcount);
+                        else
+                                ret = __socket_cached_read (this, opvector,
+                                                            opcount);
 
 			if (ret == 0) {
 				gf_log(this->name,GF_LOG_DEBUG,"EOF on socket");
@@ -837,6 +929,7 @@ __socket_reset (rpc_transport_t *this)
         GF_FREE (priv->incoming.request_info);
 
         memset (&priv->incoming, 0, sizeof (priv->incoming));
+        priv->rbuf_start = priv->rbuf_end = 0;
 
         event_unregister (this->ctx->event_pool, priv->sock, priv->idx);
 
@@ -976,12 +1069,35 @@ out:
 }
 
 
+static void
+__socket_ioq_entry_done (rpc_transport_t *this, struct ioq *entry, int direct)
+{
+	socket_private_t *priv = NULL;
+	char              a_byte = 0;
+
+        /* entry was completely written */
+        __socket_ioq_entry_free (entry);
+        this->total_msgs_write++;
+
+        priv = this->private;
+        if (priv->own_thread) {
+                /*
+                 * The pipe should only remain readable if there are
+                 * more entries after this, so drain the byte
+                 * representing this entry.
+                 */
+                if (!direct && read(priv->pipe[0],&a_byte,1) < 1) {
+                        gf_log(this->name,GF_LOG_WARNING,
+                               "read error on pipe");
+                }
+        }
+}
+
+
 int
 __socket_ioq_churn_entry (rpc_transport_t *this, struct ioq *entry, int direct)
 {
         int               ret = -1;
-	socket_private_t *priv = NULL;
-	char              a_byte = 0;
 
         ret = __socket_writev (this, entry->pending_vector,
                                entry->pending_count,
@@ -989,32 +1105,99 @@ __socket_ioq_churn_entry (rpc_transport_t *this, struct ioq *entry, int direct)
                                &entry->pending_count);
 
         if (ret == 0) {
-                /* current entry was completely written */
                 GF_ASSERT (entry->pending_count == 0);
-                __socket_ioq_entry_free (entry);
-		priv = this->private;
-		if (priv->own_thread) {
-			/*
-			 * The pipe should only remain readable if there are
-			 * more entries after this, so drain the byte
-			 * representing this entry.
-			 */
-			if (!direct && read(priv->pipe[0],&a_byte,1) < 1) {
-				gf_log(this->name,GF_LOG_WARNING,
-				       "read error on pipe");
-			}
-		}
+                __socket_ioq_entry_done (this, entry, direct);
         }
 
         return ret;
 }
 
 
+/* Advances the pending vector of @entry past @bytes written ones,
+   returns what is left of @bytes */
+static size_t
+__socket_ioq_entry_consume (struct ioq *entry, size_t bytes)
+{
+        while (entry->pending_count) {
+                if (entry->pending_vector->iov_len > bytes) {
+                        entry->pending_vector->iov_base += bytes;
+                        entry->pending_vector->iov_len -= bytes;
+                        return 0;
+                }
+
+                bytes -= entry->pending_vector->iov_len;
+                entry->pending_vector++;
+                entry->pending_count--;
+        }
+
+        return bytes;
+}
+
+
+/* Writes out as many queued entries as fit in SOCKET_IOQ_MAX_IOVEC
+   vectors with a single writev. Returns like __socket_writev, and sets
+   @more when entries were left out of the batch. */
+static int
+__socket_ioq_churn_batch (rpc_transport_t *this, int *more)
+{
+        socket_private_t *priv = NULL;
+        struct ioq       *entry = NULL;
+        struct ioq       *tmp = NULL;
+        struct iovec      vector[SOCKET_IOQ_MAX_IOVEC];
+        int               count = 0;
+        size_t            bytes = 0;
+        int               ret = -1;
+
+        priv = this->private;
+        *more = 0;
+
+        list_for_each_entry (entry, &priv->ioq, list) {
+                if (count + entry->pending_count > SOCKET_IOQ_MAX_IOVEC) {
+                        *more = 1;
+                        break;
+                }
+
+                memcpy (&vector[count], entry->pending_vector,
+                        entry->pending_count * sizeof (struct iovec));
+                count += entry->pending_count;
+        }
+
+        ret = __socket_rwv (this, vector, count, NULL, NULL, &bytes, 1);
+
+        list_for_each_entry_safe (entry, tmp, &priv->ioq, list) {
+                bytes = __socket_ioq_entry_consume (entry, bytes);
+                if (entry->pending_count)
+                        break;
+
+                __socket_ioq_entry_done (this, entry, 0);
+        }
+
+        return ret;
+}
+
+
+static void
+__socket_cork (rpc_transport_t *this, int on)
+{
+#ifdef TCP_CORK
+        socket_private_t *priv = this->private;
+
+        if (setsockopt (priv->sock, IPPROTO_TCP, TCP_CORK, &on,
+                        sizeof (on)) == -1)
+                gf_log (this->name, GF_LOG_DEBUG,
+                        "could not %scork socket (%s)", on ? "" : "un",
+                        strerror (errno));
+#endif
+}
+
+
 int
 __socket_ioq_churn (rpc_transport_t *this)
 {
         socket_private_t *priv = NULL;
         int               ret = 0;
+        int               more = 0;
+        int               corked = 0;
         struct ioq       *entry = NULL;
 
         GF_VALIDATE_OR_GOTO ("socket", this, out);
@@ -1023,15 +1206,29 @@ __socket_ioq_churn (rpc_transport_t *this)
         priv = this->private;
 
         while (!list_empty (&priv->ioq)) {
-                /* pick next entry */
-                entry = priv->ioq_next;
+                if (ssl_sends (priv)) {
+                        /* pick next entry */
+                        entry = priv->ioq_next;
 
-                ret = __socket_ioq_churn_entry (this, entry, 0);
+                        ret = __socket_ioq_churn_entry (this, entry, 0);
+                } else {
+                        ret = __socket_ioq_churn_batch (this, &more);
+
+                        /* keep the batches of a burst from going out as
+                           partial segments */
+                        if (ret == 0 && more && priv->cork && !corked) {
+                                __socket_cork (this, 1);
+                                corked = 1;
+                        }
+                }
 
                 if (ret != 0)
                         break;
         }
 
+        if (corked && ret != -1)
+                __socket_cork (this, 0);
+
         if (!priv->own_thread && list_empty (&priv->ioq)) {
                 /* all pending writes done, not interested in POLLOUT */
                 priv->idx = event_select_on (this->ctx->event_pool,
@@ -1414,6 +1611,8 @@ __socket_read_request (rpc_transport_t *this)
                                                                  prognum, progver, procnum);
                 }
 
+                in->vectored = (vector_sizer != NULL);
+
                 if (vector_sizer) {
                         ret = __socket_read_vectored_request (this, vector_sizer);
                 } else {
@@ -1804,8 +2003,10 @@ __socket_read_reply (rpc_transport_t *this)
                         in->payload_vector = *request_info->rsp.rsp_payload;
                 }
 
+                in->vectored = 1;
                 ret = __socket_read_vectored_reply (this);
         } else {
+                in->vectored = 0;
                 ret = __socket_read_simple_reply (this);
         }
 out:
@@ -2112,14 +2313,30 @@ socket_event_poll_in (rpc_transport_t *this)
 {
         int                     ret    = -1;
         rpc_transport_pollin_t *pollin = NULL;
+        socket_private_t       *priv   = NULL;
+        int                     more   = 0;
 
-        ret = socket_proto_state_machine (this, &pollin);
+        priv = this->private;
+
+        do {
+                pollin = NULL;
+                ret = socket_proto_state_machine (this, &pollin);
+
+                if (pollin == NULL)
+                        break;
 
-        if (pollin != NULL) {
                 ret = rpc_transport_notify (this, RPC_TRANSPORT_MSG_RECEIVED,
                                             pollin);
                 rpc_transport_pollin_destroy (pollin);
-        }
+
+                /* records already in the receive buffer will not make
+                   the socket poll in again */
+                pthread_mutex_lock (&priv->lock);
+                {
+                        more = __socket_has_buffered_input (priv);
+                }
+                pthread_mutex_unlock (&priv->lock);
+        } while (more && ret >= 0);
 
         return ret;
 }
@@ -2287,6 +2504,43 @@ socket_poller (void *ctx)
                         "asynchronous rpc_transport_notify failed");
         }
 
+        if (priv->ktls_send && priv->ktls_recv) {
+                /*
+                 * The kernel handles the records in both directions now,
+                 * so the connection can be polled like a plain one.  The
+                 * event pool takes over our reference; the pipe bytes of
+                 * queued entries are no longer needed.
+                 */
+                pthread_mutex_lock (&priv->lock);
+                if (priv->ot_state != OT_ALIVE) {
+                        pthread_mutex_unlock (&priv->lock);
+                        goto err;
+                }
+                priv->own_thread = 0;
+                priv->idx = event_register (this->ctx->event_pool,
+                                            priv->sock, socket_event_handler,
+                                            this, 1,
+                                            !list_empty (&priv->ioq));
+                if (priv->idx == -1) {
+                        gf_log (this->name, GF_LOG_WARNING,
+                                "failed to register the socket with event, "
+                                "staying on own thread");
+                        priv->own_thread = 1;
+                }
+                else {
+                        close (priv->pipe[0]);
+                        close (priv->pipe[1]);
+                        priv->ot_state = OT_IDLE;
+                        pthread_cond_broadcast (&priv->ot_event);
+                }
+                pthread_mutex_unlock (&priv->lock);
+
+                if (!priv->own_thread) {
+                        pthread_detach (pthread_self ());
+                        return NULL;
+                }
+        }
+
 	for (;;) {
 		pthread_mutex_lock(&priv->lock);
 		to_write = !list_empty(&priv->ioq);
@@ -2522,6 +2776,9 @@ socket_server_event_handler (int fd, int idx, void *data,
 			new_priv->use_ssl = priv->use_ssl;
 			new_priv->sock = new_sock;
 			new_priv->own_thread = priv->own_thread;
+                        new_priv->ssl_ktls = priv->ssl_ktls;
+                        new_priv->cork = priv->cork;
+                        new_priv->rbuf_size = priv->rbuf_size;
 
                         new_priv->ssl_ctx = priv->ssl_ctx;
 			if (priv->use_ssl && !priv->own_thread) {
@@ -2689,6 +2946,13 @@ socket_connect (rpc_transport_t *this, int port)
                         goto unlock;
                 }
 
+                /*
+                 * A kTLS connection is handed to the event pool only after
+                 * its thread finished the handshake, see socket_poller.
+                 */
+                if (priv->ssl_ktls)
+                        priv->own_thread = _gf_true;
+
                 memcpy (&this->peerinfo.sockaddr, &sock_union.storage,
                         sockaddr_len);
                 this->peerinfo.sockaddr_len = sockaddr_len;
@@ -3230,6 +3494,39 @@ out:
 }
 
 
+/* Takes the socket out of (or back into) the poll set for input. Records
+ * already in the receive buffer are still delivered. A socket with its own
+ * polling thread is not throttled.
+ */
+int32_t
+socket_throttle (rpc_transport_t *this, gf_boolean_t onoff)
+{
+        socket_private_t *priv = NULL;
+        int32_t           ret  = 0;
+
+        GF_VALIDATE_OR_GOTO ("socket", this, out);
+        GF_VALIDATE_OR_GOTO ("socket", this->private, out);
+
+        priv = this->private;
+
+        pthread_mutex_lock (&priv->lock);
+        {
+                if (priv->own_thread || (priv->sock == -1) ||
+                    (priv->connected != 1))
+                        goto unlock;
+
+                priv->idx = event_select_on (this->ctx->event_pool,
+                                             priv->sock, priv->idx,
+                                             (onoff ? 0 : 1), -1);
+        }
+unlock:
+        pthread_mutex_unlock (&priv->lock);
+
+out:
+        return ret;
+}
+
+
 struct rpc_transport_ops tops = {
         .listen             = socket_listen,
         .connect            = socket_connect,
@@ -3240,6 +3537,7 @@ struct rpc_transport_ops tops = {
         .get_peeraddr       = socket_getpeeraddr,
         .get_myname         = socket_getmyname,
         .get_myaddr         = socket_getmyaddr,
+        .throttle           = socket_throttle,
 };
 
 int
@@ -3302,6 +3600,7 @@ socket_init (rpc_transport_t *this)
         socket_private_t *priv = NULL;
         gf_boolean_t      tmp_bool = 0;
         uint64_t          windowsize = GF_DEFAULT_SOCKET_WINDOW_SIZE;
+        uint64_t          read_buf_size = GF_SOCKET_READ_BUF_SIZE;
         char             *optstr = NULL;
         uint32_t          keepalive = 0;
         uint32_t          backlog = 0;
@@ -3327,6 +3626,7 @@ socket_init (rpc_transport_t *this)
         priv->nodelay = 1;
         priv->bio = 0;
         priv->windowsize = GF_DEFAULT_SOCKET_WINDOW_SIZE;
+        priv->rbuf_size = GF_SOCKET_READ_BUF_SIZE;
         INIT_LIST_HEAD (&priv->ioq);
 
         /* All the below section needs 'this->options' to be present */
@@ -3371,6 +3671,30 @@ socket_init (rpc_transport_t *this)
                 }
         }
 
+        optstr = NULL;
+        if (dict_get_str (this->options, "transport.socket.cork",
+                          &optstr) == 0) {
+                if (gf_string2boolean (optstr, &tmp_bool) == -1) {
+                        gf_log (this->name, GF_LOG_ERROR,
+                                "'transport.socket.cork' takes only "
+                                "boolean options, not taking any action");
+                        tmp_bool = 0;
+                }
+                priv->cork = tmp_bool;
+        }
+
+        optstr = NULL;
+        if (dict_get_str (this->options, "transport.socket.read-buf-size",
+                          &optstr) == 0) {
+                if (gf_string2bytesize (optstr, &read_buf_size) != 0) {
+                        gf_log (this->name, GF_LOG_ERROR,
+                                "invalid number format: %s", optstr);
+                        return -1;
+                }
+        }
+
+        priv->rbuf_size = (size_t)read_buf_size;
+
         optstr = NULL;
         if (dict_get_str (this->options, "tcp-window-size",
                           &optstr) == 0) {
@@ -3486,6 +3810,27 @@ socket_init (rpc_transport_t *this)
          */
         priv->use_ssl = priv->ssl_enabled;
 
+        if (dict_get_str (this->options, SSL_KTLS_OPT, &optstr) == 0) {
+                if (gf_string2boolean (optstr, &priv->ssl_ktls) != 0) {
+                        gf_log (this->name, GF_LOG_ERROR,
+                                "invalid value given for ssl-ktls boolean");
+                }
+#ifndef SSL_OP_ENABLE_KTLS
+                if (priv->ssl_ktls) {
+                        gf_log (this->name, GF_LOG_WARNING,
+                                "%s not supported by this OpenSSL (ignored)",
+                                SSL_KTLS_OPT);
+                        priv->ssl_ktls = _gf_false;
+                }
+#endif
+                if (priv->ssl_ktls && !priv->ssl_enabled) {
+                        gf_log (this->name, GF_LOG_WARNING,
+                                "%s specified without %s (ignored)",
+                                SSL_KTLS_OPT, SSL_ENABLED_OPT);
+                        priv->ssl_ktls = _gf_false;
+                }
+        }
+
 	priv->own_thread = priv->use_ssl;
 	if (dict_get_str(this->options,OWN_THREAD_OPT,&optstr) == 0) {
                 if (gf_string2boolean (optstr, &priv->own_thread) != 0) {
@@ -3493,15 +3838,48 @@ socket_init (rpc_transport_t *this)
 				"invalid value given for own-thread boolean");
 		}
 	}
+        /*
+         * The handshake blocks, so a kTLS connection starts on a thread of
+         * its own and moves to the event pool once the kernel took over
+         * both directions.
+         */
+        if (priv->ssl_ktls && !priv->own_thread) {
+                gf_log (this->name, GF_LOG_INFO,
+                        "%s needs own-thread for the handshake",
+                        SSL_KTLS_OPT);
+                priv->own_thread = _gf_true;
+        }
 	gf_log(this->name,GF_LOG_INFO,"using %s polling thread",
 	       priv->own_thread ? "private" : "system");
 
 	if (priv->use_ssl) {
 		SSL_library_init();
 		SSL_load_error_strings();
-		priv->ssl_meth = (SSL_METHOD *)TLSv1_method();
+#ifdef SSL_OP_ENABLE_KTLS
+                if (priv->ssl_ktls)
+                        priv->ssl_meth = (SSL_METHOD *)TLS_method();
+                else
+#endif
+                        priv->ssl_meth = (SSL_METHOD *)TLSv1_method();
 		priv->ssl_ctx = SSL_CTX_new(priv->ssl_meth);
 
+#ifdef SSL_OP_ENABLE_KTLS
+                if (priv->ssl_ktls) {
+                        /*
+                         * TLS 1.2 is what the kernel offloads in both
+                         * directions, and it sends no records after the
+                         * handshake that a plain read() could not take.
+                         */
+                        SSL_CTX_set_min_proto_version (priv->ssl_ctx,
+                                                       TLS1_2_VERSION);
+                        SSL_CTX_set_max_proto_version (priv->ssl_ctx,
+                                                       TLS1_2_VERSION);
+                        SSL_CTX_set_options (priv->ssl_ctx,
+                                             SSL_OP_ENABLE_KTLS |
+                                             SSL_OP_NO_RENEGOTIATION);
+                }
+#endif
+
                 if (SSL_CTX_set_cipher_list(priv->ssl_ctx,
                                             "HIGH:-SSLv2") == 0) {
                         gf_log(this->name,GF_LOG_ERROR,
@@ -3589,6 +3967,7 @@ fini (rpc_transport_t *this)
                         "transport %p destroyed", this);
 
                 pthread_mutex_destroy (&priv->lock);
+                GF_FREE (priv->rbuf);
 		if (priv->ssl_private_key) {
 			GF_FREE(priv->ssl_private_key);
 		}
@@ -3660,6 +4039,21 @@ struct volume_options options[] = {
         { .key   = {"transport.socket.lowlat"},
           .type  = GF_OPTION_TYPE_BOOL
         },
+        { .key   = {"transport.socket.read-buf-size"},
+          .type  = GF_OPTION_TYPE_SIZET,
+          .min   = 0,
+          .max   = GF_SOCKET_READ_BUF_MAX,
+          .default_value = "64KB",
+          .description = "Size of the buffer each connection reads into "
+                         "ahead of the RPC record parser. 0 reads every "
+                         "part of a record separately."
+        },
+        { .key   = {"transport.socket.cork"},
+          .type  = GF_OPTION_TYPE_BOOL,
+          .default_value = "off",
+          .description = "Cork TCP connections while a backlog of replies "
+                         "too large for one writev is flushed."
+        },
         { .key   = {"transport.socket.keepalive"},
           .type  = GF_OPTION_TYPE_BOOL
         },
@@ -3690,5 +4084,11 @@ struct volume_options options[] = {
 	{ .key   = {OWN_THREAD_OPT},
 	  .type  = GF_OPTION_TYPE_BOOL
 	},
+        { .key   = {SSL_KTLS_OPT},
+          .type  = GF_OPTION_TYPE_BOOL,
+          .description = "Use TLS 1.2 and hand the session keys to the "
+                         "kernel after the handshake. Has to be set on both "
+                         "ends."
+        },
         { .key = {NULL} }
 };
@@ -13,6 +13,7 @@
 
 #include <openssl/ssl.h>
 #include <openssl/err.h>
+#include <limits.h>
 
 #ifndef _CONFIG_H
 #define _CONFIG_H
@@ -30,6 +31,13 @@
 #define MAX_IOVEC 16
 #endif /* MAX_IOVEC */
 
+/* most vectors gathered from the ioq into a single writev */
+#if defined(IOV_MAX) && (IOV_MAX < 1024)
+#define SOCKET_IOQ_MAX_IOVEC IOV_MAX
+#else
+#define SOCKET_IOQ_MAX_IOVEC 1024
+#endif
+
 #define GF_DEFAULT_SOCKET_LISTEN_PORT  GF_DEFAULT_BASE_PORT
 
 #define RPC_MAX_FRAGMENT_SIZE 0x7fffffff
@@ -160,6 +168,13 @@ struct gf_sock_incoming_frag {
 
 #define GF_SOCKET_RA_MAX 1024
 
+/* default size of the per connection receive buffer */
+#define GF_SOCKET_READ_BUF_SIZE (64 * GF_UNIT_KB)
+#define GF_SOCKET_READ_BUF_MAX  (1 * GF_UNIT_MB)
+/* refill size while records carry bulk payloads: enough for the rpc and
+   program headers of a write or a read reply, not much of the payload */
+#define GF_SOCKET_HDR_READ_SIZE 512
+
 struct gf_sock_incoming {
         sp_rpcrecord_state_t  record_state;
         struct gf_sock_incoming_frag frag;
@@ -175,6 +190,8 @@ struct gf_sock_incoming {
         int                  pending_count;
         uint32_t             fraghdr;
         char                 complete_record;
+        char                 vectored;  /* this or the last record has a
+                                           payload */
         msg_type_t           msg_type;
         size_t               total_bytes_read;
 
@@ -206,10 +223,17 @@ typedef struct {
                 };
         };
         struct gf_sock_incoming incoming;
+        /* input read off the socket ahead of the state machine, so
+           that one read can carry several small records */
+        char                  *rbuf;
+        size_t                 rbuf_size;
+        size_t                 rbuf_start;
+        size_t                 rbuf_end;
         pthread_mutex_t        lock;
         int                    windowsize;
         char                   lowlat;
         char                   nodelay;
+        char                   cork;
         int                    keepalive;
         int                    keepaliveidle;
         int                    keepaliveintvl;
@@ -225,6 +249,9 @@ typedef struct {
 	char                  *ssl_own_cert;
 	char                  *ssl_private_key;
 	char                  *ssl_ca_list;
+        gf_boolean_t           ssl_ktls;  /* let the kernel do the crypto */
+        char                   ktls_send; /* the kernel encrypts our writes */
+        char                   ktls_recv; /* the kernel decrypts our reads */
 	pthread_t              thread;
 	int                    pipe[2];
 	gf_boolean_t           own_thread;
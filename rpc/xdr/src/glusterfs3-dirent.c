@@ -0,0 +1,501 @@
+/*
+  Copyright (c) 2007-2012 Red Hat, Inc. <http://www.redhat.com>
+  This file is part of GlusterFS.
+
+  This file is licensed to you under your choice of the GNU Lesser
+  General Public License, version 3 or any later version (LGPLv3 or
+  later), or the GNU General Public License, version 2 (GPLv2), in all
+  cases as published by the Free Software Foundation.
+*/
+
+#ifndef _CONFIG_H
+#define _CONFIG_H
+#include "config.h"
+#endif
+
+#include "glusterfs.h"
+#include "dict.h"
+#include "common-utils.h"
+#include "logging.h"
+#include "glusterfs3-dirent.h"
+
+/*
+ * Layout of gfs3_readdirp2_rsp.entries. Numbers are unsigned LEB128
+ * varints.
+ *
+ *   key table:  <nkeys> { key '\0' } * nkeys
+ *   entries:    { <d_ino> <d_off> <d_len> <d_type>
+ *                 <name length> name
+ *                 <field mask> { field } per bit set in the mask
+ *                 <pairs + 1, 0 when the entry has no dict>
+ *                 { <key index> <value length> value } * pairs } * count
+ *
+ * The stat of an entry is sent as the difference to the one of the entry
+ * before it (all zeroes for the first one). Bit 0 of the mask stands for the
+ * 16 bytes of the gfid, bit n for the n-th of the remaining gf_iatt fields,
+ * which goes as the zigzag encoded delta to its previous value. Fields that
+ * did not change are left out.
+ *
+ * Dict keys are sent once per reply in the key table. On the receiving end
+ * names are copied into the gf_dirent_t, but keys and values of the dicts
+ * keep pointing into the reply buffer.
+ */
+
+#define GF_DIRENT_STAT_FIELDS 16
+
+struct gf_dirent_packer {
+        char    *buf;   /* NULL while only measuring */
+        size_t   off;
+        size_t   len;
+        char   **keys;
+        uint32_t nkeys;
+        uint32_t keys_size;
+        int      error;
+};
+
+
+static void
+gf_stat_to_fields (struct gf_iatt *stat, uint64_t *fields)
+{
+        fields[0]  = stat->ia_ino;
+        fields[1]  = stat->ia_dev;
+        fields[2]  = stat->mode;
+        fields[3]  = stat->ia_nlink;
+        fields[4]  = stat->ia_uid;
+        fields[5]  = stat->ia_gid;
+        fields[6]  = stat->ia_rdev;
+        fields[7]  = stat->ia_size;
+        fields[8]  = stat->ia_blksize;
+        fields[9]  = stat->ia_blocks;
+        fields[10] = stat->ia_atime;
+        fields[11] = stat->ia_atime_nsec;
+        fields[12] = stat->ia_mtime;
+        fields[13] = stat->ia_mtime_nsec;
+        fields[14] = stat->ia_ctime;
+        fields[15] = stat->ia_ctime_nsec;
+}
+
+
+static void
+gf_stat_from_fields (struct gf_iatt *stat, uint64_t *fields)
+{
+        stat->ia_ino        = fields[0];
+        stat->ia_dev        = fields[1];
+        stat->mode          = fields[2];
+        stat->ia_nlink      = fields[3];
+        stat->ia_uid        = fields[4];
+        stat->ia_gid        = fields[5];
+        stat->ia_rdev       = fields[6];
+        stat->ia_size       = fields[7];
+        stat->ia_blksize    = fields[8];
+        stat->ia_blocks     = fields[9];
+        stat->ia_atime      = fields[10];
+        stat->ia_atime_nsec = fields[11];
+        stat->ia_mtime      = fields[12];
+        stat->ia_mtime_nsec = fields[13];
+        stat->ia_ctime      = fields[14];
+        stat->ia_ctime_nsec = fields[15];
+}
+
+
+static void
+pack_bytes (struct gf_dirent_packer *p, const void *bytes, size_t len)
+{
+        if (p->buf) {
+                /* the caller notices the overrun through p->off */
+                if ((p->off > p->len) || (len > p->len - p->off)) {
+                        p->off = p->len + 1;
+                        return;
+                }
+                memcpy (p->buf + p->off, bytes, len);
+        }
+        p->off += len;
+}
+
+
+static void
+pack_uint (struct gf_dirent_packer *p, uint64_t val)
+{
+        unsigned char byte = 0;
+
+        do {
+                byte = val & 0x7f;
+                val >>= 7;
+                if (val)
+                        byte |= 0x80;
+                pack_bytes (p, &byte, 1);
+        } while (val);
+}
+
+
+static int
+unpack_uint (struct gf_dirent_packer *p, uint64_t *val)
+{
+        unsigned char byte  = 0;
+        int           shift = 0;
+
+        *val = 0;
+        do {
+                if ((p->off >= p->len) || (shift > 63))
+                        return -1;
+                byte = p->buf[p->off++];
+                *val |= ((uint64_t) (byte & 0x7f)) << shift;
+                shift += 7;
+        } while (byte & 0x80);
+
+        return 0;
+}
+
+
+/* room for @len more bytes, without wrapping around */
+static int
+unpack_check (struct gf_dirent_packer *p, uint64_t len)
+{
+        return (len > (p->len - p->off)) ? -1 : 0;
+}
+
+
+static int
+pack_key_index (struct gf_dirent_packer *p, char *key, uint32_t *index)
+{
+        char     **keys = NULL;
+        uint32_t   i    = 0;
+
+        for (i = 0; i < p->nkeys; i++) {
+                if (strcmp (p->keys[i], key) == 0)
+                        goto out;
+        }
+
+        if (p->nkeys == p->keys_size) {
+                keys = GF_REALLOC (p->keys,
+                                   (p->keys_size + 16) * sizeof (*keys));
+                if (!keys)
+                        return -1;
+                p->keys = keys;
+                p->keys_size += 16;
+        }
+        p->keys[p->nkeys++] = key;
+out:
+        *index = i;
+        return 0;
+}
+
+
+static int
+pack_pair (dict_t *dict, char *key, data_t *value, void *data)
+{
+        struct gf_dirent_packer *p     = data;
+        uint32_t                 index = 0;
+
+        if (pack_key_index (p, key, &index) < 0) {
+                p->error = ENOMEM;
+                return -1;
+        }
+
+        pack_uint (p, index);
+        pack_uint (p, value->len);
+        pack_bytes (p, value->data, value->len);
+
+        return 0;
+}
+
+
+static int
+pack_entries (struct gf_dirent_packer *p, gf_dirent_t *entries)
+{
+        gf_dirent_t    *entry = NULL;
+        struct gf_iatt  stat  = {{0,},};
+        uint64_t        prev[GF_DIRENT_STAT_FIELDS] = {0,};
+        uint64_t        cur[GF_DIRENT_STAT_FIELDS]  = {0,};
+        unsigned char   gfid[16] = {0,};
+        uint64_t        mask  = 0;
+        uint64_t        delta = 0;
+        size_t          len   = 0;
+        int             i     = 0;
+
+        list_for_each_entry (entry, &entries->list, list) {
+                pack_uint (p, entry->d_ino);
+                pack_uint (p, entry->d_off);
+                pack_uint (p, entry->d_len);
+                pack_uint (p, entry->d_type);
+
+                len = strlen (entry->d_name);
+                pack_uint (p, len);
+                pack_bytes (p, entry->d_name, len);
+
+                gf_stat_from_iatt (&stat, &entry->d_stat);
+                gf_stat_to_fields (&stat, cur);
+
+                mask = 0;
+                if (memcmp (gfid, stat.ia_gfid, 16))
+                        mask |= 1;
+                for (i = 0; i < GF_DIRENT_STAT_FIELDS; i++) {
+                        if (cur[i] != prev[i])
+                                mask |= (1ULL << (i + 1));
+                }
+
+                pack_uint (p, mask);
+                if (mask & 1)
+                        pack_bytes (p, stat.ia_gfid, 16);
+                for (i = 0; i < GF_DIRENT_STAT_FIELDS; i++) {
+                        if (!(mask & (1ULL << (i + 1))))
+                                continue;
+                        /* zigzag, so that small steps back stay short */
+                        delta = cur[i] - prev[i];
+                        pack_uint (p, (delta << 1) ^
+                                      (uint64_t) ((int64_t) delta >> 63));
+                }
+
+                memcpy (gfid, stat.ia_gfid, 16);
+                memcpy (prev, cur, sizeof (prev));
+
+                if (!entry->dict) {
+                        pack_uint (p, 0);
+                        continue;
+                }
+
+                pack_uint (p, (uint64_t) entry->dict->count + 1);
+                if (dict_foreach (entry->dict, pack_pair, p) < 0) {
+                        if (!p->error)
+                                p->error = EINVAL;
+                        return -1;
+                }
+        }
+
+        return 0;
+}
+
+
+/**
+ * gf_dirent_pack - pack @entries into one buffer
+ *
+ * @buf:   set to the buffer, to be freed with GF_FREE ()
+ * @len:   set to its length
+ * @count: set to the number of entries in it
+ *
+ * @return: success: 0
+ *          failure: -1, errno set
+ */
+int
+gf_dirent_pack (gf_dirent_t *entries, char **buf, u_int *len, u_int *count)
+{
+        struct gf_dirent_packer  p     = {0,};
+        gf_dirent_t             *entry = NULL;
+        uint32_t                 i     = 0;
+        int                      ret   = -1;
+
+        GF_VALIDATE_OR_GOTO ("dirent", entries, out);
+        GF_VALIDATE_OR_GOTO ("dirent", buf, out);
+
+        *count = 0;
+        list_for_each_entry (entry, &entries->list, list)
+                (*count)++;
+
+        /* measure the entries, collecting the keys */
+        ret = pack_entries (&p, entries);
+        if (ret < 0)
+                goto out;
+
+        pack_uint (&p, p.nkeys);
+        for (i = 0; i < p.nkeys; i++)
+                pack_bytes (&p, p.keys[i], strlen (p.keys[i]) + 1);
+
+        p.len = p.off;
+        p.buf = GF_MALLOC (p.len, gf_common_mt_char);
+        if (!p.buf) {
+                p.error = ENOMEM;
+                ret = -1;
+                goto out;
+        }
+
+        p.off = 0;
+        pack_uint (&p, p.nkeys);
+        for (i = 0; i < p.nkeys; i++)
+                pack_bytes (&p, p.keys[i], strlen (p.keys[i]) + 1);
+
+        ret = pack_entries (&p, entries);
+        if ((ret < 0) || (p.off != p.len)) {
+                /* a dict changed under us */
+                p.error = EINVAL;
+                ret = -1;
+                GF_FREE (p.buf);
+                goto out;
+        }
+
+        *buf = p.buf;
+        *len = p.len;
+out:
+        GF_FREE (p.keys);
+        if (ret < 0)
+                errno = p.error ? p.error : EINVAL;
+
+        return ret;
+}
+
+
+static int
+unpack_entry (struct gf_dirent_packer *p, data_t *backing, uint64_t *prev,
+              unsigned char *gfid, gf_dirent_t **entryp)
+{
+        gf_dirent_t    *entry = NULL;
+        struct gf_iatt  stat  = {{0,},};
+        uint64_t        d_ino = 0;
+        uint64_t        d_off = 0;
+        uint64_t        d_len = 0;
+        uint64_t        d_type = 0;
+        uint64_t        len   = 0;
+        uint64_t        mask  = 0;
+        uint64_t        delta = 0;
+        uint64_t        pairs = 0;
+        uint64_t        index = 0;
+        char           *name  = NULL;
+        int             i     = 0;
+        int             ret   = -1;
+
+        if (unpack_uint (p, &d_ino) || unpack_uint (p, &d_off) ||
+            unpack_uint (p, &d_len) || unpack_uint (p, &d_type) ||
+            unpack_uint (p, &len) || unpack_check (p, len))
+                goto out;
+        name = p->buf + p->off;
+        p->off += len;
+
+        if (unpack_uint (p, &mask) ||
+            (mask >> (GF_DIRENT_STAT_FIELDS + 1)))
+                goto out;
+        if (mask & 1) {
+                if (unpack_check (p, 16))
+                        goto out;
+                memcpy (gfid, p->buf + p->off, 16);
+                p->off += 16;
+        }
+        for (i = 0; i < GF_DIRENT_STAT_FIELDS; i++) {
+                if (!(mask & (1ULL << (i + 1))))
+                        continue;
+                if (unpack_uint (p, &delta))
+                        goto out;
+                prev[i] += (delta >> 1) ^ -(delta & 1);
+        }
+
+        entry = GF_CALLOC (1, sizeof (*entry) + len + 1,
+                           gf_common_mt_gf_dirent_t);
+        if (!entry)
+                goto out;
+
+        entry->d_ino  = d_ino;
+        entry->d_off  = d_off;
+        entry->d_len  = d_len;
+        entry->d_type = d_type;
+        memcpy (entry->d_name, name, len);
+
+        memcpy (stat.ia_gfid, gfid, 16);
+        gf_stat_from_fields (&stat, prev);
+        gf_stat_to_iatt (&stat, &entry->d_stat);
+
+        if (unpack_uint (p, &pairs))
+                goto out;
+        if (pairs) {
+                entry->dict = dict_new ();
+                if (!entry->dict)
+                        goto out;
+                pairs--;
+        }
+        while (pairs) {
+                pairs--;
+                if (unpack_uint (p, &index) || (index >= p->nkeys) ||
+                    unpack_uint (p, &len) || unpack_check (p, len) ||
+                    (len > INT32_MAX))
+                        goto out;
+                if (dict_add_backed (entry->dict, backing, p->keys[index],
+                                     p->buf + p->off, len) < 0)
+                        goto out;
+                p->off += len;
+        }
+
+        *entryp = entry;
+        entry = NULL;
+        ret = 0;
+out:
+        if (entry) {
+                if (entry->dict)
+                        dict_unref (entry->dict);
+                GF_FREE (entry);
+        }
+
+        return ret;
+}
+
+
+/**
+ * gf_dirent_unpack - add the @count entries packed in @buf to @entries
+ *
+ * @buf: allocated by libc, as XDR does. It belongs to the dicts of the
+ *       entries from here on, and is freed with the last of them (or right
+ *       away), even on failure.
+ *
+ * @return: success: 0
+ *          failure: -1, with the entries up to the bad one added
+ */
+int
+gf_dirent_unpack (char *buf, u_int len, u_int count, gf_dirent_t *entries)
+{
+        struct gf_dirent_packer  p       = {0,};
+        data_t                  *backing = NULL;
+        gf_dirent_t             *entry   = NULL;
+        uint64_t                 prev[GF_DIRENT_STAT_FIELDS] = {0,};
+        unsigned char            gfid[16] = {0,};
+        uint64_t                 nkeys   = 0;
+        char                    *end     = NULL;
+        uint32_t                 i       = 0;
+        int                      ret     = -1;
+
+        if (!buf)
+                goto out;
+
+        backing = get_new_data ();
+        if (!backing) {
+                free (buf);
+                goto out;
+        }
+        backing->data = buf;
+        backing->len = len;
+        backing->is_stdalloc = 1;
+        data_ref (backing);
+
+        p.buf = buf;
+        p.len = len;
+
+        if (unpack_uint (&p, &nkeys) || unpack_check (&p, nkeys))
+                goto out;
+        if (nkeys) {
+                p.keys = GF_CALLOC (nkeys, sizeof (*p.keys),
+                                    gf_common_mt_char);
+                if (!p.keys)
+                        goto out;
+        }
+        for (p.nkeys = 0; p.nkeys < nkeys; p.nkeys++) {
+                end = memchr (p.buf + p.off, '\0', p.len - p.off);
+                if (!end)
+                        goto out;
+                p.keys[p.nkeys] = p.buf + p.off;
+                p.off = end - p.buf + 1;
+        }
+
+        for (i = 0; i < count; i++) {
+                if (unpack_entry (&p, backing, prev, gfid, &entry) < 0)
+                        goto out;
+                list_add_tail (&entry->list, &entries->list);
+        }
+
+        ret = 0;
+out:
+        if (ret < 0)
+                gf_log ("dirent", GF_LOG_WARNING,
+                        "malformed readdirp entries at offset %zu",
+                        p.off);
+
+        GF_FREE (p.keys);
+        if (backing)
+                data_unref (backing);
+
+        return ret;
+}
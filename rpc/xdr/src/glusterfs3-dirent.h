@@ -0,0 +1,25 @@
+/*
+  Copyright (c) 2007-2012 Red Hat, Inc. <http://www.redhat.com>
+  This file is part of GlusterFS.
+
+  This file is licensed to you under your choice of the GNU Lesser
+  General Public License, version 3 or any later version (LGPLv3 or
+  later), or the GNU General Public License, version 2 (GPLv2), in all
+  cases as published by the Free Software Foundation.
+*/
+
+#ifndef _GLUSTERFS3_DIRENT_H
+#define _GLUSTERFS3_DIRENT_H
+
+#include "glusterfs3.h"
+#include "gf-dirent.h"
+
+/* entries of a gfs3_readdirp2_rsp */
+
+int
+gf_dirent_pack (gf_dirent_t *entries, char **buf, u_int *len, u_int *count);
+
+int
+gf_dirent_unpack (char *buf, u_int len, u_int count, gf_dirent_t *entries);
+
+#endif /* !_GLUSTERFS3_DIRENT_H */
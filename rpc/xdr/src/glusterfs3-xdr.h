@@ -1109,6 +1109,153 @@ struct gf_event_notify_rsp {
 };
 typedef struct gf_event_notify_rsp gf_event_notify_rsp;
 
+struct gfs3_compound_link {
+	int procnum;
+	u_int payload_len;
+	struct {
+		u_int msg_len;
+		char *msg_val;
+	} msg;
+};
+typedef struct gfs3_compound_link gfs3_compound_link;
+
+struct gfs3_compound_req {
+	struct {
+		u_int links_len;
+		struct gfs3_compound_link *links_val;
+	} links;
+	struct {
+		u_int xdata_len;
+		char *xdata_val;
+	} xdata;
+};
+typedef struct gfs3_compound_req gfs3_compound_req;
+
+struct gfs3_compound_rsp {
+	int op_ret;
+	int op_errno;
+	struct {
+		u_int links_len;
+		struct gfs3_compound_link *links_val;
+	} links;
+	struct {
+		u_int xdata_len;
+		char *xdata_val;
+	} xdata;
+};
+typedef struct gfs3_compound_rsp gfs3_compound_rsp;
+
+struct gfs3_readdirp2_rsp {
+	int op_ret;
+	int op_errno;
+	u_int count;
+	struct {
+		u_int entries_len;
+		char *entries_val;
+	} entries;
+	struct {
+		u_int xdata_len;
+		char *xdata_val;
+	} xdata;
+};
+typedef struct gfs3_readdirp2_rsp gfs3_readdirp2_rsp;
+
+struct gfs3_fallocate_req {
+	char gfid[16];
+	quad_t fd;
+	u_int flags;
+	u_quad_t offset;
+	u_quad_t size;
+	struct {
+		u_int xdata_len;
+		char *xdata_val;
+	} xdata;
+};
+typedef struct gfs3_fallocate_req gfs3_fallocate_req;
+
+struct gfs3_fallocate_rsp {
+	int op_ret;
+	int op_errno;
+	struct gf_iatt statpre;
+	struct gf_iatt statpost;
+	struct {
+		u_int xdata_len;
+		char *xdata_val;
+	} xdata;
+};
+typedef struct gfs3_fallocate_rsp gfs3_fallocate_rsp;
+
+struct gfs3_discard_req {
+	char gfid[16];
+	quad_t fd;
+	u_quad_t offset;
+	u_quad_t size;
+	struct {
+		u_int xdata_len;
+		char *xdata_val;
+	} xdata;
+};
+typedef struct gfs3_discard_req gfs3_discard_req;
+
+struct gfs3_discard_rsp {
+	int op_ret;
+	int op_errno;
+	struct gf_iatt statpre;
+	struct gf_iatt statpost;
+	struct {
+		u_int xdata_len;
+		char *xdata_val;
+	} xdata;
+};
+typedef struct gfs3_discard_rsp gfs3_discard_rsp;
+
+struct gfs3_zerofill_req {
+	char gfid[16];
+	quad_t fd;
+	u_quad_t offset;
+	u_quad_t size;
+	struct {
+		u_int xdata_len;
+		char *xdata_val;
+	} xdata;
+};
+typedef struct gfs3_zerofill_req gfs3_zerofill_req;
+
+struct gfs3_zerofill_rsp {
+	int op_ret;
+	int op_errno;
+	struct gf_iatt statpre;
+	struct gf_iatt statpost;
+	struct {
+		u_int xdata_len;
+		char *xdata_val;
+	} xdata;
+};
+typedef struct gfs3_zerofill_rsp gfs3_zerofill_rsp;
+
+struct gfs3_seek_req {
+	char gfid[16];
+	quad_t fd;
+	u_quad_t offset;
+	int what;
+	struct {
+		u_int xdata_len;
+		char *xdata_val;
+	} xdata;
+};
+typedef struct gfs3_seek_req gfs3_seek_req;
+
+struct gfs3_seek_rsp {
+	int op_ret;
+	int op_errno;
+	u_quad_t offset;
+	struct {
+		u_int xdata_len;
+		char *xdata_val;
+	} xdata;
+};
+typedef struct gfs3_seek_rsp gfs3_seek_rsp;
+
 /* the xdr functions */
 
 #if defined(__STDC__) || defined(__cplusplus)
@@ -1204,6 +1351,18 @@ extern  bool_t xdr_gf_set_lk_ver_rsp (XDR *, gf_set_lk_ver_rsp*);
 extern  bool_t xdr_gf_set_lk_ver_req (XDR *, gf_set_lk_ver_req*);
 extern  bool_t xdr_gf_event_notify_req (XDR *, gf_event_notify_req*);
 extern  bool_t xdr_gf_event_notify_rsp (XDR *, gf_event_notify_rsp*);
+extern  bool_t xdr_gfs3_compound_link (XDR *, gfs3_compound_link*);
+extern  bool_t xdr_gfs3_compound_req (XDR *, gfs3_compound_req*);
+extern  bool_t xdr_gfs3_compound_rsp (XDR *, gfs3_compound_rsp*);
+extern  bool_t xdr_gfs3_readdirp2_rsp (XDR *, gfs3_readdirp2_rsp*);
+extern  bool_t xdr_gfs3_fallocate_req (XDR *, gfs3_fallocate_req*);
+extern  bool_t xdr_gfs3_fallocate_rsp (XDR *, gfs3_fallocate_rsp*);
+extern  bool_t xdr_gfs3_discard_req (XDR *, gfs3_discard_req*);
+extern  bool_t xdr_gfs3_discard_rsp (XDR *, gfs3_discard_rsp*);
+extern  bool_t xdr_gfs3_zerofill_req (XDR *, gfs3_zerofill_req*);
+extern  bool_t xdr_gfs3_zerofill_rsp (XDR *, gfs3_zerofill_rsp*);
+extern  bool_t xdr_gfs3_seek_req (XDR *, gfs3_seek_req*);
+extern  bool_t xdr_gfs3_seek_rsp (XDR *, gfs3_seek_rsp*);
 
 #else /* K&R C */
 extern bool_t xdr_gf_statfs ();
@@ -1298,6 +1457,18 @@ extern bool_t xdr_gf_set_lk_ver_rsp ();
 extern bool_t xdr_gf_set_lk_ver_req ();
 extern bool_t xdr_gf_event_notify_req ();
 extern bool_t xdr_gf_event_notify_rsp ();
+extern bool_t xdr_gfs3_compound_link ();
+extern bool_t xdr_gfs3_compound_req ();
+extern bool_t xdr_gfs3_compound_rsp ();
+extern bool_t xdr_gfs3_readdirp2_rsp ();
+extern bool_t xdr_gfs3_fallocate_req ();
+extern bool_t xdr_gfs3_fallocate_rsp ();
+extern bool_t xdr_gfs3_discard_req ();
+extern bool_t xdr_gfs3_discard_rsp ();
+extern bool_t xdr_gfs3_zerofill_req ();
+extern bool_t xdr_gfs3_zerofill_rsp ();
+extern bool_t xdr_gfs3_seek_req ();
+extern bool_t xdr_gfs3_seek_rsp ();
 
 #endif /* K&R C */
 
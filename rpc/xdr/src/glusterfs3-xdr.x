@@ -704,3 +704,99 @@ struct gf_event_notify_rsp {
 	int op_errno;
 	opaque dict<>;
 };
+
+/* One fop of a GFS3_OP_COMPOUND call: msg carries the encoded
+   gfs3_<fop>_req (or _rsp) of procnum, and payload_len the number of bytes
+   of write (or read) payload which follow the compound header for it. */
+struct gfs3_compound_link {
+        int          procnum;
+        unsigned int payload_len;
+        opaque       msg<>;
+};
+
+struct gfs3_compound_req {
+        struct gfs3_compound_link links<>;
+        opaque   xdata<>; /* Extra data */
+};
+
+struct gfs3_compound_rsp {
+        int op_ret;
+        int op_errno;
+        struct gfs3_compound_link links<>;
+        opaque   xdata<>; /* Extra data */
+};
+
+/* GFS3_OP_READDIRP2: the entries of a readdirp reply packed into a single
+   buffer instead of a gfs3_dirplist per entry, see glusterfs3-dirent.c for
+   the layout. The request is a gfs3_readdirp_req. */
+struct gfs3_readdirp2_rsp {
+        int          op_ret;
+        int          op_errno;
+        unsigned int count;
+        opaque       entries<>;
+        opaque       xdata<>; /* Extra data */
+};
+
+struct gfs3_fallocate_req {
+        opaque gfid[16];
+        hyper        fd;
+        unsigned int flags; /* 1: keep the file size */
+        unsigned hyper offset;
+        unsigned hyper size;
+        opaque   xdata<>; /* Extra data */
+};
+
+struct gfs3_fallocate_rsp {
+        int    op_ret;
+        int    op_errno;
+        struct gf_iatt statpre;
+        struct gf_iatt statpost;
+        opaque   xdata<>; /* Extra data */
+};
+
+struct gfs3_discard_req {
+        opaque gfid[16];
+        hyper        fd;
+        unsigned hyper offset;
+        unsigned hyper size;
+        opaque   xdata<>; /* Extra data */
+};
+
+struct gfs3_discard_rsp {
+        int    op_ret;
+        int    op_errno;
+        struct gf_iatt statpre;
+        struct gf_iatt statpost;
+        opaque   xdata<>; /* Extra data */
+};
+
+struct gfs3_zerofill_req {
+        opaque gfid[16];
+        hyper        fd;
+        unsigned hyper offset;
+        unsigned hyper size;
+        opaque   xdata<>; /* Extra data */
+};
+
+struct gfs3_zerofill_rsp {
+        int    op_ret;
+        int    op_errno;
+        struct gf_iatt statpre;
+        struct gf_iatt statpost;
+        opaque   xdata<>; /* Extra data */
+};
+
+struct gfs3_seek_req {
+        opaque gfid[16];
+        hyper        fd;
+        unsigned hyper offset;
+        int          what; /* gf_seek_what_t */
+        opaque   xdata<>; /* Extra data */
+};
+
+struct gfs3_seek_rsp {
+        int    op_ret;
+        int    op_errno;
+        unsigned hyper offset;
+        opaque   xdata<>; /* Extra data */
+};
@@ -0,0 +1,166 @@
+#!/bin/bash
+#
+# fallocate, keep-size fallocate, hole punch and zero range on replicate
+# and stripe: the sizes and allocation seen on the mount match the bricks,
+# and only the requested range changes. A discard the bricks cannot do
+# must not leave the file blamed for heal.
+#
+###
+
+. $(dirname $0)/../include.rc
+. $(dirname $0)/../volume.rc
+
+V1=patchy2
+
+cleanup;
+
+REF=$B0/fallocate-ref
+
+function md5 {
+        md5sum < $1 | cut -f1 -d' '
+}
+
+function blocks {
+        stat -c %b $1
+}
+
+# what a brick reports up: allocation past the end of file is not counted
+function brick_blocks {
+        stat -c '%s %b' $1 | \
+                awk '{ m = int (($1 + 511) / 512); print ($2 > m) ? m : $2 }'
+}
+
+# fallocate the same way on the mount and on the local reference copy
+function falloc {
+        local file=$1
+        shift
+        fallocate "$@" $file && fallocate "$@" $REF
+}
+
+function replicate_matches {
+        local b
+
+        EXPECT "$(stat -c %s $REF)" stat -c %s $M0/f
+        EXPECT "$(md5 $REF)" md5 $M0/f
+        for b in 0 1; do
+                EXPECT "$(stat -c %s $M0/f)" stat -c %s $B0/${V0}$b/f
+                EXPECT "$(blocks $M0/f)" brick_blocks $B0/${V0}$b/f
+                EXPECT "$(md5 $REF)" md5 $B0/${V0}$b/f
+        done
+}
+
+# $1 (blocks or brick_blocks) summed over the stripe bricks
+function stripe_blocks {
+        local b
+        local s=0
+
+        for b in $B0/${V1}{0,1}/f; do
+                s=$(( $s + $($1 $b) ))
+        done
+        echo $s
+}
+
+function stripe_matches {
+        EXPECT "$(stat -c %s $REF)" stat -c %s $M1/f
+        EXPECT "$(md5 $REF)" md5 $M1/f
+        EXPECT "$(blocks $M1/f)" stripe_blocks brick_blocks
+}
+
+TEST glusterd
+TEST pidof glusterd
+
+TEST $CLI volume create $V0 replica 2 $H0:$B0/${V0}{0,1}
+TEST $CLI volume create $V1 stripe 2 $H0:$B0/${V1}{0,1}
+TEST $CLI volume start $V0
+TEST $CLI volume start $V1
+
+TEST glusterfs --entry-timeout=0 --attribute-timeout=0 -s $H0 --volfile-id $V0 $M0
+TEST glusterfs --entry-timeout=0 --attribute-timeout=0 -s $H0 --volfile-id $V1 $M1
+
+## replicate
+
+TEST dd if=/dev/urandom of=$REF bs=128k count=8
+TEST cp $REF $M0/f
+replicate_matches
+
+# grow to 2MB
+TEST falloc $M0/f -l 2M
+replicate_matches
+TEST [ $(blocks $M0/f) -ge 4096 ]
+
+# allocate 1MB past the end without growing
+TEST falloc $M0/f -n -o 2M -l 1M
+replicate_matches
+EXPECT "2097152" stat -c %s $M0/f
+TEST [ $(blocks $B0/${V0}0/f) -ge 6144 ]
+TEST [ $(blocks $B0/${V0}1/f) -ge 6144 ]
+
+# punch 256KB out of the data
+BLOCKS=$(blocks $B0/${V0}0/f)
+TEST falloc $M0/f -p -o 256K -l 256K
+replicate_matches
+EXPECT "2097152" stat -c %s $M0/f
+TEST [ $(blocks $B0/${V0}0/f) -lt $BLOCKS ]
+
+# zero 128KB of the data
+TEST falloc $M0/f -z -o 640K -l 128K
+replicate_matches
+EXPECT "2097152" stat -c %s $M0/f
+
+## stripe
+
+TEST dd if=/dev/urandom of=$REF bs=128k count=8
+TEST cp $REF $M1/f
+stripe_matches
+
+TEST falloc $M1/f -l 2M
+stripe_matches
+TEST [ $(blocks $M1/f) -ge 4096 ]
+
+TEST falloc $M1/f -n -o 2M -l 1M
+stripe_matches
+EXPECT "2097152" stat -c %s $M1/f
+TEST [ $(stripe_blocks blocks) -ge 6144 ]
+
+BLOCKS=$(stripe_blocks blocks)
+TEST falloc $M1/f -p -o 256K -l 256K
+stripe_matches
+EXPECT "2097152" stat -c %s $M1/f
+TEST [ $(stripe_blocks blocks) -lt $BLOCKS ]
+
+TEST falloc $M1/f -z -o 640K -l 128K
+stripe_matches
+EXPECT "2097152" stat -c %s $M1/f
+
+## discard unsupported by every brick of the replica
+
+TEST umount $M0
+TEST $CLI volume stop $V0
+TEST $CLI volume set $V0 debug.error-gen posix
+TEST $CLI volume set $V0 debug.error-fops discard
+TEST $CLI volume set $V0 debug.error-number EOPNOTSUPP
+TEST $CLI volume set $V0 debug.error-failure 100
+TEST $CLI volume start $V0
+TEST glusterfs --entry-timeout=0 --attribute-timeout=0 -s $H0 --volfile-id $V0 $M0
+
+MD5=$(md5 $M0/f)
+TEST ! fallocate -p -o 1M -l 128K $M0/f
+EXPECT "$MD5" md5 $M0/f
+
+# neither brick blames the other
+for b in 0 1; do
+        for c in 0 1; do
+                EXPECT "0x000000000000000000000000" afr_get_changelog_xattr \
+                       $B0/${V0}$b/f trusted.afr.$V0-client-$c
+        done
+done
+
+TEST rm -f $M0/f $M1/f $REF
+TEST umount $M0
+TEST umount $M1
+TEST $CLI volume stop $V0
+TEST $CLI volume stop $V1
+TEST $CLI volume delete $V0
+TEST $CLI volume delete $V1
+
+cleanup;
@@ -0,0 +1,73 @@
+#!/bin/bash
+#
+# Migration of a sparse file must seek over its holes instead of reading
+# them: a file with a 64GB hole finishes migrating well within the time it
+# would take to read the zeroes, and the copy stays sparse.
+#
+###
+
+. $(dirname $0)/../include.rc
+. $(dirname $0)/../dht.rc
+
+cleanup;
+
+TEST glusterd
+TEST pidof glusterd
+
+BRICK_COUNT=3
+TEST $CLI volume create $V0 $H0:$B0/${V0}0 $H0:$B0/${V0}1 $H0:$B0/${V0}2
+TEST $CLI volume start $V0
+
+TEST glusterfs --attribute-timeout=0 --entry-timeout=0 --gid-timeout=-1 -s $H0 --volfile-id $V0 $M0;
+
+i=1
+# 1MB of data at the start and at the end of a 64GB file
+TEST dd if=/dev/urandom of=$M0/$i bs=1M count=1
+TEST dd if=/dev/urandom of=$M0/$i bs=1M count=1 seek=65535 conv=notrunc
+
+HEAD1=`dd if=$M0/$i bs=1M count=1 2>/dev/null | md5sum`
+TAIL1=`dd if=$M0/$i bs=1M count=1 skip=65535 2>/dev/null | md5sum`
+SIZE1=`stat -c %s $M0/$i`
+
+# rename till file gets a linkfile
+
+while [ $i -ne 0 ]
+do
+        test=`mv $M0/$i $M0/$(( $i+1 )) 2>/dev/null`
+        if [ $? -ne 0 ]
+        then
+                echo "rename failed"
+                break
+        fi
+        let i++
+        file_has_linkfile $i
+        has_link=$?
+        if [ $has_link -eq 2 ]
+        then
+                break;
+        fi
+done
+
+TEST $CLI volume rebalance $V0 start force
+
+# reading the hole alone would take minutes
+EXPECT_WITHIN 20 "0" rebalance_completed
+
+SIZE2=`stat -c %s $M0/$i`
+TEST [ $SIZE1 -eq $SIZE2 ]
+
+HEAD2=`dd if=$M0/$i bs=1M count=1 2>/dev/null | md5sum`
+TAIL2=`dd if=$M0/$i bs=1M count=1 skip=65535 2>/dev/null | md5sum`
+TEST [ "$HEAD1" == "$HEAD2" ]
+TEST [ "$TAIL1" == "$TAIL2" ]
+
+# the migrated copy holds the 2MB of data, not the hole
+BLOCKS=`stat -c %b $B0/${V0}{0,1,2}/$i 2>/dev/null | awk '{ s += $1 } END { print s }'`
+TEST [ $BLOCKS -lt 16384 ]
+
+TEST rm -f $M0/$i
+TEST umount $M0
+TEST $CLI volume stop $V0
+TEST $CLI volume delete $V0
+
+cleanup;
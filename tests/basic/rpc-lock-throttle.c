@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/* Holds a lock on <filename> while <count> processes queue blocking
+   requests for it, then lets them take it in turn. Fails unless every
+   one of them gets the lock. */
+
+static int
+lock_file (int fd, short type)
+{
+        struct flock lock = {0, };
+
+        lock.l_type = type;
+        lock.l_whence = SEEK_SET;
+
+        return fcntl (fd, F_SETLKW, &lock);
+}
+
+static int
+run_child (char *filename)
+{
+        int fd = -1;
+
+        fd = open (filename, O_RDWR);
+        if (fd < 0) {
+                fprintf (stderr, "open failed (%s)\n", strerror (errno));
+                return 1;
+        }
+
+        if (lock_file (fd, F_WRLCK) < 0) {
+                fprintf (stderr, "lock failed (%s)\n", strerror (errno));
+                return 1;
+        }
+
+        usleep (1000);
+
+        if (lock_file (fd, F_UNLCK) < 0) {
+                fprintf (stderr, "unlock failed (%s)\n", strerror (errno));
+                return 1;
+        }
+
+        close (fd);
+        return 0;
+}
+
+int
+main (int argc, char *argv[])
+{
+        char  *filename = NULL;
+        int    count = 0;
+        int    fd = -1;
+        int    i = 0;
+        int    status = 0;
+        int    failed = 0;
+        pid_t  pid = 0;
+
+        if (argc != 3) {
+                fprintf (stderr, "Usage: %s <filename> <count>\n", argv[0]);
+                return 1;
+        }
+
+        filename = argv[1];
+        count = atoi (argv[2]);
+
+        fd = open (filename, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+                fprintf (stderr, "open (%s) failed (%s)\n", filename,
+                         strerror (errno));
+                return 1;
+        }
+
+        if (lock_file (fd, F_WRLCK) < 0) {
+                fprintf (stderr, "lock failed (%s)\n", strerror (errno));
+                return 1;
+        }
+
+        for (i = 0; i < count; i++) {
+                pid = fork ();
+                if (pid < 0) {
+                        fprintf (stderr, "fork failed (%s)\n",
+                                 strerror (errno));
+                        return 1;
+                }
+                if (pid == 0)
+                        exit (run_child (filename));
+        }
+
+        /* let all of them block on the brick */
+        sleep (2);
+
+        if (lock_file (fd, F_UNLCK) < 0) {
+                fprintf (stderr, "unlock failed (%s)\n", strerror (errno));
+                failed++;
+        }
+
+        for (i = 0; i < count; i++) {
+                if (wait (&status) < 0 || !WIFEXITED (status) ||
+                    WEXITSTATUS (status))
+                        failed++;
+        }
+
+        close (fd);
+
+        return failed ? 1 : 0;
+}
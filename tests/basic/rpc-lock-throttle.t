@@ -0,0 +1,37 @@
+#!/bin/bash
+#
+# Blocked lock requests must not count against outstanding-rpc-limit:
+# with more of them queued than the limit, the brick still has to read
+# the unlocks that let them through, and the pings.
+#
+###
+
+. $(dirname $0)/../include.rc
+
+cleanup;
+
+TEST glusterd
+TEST pidof glusterd
+
+TEST $CLI volume create $V0 $H0:$B0/${V0}0
+TEST $CLI volume set $V0 server.outstanding-rpc-limit 64
+TEST $CLI volume start $V0
+
+TEST glusterfs --entry-timeout=0 --attribute-timeout=0 -s $H0 --volfile-id $V0 $M0
+
+build_tester $(dirname $0)/rpc-lock-throttle.c
+
+# twice the limit of processes contending for one lock
+TEST timeout 120 $(dirname $0)/rpc-lock-throttle $M0/lockfile 128
+
+# the connection is still served
+TEST touch $M0/after
+TEST stat $M0/after
+
+TEST rm -f $M0/lockfile $M0/after
+TEST rm -f $(dirname $0)/rpc-lock-throttle
+TEST umount $M0
+TEST $CLI volume stop $V0
+TEST $CLI volume delete $V0
+
+cleanup;
@@ -827,6 +827,7 @@ void
 afr_local_transaction_cleanup (afr_local_t *local, xlator_t *this)
 {
         afr_private_t * priv = NULL;
+        int             i    = 0;
 
         priv = this->private;
 
@@ -843,6 +844,13 @@ afr_local_transaction_cleanup (afr_local_t *local, xlator_t *this)
         afr_entry_lockee_cleanup (&local->internal_lock);
 
         GF_FREE (local->transaction.pre_op);
+        if (local->transaction.pre_op_xattr) {
+                for (i = 0; i < priv->child_count; i++) {
+                        if (local->transaction.pre_op_xattr[i])
+                                dict_unref (local->transaction.pre_op_xattr[i]);
+                }
+                GF_FREE (local->transaction.pre_op_xattr);
+        }
         GF_FREE (local->transaction.eager_lock);
 
         GF_FREE (local->transaction.basename);
@@ -4079,6 +4087,12 @@ afr_transaction_local_init (afr_local_t *local, xlator_t *this)
         if (!local->transaction.pre_op)
                 goto out;
 
+        local->transaction.pre_op_xattr =
+                GF_CALLOC (sizeof (*local->transaction.pre_op_xattr),
+                           priv->child_count, gf_afr_mt_dict_t);
+        if (!local->transaction.pre_op_xattr)
+                goto out;
+
         local->pending = afr_matrix_create (priv->child_count,
                                             AFR_NUM_CHANGE_LOGS);
         if (!local->pending)
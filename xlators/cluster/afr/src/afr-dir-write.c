@@ -378,11 +378,41 @@ unlock:
 }
 
 
+static int
+afr_create_compound_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                         int32_t op_ret, int32_t op_errno,
+                         compound_args_t *args, dict_t *xdata)
+{
+        call_stub_t *reply = NULL;
+
+        reply = afr_changelog_pre_op_compound_cbk (frame, this,
+                                                   (long) cookie, op_ret,
+                                                   op_errno, args, &op_errno);
+        if (reply)
+                afr_create_wind_cbk (frame, cookie, this,
+                                     reply->args_cbk.op_ret,
+                                     reply->args_cbk.op_errno,
+                                     reply->args_cbk.fd,
+                                     reply->args_cbk.inode,
+                                     &reply->args_cbk.stat,
+                                     &reply->args_cbk.preparent,
+                                     &reply->args_cbk.postparent,
+                                     reply->args_cbk.xdata);
+        else
+                afr_create_wind_cbk (frame, cookie, this, -1, op_errno,
+                                     NULL, NULL, NULL, NULL, NULL, NULL);
+
+        compound_args_destroy (args);
+        return 0;
+}
+
+
 int
 afr_create_wind (call_frame_t *frame, xlator_t *this)
 {
         afr_local_t *local = NULL;
         afr_private_t *priv = NULL;
+        call_stub_t *stub = NULL;
         int call_count = -1;
         int i = 0;
 
@@ -400,7 +430,19 @@ afr_create_wind (call_frame_t *frame, xlator_t *this)
         local->call_count = call_count;
 
         for (i = 0; i < priv->child_count; i++) {
-                if (local->transaction.pre_op[i]) {
+                if (local->transaction.pre_op_xattr[i]) {
+                        stub = fop_create_stub (frame, NULL, &local->loc,
+                                                local->cont.create.flags,
+                                                local->cont.create.mode,
+                                                local->umask,
+                                                local->cont.create.fd,
+                                                local->xdata_req);
+                        afr_changelog_pre_op_compound_wind (frame, this, i,
+                                                            stub,
+                                                            afr_create_compound_cbk);
+                        if (!--call_count)
+                                break;
+                } else if (local->transaction.pre_op[i]) {
                         STACK_WIND_COOKIE (frame, afr_create_wind_cbk,
                                            (void *) (long) i,
                                            priv->children[i],
@@ -489,6 +531,8 @@ afr_create (call_frame_t *frame, xlator_t *this,
         local->transaction.done   = afr_create_done;
         local->transaction.unwind = afr_create_unwind;
 
+        local->transaction.compound_pre_op = priv->use_compound_fops;
+
         ret = afr_build_parent_loc (&local->transaction.parent_loc, loc,
                                     &op_errno);
         if (ret)
@@ -40,6 +40,19 @@ int32_t
 afr_ftruncate (call_frame_t *frame, xlator_t *this,
 	       fd_t *fd, off_t offset, dict_t *xdata);
 
+int32_t
+afr_fallocate (call_frame_t *frame, xlator_t *this,
+               fd_t *fd, int32_t keep_size, off_t offset, size_t len,
+               dict_t *xdata);
+
+int32_t
+afr_discard (call_frame_t *frame, xlator_t *this,
+             fd_t *fd, off_t offset, size_t len, dict_t *xdata);
+
+int32_t
+afr_zerofill (call_frame_t *frame, xlator_t *this,
+              fd_t *fd, off_t offset, off_t len, dict_t *xdata);
+
 int32_t
 afr_utimens (call_frame_t *frame, xlator_t *this,
 	     loc_t *loc, struct timespec tv[2], dict_t *xdata);
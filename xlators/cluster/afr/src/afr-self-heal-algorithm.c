@@ -715,6 +715,62 @@ sh_diff_checksum (call_frame_t *loop_frame, xlator_t *this)
         return 0;
 }
 
+/* A block that is a hole on the source need not be read: sinks that end
+   before it keep the hole, the others still get it written as zeroes.
+   When no sink needs the block, none needs the rest of the hole either
+   (they all end before it), so the loops move on to the next data. */
+static int
+sh_full_seek_cbk (call_frame_t *loop_frame, void *cookie, xlator_t *this,
+                  int32_t op_ret, int32_t op_errno, off_t offset,
+                  dict_t *xdata)
+{
+        afr_private_t           *priv         = NULL;
+        afr_local_t             *loop_local   = NULL;
+        afr_self_heal_t         *loop_sh      = NULL;
+        call_frame_t            *sh_frame     = NULL;
+        afr_local_t             *sh_local     = NULL;
+        afr_self_heal_t         *sh           = NULL;
+        afr_sh_algo_private_t   *sh_priv      = NULL;
+        off_t                    next         = 0;
+
+        priv       = this->private;
+        loop_local = loop_frame->local;
+        loop_sh    = &loop_local->self_heal;
+        sh_frame   = loop_sh->sh_frame;
+        sh_local   = sh_frame->local;
+        sh         = &sh_local->self_heal;
+        sh_priv    = sh->private;
+
+        if ((op_ret == -1) && (op_errno == ENXIO))
+                next = sh->file_size;
+        else if (op_ret != -1)
+                next = offset - (offset % loop_sh->block_size);
+        else
+                goto read;
+
+        if (next <= loop_sh->offset)
+                goto read;
+
+        sh_prune_writes_needed (sh_frame, loop_frame, priv);
+        if (sh_number_of_writes_needed (loop_sh->write_needed,
+                                        priv->child_count))
+                goto read;
+
+        LOCK (&sh_priv->lock);
+        {
+                if (sh_priv->offset < next)
+                        sh_priv->offset = next;
+        }
+        UNLOCK (&sh_priv->lock);
+
+        sh_loop_return (sh_frame, this, loop_frame, 0, 0);
+        return 0;
+
+read:
+        sh_loop_read (loop_frame, this);
+        return 0;
+}
+
 static int
 sh_full_read_write_to_sinks (call_frame_t *loop_frame, xlator_t *this)
 {
@@ -732,6 +788,17 @@ sh_full_read_write_to_sinks (call_frame_t *loop_frame, xlator_t *this)
                         continue;
                 loop_sh->write_needed[i] = 1;
         }
+
+        if (loop_sh->file_has_holes) {
+                STACK_WIND_COOKIE (loop_frame, sh_full_seek_cbk,
+                                   (void *) (long) loop_sh->source,
+                                   priv->children[loop_sh->source],
+                                   priv->children[loop_sh->source]->fops->seek,
+                                   loop_sh->healing_fd, loop_sh->offset,
+                                   GF_SEEK_DATA, NULL);
+                return 0;
+        }
+
         sh_loop_read (loop_frame, this);
         return 0;
 }
@@ -824,6 +824,168 @@ afr_changelog_pre_op_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
         return 0;
 }
 
+/* Holds back the pre-op of child @child_index, to be sent in the same
+ * compound call as the fop (see afr_changelog_pre_op_compound_wind ()).
+ * The pre-op is taken as done until the compound call says otherwise.
+ *
+ * @xattr only points into local->pending, which is reset before the fop
+ * is wound, so the pending counts are copied out here.
+ */
+static void
+afr_changelog_pre_op_defer (call_frame_t *frame, xlator_t *this,
+                            int child_index, dict_t *xattr)
+{
+        afr_local_t   *local   = NULL;
+        afr_private_t *priv    = NULL;
+        dict_t        *copy    = NULL;
+        int32_t       *pending = NULL;
+        int            size    = 0;
+        int            ret     = 0;
+        int            i       = 0;
+
+        local = frame->local;
+        priv  = this->private;
+        size  = AFR_NUM_CHANGE_LOGS * sizeof (int32_t);
+
+        copy = dict_new ();
+        if (!copy)
+                goto wind;
+
+        for (i = 0; i < priv->child_count; i++) {
+                pending = memdup (local->pending[i], size);
+                if (!pending)
+                        goto wind;
+                ret = dict_set_bin (copy, priv->pending_key[i], pending, size);
+                if (ret) {
+                        GF_FREE (pending);
+                        goto wind;
+                }
+        }
+
+        local->transaction.pre_op_xattr[child_index] = copy;
+
+        afr_changelog_pre_op_cbk (frame, (void *)(long) child_index, this,
+                                  1, 0, NULL, NULL);
+        return;
+
+wind:
+        if (copy)
+                dict_unref (copy);
+
+        if (local->fd)
+                STACK_WIND_COOKIE (frame, afr_changelog_pre_op_cbk,
+                                   (void *) (long) child_index,
+                                   priv->children[child_index],
+                                   priv->children[child_index]->fops->fxattrop,
+                                   local->fd, GF_XATTROP_ADD_ARRAY, xattr,
+                                   NULL);
+        else
+                STACK_WIND_COOKIE (frame, afr_changelog_pre_op_cbk,
+                                   (void *) (long) child_index,
+                                   priv->children[child_index],
+                                   priv->children[child_index]->fops->xattrop,
+                                   &local->transaction.parent_loc,
+                                   GF_XATTROP_ADD_ARRAY, xattr, NULL);
+}
+
+
+int
+afr_changelog_pre_op_compound_wind (call_frame_t *frame, xlator_t *this,
+                                    int child_index, call_stub_t *fop,
+                                    fop_compound_cbk_t fop_cbk)
+{
+        afr_local_t     *local = NULL;
+        afr_private_t   *priv  = NULL;
+        compound_args_t *args  = NULL;
+        call_stub_t     *stub  = NULL;
+        dict_t          *xattr = NULL;
+
+        local = frame->local;
+        priv  = this->private;
+        xattr = local->transaction.pre_op_xattr[child_index];
+
+        args = compound_args_new ();
+        if (!args)
+                goto err;
+
+        if (local->fd)
+                stub = fop_fxattrop_stub (frame, NULL, local->fd,
+                                          GF_XATTROP_ADD_ARRAY, xattr, NULL);
+        else
+                stub = fop_xattrop_stub (frame, NULL,
+                                         &local->transaction.parent_loc,
+                                         GF_XATTROP_ADD_ARRAY, xattr, NULL);
+        if (!stub || compound_args_add (args, stub))
+                goto err;
+        stub = NULL;
+
+        if (compound_args_add (args, fop))
+                goto err;
+        fop = NULL;
+
+        STACK_WIND_COOKIE (frame, fop_cbk, (void *) (long) child_index,
+                           priv->children[child_index],
+                           priv->children[child_index]->fops->compound,
+                           args, NULL);
+        return 0;
+err:
+        if (stub)
+                call_stub_destroy (stub);
+        if (fop)
+                call_stub_destroy (fop);
+        compound_args_destroy (args);
+
+        fop_cbk (frame, (void *) (long) child_index, this, -1, ENOMEM,
+                 NULL, NULL);
+        return 0;
+}
+
+
+/* Settles the held back pre-op once the compound call returned. Gives the
+ * reply of the fop, or NULL with @fop_errno set if either link failed.
+ */
+call_stub_t *
+afr_changelog_pre_op_compound_cbk (call_frame_t *frame, xlator_t *this,
+                                   int child_index, int32_t op_ret,
+                                   int32_t op_errno, compound_args_t *args,
+                                   int32_t *fop_errno)
+{
+        afr_local_t   *local = NULL;
+        afr_private_t *priv  = NULL;
+
+        local = frame->local;
+        priv  = this->private;
+
+        if ((op_ret == 0) && args)
+                op_ret = compound_link_op_ret (args, 0, &op_errno);
+
+        LOCK (&frame->lock);
+        {
+                if (op_ret < 0)
+                        local->transaction.pre_op[child_index] = 0;
+                else
+                        __mark_pre_op_done_on_fd (frame, this, child_index);
+        }
+        UNLOCK (&frame->lock);
+
+        if (op_ret < 0) {
+                if (!child_went_down (op_ret, op_errno))
+                        gf_log (this->name, GF_LOG_ERROR,
+                                "xattrop failed on child %s: %s",
+                                priv->children[child_index]->name,
+                                strerror (op_errno));
+                *fop_errno = op_errno;
+                return NULL;
+        }
+
+        if (!args->links[1].reply) {
+                *fop_errno = ENOMEM;
+                return NULL;
+        }
+
+        return args->links[1].reply;
+}
+
 int
 afr_changelog_pre_op (call_frame_t *frame, xlator_t *this)
 {
@@ -912,6 +1074,9 @@ afr_changelog_pre_op (call_frame_t *frame, xlator_t *this)
                                 afr_changelog_pre_op_cbk (frame, (void *)(long)i,
                                                           this, 1, 0, xattr[i],
                                                           NULL);
+                        else if (local->transaction.compound_pre_op)
+                                afr_changelog_pre_op_defer (frame, this, i,
+                                                            xattr[i]);
                         else
                                 STACK_WIND_COOKIE (frame,
                                                    afr_changelog_pre_op_cbk,
@@ -1009,6 +1174,9 @@ afr_changelog_pre_op (call_frame_t *frame, xlator_t *this)
                                                    local->fd,
                                                    GF_XATTROP_ADD_ARRAY, xattr[i],
                                                    NULL);
+                        else if (local->transaction.compound_pre_op)
+                                afr_changelog_pre_op_defer (frame, this, i,
+                                                            xattr[i]);
                         else
                                 STACK_WIND_COOKIE (frame,
                                                    afr_changelog_pre_op_cbk,
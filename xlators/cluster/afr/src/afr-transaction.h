@@ -40,4 +40,15 @@ afr_delayed_changelog_wake_up (xlator_t *this, fd_t *fd);
 void
 __mark_all_success (int32_t *pending[], int child_count,
                     afr_transaction_type type);
+
+int
+afr_changelog_pre_op_compound_wind (call_frame_t *frame, xlator_t *this,
+                                    int child_index, call_stub_t *fop,
+                                    fop_compound_cbk_t fop_cbk);
+
+call_stub_t *
+afr_changelog_pre_op_compound_cbk (call_frame_t *frame, xlator_t *this,
+                                   int child_index, int32_t op_ret,
+                                   int32_t op_errno, compound_args_t *args,
+                                   int32_t *fop_errno);
 #endif /* __TRANSACTION_H__ */
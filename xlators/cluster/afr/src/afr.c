@@ -176,6 +176,8 @@ reconfigure (xlator_t *this, dict_t *options)
         }
 
         GF_OPTION_RECONF ("eager-lock", priv->eager_lock, options, bool, out);
+        GF_OPTION_RECONF ("use-compound-fops", priv->use_compound_fops,
+                          options, bool, out);
         GF_OPTION_RECONF ("quorum-type", qtype, options, str, out);
         GF_OPTION_RECONF ("quorum-count", priv->quorum_count, options,
                           uint32, out);
@@ -327,6 +329,8 @@ init (xlator_t *this)
         GF_OPTION_INIT ("strict-readdir", priv->strict_readdir, bool, out);
 
         GF_OPTION_INIT ("eager-lock", priv->eager_lock, bool, out);
+        GF_OPTION_INIT ("use-compound-fops", priv->use_compound_fops, bool,
+                        out);
         GF_OPTION_INIT ("quorum-type", qtype, str, out);
         GF_OPTION_INIT ("quorum-count", priv->quorum_count, uint32, out);
         GF_OPTION_INIT (AFR_SH_READDIR_SIZE_KEY, priv->sh_readdir_size, size,
@@ -488,6 +492,7 @@ struct xlator_fops fops = {
         .access      = afr_access,
         .stat        = afr_stat,
         .fstat       = afr_fstat,
+        .seek        = afr_seek,
         .readlink    = afr_readlink,
         .getxattr    = afr_getxattr,
         .fgetxattr   = afr_fgetxattr,
@@ -497,6 +502,9 @@ struct xlator_fops fops = {
         .writev      = afr_writev,
         .truncate    = afr_truncate,
         .ftruncate   = afr_ftruncate,
+        .fallocate   = afr_fallocate,
+        .discard     = afr_discard,
+        .zerofill    = afr_zerofill,
         .setxattr    = afr_setxattr,
         .fsetxattr   = afr_fsetxattr,
         .setattr     = afr_setattr,
@@ -697,6 +705,15 @@ struct volume_options options[] = {
                          "the last \"optimzed\" transaction."
 
         },
+        { .key = {"use-compound-fops"},
+          .type = GF_OPTION_TYPE_BOOL,
+          .default_value = "off",
+          .description = "If this option is enabled, the changelog pre-op "
+                         "of writes and creates is sent to each brick in "
+                         "the same request as the fop itself, saving a "
+                         "network round trip per transaction. Needs bricks "
+                         "which understand compound fops."
+        },
         { .key = {"self-heal-daemon"},
           .type = GF_OPTION_TYPE_BOOL,
           .default_value = "off",
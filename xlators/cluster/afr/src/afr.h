@@ -160,6 +160,7 @@ typedef struct _afr_private {
         struct list_head saved_fds;   /* list of fds on which locks have succeeded */
         gf_boolean_t      optimistic_change_log;
         gf_boolean_t      eager_lock;
+        gf_boolean_t      use_compound_fops;
 	uint32_t          post_op_delay_secs;
         unsigned int      quorum_count;
 
@@ -510,6 +511,12 @@ typedef struct _afr_local {
                         int last_index;
                 } fstat;
 
+                struct {
+                        int last_index;
+                        off_t offset;
+                        gf_seek_what_t what;
+                } seek;
+
                 struct {
                         size_t size;
                         int last_index;
@@ -579,6 +586,28 @@ typedef struct _afr_local {
                         struct iatt postbuf;
                 } ftruncate;
 
+                struct {
+                        int32_t keep_size;
+                        off_t offset;
+                        size_t len;
+                        struct iatt prebuf;
+                        struct iatt postbuf;
+                } fallocate;
+
+                struct {
+                        off_t offset;
+                        size_t len;
+                        struct iatt prebuf;
+                        struct iatt postbuf;
+                } discard;
+
+                struct {
+                        off_t offset;
+                        off_t len;
+                        struct iatt prebuf;
+                        struct iatt postbuf;
+                } zerofill;
+
                 struct {
                         struct iatt in_buf;
                         int32_t valid;
@@ -682,6 +711,12 @@ typedef struct _afr_local {
                 int32_t         **txn_changelog;//changelog after pre+post ops
                 unsigned char   *pre_op;
 
+                /* set by fops which can carry their pre-op in a compound
+                   call; the pre-op xattrs are then held back here and
+                   sent along with the fop itself */
+                gf_boolean_t      compound_pre_op;
+                dict_t          **pre_op_xattr;
+
                 call_frame_t *main_frame;
 
                 int (*fop) (call_frame_t *frame, xlator_t *this);
@@ -395,6 +395,35 @@ out:
         return ret;
 }
 
+/* Find the data extent of a sparse file at or after 'offset', so holes are
+   skipped rather than read as zeroes. Returns 1 when only holes are left;
+   if the subvolume cannot seek, the rest of the file is one extent. */
+static inline int
+__dht_rebalance_next_data (xlator_t *from, fd_t *src, off_t offset,
+                           uint64_t ia_size, off_t *data_start,
+                           off_t *data_end)
+{
+        int ret = 0;
+
+        *data_start = offset;
+        *data_end   = ia_size;
+
+        ret = syncop_seek (from, src, offset, GF_SEEK_DATA, data_start);
+        if (ret < 0) {
+                if (errno == ENXIO)
+                        return 1;
+                *data_start = offset;
+                return 0;
+        }
+
+        ret = syncop_seek (from, src, *data_start, GF_SEEK_HOLE, data_end);
+        if ((ret < 0) || (*data_end <= *data_start) ||
+            (*data_end > ia_size))
+                *data_end = ia_size;
+
+        return 0;
+}
+
 static inline int
 __dht_rebalance_migrate_data (xlator_t *from, xlator_t *to, fd_t *src, fd_t *dst,
                              uint64_t ia_size, int hole_exists)
@@ -402,6 +431,7 @@ __dht_rebalance_migrate_data (xlator_t *from, xlator_t *to, fd_t *src, fd_t *dst
         int            ret    = 0;
         int            count  = 0;
         off_t          offset = 0;
+        off_t          data_end = 0;
         struct iovec  *vector = NULL;
         struct iobref *iobref = NULL;
         uint64_t       total  = 0;
@@ -409,8 +439,26 @@ __dht_rebalance_migrate_data (xlator_t *from, xlator_t *to, fd_t *src, fd_t *dst
 
         /* if file size is '0', no need to enter this loop */
         while (total < ia_size) {
+                if (hole_exists && (offset >= data_end)) {
+                        /* the destination is already truncated to
+                           ia_size, so skipped ranges stay holes */
+                        ret = __dht_rebalance_next_data (from, src, offset,
+                                                         ia_size, &offset,
+                                                         &data_end);
+                        if (ret) {
+                                ret = 0;
+                                break;
+                        }
+                        total = offset;
+                        if (total >= ia_size)
+                                break;
+                }
+
                 read_size = (((ia_size - total) > DHT_REBALANCE_BLKSIZE) ?
                              DHT_REBALANCE_BLKSIZE : (ia_size - total));
+                if (hole_exists && ((offset + read_size) > data_end))
+                        read_size = data_end - offset;
+
                 ret = syncop_readv (from, src, read_size,
                                     offset, 0, &vector, &count, &iobref);
                 if (!ret || (ret < 0)) {
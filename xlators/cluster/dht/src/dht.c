@@ -65,6 +65,10 @@ struct xlator_fops fops = {
         .fsetxattr   = dht_fsetxattr,
         .truncate    = dht_truncate,
         .ftruncate   = dht_ftruncate,
+        .fallocate   = dht_fallocate,
+        .discard     = dht_discard,
+        .zerofill    = dht_zerofill,
+        .seek        = dht_seek,
         .writev      = dht_writev,
         .xattrop     = dht_xattrop,
         .fxattrop    = dht_fxattrop,
@@ -865,6 +865,10 @@ struct xlator_fops fops = {
         .fstat       = dht_fstat,
         .truncate    = dht_truncate,
         .ftruncate   = dht_ftruncate,
+        .fallocate   = dht_fallocate,
+        .discard     = dht_discard,
+        .zerofill    = dht_zerofill,
+        .seek        = dht_seek,
         .access      = dht_access,
         .readlink    = dht_readlink,
         .setxattr    = dht_setxattr,
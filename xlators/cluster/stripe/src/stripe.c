@@ -3773,6 +3773,375 @@ err:
 }
 
 
+/* fallocate, discard and zerofill are split at stripe boundaries and each
+   piece is sent to the node holding it, the same way writev splits data */
+static int32_t
+stripe_range_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                  glusterfs_fop_t fop, int32_t op_ret, int32_t op_errno,
+                  struct iatt *prebuf, struct iatt *postbuf)
+{
+        int32_t         callcnt = 0;
+        int32_t         unwind = 0;
+        stripe_local_t *local = NULL;
+	stripe_local_t *mlocal = NULL;
+        call_frame_t   *prev = NULL;
+	call_frame_t   *mframe = NULL;
+	struct stripe_replies *reply = NULL;
+	int32_t		i = 0;
+
+        if (!this || !frame || !frame->local || !cookie) {
+                gf_log ("stripe", GF_LOG_DEBUG, "possible NULL deref");
+                goto out;
+        }
+
+        prev  = cookie;
+        local = frame->local;
+	mframe = local->orig_frame;
+	mlocal = mframe->local;
+
+        /* the pieces answer on their own frames, they share the lock of
+           the frame they were split from */
+        LOCK(&mframe->lock);
+        {
+                callcnt = ++mlocal->call_count;
+                unwind = (callcnt == mlocal->wind_count) && mlocal->unwind;
+
+		mlocal->replies[local->node_index].op_ret = op_ret;
+		mlocal->replies[local->node_index].op_errno = op_errno;
+
+                if (op_ret >= 0) {
+                        mlocal->post_buf = *postbuf;
+                        mlocal->pre_buf = *prebuf;
+
+			mlocal->prebuf_blocks  += prebuf->ia_blocks;
+			mlocal->postbuf_blocks += postbuf->ia_blocks;
+
+			correct_file_size(prebuf, mlocal->fctx, prev);
+			correct_file_size(postbuf, mlocal->fctx, prev);
+
+			if (mlocal->prebuf_size < prebuf->ia_size)
+				mlocal->prebuf_size = prebuf->ia_size;
+			if (mlocal->postbuf_size < postbuf->ia_size)
+				mlocal->postbuf_size = postbuf->ia_size;
+                }
+        }
+        UNLOCK (&mframe->lock);
+
+        if (unwind) {
+		mlocal->pre_buf.ia_size = mlocal->prebuf_size;
+		mlocal->pre_buf.ia_blocks = mlocal->prebuf_blocks;
+		mlocal->post_buf.ia_size = mlocal->postbuf_size;
+		mlocal->post_buf.ia_blocks = mlocal->postbuf_blocks;
+
+		/* all or nothing, unlike a short write. op_ret is already -1
+		   when the rest of the pieces could not be sent */
+		for (i = 0, reply = mlocal->replies; i < mlocal->wind_count;
+			i++, reply++) {
+			if (reply->op_ret == -1) {
+				gf_log(this->name, GF_LOG_DEBUG, "reply %d "
+					"returned error %s", i,
+					strerror(reply->op_errno));
+				mlocal->op_ret = -1;
+				mlocal->op_errno = reply->op_errno;
+				break;
+			}
+		}
+
+		GF_FREE(mlocal->replies);
+		mlocal->replies = NULL;
+
+                switch (fop) {
+                case GF_FOP_FALLOCATE:
+                        STRIPE_STACK_UNWIND (fallocate, mframe, mlocal->op_ret,
+                                             mlocal->op_errno, &mlocal->pre_buf,
+                                             &mlocal->post_buf, NULL);
+                        break;
+                case GF_FOP_DISCARD:
+                        STRIPE_STACK_UNWIND (discard, mframe, mlocal->op_ret,
+                                             mlocal->op_errno, &mlocal->pre_buf,
+                                             &mlocal->post_buf, NULL);
+                        break;
+                case GF_FOP_ZEROFILL:
+                        STRIPE_STACK_UNWIND (zerofill, mframe, mlocal->op_ret,
+                                             mlocal->op_errno, &mlocal->pre_buf,
+                                             &mlocal->post_buf, NULL);
+                        break;
+                default:
+                        break;
+                }
+        }
+out:
+	STRIPE_STACK_DESTROY(frame);
+        return 0;
+}
+
+
+int32_t
+stripe_fallocate_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                      int32_t op_ret, int32_t op_errno, struct iatt *prebuf,
+                      struct iatt *postbuf, dict_t *xdata)
+{
+        return stripe_range_cbk (frame, cookie, this, GF_FOP_FALLOCATE,
+                                 op_ret, op_errno, prebuf, postbuf);
+}
+
+
+int32_t
+stripe_discard_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                    int32_t op_ret, int32_t op_errno, struct iatt *prebuf,
+                    struct iatt *postbuf, dict_t *xdata)
+{
+        return stripe_range_cbk (frame, cookie, this, GF_FOP_DISCARD,
+                                 op_ret, op_errno, prebuf, postbuf);
+}
+
+
+int32_t
+stripe_zerofill_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                     int32_t op_ret, int32_t op_errno, struct iatt *prebuf,
+                     struct iatt *postbuf, dict_t *xdata)
+{
+        return stripe_range_cbk (frame, cookie, this, GF_FOP_ZEROFILL,
+                                 op_ret, op_errno, prebuf, postbuf);
+}
+
+
+/* returns 0 once the pieces are wound, or an errno to unwind with */
+static int32_t
+stripe_range_wind (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                   glusterfs_fop_t fop, int32_t keep_size, off_t offset,
+                   off_t len, dict_t *xdata)
+{
+        stripe_local_t   *local = NULL;
+        stripe_fd_ctx_t  *fctx = NULL;
+        int32_t           op_errno = 1;
+        int32_t           idx = 0;
+        off_t             offset_offset = 0;
+        off_t             remaining_size = 0;
+        off_t             fill_size = 0;
+        uint64_t          stripe_size = 0;
+        uint64_t          tmp_fctx = 0;
+	off_t		  dest_offset = 0;
+	off_t		  rounded_start = 0;
+	off_t		  rounded_end = 0;
+	int32_t		  total_chunks = 0;
+	call_frame_t	  *wframe = NULL;
+	stripe_local_t	  *wlocal = NULL;
+        xlator_t         *subvol = NULL;
+
+        inode_ctx_get (fd->inode, this, &tmp_fctx);
+        if (!tmp_fctx) {
+                op_errno = EINVAL;
+                goto err;
+        }
+        fctx = (stripe_fd_ctx_t *)(long)tmp_fctx;
+        stripe_size = fctx->stripe_size;
+
+        STRIPE_VALIDATE_FCTX (fctx, err);
+
+        if (len <= 0) {
+                op_errno = EINVAL;
+                goto err;
+        }
+        remaining_size = len;
+
+        local = mem_get0 (this->local_pool);
+        if (!local) {
+                op_errno = ENOMEM;
+                goto err;
+        }
+        frame->local = local;
+        local->stripe_size = stripe_size;
+	local->fctx = fctx;
+
+        if (!stripe_size) {
+                gf_log (this->name, GF_LOG_DEBUG,
+                        "Wrong stripe size for the file");
+                op_errno = EINVAL;
+                goto err;
+        }
+
+	rounded_start = floor(offset, stripe_size);
+	rounded_end = roof(offset + len, stripe_size);
+	total_chunks = (rounded_end - rounded_start) / stripe_size;
+	local->replies = GF_CALLOC(total_chunks, sizeof(struct stripe_replies),
+				gf_stripe_mt_stripe_replies);
+	if (!local->replies) {
+		op_errno = ENOMEM;
+		goto err;
+	}
+
+	total_chunks = 0;
+        while (1) {
+		wframe = copy_frame(frame);
+		if (!wframe) {
+			op_errno = ENOMEM;
+			goto err;
+		}
+		wlocal = mem_get0(this->local_pool);
+		if (!wlocal) {
+			op_errno = ENOMEM;
+			goto err;
+		}
+		wlocal->orig_frame = frame;
+		wframe->local = wlocal;
+
+                idx = (((offset + offset_offset) /
+                        local->stripe_size) % fctx->stripe_count);
+
+                fill_size = (local->stripe_size -
+                             ((offset + offset_offset) % local->stripe_size));
+                if (fill_size > remaining_size)
+                        fill_size = remaining_size;
+
+                remaining_size -= fill_size;
+
+                LOCK (&frame->lock);
+                {
+                        local->wind_count++;
+                        if (remaining_size == 0)
+                                local->unwind = 1;
+                }
+                UNLOCK (&frame->lock);
+
+		wlocal->node_index = total_chunks;
+		local->replies[total_chunks].requested_size = fill_size;
+
+		dest_offset = offset + offset_offset;
+		if (fctx->stripe_coalesce)
+			dest_offset = coalesced_offset(dest_offset,
+					local->stripe_size, fctx->stripe_count);
+
+                subvol = fctx->xl_array[idx];
+                switch (fop) {
+                case GF_FOP_FALLOCATE:
+                        STACK_WIND (wframe, stripe_fallocate_cbk, subvol,
+                                    subvol->fops->fallocate, fd, keep_size,
+                                    dest_offset, fill_size, xdata);
+                        break;
+                case GF_FOP_DISCARD:
+                        STACK_WIND (wframe, stripe_discard_cbk, subvol,
+                                    subvol->fops->discard, fd, dest_offset,
+                                    fill_size, xdata);
+                        break;
+                case GF_FOP_ZEROFILL:
+                        STACK_WIND (wframe, stripe_zerofill_cbk, subvol,
+                                    subvol->fops->zerofill, fd, dest_offset,
+                                    fill_size, xdata);
+                        break;
+                default:
+                        break;
+                }
+
+                offset_offset += fill_size;
+		total_chunks++;
+                if (remaining_size == 0)
+                        break;
+        }
+
+        return 0;
+err:
+	if (wframe)
+		STRIPE_STACK_DESTROY(wframe);
+
+        if (local && local->wind_count) {
+                /* the pieces sent still point at frame and replies, the
+                   last of them to answer unwinds with the error */
+                LOCK (&frame->lock);
+                {
+                        local->op_ret = -1;
+                        local->op_errno = op_errno;
+                        local->unwind = 1;
+                        if (local->call_count != local->wind_count)
+                                op_errno = 0;
+                }
+                UNLOCK (&frame->lock);
+        }
+
+        if (local && op_errno) {
+                GF_FREE (local->replies);
+                local->replies = NULL;
+        }
+
+        return op_errno;
+}
+
+
+int32_t
+stripe_fallocate (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                  int32_t keep_size, off_t offset, size_t len, dict_t *xdata)
+{
+        int32_t op_errno = EINVAL;
+
+        VALIDATE_OR_GOTO (frame, err);
+        VALIDATE_OR_GOTO (this, err);
+        VALIDATE_OR_GOTO (fd, err);
+        VALIDATE_OR_GOTO (fd->inode, err);
+
+        op_errno = stripe_range_wind (frame, this, fd, GF_FOP_FALLOCATE,
+                                      keep_size, offset, len, xdata);
+        if (!op_errno)
+                return 0;
+err:
+        STRIPE_STACK_UNWIND (fallocate, frame, -1, op_errno, NULL, NULL, NULL);
+        return 0;
+}
+
+
+int32_t
+stripe_discard (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                off_t offset, size_t len, dict_t *xdata)
+{
+        int32_t op_errno = EINVAL;
+
+        VALIDATE_OR_GOTO (frame, err);
+        VALIDATE_OR_GOTO (this, err);
+        VALIDATE_OR_GOTO (fd, err);
+        VALIDATE_OR_GOTO (fd->inode, err);
+
+        op_errno = stripe_range_wind (frame, this, fd, GF_FOP_DISCARD, 0,
+                                      offset, len, xdata);
+        if (!op_errno)
+                return 0;
+err:
+        STRIPE_STACK_UNWIND (discard, frame, -1, op_errno, NULL, NULL, NULL);
+        return 0;
+}
+
+
+int32_t
+stripe_zerofill (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                 off_t offset, off_t len, dict_t *xdata)
+{
+        int32_t op_errno = EINVAL;
+
+        VALIDATE_OR_GOTO (frame, err);
+        VALIDATE_OR_GOTO (this, err);
+        VALIDATE_OR_GOTO (fd, err);
+        VALIDATE_OR_GOTO (fd->inode, err);
+
+        op_errno = stripe_range_wind (frame, this, fd, GF_FOP_ZEROFILL, 0,
+                                      offset, len, xdata);
+        if (!op_errno)
+                return 0;
+err:
+        STRIPE_STACK_UNWIND (zerofill, frame, -1, op_errno, NULL, NULL, NULL);
+        return 0;
+}
+
+
+/* Finding the next hole needs the logical file size, which no single node
+   knows, and every node sees holes where its neighbours hold the data.
+   Callers treat EOPNOTSUPP as "all of the file is data". */
+int32_t
+stripe_seek (call_frame_t *frame, xlator_t *this, fd_t *fd, off_t offset,
+             gf_seek_what_t what, dict_t *xdata)
+{
+        STRIPE_STACK_UNWIND (seek, frame, -1, EOPNOTSUPP, 0, NULL);
+        return 0;
+}
+
+
 int32_t
 stripe_release (xlator_t *this, fd_t *fd)
 {
@@ -5204,6 +5573,10 @@ struct xlator_fops fops = {
         .flush          = stripe_flush,
         .fsync          = stripe_fsync,
         .ftruncate      = stripe_ftruncate,
+        .fallocate      = stripe_fallocate,
+        .discard        = stripe_discard,
+        .zerofill       = stripe_zerofill,
+        .seek           = stripe_seek,
         .fstat          = stripe_fstat,
         .mkdir          = stripe_mkdir,
         .rmdir          = stripe_rmdir,
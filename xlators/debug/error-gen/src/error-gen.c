@@ -174,7 +174,16 @@ sys_error_t error_no_list[] = {
                                                  EROFS,EBADF,EIO}},
         [GF_FOP_GETSPEC]           = { .error_no_count = 4,
                                     .error_no = {EACCES,EBADF,ENAMETOOLONG,
-                                                 EINTR}}
+                                                 EINTR}},
+        [GF_FOP_FALLOCATE]         = { .error_no_count = 6,
+                                    .error_no = {EBADF,EFBIG,EINVAL,EIO,
+                                                 ENOSPC,EOPNOTSUPP}},
+        [GF_FOP_DISCARD]           = { .error_no_count = 5,
+                                    .error_no = {EBADF,EINVAL,EIO,ENOSPC,
+                                                 EOPNOTSUPP}},
+        [GF_FOP_ZEROFILL]          = { .error_no_count = 5,
+                                    .error_no = {EBADF,EINVAL,EIO,ENOSPC,
+                                                 EOPNOTSUPP}}
 };
 
 int
@@ -238,6 +247,8 @@ conv_errno_to_int (char **error_no)
                 return EINTR;
         else if (!strcmp ((*error_no), "EFBIG"))
                 return EFBIG;
+        else if (!strcmp ((*error_no), "EOPNOTSUPP"))
+                return EOPNOTSUPP;
 	else if (!strcmp((*error_no), "GF_ERROR_SHORT_WRITE"))
 		return GF_ERROR_SHORT_WRITE;
         else
@@ -329,6 +340,12 @@ get_fop_int (char **op_no_str)
                 return GF_FOP_FSETATTR;
         else if (!strcmp ((*op_no_str), "getspec"))
                 return GF_FOP_GETSPEC;
+        else if (!strcmp ((*op_no_str), "fallocate"))
+                return GF_FOP_FALLOCATE;
+        else if (!strcmp ((*op_no_str), "discard"))
+                return GF_FOP_DISCARD;
+        else if (!strcmp ((*op_no_str), "zerofill"))
+                return GF_FOP_ZEROFILL;
 	else
                 return -1;
 }
@@ -1954,6 +1971,126 @@ error_gen_readdirp (call_frame_t *frame, xlator_t *this, fd_t *fd, size_t size,
 	return 0;
 }
 
+
+int
+error_gen_fallocate_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                         int32_t op_ret, int32_t op_errno, struct iatt *prebuf,
+                         struct iatt *postbuf, dict_t *xdata)
+{
+	STACK_UNWIND_STRICT (fallocate, frame, op_ret, op_errno, prebuf, postbuf,
+                             xdata);
+        return 0;
+}
+
+
+int
+error_gen_fallocate (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                     int32_t keep_size, off_t offset, size_t len, dict_t *xdata)
+{
+	int              op_errno = 0;
+        eg_t            *egp = NULL;
+        int              enable = 1;
+
+        egp = this->private;
+        enable = egp->enable[GF_FOP_FALLOCATE];
+
+        if (enable)
+                op_errno = error_gen (this, GF_FOP_FALLOCATE);
+
+	if (op_errno) {
+		GF_ERROR(this, "unwind(-1, %s)", strerror (op_errno));
+		STACK_UNWIND_STRICT (fallocate, frame, -1, op_errno, NULL, NULL,
+                                     xdata);
+                return 0;
+	}
+
+	STACK_WIND (frame, error_gen_fallocate_cbk,
+		    FIRST_CHILD(this),
+		    FIRST_CHILD(this)->fops->fallocate,
+		    fd, keep_size, offset, len, xdata);
+        return 0;
+}
+
+
+int
+error_gen_discard_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                       int32_t op_ret, int32_t op_errno, struct iatt *prebuf,
+                       struct iatt *postbuf, dict_t *xdata)
+{
+	STACK_UNWIND_STRICT (discard, frame, op_ret, op_errno, prebuf, postbuf,
+                             xdata);
+        return 0;
+}
+
+
+int
+error_gen_discard (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                   off_t offset, size_t len, dict_t *xdata)
+{
+	int              op_errno = 0;
+        eg_t            *egp = NULL;
+        int              enable = 1;
+
+        egp = this->private;
+        enable = egp->enable[GF_FOP_DISCARD];
+
+        if (enable)
+                op_errno = error_gen (this, GF_FOP_DISCARD);
+
+	if (op_errno) {
+		GF_ERROR(this, "unwind(-1, %s)", strerror (op_errno));
+		STACK_UNWIND_STRICT (discard, frame, -1, op_errno, NULL, NULL,
+                                     xdata);
+                return 0;
+	}
+
+	STACK_WIND (frame, error_gen_discard_cbk,
+		    FIRST_CHILD(this),
+		    FIRST_CHILD(this)->fops->discard,
+		    fd, offset, len, xdata);
+        return 0;
+}
+
+
+int
+error_gen_zerofill_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                        int32_t op_ret, int32_t op_errno, struct iatt *prebuf,
+                        struct iatt *postbuf, dict_t *xdata)
+{
+	STACK_UNWIND_STRICT (zerofill, frame, op_ret, op_errno, prebuf, postbuf,
+                             xdata);
+        return 0;
+}
+
+
+int
+error_gen_zerofill (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                    off_t offset, off_t len, dict_t *xdata)
+{
+	int              op_errno = 0;
+        eg_t            *egp = NULL;
+        int              enable = 1;
+
+        egp = this->private;
+        enable = egp->enable[GF_FOP_ZEROFILL];
+
+        if (enable)
+                op_errno = error_gen (this, GF_FOP_ZEROFILL);
+
+	if (op_errno) {
+		GF_ERROR(this, "unwind(-1, %s)", strerror (op_errno));
+		STACK_UNWIND_STRICT (zerofill, frame, -1, op_errno, NULL, NULL,
+                                     xdata);
+                return 0;
+	}
+
+	STACK_WIND (frame, error_gen_zerofill_cbk,
+		    FIRST_CHILD(this),
+		    FIRST_CHILD(this)->fops->zerofill,
+		    fd, offset, len, xdata);
+        return 0;
+}
+
 static void
 error_gen_set_failure (eg_t *pvt, int percent)
 {
@@ -2202,6 +2339,9 @@ struct xlator_fops fops = {
         .setattr     = error_gen_setattr,
         .fsetattr    = error_gen_fsetattr,
 	.getspec     = error_gen_getspec,
+	.fallocate   = error_gen_fallocate,
+	.discard     = error_gen_discard,
+	.zerofill    = error_gen_zerofill,
 };
 
 struct volume_options options[] = {
@@ -2215,7 +2355,7 @@ struct volume_options options[] = {
                     "EFAULT","ENOMEM","EINVAL","EIO","EEXIST","ENOSPC",
                     "EPERM","EROFS","EBUSY","EISDIR","ENOTEMPTY","EMLINK"
                     "ENODEV","EXDEV","EMFILE","ENFILE","ENOSYS","EINTR",
-                    "EFBIG","EAGAIN","GF_ERROR_SHORT_WRITE"},
+                    "EFBIG","EAGAIN","EOPNOTSUPP","GF_ERROR_SHORT_WRITE"},
           .type = GF_OPTION_TYPE_STR,
         },
 
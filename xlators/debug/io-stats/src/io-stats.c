@@ -2547,6 +2547,7 @@ reconfigure (xlator_t *this, dict_t *options)
         int                 sys_log_level = -1;
         char               *log_str = NULL;
         int                 log_level = -1;
+        uint64_t            log_buf_size = 0;
 
         if (!this || !this->private)
                 goto out;
@@ -2574,6 +2575,9 @@ reconfigure (xlator_t *this, dict_t *options)
                 gf_log_set_loglevel (log_level);
         }
 
+        GF_OPTION_RECONF ("log-buf-size", log_buf_size, options, size, out);
+        gf_log_set_buf_size (log_buf_size);
+
         ret = 0;
 out:
         gf_log (this->name, GF_LOG_DEBUG, "reconfigure returning %d", ret);
@@ -2608,6 +2612,7 @@ init (xlator_t *this)
         int                 sys_log_level = -1;
         char               *log_str = NULL;
         int                 log_level = -1;
+        uint64_t            log_buf_size = 0;
         int                 ret = -1;
 
         if (!this)
@@ -2663,6 +2668,9 @@ init (xlator_t *this)
                 gf_log_set_loglevel (log_level);
         }
 
+        GF_OPTION_INIT ("log-buf-size", log_buf_size, size, out);
+        gf_log_set_buf_size (log_buf_size);
+
         this->private = conf;
         ret = 0;
 out:
@@ -2847,6 +2855,18 @@ struct volume_options options[] = {
                      "CRITICAL", "NONE", "TRACE"}
         },
 
+        { .key  = {"log-buf-size"},
+          .type = GF_OPTION_TYPE_SIZET,
+          .min  = 0,
+          .max  = GF_LOG_BUF_MAX_SIZE,
+          .default_value = "0",
+          .description = "When non-zero, every thread queues its log "
+                         "messages in a buffer of this size which a logger "
+                         "thread writes out, instead of writing them itself. "
+                         "Messages are dropped (and counted) when the buffer "
+                         "is full, repeated messages are counted."
+        },
+
         /* These are synthetic entries to assist validation of CLI's  *
          *  volume set  command                                       */
         { .key = {"client-log-level"},
@@ -2862,6 +2882,22 @@ struct volume_options options[] = {
           .description = "Gluster's syslog log-level",
           .value = { "WARNING", "ERROR", "INFO", "CRITICAL"}
         },
+        { .key = {"client-log-buf-size"},
+          .type = GF_OPTION_TYPE_SIZET,
+          .min  = 0,
+          .max  = GF_LOG_BUF_MAX_SIZE,
+          .default_value = "0",
+          .description = "Size of the per thread log buffer of the clients, "
+                         "0 to log synchronously"
+        },
+        { .key = {"brick-log-buf-size"},
+          .type = GF_OPTION_TYPE_SIZET,
+          .min  = 0,
+          .max  = GF_LOG_BUF_MAX_SIZE,
+          .default_value = "0",
+          .description = "Size of the per thread log buffer of the bricks, "
+                         "0 to log synchronously"
+        },
         { .key = {"brick-log-level"},
           .type = GF_OPTION_TYPE_STR,
           .default_value = "INFO",
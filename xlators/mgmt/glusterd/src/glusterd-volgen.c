@@ -1247,6 +1247,24 @@ loglevel_option_handler (volgen_graph_t *graph,
         return basic_option_handler (graph, &vme2, NULL);
 }
 
+static int
+logbuf_option_handler (volgen_graph_t *graph,
+                       struct volopt_map_entry *vme, void *param)
+{
+        char *role = param;
+        struct volopt_map_entry vme2 = {0,};
+
+        if ( (strcmp (vme->option, "!client-log-buf-size") != 0 &&
+               strcmp (vme->option, "!brick-log-buf-size") != 0)
+            || !strstr (vme->key, role))
+                return 0;
+
+        memcpy (&vme2, vme, sizeof (vme2));
+        vme2.option = "log-buf-size";
+
+        return basic_option_handler (graph, &vme2, NULL);
+}
+
 static int
 server_check_marker_off (volgen_graph_t *graph, struct volopt_map_entry *vme,
                          glusterd_volinfo_t *volinfo)
@@ -1372,6 +1390,9 @@ server_spec_option_handler (volgen_graph_t *graph,
         if (!ret)
                 ret = sys_loglevel_option_handler (graph, vme, "brick");
 
+        if (!ret)
+                ret = logbuf_option_handler (graph, vme, "brick");
+
         return ret;
 }
 
@@ -2438,6 +2459,12 @@ client_graph_builder (volgen_graph_t *graph, glusterd_volinfo_t *volinfo,
         if (ret)
                 gf_log (THIS->name, GF_LOG_WARNING, "changing client syslog "
                         "level failed");
+
+        ret = volgen_graph_set_options_generic (graph, set_dict, "client",
+                                                &logbuf_option_handler);
+        if (ret)
+                gf_log (THIS->name, GF_LOG_WARNING, "changing client log "
+                        "buffer size failed");
 out:
         return ret;
 }
@@ -2784,6 +2811,13 @@ build_shd_graph (volgen_graph_t *graph, dict_t *mod_dict)
                         gf_log (THIS->name, GF_LOG_WARNING, "changing syslog "
                                 "level of self-heal daemon failed");
 
+                ret = volgen_graph_set_options_generic (graph, set_dict,
+                                                        "client",
+                                                 &logbuf_option_handler);
+                if (ret)
+                        gf_log (THIS->name, GF_LOG_WARNING, "changing log "
+                                "buffer size of self-heal daemon failed");
+
                 ret = dict_reset (set_dict);
                 if (ret)
                         goto out;
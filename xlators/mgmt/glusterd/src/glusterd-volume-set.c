@@ -491,6 +491,11 @@ struct volopt_map_entry glusterd_volopt_map[] = {
           .op_version    = 1,
           .client_option = _gf_true
         },
+        { .key           = "cluster.use-compound-fops",
+          .voltype       = "cluster/replicate",
+          .op_version    = 2,
+          .client_option = _gf_true
+        },
         { .key           = "cluster.quorum-type",
           .voltype       = "cluster/replicate",
           .option        = "quorum-type",
@@ -580,6 +585,17 @@ struct volopt_map_entry glusterd_volopt_map[] = {
           .op_version    = 1,
           .client_option = _gf_true
         },
+        { .key         = "diagnostics.brick-log-buf-size",
+          .voltype     = "debug/io-stats",
+          .option      = "!brick-log-buf-size",
+          .op_version  = 2
+        },
+        { .key           = "diagnostics.client-log-buf-size",
+          .voltype       = "debug/io-stats",
+          .option        = "!client-log-buf-size",
+          .op_version    = 2,
+          .client_option = _gf_true
+        },
 
         /* IO-cache xlator options */
         { .key           = "performance.cache-max-file-size",
@@ -729,12 +745,31 @@ struct volopt_map_entry glusterd_volopt_map[] = {
           .op_version    = 2,
           .client_option = _gf_true
         },
+        { .key           = "client.ssl-ktls",
+          .voltype       = "protocol/client",
+          .option        = "transport.socket.ssl-ktls",
+          .type          = NO_DOC,
+          .op_version    = 2,
+          .client_option = _gf_true
+        },
         { .key           = "network.remote-dio",
           .voltype       = "protocol/client",
           .option        = "filter-O_DIRECT",
           .op_version    = 1,
           .client_option = _gf_true
         },
+        { .key           = "client.event-threads",
+          .voltype       = "protocol/client",
+          .option        = "event-threads",
+          .op_version    = 2,
+          .client_option = _gf_true
+        },
+        { .key           = "client.transport-count",
+          .voltype       = "protocol/client",
+          .option        = "transport-count",
+          .op_version    = 2,
+          .client_option = _gf_true
+        },
 
         /* Server xlator options */
         { .key         = "network.tcp-window-size",
@@ -762,6 +797,11 @@ struct volopt_map_entry glusterd_volopt_map[] = {
           .type        = NO_DOC,
           .op_version  = 1
         },
+        { .key         = "server.tcp-cork",
+          .voltype     = "protocol/server",
+          .option      = "transport.socket.cork",
+          .op_version  = 2
+        },
         { .key         = "server.allow-insecure",
           .voltype     = "protocol/server",
           .option      = "rpc-auth-allow-insecure",
@@ -796,6 +836,27 @@ struct volopt_map_entry glusterd_volopt_map[] = {
           .type        = NO_DOC,
           .op_version  = 2
         },
+        { .key         = "server.ssl-ktls",
+          .voltype     = "protocol/server",
+          .option      = "transport.socket.ssl-ktls",
+          .type        = NO_DOC,
+          .op_version  = 2
+        },
+        { .key         = "server.event-threads",
+          .voltype     = "protocol/server",
+          .option      = "event-threads",
+          .op_version  = 2
+        },
+        { .key         = "server.rpc-worker-threads",
+          .voltype     = "protocol/server",
+          .option      = "rpc-worker-threads",
+          .op_version  = 2
+        },
+        { .key         = "server.outstanding-rpc-limit",
+          .voltype     = "protocol/server",
+          .option      = "outstanding-rpc-limit",
+          .op_version  = 2
+        },
 
         /* Performance xlators enable/disbable options */
         { .key           = "performance.write-behind",
@@ -1171,6 +1232,22 @@ struct volopt_map_entry glusterd_volopt_map[] = {
           .voltype     = "storage/posix",
           .op_version  = 2
         },
+        { .key         = "storage.io-uring",
+          .voltype     = "storage/posix",
+          .op_version  = 2
+        },
+        { .key         = "storage.io-uring-depth",
+          .voltype     = "storage/posix",
+          .op_version  = 2
+        },
+        { .key         = "storage.handle-cache-size",
+          .voltype     = "storage/posix",
+          .op_version  = 2
+        },
+        { .key         = "storage.batch-xattr-fetch",
+          .voltype     = "storage/posix",
+          .op_version  = 2
+        },
         { .key         = "storage.owner-uid",
           .voltype     = "storage/posix",
           .option      = "brick-uid",
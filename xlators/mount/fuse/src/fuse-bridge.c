@@ -1149,6 +1149,14 @@ fuse_fsync_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
         return fuse_err_cbk (frame, cookie, this, op_ret, op_errno, xdata);
 }
 
+static int
+fuse_fallocate_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                    int32_t op_ret, int32_t op_errno, struct iatt *prebuf,
+                    struct iatt *postbuf, dict_t *xdata)
+{
+        return fuse_err_cbk (frame, cookie, this, op_ret, op_errno, xdata);
+}
+
 static int
 fuse_setxattr_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
                    int32_t op_ret, int32_t op_errno, dict_t *xdata)
@@ -2323,6 +2331,60 @@ fuse_fsync (xlator_t *this, fuse_in_header_t *finh, void *msg)
         return;
 }
 
+void
+fuse_fallocate_resume (fuse_state_t *state)
+{
+        gf_log ("glusterfs-fuse", GF_LOG_TRACE,
+                "%"PRIu64": FALLOCATE (%p, flags=%d, size=%zu, "
+                "offset=%"PRId64")", state->finh->unique, state->fd,
+                state->flags, state->size, state->off);
+
+        /* a hole punch always comes with FALLOC_FL_KEEP_SIZE */
+        if (state->flags & FALLOC_FL_PUNCH_HOLE)
+                FUSE_FOP (state, fuse_fallocate_cbk, GF_FOP_DISCARD, discard,
+                          state->fd, state->off, state->size, state->xdata);
+        else if (state->flags & FALLOC_FL_ZERO_RANGE)
+                FUSE_FOP (state, fuse_fallocate_cbk, GF_FOP_ZEROFILL, zerofill,
+                          state->fd, state->off, state->size, state->xdata);
+        else
+                FUSE_FOP (state, fuse_fallocate_cbk, GF_FOP_FALLOCATE,
+                          fallocate, state->fd,
+                          (state->flags & FALLOC_FL_KEEP_SIZE), state->off,
+                          state->size, state->xdata);
+}
+
+static void
+fuse_fallocate (xlator_t *this, fuse_in_header_t *finh, void *msg)
+{
+        struct fuse_fallocate_in *ffi = msg;
+
+        fuse_state_t *state = NULL;
+        fd_t         *fd = NULL;
+
+        /* zerofill may grow the file, so it cannot honour KEEP_SIZE */
+        if ((ffi->mode & ~(FALLOC_FL_KEEP_SIZE | FALLOC_FL_PUNCH_HOLE |
+                           FALLOC_FL_ZERO_RANGE)) ||
+            ((ffi->mode & FALLOC_FL_ZERO_RANGE) &&
+             (ffi->mode & FALLOC_FL_KEEP_SIZE))) {
+                send_fuse_err (this, finh, EOPNOTSUPP);
+                GF_FREE (finh);
+                return;
+        }
+
+        GET_STATE (this, finh, state);
+        fd = FH_TO_FD (ffi->fh);
+        state->fd = fd;
+
+        fuse_resolve_fd_init (state, &state->resolve, fd);
+
+        state->flags = ffi->mode;
+        state->off   = ffi->offset;
+        state->size  = ffi->length;
+
+        fuse_resolve_and_resume (state, fuse_fallocate_resume);
+        return;
+}
+
 void
 fuse_opendir_resume (fuse_state_t *state)
 {
@@ -4859,7 +4921,7 @@ static fuse_handler_t *fuse_std_ops[FUSE_OP_HIGH] = {
      /* [FUSE_POLL] */
      /* [FUSE_NOTIFY_REPLY] */
      /* [FUSE_BATCH_FORGET] */
-     /* [FUSE_FALLOCATE] */
+        [FUSE_FALLOCATE]   = fuse_fallocate,
 	[FUSE_READDIRPLUS] = fuse_readdirp,
 };
 
@@ -18,6 +18,7 @@
 #include <sys/mount.h>
 #include <sys/time.h>
 #include <fnmatch.h>
+#include <fcntl.h>
 
 #ifndef _CONFIG_H
 #define _CONFIG_H
@@ -58,6 +59,17 @@
 #endif
 #define GLUSTERFS_XATTR_LEN_MAX  65536
 
+/* fallocate(2) modes passed through FUSE_FALLOCATE */
+#ifndef FALLOC_FL_KEEP_SIZE
+#define FALLOC_FL_KEEP_SIZE      0x01
+#endif
+#ifndef FALLOC_FL_PUNCH_HOLE
+#define FALLOC_FL_PUNCH_HOLE     0x02
+#endif
+#ifndef FALLOC_FL_ZERO_RANGE
+#define FALLOC_FL_ZERO_RANGE     0x10
+#endif
+
 #define MAX_FUSE_PROC_DELAY 1
 
 typedef struct fuse_in_header fuse_in_header_t;
@@ -152,6 +152,7 @@ frame_fill_groups (call_frame_t *frame)
         char         line[4096];
         char        *ptr = NULL;
         FILE        *fp = NULL;
+        gid_t        groups[GF_MAX_AUX_GROUPS];
         int          idx = 0;
         long int     id = 0;
         char        *saveptr = NULL;
@@ -181,12 +182,12 @@ frame_fill_groups (call_frame_t *frame)
                                 break;
                         if (!endptr || *endptr)
                                 break;
-                        frame->root->groups[idx++] = id;
+                        groups[idx++] = id;
                         if (idx == GF_MAX_AUX_GROUPS)
                                 break;
                 }
 
-                frame->root->ngrps = idx;
+                call_stack_set_groups (frame->root, idx, groups);
                 break;
         }
 out:
@@ -206,8 +207,9 @@ out:
                 fp = fopen (filename, "r");
                 if (fp != NULL) {
                         if (fgets (scratch, sizeof scratch, fp) != NULL) {
-                                frame->root->ngrps = MIN(prcred->pr_ngroups,
-                                                         GF_REQUEST_MAXGROUPS);
+                                call_stack_alloc_groups (frame->root,
+                                                         MIN(prcred->pr_ngroups,
+                                                         GF_REQUEST_MAXGROUPS));
                         }
                         fclose (fp);
                  }
@@ -239,6 +241,8 @@ out:
 		gid_t * gidset = NULL;
 		ngroups = MIN(getgroups(gidsetlen, gidset), GF_REQUEST_MAXGROUPS);
 #endif /* __FreeBSD__ */
+        if (call_stack_alloc_groups (frame->root, ngroups) != 0)
+                ngroups = 0;
 #ifndef __FreeBSD__
         for (i = 0; i < ngroups; i++)
 			frame->root->groups[i] = kp.kp_eproc.e_ucred.cr_groups[i];
@@ -247,7 +251,6 @@ out:
 		    frame->root->groups[i] = gidset[i];
 		FREE(gidset);
 #endif /* __FreeBSD__ */
-        frame->root->ngrps = ngroups;
 #else
         frame->root->ngrps = 0;
 #endif /* GF_LINUX_HOST_OS */
@@ -259,7 +262,6 @@ out:
  */
 static void get_groups(fuse_private_t *priv, call_frame_t *frame)
 {
-	int i;
 	const gid_list_t *gl;
 	gid_list_t agl;
 
@@ -275,27 +277,25 @@ static void get_groups(fuse_private_t *priv, call_frame_t *frame)
 
 	gl = gid_cache_lookup(&priv->gid_cache, frame->root->pid);
 	if (gl) {
-		frame->root->ngrps = gl->gl_count;
-		for (i = 0; i < gl->gl_count; i++)
-			frame->root->groups[i] = gl->gl_list[i];
+		call_stack_share_groups(frame->root, gl->gl_groups);
 		gid_cache_release(&priv->gid_cache, gl);
 		return;
 	}
 
 	frame_fill_groups (frame);
 
-	agl.gl_id = frame->root->pid;
-	agl.gl_count = frame->root->ngrps;
-	agl.gl_list = GF_CALLOC(frame->root->ngrps, sizeof(gid_t),
-			gf_fuse_mt_gids_t);
-	if (!agl.gl_list)
+	agl.gl_groups = gf_groups_new(frame->root->ngrps);
+	if (!agl.gl_groups)
 		return;
 
-	for (i = 0; i < frame->root->ngrps; i++)
-		agl.gl_list[i] = frame->root->groups[i];
+	memcpy(agl.gl_groups->gs_gids, frame->root->groups,
+	       frame->root->ngrps * sizeof(gid_t));
+	agl.gl_id = frame->root->pid;
+	agl.gl_count = frame->root->ngrps;
+	agl.gl_list = agl.gl_groups->gs_gids;
 
 	if (gid_cache_add(&priv->gid_cache, &agl) != 1)
-		GF_FREE(agl.gl_list);
+		gf_groups_unref(agl.gl_groups);
 }
 
 call_frame_t *
@@ -60,9 +60,7 @@ nfs_fix_groups (xlator_t *this, call_stack_t *root)
 
 	agl = gid_cache_lookup(&priv->gid_cache, root->uid);
 	if (agl) {
-		for (ngroups = 0; ngroups < agl->gl_count; ngroups++) 
-			root->groups[ngroups] = agl->gl_list[ngroups];
-		root->ngrps = ngroups;
+		call_stack_share_groups(root, agl->gl_groups);
 		gid_cache_release(&priv->gid_cache, agl);
 		return;
 	}
@@ -90,24 +88,27 @@ nfs_fix_groups (xlator_t *this, call_stack_t *root)
                 return;
         }
 
-	/* Add the group data to the cache. */
-	gl.gl_list = GF_CALLOC(ngroups, sizeof(gid_t), gf_nfs_mt_aux_gids);
-	if (gl.gl_list) {
-		/* It's not fatal if the alloc failed. */
-		gl.gl_id = root->uid;
-		gl.gl_count = ngroups;
-		memcpy(gl.gl_list, mygroups, sizeof(gid_t) * ngroups);
-		if (gid_cache_add(&priv->gid_cache, &gl) != 1)
-			GF_FREE(gl.gl_list);
-	}
-
-	/* Copy data to the frame. */
-        for (i = 0; i < ngroups; ++i) {
+        for (i = 0; i < ngroups; ++i)
                 gf_log (this->name, GF_LOG_TRACE,
                         "%s is in group %u", result->pw_name, mygroups[i]);
-                root->groups[i] = mygroups[i];
-        }
-        root->ngrps = ngroups;
+
+	/* Add the group data to the cache, it's not fatal if the alloc
+	   failed. */
+	gl.gl_groups = gf_groups_new(ngroups);
+	if (!gl.gl_groups) {
+		call_stack_set_groups(root, ngroups, mygroups);
+		return;
+	}
+
+	memcpy(gl.gl_groups->gs_gids, mygroups, sizeof(gid_t) * ngroups);
+	gl.gl_id = root->uid;
+	gl.gl_count = ngroups;
+	gl.gl_list = gl.gl_groups->gs_gids;
+
+	/* The frame shares the list with the cache. */
+	call_stack_share_groups(root, gl.gl_groups);
+	if (gid_cache_add(&priv->gid_cache, &gl) != 1)
+		gf_groups_unref(gl.gl_groups);
 }
 
 struct nfs_fop_local *
@@ -199,7 +200,8 @@ nfs_create_frame (xlator_t *xl, nfs_user_t *nfu)
         frame->root->lk_owner = nfu->lk_owner;
 
         if (nfu->ngrps != 1) {
-                frame->root->ngrps = nfu->ngrps - 1;
+                if (call_stack_alloc_groups (frame->root, nfu->ngrps - 1))
+                        goto err;
 
                 gf_log (GF_NFS, GF_LOG_TRACE,"uid: %d, gid %d, gids: %d",
                         frame->root->uid, frame->root->gid, frame->root->ngrps);
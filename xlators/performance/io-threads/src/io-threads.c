@@ -295,6 +295,7 @@ iot_schedule (call_frame_t *frame, xlator_t *this, call_stub_t *stub)
         case GF_FOP_FSETXATTR:
         case GF_FOP_REMOVEXATTR:
         case GF_FOP_FREMOVEXATTR:
+        case GF_FOP_SEEK:
                 pri = IOT_PRI_NORMAL;
                 break;
 
@@ -307,6 +308,9 @@ iot_schedule (call_frame_t *frame, xlator_t *this, call_stub_t *stub)
         case GF_FOP_XATTROP:
         case GF_FOP_FXATTROP:
         case GF_FOP_RCHECKSUM:
+        case GF_FOP_FALLOCATE:
+        case GF_FOP_DISCARD:
+        case GF_FOP_ZEROFILL:
                 pri = IOT_PRI_LO;
                 break;
 
@@ -315,6 +319,7 @@ iot_schedule (call_frame_t *frame, xlator_t *this, call_stub_t *stub)
         case GF_FOP_RELEASE:
         case GF_FOP_RELEASEDIR:
         case GF_FOP_GETSPEC:
+        case GF_FOP_COMPOUND:
         case GF_FOP_MAXVALUE:
                 //fail compilation on missing fop
                 //new fop must choose priority.
@@ -1429,6 +1434,214 @@ out:
 }
 
 
+int
+iot_fallocate_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                   int32_t op_ret, int32_t op_errno, struct iatt *preop,
+                   struct iatt *postop, dict_t *xdata)
+{
+        STACK_UNWIND_STRICT (fallocate, frame, op_ret, op_errno, preop, postop,
+                             xdata);
+        return 0;
+}
+
+
+int
+iot_fallocate_wrapper (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                       int32_t keep_size, off_t offset, size_t len,
+                       dict_t *xdata)
+{
+        STACK_WIND (frame, iot_fallocate_cbk, FIRST_CHILD (this),
+                    FIRST_CHILD (this)->fops->fallocate, fd, keep_size,
+                    offset, len, xdata);
+        return 0;
+}
+
+
+int
+iot_fallocate (call_frame_t *frame, xlator_t *this, fd_t *fd,
+               int32_t keep_size, off_t offset, size_t len,
+               dict_t *xdata)
+{
+        call_stub_t *stub = NULL;
+        int          ret  = -1;
+
+        stub = fop_fallocate_stub (frame, iot_fallocate_wrapper, fd,
+                                   keep_size, offset, len, xdata);
+        if (!stub) {
+                gf_log (this->name, GF_LOG_ERROR,
+                        "cannot create fop_fallocate call stub"
+                        "(out of memory)");
+                ret = -ENOMEM;
+                goto out;
+        }
+
+        ret = iot_schedule (frame, this, stub);
+out:
+        if (ret < 0) {
+                STACK_UNWIND_STRICT (fallocate, frame, -1, -ret, NULL, NULL,
+                                     NULL);
+
+                if (stub != NULL) {
+                        call_stub_destroy (stub);
+                }
+        }
+        return 0;
+}
+
+
+int
+iot_discard_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                 int32_t op_ret, int32_t op_errno, struct iatt *preop,
+                 struct iatt *postop, dict_t *xdata)
+{
+        STACK_UNWIND_STRICT (discard, frame, op_ret, op_errno, preop, postop,
+                             xdata);
+        return 0;
+}
+
+
+int
+iot_discard_wrapper (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                     off_t offset, size_t len, dict_t *xdata)
+{
+        STACK_WIND (frame, iot_discard_cbk, FIRST_CHILD (this),
+                    FIRST_CHILD (this)->fops->discard, fd, offset, len, xdata);
+        return 0;
+}
+
+
+int
+iot_discard (call_frame_t *frame, xlator_t *this, fd_t *fd,
+             off_t offset, size_t len, dict_t *xdata)
+{
+        call_stub_t *stub = NULL;
+        int          ret  = -1;
+
+        stub = fop_discard_stub (frame, iot_discard_wrapper, fd, offset, len,
+                                 xdata);
+        if (!stub) {
+                gf_log (this->name, GF_LOG_ERROR,
+                        "cannot create fop_discard call stub"
+                        "(out of memory)");
+                ret = -ENOMEM;
+                goto out;
+        }
+
+        ret = iot_schedule (frame, this, stub);
+out:
+        if (ret < 0) {
+                STACK_UNWIND_STRICT (discard, frame, -1, -ret, NULL, NULL,
+                                     NULL);
+
+                if (stub != NULL) {
+                        call_stub_destroy (stub);
+                }
+        }
+        return 0;
+}
+
+
+int
+iot_zerofill_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                  int32_t op_ret, int32_t op_errno, struct iatt *preop,
+                  struct iatt *postop, dict_t *xdata)
+{
+        STACK_UNWIND_STRICT (zerofill, frame, op_ret, op_errno, preop, postop,
+                             xdata);
+        return 0;
+}
+
+
+int
+iot_zerofill_wrapper (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                      off_t offset, off_t len, dict_t *xdata)
+{
+        STACK_WIND (frame, iot_zerofill_cbk, FIRST_CHILD (this),
+                    FIRST_CHILD (this)->fops->zerofill, fd, offset, len, xdata);
+        return 0;
+}
+
+
+int
+iot_zerofill (call_frame_t *frame, xlator_t *this, fd_t *fd,
+              off_t offset, off_t len, dict_t *xdata)
+{
+        call_stub_t *stub = NULL;
+        int          ret  = -1;
+
+        stub = fop_zerofill_stub (frame, iot_zerofill_wrapper, fd, offset, len,
+                                  xdata);
+        if (!stub) {
+                gf_log (this->name, GF_LOG_ERROR,
+                        "cannot create fop_zerofill call stub"
+                        "(out of memory)");
+                ret = -ENOMEM;
+                goto out;
+        }
+
+        ret = iot_schedule (frame, this, stub);
+out:
+        if (ret < 0) {
+                STACK_UNWIND_STRICT (zerofill, frame, -1, -ret, NULL, NULL,
+                                     NULL);
+
+                if (stub != NULL) {
+                        call_stub_destroy (stub);
+                }
+        }
+        return 0;
+}
+
+
+int
+iot_seek_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+              int32_t op_ret, int32_t op_errno, off_t offset, dict_t *xdata)
+{
+        STACK_UNWIND_STRICT (seek, frame, op_ret, op_errno, offset, xdata);
+        return 0;
+}
+
+
+int
+iot_seek_wrapper (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                  off_t offset, gf_seek_what_t what, dict_t *xdata)
+{
+        STACK_WIND (frame, iot_seek_cbk, FIRST_CHILD (this),
+                    FIRST_CHILD (this)->fops->seek, fd, offset, what, xdata);
+        return 0;
+}
+
+
+int
+iot_seek (call_frame_t *frame, xlator_t *this, fd_t *fd, off_t offset,
+          gf_seek_what_t what, dict_t *xdata)
+{
+        call_stub_t *stub = NULL;
+        int          ret  = -1;
+
+        stub = fop_seek_stub (frame, iot_seek_wrapper, fd, offset, what,
+                              xdata);
+        if (!stub) {
+                gf_log (this->name, GF_LOG_ERROR,
+                        "cannot create fop_seek call stub"
+                        "(out of memory)");
+                ret = -ENOMEM;
+                goto out;
+        }
+
+        ret = iot_schedule (frame, this, stub);
+out:
+        if (ret < 0) {
+                STACK_UNWIND_STRICT (seek, frame, -1, -ret, 0, NULL);
+
+                if (stub != NULL) {
+                        call_stub_destroy (stub);
+                }
+        }
+        return 0;
+}
+
+
 
 int
 iot_unlink_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
@@ -2736,6 +2949,10 @@ struct xlator_fops fops = {
         .xattrop     = iot_xattrop,
 	.fxattrop    = iot_fxattrop,
         .rchecksum   = iot_rchecksum,
+        .fallocate   = iot_fallocate,
+        .discard     = iot_discard,
+        .zerofill    = iot_zerofill,
+        .seek        = iot_seek,
 };
 
 struct xlator_cbks cbks;
@@ -434,6 +434,33 @@ err:
 }
 
 
+int
+ob_seek (call_frame_t *frame, xlator_t *this, fd_t *fd, off_t offset,
+	 gf_seek_what_t what, dict_t *xdata)
+{
+	call_stub_t  *stub = NULL;
+	fd_t         *wind_fd = NULL;
+
+	wind_fd = ob_get_wind_fd (this, fd);
+
+	stub = fop_seek_stub (frame, default_seek_resume, wind_fd, offset,
+			      what, xdata);
+
+	fd_unref (wind_fd);
+
+	if (!stub)
+		goto err;
+
+	open_and_resume (this, wind_fd, stub);
+
+	return 0;
+err:
+	STACK_UNWIND_STRICT (seek, frame, -1, ENOMEM, 0, 0);
+
+	return 0;
+}
+
+
 int
 ob_flush (call_frame_t *frame, xlator_t *this, fd_t *fd, dict_t *xdata)
 {
@@ -682,6 +709,69 @@ err:
 }
 
 
+int
+ob_fallocate (call_frame_t *frame, xlator_t *this, fd_t *fd, int32_t keep_size,
+	      off_t offset, size_t len, dict_t *xdata)
+{
+	call_stub_t  *stub = NULL;
+
+	stub = fop_fallocate_stub (frame, default_fallocate_resume, fd,
+				   keep_size, offset, len, xdata);
+	if (!stub)
+		goto err;
+
+	open_and_resume (this, fd, stub);
+
+	return 0;
+err:
+	STACK_UNWIND_STRICT (fallocate, frame, -1, ENOMEM, 0, 0, 0);
+
+	return 0;
+}
+
+
+int
+ob_discard (call_frame_t *frame, xlator_t *this, fd_t *fd, off_t offset,
+	    size_t len, dict_t *xdata)
+{
+	call_stub_t  *stub = NULL;
+
+	stub = fop_discard_stub (frame, default_discard_resume, fd, offset,
+				 len, xdata);
+	if (!stub)
+		goto err;
+
+	open_and_resume (this, fd, stub);
+
+	return 0;
+err:
+	STACK_UNWIND_STRICT (discard, frame, -1, ENOMEM, 0, 0, 0);
+
+	return 0;
+}
+
+
+int
+ob_zerofill (call_frame_t *frame, xlator_t *this, fd_t *fd, off_t offset,
+	     off_t len, dict_t *xdata)
+{
+	call_stub_t  *stub = NULL;
+
+	stub = fop_zerofill_stub (frame, default_zerofill_resume, fd, offset,
+				  len, xdata);
+	if (!stub)
+		goto err;
+
+	open_and_resume (this, fd, stub);
+
+	return 0;
+err:
+	STACK_UNWIND_STRICT (zerofill, frame, -1, ENOMEM, 0, 0, 0);
+
+	return 0;
+}
+
+
 int
 ob_unlink (call_frame_t *frame, xlator_t *this, loc_t *loc, int xflags,
 	   dict_t *xdata)
@@ -903,6 +993,10 @@ struct xlator_fops fops = {
 	.fentrylk    = ob_fentrylk,
 	.fxattrop    = ob_fxattrop,
 	.fsetattr    = ob_fsetattr,
+	.fallocate   = ob_fallocate,
+	.discard     = ob_discard,
+	.zerofill    = ob_zerofill,
+	.seek        = ob_seek,
 	.unlink      = ob_unlink,
 	.rename      = ob_rename,
 	.lk          = ob_lk,
@@ -530,6 +530,16 @@ wb_enqueue_common (wb_inode_t *wb_inode, call_stub_t *stub, int tempted)
 
 		req->fd = fd_ref (stub->args.fd);
 
+		break;
+	case GF_FOP_FALLOCATE:
+	case GF_FOP_DISCARD:
+	case GF_FOP_ZEROFILL:
+		/* ordered against cached writes to the range, like a write */
+		req->ordering.off = stub->args.offset;
+		req->ordering.size = stub->args.size;
+
+		req->fd = fd_ref (stub->args.fd);
+
 		break;
 	default:
 		break;
@@ -1572,6 +1582,53 @@ noqueue:
 }
 
 
+int
+wb_seek_helper (call_frame_t *frame, xlator_t *this, fd_t *fd, off_t offset,
+                gf_seek_what_t what, dict_t *xdata)
+{
+        STACK_WIND (frame, default_seek_cbk, FIRST_CHILD(this),
+                    FIRST_CHILD(this)->fops->seek, fd, offset, what, xdata);
+        return 0;
+}
+
+
+int
+wb_seek (call_frame_t *frame, xlator_t *this, fd_t *fd, off_t offset,
+         gf_seek_what_t what, dict_t *xdata)
+{
+        wb_inode_t   *wb_inode     = NULL;
+	call_stub_t  *stub         = NULL;
+
+
+        wb_inode = wb_inode_ctx_get (this, fd->inode);
+	if (!wb_inode)
+		goto noqueue;
+
+	stub = fop_seek_stub (frame, wb_seek_helper, fd, offset, what, xdata);
+	if (!stub)
+		goto unwind;
+
+	if (!wb_enqueue (wb_inode, stub))
+		goto unwind;
+
+	wb_process_queue (wb_inode);
+
+        return 0;
+
+unwind:
+        STACK_UNWIND_STRICT (seek, frame, -1, ENOMEM, 0, NULL);
+
+        if (stub)
+                call_stub_destroy (stub);
+        return 0;
+
+noqueue:
+        STACK_WIND (frame, default_seek_cbk, FIRST_CHILD(this),
+                    FIRST_CHILD(this)->fops->seek, fd, offset, what, xdata);
+        return 0;
+}
+
+
 int
 wb_truncate_helper (call_frame_t *frame, xlator_t *this, loc_t *loc,
                     off_t offset, dict_t *xdata)
@@ -1667,6 +1724,167 @@ unwind:
 }
 
 
+int
+wb_fallocate_helper (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                     int32_t keep_size, off_t offset, size_t len,
+                     dict_t *xdata)
+{
+        STACK_WIND (frame, default_fallocate_cbk, FIRST_CHILD(this),
+                    FIRST_CHILD(this)->fops->fallocate, fd, keep_size, offset,
+                    len, xdata);
+        return 0;
+}
+
+
+int
+wb_fallocate (call_frame_t *frame, xlator_t *this, fd_t *fd,
+              int32_t keep_size, off_t offset, size_t len,
+              dict_t *xdata)
+{
+        wb_inode_t   *wb_inode     = NULL;
+        call_stub_t  *stub         = NULL;
+        int32_t       op_errno     = 0;
+
+        wb_inode = wb_inode_create (this, fd->inode);
+        if (!wb_inode) {
+                op_errno = ENOMEM;
+                goto unwind;
+        }
+
+        if (wb_fd_err (fd, this, &op_errno))
+                goto unwind;
+
+        stub = fop_fallocate_stub (frame, wb_fallocate_helper, fd,
+                                   keep_size, offset, len, xdata);
+        if (!stub) {
+                op_errno = ENOMEM;
+                goto unwind;
+        }
+
+        if (!wb_enqueue (wb_inode, stub)) {
+                op_errno = ENOMEM;
+                goto unwind;
+        }
+
+        wb_process_queue (wb_inode);
+
+        return 0;
+
+unwind:
+        STACK_UNWIND_STRICT (fallocate, frame, -1, op_errno, NULL, NULL, NULL);
+
+        if (stub)
+                call_stub_destroy (stub);
+        return 0;
+}
+
+
+int
+wb_discard_helper (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                   off_t offset, size_t len, dict_t *xdata)
+{
+        STACK_WIND (frame, default_discard_cbk, FIRST_CHILD(this),
+                    FIRST_CHILD(this)->fops->discard, fd, offset, len,
+                    xdata);
+        return 0;
+}
+
+
+int
+wb_discard (call_frame_t *frame, xlator_t *this, fd_t *fd,
+            off_t offset, size_t len, dict_t *xdata)
+{
+        wb_inode_t   *wb_inode     = NULL;
+        call_stub_t  *stub         = NULL;
+        int32_t       op_errno     = 0;
+
+        wb_inode = wb_inode_create (this, fd->inode);
+        if (!wb_inode) {
+                op_errno = ENOMEM;
+                goto unwind;
+        }
+
+        if (wb_fd_err (fd, this, &op_errno))
+                goto unwind;
+
+        stub = fop_discard_stub (frame, wb_discard_helper, fd,
+                                 offset, len, xdata);
+        if (!stub) {
+                op_errno = ENOMEM;
+                goto unwind;
+        }
+
+        if (!wb_enqueue (wb_inode, stub)) {
+                op_errno = ENOMEM;
+                goto unwind;
+        }
+
+        wb_process_queue (wb_inode);
+
+        return 0;
+
+unwind:
+        STACK_UNWIND_STRICT (discard, frame, -1, op_errno, NULL, NULL, NULL);
+
+        if (stub)
+                call_stub_destroy (stub);
+        return 0;
+}
+
+
+int
+wb_zerofill_helper (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                    off_t offset, off_t len, dict_t *xdata)
+{
+        STACK_WIND (frame, default_zerofill_cbk, FIRST_CHILD(this),
+                    FIRST_CHILD(this)->fops->zerofill, fd, offset, len,
+                    xdata);
+        return 0;
+}
+
+
+int
+wb_zerofill (call_frame_t *frame, xlator_t *this, fd_t *fd,
+             off_t offset, off_t len, dict_t *xdata)
+{
+        wb_inode_t   *wb_inode     = NULL;
+        call_stub_t  *stub         = NULL;
+        int32_t       op_errno     = 0;
+
+        wb_inode = wb_inode_create (this, fd->inode);
+        if (!wb_inode) {
+                op_errno = ENOMEM;
+                goto unwind;
+        }
+
+        if (wb_fd_err (fd, this, &op_errno))
+                goto unwind;
+
+        stub = fop_zerofill_stub (frame, wb_zerofill_helper, fd,
+                                  offset, len, xdata);
+        if (!stub) {
+                op_errno = ENOMEM;
+                goto unwind;
+        }
+
+        if (!wb_enqueue (wb_inode, stub)) {
+                op_errno = ENOMEM;
+                goto unwind;
+        }
+
+        wb_process_queue (wb_inode);
+
+        return 0;
+
+unwind:
+        STACK_UNWIND_STRICT (zerofill, frame, -1, op_errno, NULL, NULL, NULL);
+
+        if (stub)
+                call_stub_destroy (stub);
+        return 0;
+}
+
+
 int
 wb_setattr_helper (call_frame_t *frame, xlator_t *this, loc_t *loc,
                    struct iatt *stbuf, int32_t valid, dict_t *xdata)
@@ -2070,6 +2288,10 @@ struct xlator_fops fops = {
         .fstat       = wb_fstat,
         .truncate    = wb_truncate,
         .ftruncate   = wb_ftruncate,
+        .fallocate   = wb_fallocate,
+        .discard     = wb_discard,
+        .zerofill    = wb_zerofill,
+        .seek        = wb_seek,
         .setattr     = wb_setattr,
         .fsetattr    = wb_fsetattr,
 };
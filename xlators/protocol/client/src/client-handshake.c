@@ -1426,6 +1426,11 @@ client_setvolume_cbk (struct rpc_req *req, struct iovec *iov, int count, void *m
                 goto out;
         }
 
+        /* older bricks do not know GFS3_OP_READDIRP2 */
+        conf->readdirp2 = (dict_get (reply, "readdirp2") != NULL);
+        conf->fallocate = (dict_get (reply, "fallocate") != NULL);
+        conf->seek = (dict_get (reply, "seek") != NULL);
+
         gf_log (this->name, GF_LOG_DEBUG, "clnt-lk-version = %d, "
                 "server-lk-version = %d", client_get_lk_ver (conf), lk_ver);
         /* TODO: currently setpeer path is broken */
@@ -1457,6 +1462,8 @@ client_setvolume_cbk (struct rpc_req *req, struct iovec *iov, int count, void *m
 
         rpc_clnt_set_connected (&conf->rpc->conn);
 
+        client_attach_data_conns (this);
+
         op_ret = 0;
         conf->connecting = 0;
         conf->connected = 1;
@@ -1514,6 +1521,64 @@ out:
         return ret;
 }
 
+int
+client_data_setvolume_cbk (struct rpc_req *req, struct iovec *iov, int count,
+                           void *myframe)
+{
+        call_frame_t     *frame    = NULL;
+        clnt_conf_t      *conf     = NULL;
+        clnt_data_conn_t *dc       = NULL;
+        xlator_t         *this     = NULL;
+        gf_setvolume_rsp  rsp      = {0,};
+        int               ret      = 0;
+        int32_t           op_ret   = -1;
+        int32_t           op_errno = 0;
+
+        frame = myframe;
+        this  = frame->this;
+        conf  = this->private;
+        dc    = frame->cookie;
+
+        if (-1 == req->rpc_status) {
+                op_errno = ENOTCONN;
+                goto out;
+        }
+
+        ret = xdr_to_generic (*iov, &rsp, (xdrproc_t)xdr_gf_setvolume_rsp);
+        if (ret < 0) {
+                gf_log (this->name, GF_LOG_ERROR, "XDR decoding failed");
+                op_errno = EINVAL;
+                goto out;
+        }
+        op_ret   = rsp.op_ret;
+        op_errno = gf_error_to_errno (rsp.op_errno);
+
+out:
+        if (op_ret < 0) {
+                gf_log (this->name, GF_LOG_WARNING,
+                        "SETVOLUME on data connection %d failed (%s)",
+                        dc->index, strerror (op_errno));
+                rpc_transport_disconnect (dc->rpc->conn.trans);
+        } else {
+                pthread_mutex_lock (&conf->lock);
+                {
+                        /* rpc may have gone down meanwhile */
+                        dc->attached = conf->attached && dc->connected;
+                }
+                pthread_mutex_unlock (&conf->lock);
+
+                gf_log (this->name, GF_LOG_INFO, "data connection %d "
+                        "attached to remote volume", dc->index);
+        }
+
+        free (rsp.dict.dict_val);
+
+        STACK_DESTROY (frame->root);
+
+        return 0;
+}
+
+/* rpc is either conf->rpc or the one of a data connection */
 int
 client_setvolume (xlator_t *this, struct rpc_clnt *rpc)
 {
@@ -1620,10 +1685,21 @@ client_setvolume (xlator_t *this, struct rpc_clnt *rpc)
         if (!fr)
                 goto fail;
 
-        ret = client_submit_request (this, &req, fr, conf->handshake,
-                                     GF_HNDSK_SETVOLUME, client_setvolume_cbk,
-                                     NULL, NULL, 0, NULL, 0, NULL,
-                                     (xdrproc_t)xdr_gf_setvolume_req);
+        if (rpc == conf->rpc) {
+                ret = client_submit_request (this, &req, fr, conf->handshake,
+                                             GF_HNDSK_SETVOLUME,
+                                             client_setvolume_cbk,
+                                             NULL, NULL, 0, NULL, 0, NULL,
+                                             (xdrproc_t)xdr_gf_setvolume_req);
+        } else {
+                fr->cookie = rpc->mydata;
+                ret = client_submit_request_on (this, rpc, &req, fr,
+                                                conf->handshake,
+                                                GF_HNDSK_SETVOLUME,
+                                                client_data_setvolume_cbk,
+                                                NULL, NULL, 0, NULL, 0, NULL,
+                                             (xdrproc_t)xdr_gf_setvolume_req);
+        }
 
 fail:
         GF_FREE (req.dict.dict_val);
@@ -15,6 +15,7 @@
 
 #include "client.h"
 #include "fd.h"
+#include "glusterfs3-dirent.h"
 
 int
 client_fd_lk_list_empty (fd_lk_ctx_t *lk_ctx, gf_boolean_t try_lock)
@@ -177,7 +178,6 @@ unserialize_rsp_direntp (xlator_t *this, fd_t *fd,
                          struct gfs3_readdirp_rsp *rsp, gf_dirent_t *entries)
 {
         struct gfs3_dirplist *trav      = NULL;
-        char                 *buf       = NULL;
 	gf_dirent_t          *entry     = NULL;
         inode_table_t        *itable    = NULL;
         int                   entry_len = 0;
@@ -205,22 +205,22 @@ unserialize_rsp_direntp (xlator_t *this, fd_t *fd,
 
                 if (trav->dict.dict_val) {
                         /* Dictionary is sent along with response */
-                        buf = memdup (trav->dict.dict_val, trav->dict.dict_len);
-                        if (!buf)
-                                goto out;
-
                         entry->dict = dict_new ();
+                        if (!entry->dict)
+                                goto out;
 
-                        ret = dict_unserialize (buf, trav->dict.dict_len,
-                                                &entry->dict);
+                        /* the dict takes over the XDR buffer, see
+                           clnt_readdirp_rsp_cleanup () */
+                        ret = dict_unserialize_nocopy (trav->dict.dict_val,
+                                                       trav->dict.dict_len,
+                                                       &entry->dict);
+                        trav->dict.dict_val = NULL;
                         if (ret < 0) {
                                 gf_log (THIS->name, GF_LOG_WARNING,
                                         "failed to unserialize xattr dict");
                                 errno = EINVAL;
                                 goto out;
                         }
-                        entry->dict->extra_free = buf;
-                        buf = NULL;
                 }
 
                 entry->inode = inode_find (itable, entry->d_stat.ia_gfid);
@@ -237,6 +237,31 @@ out:
         return ret;
 }
 
+int
+unpack_rsp_direntp (xlator_t *this, fd_t *fd,
+                    struct gfs3_readdirp2_rsp *rsp, gf_dirent_t *entries)
+{
+        gf_dirent_t          *entry     = NULL;
+        inode_table_t        *itable    = NULL;
+        int                   ret       = -1;
+
+        /* the entries take over the XDR buffer */
+        ret = gf_dirent_unpack (rsp->entries.entries_val,
+                                rsp->entries.entries_len, rsp->count, entries);
+        rsp->entries.entries_val = NULL;
+
+        if (fd)
+                itable = fd->inode->table;
+
+        list_for_each_entry (entry, &entries->list, list) {
+                entry->inode = inode_find (itable, entry->d_stat.ia_gfid);
+                if (!entry->inode)
+                        entry->inode = inode_new (itable);
+        }
+
+        return ret;
+}
+
 int
 clnt_readdirp_rsp_cleanup (gfs3_readdirp_rsp *rsp)
 {
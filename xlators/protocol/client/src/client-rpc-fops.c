@@ -17,6 +17,7 @@
 #include "glusterfs3-xdr.h"
 #include "glusterfs3.h"
 #include "compat-errno.h"
+#include "call-stub.h"
 
 int32_t client3_getspec (call_frame_t *frame, xlator_t *this, void *data);
 void client_start_ping (void *data);
@@ -39,11 +40,22 @@ client_submit_vec_request (xlator_t  *this, void *req, call_frame_t  *frame,
         struct iobref  *new_iobref = NULL;
         ssize_t         xdr_size   = 0;
         struct rpc_req  rpcreq     = {0, };
+        clnt_compound_t *cc        = NULL;
 
         start_ping = 0;
 
         conf = this->private;
 
+        cc = client_compound_of (this, frame);
+        if (cc) {
+                ret = client_compound_capture (this, cc, frame, procnum, cbkfn,
+                                               req, xdrproc, payload,
+                                               payloadcnt, iobref);
+                if (ret)
+                        goto unwind;
+                return 0;
+        }
+
         if (req && xdrproc) {
                 xdr_size = xdr_sizeof (xdrproc, req);
                 iobuf = iobuf_get2 (this->ctx->iobuf_pool, xdr_size);
@@ -88,7 +100,8 @@ client_submit_vec_request (xlator_t  *this, void *req, call_frame_t  *frame,
         }
 
         /* Send the msg */
-        ret = rpc_clnt_submit (conf->rpc, prog, procnum, cbkfn, &iov, count,
+        ret = rpc_clnt_submit (client_pick_rpc (this, prog, procnum, req),
+                               prog, procnum, cbkfn, &iov, count,
                                payload, payloadcnt, new_iobref, frame, NULL, 0,
                                NULL, 0, NULL);
         if (ret < 0) {
@@ -173,9 +186,9 @@ client3_3_symlink_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.postparent, &postparent);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -244,9 +257,9 @@ client3_3_mknod_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.postparent, &postparent);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -310,9 +323,9 @@ client3_3_mkdir_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.postparent, &postparent);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -452,9 +465,9 @@ client3_3_open_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 }
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -509,9 +522,9 @@ client3_3_stat_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.stat, &iatt);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -563,9 +576,9 @@ client3_3_readlink_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.buf, &iatt);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -625,9 +638,9 @@ client3_3_unlink_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.postparent, &postparent);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -685,9 +698,9 @@ client3_3_rmdir_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.postparent, &postparent);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -742,9 +755,9 @@ client3_3_truncate_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.poststat, &poststat);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -797,9 +810,9 @@ client3_3_statfs_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_statfs_to_statfs (&rsp.statfs, &statfs);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -856,9 +869,9 @@ client3_3_writev_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.poststat, &poststat);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -917,9 +930,9 @@ client3_3_flush_cbk (struct rpc_req *req, struct iovec *iov, int count,
                         lkowner_utoa (&local->owner), ret);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -974,9 +987,9 @@ client3_3_fsync_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.poststat, &poststat);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -1024,9 +1037,9 @@ client3_3_setxattr_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 goto out;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         op_errno = gf_error_to_errno (rsp.op_errno);
@@ -1081,15 +1094,15 @@ client3_3_getxattr_cbk (struct rpc_req *req, struct iovec *iov, int count,
 
         op_errno = gf_error_to_errno (rsp.op_errno);
         if (-1 != rsp.op_ret) {
-                GF_PROTOCOL_DICT_UNSERIALIZE (frame->this, dict,
-                                              (rsp.dict.dict_val),
-                                              (rsp.dict.dict_len), rsp.op_ret,
-                                              op_errno, out);
+                GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (frame->this, dict,
+                                                     (rsp.dict.dict_val),
+                                                     (rsp.dict.dict_len), rsp.op_ret,
+                                                     op_errno, out);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -1153,14 +1166,14 @@ client3_3_fgetxattr_cbk (struct rpc_req *req, struct iovec *iov, int count,
 
         op_errno = gf_error_to_errno (rsp.op_errno);
         if (-1 != rsp.op_ret) {
-                GF_PROTOCOL_DICT_UNSERIALIZE (frame->this, dict,
-                                              (rsp.dict.dict_val),
-                                              (rsp.dict.dict_len), rsp.op_ret,
-                                              op_errno, out);
+                GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (frame->this, dict,
+                                                     (rsp.dict.dict_val),
+                                                     (rsp.dict.dict_len), rsp.op_ret,
+                                                     op_errno, out);
         }
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -1213,9 +1226,9 @@ client3_3_removexattr_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 goto out;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -1263,9 +1276,9 @@ client3_3_fremovexattr_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 goto out;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -1311,9 +1324,9 @@ client3_3_fsyncdir_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 goto out;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -1359,9 +1372,9 @@ client3_3_access_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 goto out;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -1415,9 +1428,9 @@ client3_3_ftruncate_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.poststat, &poststat);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -1436,6 +1449,225 @@ out:
         return 0;
 }
 
+int
+client3_3_fallocate_cbk (struct rpc_req *req, struct iovec *iov, int count,
+                         void *myframe)
+{
+        gfs3_fallocate_rsp rsp = {0,};
+        call_frame_t   *frame = NULL;
+        struct iatt  prestat  = {0,};
+        struct iatt  poststat = {0,};
+        int ret = 0;
+        xlator_t *this       = NULL;
+        dict_t  *xdata       = NULL;
+
+
+        this = THIS;
+
+        frame = myframe;
+
+        if (-1 == req->rpc_status) {
+                rsp.op_ret   = -1;
+                rsp.op_errno = ENOTCONN;
+                goto out;
+        }
+        ret = xdr_to_generic (*iov, &rsp, (xdrproc_t)xdr_gfs3_fallocate_rsp);
+        if (ret < 0) {
+                gf_log (this->name, GF_LOG_ERROR, "XDR decoding failed");
+                rsp.op_ret   = -1;
+                rsp.op_errno = EINVAL;
+                goto out;
+        }
+
+        if (-1 != rsp.op_ret) {
+                gf_stat_to_iatt (&rsp.statpre, &prestat);
+                gf_stat_to_iatt (&rsp.statpost, &poststat);
+        }
+
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
+
+out:
+        if (rsp.op_ret == -1) {
+                gf_log (this->name, GF_LOG_WARNING, "remote operation failed: %s",
+                        strerror (gf_error_to_errno (rsp.op_errno)));
+        }
+        CLIENT_STACK_UNWIND (fallocate, frame, rsp.op_ret,
+                             gf_error_to_errno (rsp.op_errno), &prestat,
+                             &poststat, xdata);
+
+        free (rsp.xdata.xdata_val);
+
+        if (xdata)
+                dict_unref (xdata);
+
+        return 0;
+}
+
+int
+client3_3_discard_cbk (struct rpc_req *req, struct iovec *iov, int count,
+                       void *myframe)
+{
+        gfs3_discard_rsp rsp = {0,};
+        call_frame_t   *frame = NULL;
+        struct iatt  prestat  = {0,};
+        struct iatt  poststat = {0,};
+        int ret = 0;
+        xlator_t *this       = NULL;
+        dict_t  *xdata       = NULL;
+
+
+        this = THIS;
+
+        frame = myframe;
+
+        if (-1 == req->rpc_status) {
+                rsp.op_ret   = -1;
+                rsp.op_errno = ENOTCONN;
+                goto out;
+        }
+        ret = xdr_to_generic (*iov, &rsp, (xdrproc_t)xdr_gfs3_discard_rsp);
+        if (ret < 0) {
+                gf_log (this->name, GF_LOG_ERROR, "XDR decoding failed");
+                rsp.op_ret   = -1;
+                rsp.op_errno = EINVAL;
+                goto out;
+        }
+
+        if (-1 != rsp.op_ret) {
+                gf_stat_to_iatt (&rsp.statpre, &prestat);
+                gf_stat_to_iatt (&rsp.statpost, &poststat);
+        }
+
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
+
+out:
+        if (rsp.op_ret == -1) {
+                gf_log (this->name, GF_LOG_WARNING, "remote operation failed: %s",
+                        strerror (gf_error_to_errno (rsp.op_errno)));
+        }
+        CLIENT_STACK_UNWIND (discard, frame, rsp.op_ret,
+                             gf_error_to_errno (rsp.op_errno), &prestat,
+                             &poststat, xdata);
+
+        free (rsp.xdata.xdata_val);
+
+        if (xdata)
+                dict_unref (xdata);
+
+        return 0;
+}
+
+int
+client3_3_zerofill_cbk (struct rpc_req *req, struct iovec *iov, int count,
+                        void *myframe)
+{
+        gfs3_zerofill_rsp rsp = {0,};
+        call_frame_t   *frame = NULL;
+        struct iatt  prestat  = {0,};
+        struct iatt  poststat = {0,};
+        int ret = 0;
+        xlator_t *this       = NULL;
+        dict_t  *xdata       = NULL;
+
+
+        this = THIS;
+
+        frame = myframe;
+
+        if (-1 == req->rpc_status) {
+                rsp.op_ret   = -1;
+                rsp.op_errno = ENOTCONN;
+                goto out;
+        }
+        ret = xdr_to_generic (*iov, &rsp, (xdrproc_t)xdr_gfs3_zerofill_rsp);
+        if (ret < 0) {
+                gf_log (this->name, GF_LOG_ERROR, "XDR decoding failed");
+                rsp.op_ret   = -1;
+                rsp.op_errno = EINVAL;
+                goto out;
+        }
+
+        if (-1 != rsp.op_ret) {
+                gf_stat_to_iatt (&rsp.statpre, &prestat);
+                gf_stat_to_iatt (&rsp.statpost, &poststat);
+        }
+
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
+
+out:
+        if (rsp.op_ret == -1) {
+                gf_log (this->name, GF_LOG_WARNING, "remote operation failed: %s",
+                        strerror (gf_error_to_errno (rsp.op_errno)));
+        }
+        CLIENT_STACK_UNWIND (zerofill, frame, rsp.op_ret,
+                             gf_error_to_errno (rsp.op_errno), &prestat,
+                             &poststat, xdata);
+
+        free (rsp.xdata.xdata_val);
+
+        if (xdata)
+                dict_unref (xdata);
+
+        return 0;
+}
+
+int
+client3_3_seek_cbk (struct rpc_req *req, struct iovec *iov, int count,
+                    void *myframe)
+{
+        gfs3_seek_rsp   rsp = {0,};
+        call_frame_t   *frame = NULL;
+        int ret = 0;
+        xlator_t *this       = NULL;
+        dict_t  *xdata       = NULL;
+
+
+        this = THIS;
+
+        frame = myframe;
+
+        if (-1 == req->rpc_status) {
+                rsp.op_ret   = -1;
+                rsp.op_errno = ENOTCONN;
+                goto out;
+        }
+        ret = xdr_to_generic (*iov, &rsp, (xdrproc_t)xdr_gfs3_seek_rsp);
+        if (ret < 0) {
+                gf_log (this->name, GF_LOG_ERROR, "XDR decoding failed");
+                rsp.op_ret   = -1;
+                rsp.op_errno = EINVAL;
+                goto out;
+        }
+
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
+
+out:
+        /* ENXIO: nothing more to find past the offset */
+        if ((rsp.op_ret == -1) &&
+            (gf_error_to_errno (rsp.op_errno) != ENXIO)) {
+                gf_log (this->name, GF_LOG_WARNING, "remote operation failed: %s",
+                        strerror (gf_error_to_errno (rsp.op_errno)));
+        }
+        CLIENT_STACK_UNWIND (seek, frame, rsp.op_ret,
+                             gf_error_to_errno (rsp.op_errno), rsp.offset,
+                             xdata);
+
+        free (rsp.xdata.xdata_val);
+
+        if (xdata)
+                dict_unref (xdata);
+
+        return 0;
+}
+
 int
 client3_3_fstat_cbk (struct rpc_req *req, struct iovec *iov, int count,
                      void *myframe)
@@ -1469,9 +1701,9 @@ client3_3_fstat_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.stat, &stat);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -1518,9 +1750,9 @@ client3_3_inodelk_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 goto out;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if ((rsp.op_ret == -1) &&
@@ -1568,9 +1800,9 @@ client3_3_finodelk_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 goto out;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if ((rsp.op_ret == -1) &&
@@ -1620,9 +1852,9 @@ client3_3_entrylk_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 goto out;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if ((rsp.op_ret == -1) &&
@@ -1670,9 +1902,9 @@ client3_3_fentrylk_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 goto out;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if ((rsp.op_ret == -1) &&
@@ -1726,15 +1958,15 @@ client3_3_xattrop_cbk (struct rpc_req *req, struct iovec *iov, int count,
 
         op_errno = rsp.op_errno;
         if (-1 != rsp.op_ret) {
-                GF_PROTOCOL_DICT_UNSERIALIZE (frame->this, dict,
-                                              (rsp.dict.dict_val),
-                                              (rsp.dict.dict_len), rsp.op_ret,
-                                              op_errno, out);
+                GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (frame->this, dict,
+                                                     (rsp.dict.dict_val),
+                                                     (rsp.dict.dict_len), rsp.op_ret,
+                                                     op_errno, out);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -1793,16 +2025,16 @@ client3_3_fxattrop_cbk (struct rpc_req *req, struct iovec *iov, int count,
         }
         op_errno = rsp.op_errno;
         if (-1 != rsp.op_ret) {
-                GF_PROTOCOL_DICT_UNSERIALIZE (frame->this, dict,
-                                              (rsp.dict.dict_val),
-                                              (rsp.dict.dict_len), rsp.op_ret,
-                                              op_errno, out);
+                GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (frame->this, dict,
+                                                     (rsp.dict.dict_val),
+                                                     (rsp.dict.dict_len), rsp.op_ret,
+                                                     op_errno, out);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (frame->this, xdata,
-                                      (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), rsp.op_ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (frame->this, xdata,
+                                             (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), rsp.op_ret,
+                                             op_errno, out);
 out:
 
         if (rsp.op_ret == -1) {
@@ -1857,9 +2089,9 @@ client3_3_fsetxattr_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 goto out;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         op_errno = gf_error_to_errno (rsp.op_errno);
@@ -1915,9 +2147,9 @@ client3_3_fsetattr_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.statpost, &poststat);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -1973,9 +2205,9 @@ client3_3_setattr_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.statpost, &poststat);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -2046,9 +2278,9 @@ client3_3_create_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 }
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -2100,9 +2332,9 @@ client3_3_rchecksum_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 goto out;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -2178,9 +2410,9 @@ client3_3_lk_cbk (struct rpc_req *req, struct iovec *iov, int count,
         }
         */
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if ((rsp.op_ret == -1) &&
@@ -2239,10 +2471,10 @@ client3_3_readdir_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 unserialize_rsp_dirent (&rsp, &entries);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (frame->this, xdata,
-                                      (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), rsp.op_ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (frame->this, xdata,
+                                             (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), rsp.op_ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -2305,9 +2537,9 @@ client3_3_readdirp_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 unserialize_rsp_direntp (this, local->fd, &rsp, &entries);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -2332,6 +2564,74 @@ out:
 }
 
 
+int
+client3_3_readdirp2_cbk (struct rpc_req *req, struct iovec *iov, int count,
+                         void *myframe)
+{
+        call_frame_t       *frame = NULL;
+        gfs3_readdirp2_rsp  rsp   = {0,};
+        int32_t             ret   = 0;
+        clnt_local_t       *local = NULL;
+        gf_dirent_t         entries;
+        xlator_t           *this  = NULL;
+        dict_t             *xdata = NULL;
+
+        this = THIS;
+
+        frame = myframe;
+        local = frame->local;
+
+        INIT_LIST_HEAD (&entries.list);
+
+        if (-1 == req->rpc_status) {
+                rsp.op_ret   = -1;
+                rsp.op_errno = ENOTCONN;
+                goto out;
+        }
+
+        ret = xdr_to_generic (*iov, &rsp, (xdrproc_t)xdr_gfs3_readdirp2_rsp);
+        if (ret < 0) {
+                gf_log (this->name, GF_LOG_ERROR, "XDR decoding failed");
+                rsp.op_ret   = -1;
+                rsp.op_errno = EINVAL;
+                goto out;
+        }
+
+        if (rsp.op_ret > 0) {
+                ret = unpack_rsp_direntp (this, local->fd, &rsp, &entries);
+                if (ret < 0) {
+                        gf_dirent_free (&entries);
+                        rsp.op_ret   = -1;
+                        rsp.op_errno = EINVAL;
+                        goto out;
+                }
+        }
+
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
+
+out:
+        if (rsp.op_ret == -1) {
+                gf_log (this->name, GF_LOG_WARNING,
+                        "remote operation failed: %s",
+                        strerror (gf_error_to_errno (rsp.op_errno)));
+        }
+        CLIENT_STACK_UNWIND (readdirp, frame, rsp.op_ret,
+                             gf_error_to_errno (rsp.op_errno), &entries, xdata);
+
+        gf_dirent_free (&entries);
+
+        free (rsp.entries.entries_val);
+        free (rsp.xdata.xdata_val);
+
+        if (xdata)
+                dict_unref (xdata);
+
+        return 0;
+}
+
+
 int
 client3_3_rename_cbk (struct rpc_req *req, struct iovec *iov, int count,
                       void *myframe)
@@ -2375,9 +2675,9 @@ client3_3_rename_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.postnewparent, &postnewparent);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -2441,9 +2741,9 @@ client3_3_link_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 gf_stat_to_iatt (&rsp.postparent, &postparent);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -2511,9 +2811,9 @@ client3_3_opendir_cbk (struct rpc_req *req, struct iovec *iov, int count,
                 }
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 out:
         if (rsp.op_ret == -1) {
@@ -2578,9 +2878,9 @@ client3_3_lookup_cbk (struct rpc_req *req, struct iovec *iov, int count,
         rsp.op_ret = -1;
         gf_stat_to_iatt (&rsp.stat, &stbuf);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (frame->this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), rsp.op_ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (frame->this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), rsp.op_ret,
+                                             op_errno, out);
 
         if ((!uuid_is_null (inode->gfid))
             && (uuid_compare (stbuf.ia_gfid, inode->gfid) != 0)) {
@@ -2662,9 +2962,9 @@ client3_3_readv_cbk (struct rpc_req *req, struct iovec *iov, int count,
                         vector[0].iov_base = req->rsp[1].iov_base;
                 rspcount = 1;
         }
-        GF_PROTOCOL_DICT_UNSERIALIZE (this, xdata, (rsp.xdata.xdata_val),
-                                      (rsp.xdata.xdata_len), ret,
-                                      rsp.op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
 
 #ifdef GF_TESTING_IO_XDATA
         dict_dump (xdata);
@@ -3145,23 +3445,244 @@ unwind:
 }
 
 
-
 int32_t
-client3_3_access (call_frame_t *frame, xlator_t *this,
-                  void *data)
+client3_3_fallocate (call_frame_t *frame, xlator_t *this,
+                     void *data)
 {
-        clnt_conf_t     *conf     = NULL;
-        clnt_args_t     *args     = NULL;
-        gfs3_access_req  req      = {{0,},};
-        int              ret      = 0;
-        int              op_errno = ESTALE;
+        clnt_args_t        *args     = NULL;
+        int64_t             remote_fd = -1;
+        clnt_conf_t        *conf     = NULL;
+        gfs3_fallocate_req req      = {{0,},};
+        int                 op_errno = EINVAL;
+        int                 ret      = 0;
 
         if (!frame || !this || !data)
                 goto unwind;
 
         args = data;
 
-        if (!(args->loc && args->loc->inode))
+        conf = this->private;
+
+        if (!conf->fallocate) {
+                /* the brick is too old for it */
+                op_errno = EOPNOTSUPP;
+                goto unwind;
+        }
+
+        CLIENT_GET_REMOTE_FD (this, args->fd, DEFAULT_REMOTE_FD,
+                              remote_fd, op_errno, unwind);
+
+        req.fd     = remote_fd;
+        req.flags  = args->flags;
+        req.offset = args->offset;
+        req.size   = args->size;
+        memcpy (req.gfid, args->fd->inode->gfid, 16);
+
+        GF_PROTOCOL_DICT_SERIALIZE (this, args->xdata, (&req.xdata.xdata_val),
+                                    req.xdata.xdata_len, op_errno, unwind);
+
+        ret = client_submit_request (this, &req, frame, conf->fops,
+                                     GFS3_OP_FALLOCATE,
+                                     client3_3_fallocate_cbk, NULL,
+                                     NULL, 0, NULL, 0,
+                                     NULL, (xdrproc_t)xdr_gfs3_fallocate_req);
+        if (ret) {
+                gf_log (this->name, GF_LOG_WARNING, "failed to send the fop");
+        }
+
+        GF_FREE (req.xdata.xdata_val);
+
+        return 0;
+unwind:
+        CLIENT_STACK_UNWIND (fallocate, frame, -1, op_errno, NULL, NULL, NULL);
+        GF_FREE (req.xdata.xdata_val);
+
+        return 0;
+}
+
+
+int32_t
+client3_3_discard (call_frame_t *frame, xlator_t *this,
+                   void *data)
+{
+        clnt_args_t        *args     = NULL;
+        int64_t             remote_fd = -1;
+        clnt_conf_t        *conf     = NULL;
+        gfs3_discard_req   req      = {{0,},};
+        int                 op_errno = EINVAL;
+        int                 ret      = 0;
+
+        if (!frame || !this || !data)
+                goto unwind;
+
+        args = data;
+
+        conf = this->private;
+
+        if (!conf->fallocate) {
+                /* the brick is too old for it */
+                op_errno = EOPNOTSUPP;
+                goto unwind;
+        }
+
+        CLIENT_GET_REMOTE_FD (this, args->fd, DEFAULT_REMOTE_FD,
+                              remote_fd, op_errno, unwind);
+
+        req.fd     = remote_fd;
+        req.offset = args->offset;
+        req.size   = args->size;
+        memcpy (req.gfid, args->fd->inode->gfid, 16);
+
+        GF_PROTOCOL_DICT_SERIALIZE (this, args->xdata, (&req.xdata.xdata_val),
+                                    req.xdata.xdata_len, op_errno, unwind);
+
+        ret = client_submit_request (this, &req, frame, conf->fops,
+                                     GFS3_OP_DISCARD,
+                                     client3_3_discard_cbk, NULL,
+                                     NULL, 0, NULL, 0,
+                                     NULL, (xdrproc_t)xdr_gfs3_discard_req);
+        if (ret) {
+                gf_log (this->name, GF_LOG_WARNING, "failed to send the fop");
+        }
+
+        GF_FREE (req.xdata.xdata_val);
+
+        return 0;
+unwind:
+        CLIENT_STACK_UNWIND (discard, frame, -1, op_errno, NULL, NULL, NULL);
+        GF_FREE (req.xdata.xdata_val);
+
+        return 0;
+}
+
+
+int32_t
+client3_3_zerofill (call_frame_t *frame, xlator_t *this,
+                    void *data)
+{
+        clnt_args_t        *args     = NULL;
+        int64_t             remote_fd = -1;
+        clnt_conf_t        *conf     = NULL;
+        gfs3_zerofill_req  req      = {{0,},};
+        int                 op_errno = EINVAL;
+        int                 ret      = 0;
+
+        if (!frame || !this || !data)
+                goto unwind;
+
+        args = data;
+
+        conf = this->private;
+
+        if (!conf->fallocate) {
+                /* the brick is too old for it */
+                op_errno = EOPNOTSUPP;
+                goto unwind;
+        }
+
+        CLIENT_GET_REMOTE_FD (this, args->fd, DEFAULT_REMOTE_FD,
+                              remote_fd, op_errno, unwind);
+
+        req.fd     = remote_fd;
+        req.offset = args->offset;
+        req.size   = args->size;
+        memcpy (req.gfid, args->fd->inode->gfid, 16);
+
+        GF_PROTOCOL_DICT_SERIALIZE (this, args->xdata, (&req.xdata.xdata_val),
+                                    req.xdata.xdata_len, op_errno, unwind);
+
+        ret = client_submit_request (this, &req, frame, conf->fops,
+                                     GFS3_OP_ZEROFILL,
+                                     client3_3_zerofill_cbk, NULL,
+                                     NULL, 0, NULL, 0,
+                                     NULL, (xdrproc_t)xdr_gfs3_zerofill_req);
+        if (ret) {
+                gf_log (this->name, GF_LOG_WARNING, "failed to send the fop");
+        }
+
+        GF_FREE (req.xdata.xdata_val);
+
+        return 0;
+unwind:
+        CLIENT_STACK_UNWIND (zerofill, frame, -1, op_errno, NULL, NULL, NULL);
+        GF_FREE (req.xdata.xdata_val);
+
+        return 0;
+}
+
+
+int32_t
+client3_3_seek (call_frame_t *frame, xlator_t *this,
+                void *data)
+{
+        clnt_args_t        *args     = NULL;
+        int64_t             remote_fd = -1;
+        clnt_conf_t        *conf     = NULL;
+        gfs3_seek_req       req      = {{0,},};
+        int                 op_errno = EINVAL;
+        int                 ret      = 0;
+
+        if (!frame || !this || !data)
+                goto unwind;
+
+        args = data;
+
+        conf = this->private;
+
+        if (!conf->seek) {
+                /* the brick is too old for it */
+                op_errno = EOPNOTSUPP;
+                goto unwind;
+        }
+
+        CLIENT_GET_REMOTE_FD (this, args->fd, DEFAULT_REMOTE_FD,
+                              remote_fd, op_errno, unwind);
+
+        req.fd     = remote_fd;
+        req.offset = args->offset;
+        req.what   = args->what;
+        memcpy (req.gfid, args->fd->inode->gfid, 16);
+
+        GF_PROTOCOL_DICT_SERIALIZE (this, args->xdata, (&req.xdata.xdata_val),
+                                    req.xdata.xdata_len, op_errno, unwind);
+
+        ret = client_submit_request (this, &req, frame, conf->fops,
+                                     GFS3_OP_SEEK,
+                                     client3_3_seek_cbk, NULL,
+                                     NULL, 0, NULL, 0,
+                                     NULL, (xdrproc_t)xdr_gfs3_seek_req);
+        if (ret) {
+                gf_log (this->name, GF_LOG_WARNING, "failed to send the fop");
+        }
+
+        GF_FREE (req.xdata.xdata_val);
+
+        return 0;
+unwind:
+        CLIENT_STACK_UNWIND (seek, frame, -1, op_errno, 0, NULL);
+        GF_FREE (req.xdata.xdata_val);
+
+        return 0;
+}
+
+
+
+int32_t
+client3_3_access (call_frame_t *frame, xlator_t *this,
+                  void *data)
+{
+        clnt_conf_t     *conf     = NULL;
+        clnt_args_t     *args     = NULL;
+        gfs3_access_req  req      = {{0,},};
+        int              ret      = 0;
+        int              op_errno = ESTALE;
+
+        if (!frame || !this || !data)
+                goto unwind;
+
+        args = data;
+
+        if (!(args->loc && args->loc->inode))
                 goto unwind;
 
         if (!uuid_is_null (args->loc->inode->gfid))
@@ -5656,8 +6177,11 @@ client3_3_readdirp (call_frame_t *frame, xlator_t *this,
                                     req.dict.dict_len, op_errno, unwind);
 
         ret = client_submit_request (this, &req, frame, conf->fops,
-                                     GFS3_OP_READDIRP,
-                                     client3_3_readdirp_cbk, NULL,
+                                     conf->readdirp2 ? GFS3_OP_READDIRP2 :
+                                                       GFS3_OP_READDIRP,
+                                     conf->readdirp2 ? client3_3_readdirp2_cbk :
+                                                       client3_3_readdirp_cbk,
+                                     NULL,
                                      rsphdr, count, NULL,
                                      0, rsp_iobref,
                                      (xdrproc_t)xdr_gfs3_readdirp_req);
@@ -5787,6 +6311,315 @@ unwind:
 }
 
 
+/* Every fop reply starts like a gf_common_rsp, and zeroes decode as empty
+   values for the rest of any of them (those of the fops a compound call
+   takes fit well within this size): the reply to hand the links which the
+   server did not run after an earlier one failed. */
+#define CLIENT_COMPOUND_ERR_RSP_SIZE 1024
+
+static int
+client_compound_err_rsp (struct iovec *iov, int op_errno)
+{
+        gf_common_rsp rsp = {0,};
+
+        memset (iov->iov_base, 0, iov->iov_len);
+
+        rsp.op_ret = -1;
+        rsp.op_errno = op_errno;
+
+        return xdr_serialize_generic (*iov, &rsp, (xdrproc_t)xdr_gf_common_rsp);
+}
+
+
+int
+client3_3_compound_cbk (struct rpc_req *req, struct iovec *iov, int count,
+                        void *myframe)
+{
+        call_frame_t         *frame     = NULL;
+        clnt_compound_t      *cc        = NULL;
+        clnt_compound_link_t *link      = NULL;
+        gfs3_compound_rsp     rsp       = {0,};
+        gfs3_compound_link   *rsp_link  = NULL;
+        struct rpc_req        link_req  = {0,};
+        char                 *payload   = NULL;
+        size_t                remaining = 0;
+        ssize_t               len       = 0;
+        int                   ret       = 0;
+        int                   i         = 0;
+        int                   n         = 0;
+        xlator_t             *this      = NULL;
+        dict_t               *xdata     = NULL;
+        char                  errbuf[CLIENT_COMPOUND_ERR_RSP_SIZE];
+        struct iovec          err_rsp   = {errbuf, sizeof (errbuf)};
+        gf_boolean_t          decoded   = _gf_false;
+
+        this = THIS;
+
+        frame = myframe;
+        cc = frame->local;
+        frame->local = NULL;
+
+        if (-1 == req->rpc_status) {
+                rsp.op_ret   = -1;
+                rsp.op_errno = ENOTCONN;
+                goto out;
+        }
+
+        len = xdr_to_generic (*iov, &rsp, (xdrproc_t)xdr_gfs3_compound_rsp);
+        if (len < 0) {
+                gf_log (this->name, GF_LOG_ERROR, "XDR decoding failed");
+                rsp.op_ret   = -1;
+                rsp.op_errno = EINVAL;
+                goto out;
+        }
+
+        /* read payloads follow the reply, in the order of the links */
+        payload = iov->iov_base + len;
+        remaining = iov->iov_len - len;
+        decoded = _gf_true;
+
+        /* the server stopped at a failed link, the ones after it did not
+           run and fail the same way */
+        if ((rsp.op_ret == -1) &&
+            (client_compound_err_rsp (&err_rsp, rsp.op_errno) < 0)) {
+                rsp.op_errno = EINVAL;
+                decoded = _gf_false;
+        }
+
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (this, xdata, (rsp.xdata.xdata_val),
+                                             (rsp.xdata.xdata_len), ret,
+                                             rsp.op_errno, out);
+
+out:
+        if (rsp.op_ret == -1) {
+                gf_log (this->name, GF_LOG_WARNING,
+                        "remote operation failed: %s",
+                        strerror (gf_error_to_errno (rsp.op_errno)));
+        }
+
+        /* hand every link which went out its own part of the reply; those
+           left out of a failed chain get its error, those the server did
+           not answer otherwise fail like a lost connection would */
+        for (i = 0; i < cc->count; i++) {
+                link = &cc->links[i];
+                if (!link->frame)
+                        continue;
+
+                memset (&link_req, 0, sizeof (link_req));
+                link_req.rpc_status = -1;
+
+                if (decoded && (n < rsp.links.links_len)) {
+                        rsp_link = &rsp.links.links_val[n++];
+                        if ((rsp_link->procnum == link->procnum) &&
+                            rsp_link->msg.msg_len &&
+                            (rsp_link->payload_len <= remaining)) {
+                                link_req.rpc_status = 0;
+                                link_req.rsp[0].iov_base =
+                                        rsp_link->msg.msg_val;
+                                link_req.rsp[0].iov_len =
+                                        rsp_link->msg.msg_len;
+                                link_req.rsp[1].iov_base = payload;
+                                link_req.rsp[1].iov_len =
+                                        rsp_link->payload_len;
+                                link_req.rspcnt = 2;
+                                link_req.rsp_iobref = req->rsp_iobref;
+                        }
+
+                        if (rsp_link->payload_len <= remaining) {
+                                payload += rsp_link->payload_len;
+                                remaining -= rsp_link->payload_len;
+                        } else {
+                                remaining = 0;
+                        }
+
+                        if (link_req.rpc_status && (rsp.op_ret == -1)) {
+                                link_req.rpc_status = 0;
+                                link_req.rsp[0] = err_rsp;
+                                link_req.rspcnt = 1;
+                        }
+                }
+
+                link->cbkfn (&link_req, &link_req.rsp[0], 1, link->frame);
+        }
+
+        STACK_UNWIND_STRICT (compound, frame, rsp.op_ret,
+                             gf_error_to_errno (rsp.op_errno), cc->args,
+                             xdata);
+
+        client_compound_destroy (cc);
+
+        for (i = 0; i < rsp.links.links_len; i++)
+                free (rsp.links.links_val[i].msg.msg_val);
+        free (rsp.links.links_val);
+
+        free (rsp.xdata.xdata_val);
+
+        if (xdata)
+                dict_unref (xdata);
+
+        return 0;
+}
+
+
+static int
+client3_3_compound_link_done (call_frame_t *frame, xlator_t *this,
+                              compound_args_t *args, int index)
+{
+        /* results are collected as the links unwind, the compound call
+           itself unwinds from client3_3_compound_cbk () */
+        return 0;
+}
+
+
+int32_t
+client3_3_compound (call_frame_t *frame, xlator_t *this, void *data)
+{
+        clnt_args_t        *args       = NULL;
+        clnt_conf_t        *conf       = NULL;
+        compound_args_t    *cargs      = NULL;
+        clnt_compound_t    *cc         = NULL;
+        gfs3_compound_req   req        = {{0,},};
+        gfs3_compound_link *req_link   = NULL;
+        struct iovec       *payload    = NULL;
+        struct iobuf       *iobuf      = NULL;
+        int                 payloadcnt = 0;
+        size_t              size       = 0;
+        int                 op_errno   = ENOMEM;
+        int                 i          = 0;
+        int                 ret        = 0;
+
+        if (!frame || !this || !data)
+                goto unwind;
+
+        args = data;
+        conf = this->private;
+        cargs = args->compound;
+
+        cc = GF_CALLOC (1, sizeof (*cc), gf_client_mt_compound_t);
+        if (!cc)
+                goto unwind;
+
+        cc->args  = cargs;
+        cc->count = cargs->count;
+        cc->links = GF_CALLOC (cargs->count, sizeof (*cc->links),
+                               gf_client_mt_compound_t);
+        if (!cc->links)
+                goto unwind;
+
+        cc->iobref = iobref_new ();
+        if (!cc->iobref)
+                goto unwind;
+
+        /* every link goes through client3_3_<fop> () as usual, which leaves
+           its encoded request in cc->links instead of sending it */
+        frame->local = cc;
+        for (i = 0; i < cargs->count; i++) {
+                cc->current = i;
+                compound_link_wind (frame, this, cargs, i,
+                                    client3_3_compound_link_done);
+        }
+        cc->current = -1;
+
+        req.links.links_val = GF_CALLOC (cargs->count,
+                                         sizeof (*req.links.links_val),
+                                         gf_client_mt_compound_t);
+        if (!req.links.links_val)
+                goto fail;
+
+        for (i = 0; i < cargs->count; i++) {
+                if (!cc->links[i].frame)
+                        continue;
+
+                req_link = &req.links.links_val[req.links.links_len++];
+                req_link->procnum = cc->links[i].procnum;
+                req_link->msg.msg_val = cc->links[i].msg.iov_base;
+                req_link->msg.msg_len = cc->links[i].msg.iov_len;
+                req_link->payload_len = iov_length (cc->links[i].payload,
+                                                    cc->links[i].payloadcnt);
+                payloadcnt += cc->links[i].payloadcnt;
+                size += req_link->payload_len;
+        }
+
+        if (!req.links.links_len) {
+                /* all of them failed before they got here */
+                frame->local = NULL;
+                STACK_UNWIND_STRICT (compound, frame, 0, 0, cargs, NULL);
+                client_compound_destroy (cc);
+                GF_FREE (req.links.links_val);
+                return 0;
+        }
+
+        if (payloadcnt) {
+                payload = GF_CALLOC (payloadcnt, sizeof (*payload),
+                                     gf_client_mt_compound_t);
+                if (!payload)
+                        goto fail;
+
+                payloadcnt = 0;
+                for (i = 0; i < cargs->count; i++) {
+                        if (!cc->links[i].frame)
+                                continue;
+                        memcpy (&payload[payloadcnt], cc->links[i].payload,
+                                cc->links[i].payloadcnt * sizeof (*payload));
+                        payloadcnt += cc->links[i].payloadcnt;
+                }
+
+                /* the transport takes only so many vectors per message */
+                if (payloadcnt > (MAX_IOVEC - 3)) {
+                        iobuf = iobuf_get2 (this->ctx->iobuf_pool, size);
+                        if (!iobuf)
+                                goto fail;
+
+                        iobref_add (cc->iobref, iobuf);
+                        iov_unload (iobuf_ptr (iobuf), payload, payloadcnt);
+                        payload[0].iov_base = iobuf_ptr (iobuf);
+                        payload[0].iov_len = size;
+                        payloadcnt = 1;
+                        iobuf_unref (iobuf);
+                }
+        }
+
+        GF_PROTOCOL_DICT_SERIALIZE (this, args->xdata, (&req.xdata.xdata_val),
+                                    req.xdata.xdata_len, op_errno, fail);
+
+        ret = client_submit_vec_request (this, &req, frame, conf->fops,
+                                         GFS3_OP_COMPOUND,
+                                         client3_3_compound_cbk,
+                                         payload, payloadcnt, cc->iobref,
+                                         (xdrproc_t)xdr_gfs3_compound_req);
+        if (ret) {
+                gf_log (this->name, GF_LOG_WARNING, "failed to send the fop");
+        }
+
+        GF_FREE (payload);
+        GF_FREE (req.links.links_val);
+        GF_FREE (req.xdata.xdata_val);
+
+        return 0;
+
+fail:
+        /* the links which went through client3_3_<fop> () still wait for
+           their reply, fail them as if the call had been lost */
+        {
+                struct rpc_req rpcreq = {0, };
+
+                rpcreq.rpc_status = -1;
+                client3_3_compound_cbk (&rpcreq, NULL, 0, frame);
+        }
+
+        GF_FREE (payload);
+        GF_FREE (req.links.links_val);
+        GF_FREE (req.xdata.xdata_val);
+
+        return 0;
+
+unwind:
+        STACK_UNWIND_STRICT (compound, frame, -1, op_errno, cargs, NULL);
+        client_compound_destroy (cc);
+
+        return 0;
+}
+
 
 /* Table Specific to FOPS */
 
@@ -5837,6 +6670,11 @@ rpc_clnt_procedure_t clnt3_3_fop_actors[GF_FOP_MAXVALUE] = {
         [GF_FOP_RELEASEDIR]  = { "RELEASEDIR",  client3_3_releasedir },
         [GF_FOP_GETSPEC]     = { "GETSPEC",     client3_getspec },
         [GF_FOP_FREMOVEXATTR] = { "FREMOVEXATTR", client3_3_fremovexattr },
+        [GF_FOP_COMPOUND]    = { "COMPOUND",    client3_3_compound },
+        [GF_FOP_FALLOCATE]   = { "FALLOCATE",   client3_3_fallocate },
+        [GF_FOP_DISCARD]     = { "DISCARD",     client3_3_discard },
+        [GF_FOP_ZEROFILL]    = { "ZEROFILL",    client3_3_zerofill },
+        [GF_FOP_SEEK]        = { "SEEK",        client3_3_seek },
 };
 
 /* Used From RPC-CLNT library to log proper name of procedure based on number */
@@ -5885,6 +6723,12 @@ char *clnt3_3_fop_names[GFS3_OP_MAXVALUE] = {
         [GFS3_OP_RELEASE]     = "RELEASE",
         [GFS3_OP_RELEASEDIR]  = "RELEASEDIR",
         [GFS3_OP_FREMOVEXATTR] = "FREMOVEXATTR",
+        [GFS3_OP_COMPOUND]    = "COMPOUND",
+        [GFS3_OP_READDIRP2]   = "READDIRP2",
+        [GFS3_OP_FALLOCATE]   = "FALLOCATE",
+        [GFS3_OP_DISCARD]     = "DISCARD",
+        [GFS3_OP_ZEROFILL]    = "ZEROFILL",
+        [GFS3_OP_SEEK]        = "SEEK",
 };
 
 rpc_clnt_prog_t clnt3_3_fop_prog = {
@@ -20,6 +20,8 @@
 #include "glusterfs.h"
 #include "statedump.h"
 #include "compat-errno.h"
+#include "call-stub.h"
+#include "event.h"
 
 #include "glusterfs3.h"
 
@@ -142,6 +144,138 @@ out:
         return ret;
 }
 
+/* The links of a compound call are wound by client3_3_compound () to this
+   very client, with the compound frame as their parent, which is how no
+   other client frame is ever wound. */
+clnt_compound_t *
+client_compound_of (xlator_t *this, call_frame_t *frame)
+{
+        if (!frame || !frame->parent || (frame->parent->this != this))
+                return NULL;
+
+        return frame->parent->local;
+}
+
+
+/* Keeps the request of a compound link instead of sending it; it goes out
+   with the others in one GFS3_OP_COMPOUND and cbkfn gets its part of the
+   reply. */
+int
+client_compound_capture (xlator_t *this, clnt_compound_t *cc,
+                         call_frame_t *frame, int procnum, fop_cbk_fn_t cbkfn,
+                         void *req, xdrproc_t xdrproc, struct iovec *payload,
+                         int payloadcnt, struct iobref *iobref)
+{
+        clnt_compound_link_t *link     = NULL;
+        struct iobuf         *iobuf    = NULL;
+        ssize_t               xdr_size = 0;
+        int                   ret      = -1;
+
+        GF_ASSERT (cc->current >= 0);
+
+        link = &cc->links[cc->current];
+
+        xdr_size = xdr_sizeof (xdrproc, req);
+        iobuf = iobuf_get2 (this->ctx->iobuf_pool, xdr_size);
+        if (!iobuf)
+                goto out;
+
+        iobref_add (cc->iobref, iobuf);
+
+        link->msg.iov_base = iobuf->ptr;
+        link->msg.iov_len  = iobuf_size (iobuf);
+
+        ret = xdr_serialize_generic (link->msg, req, xdrproc);
+        if (ret == -1) {
+                gf_log_callingfn (this->name, GF_LOG_WARNING,
+                                  "XDR payload creation failed");
+                goto out;
+        }
+        link->msg.iov_len = ret;
+
+        if (payloadcnt) {
+                link->payload = iov_dup (payload, payloadcnt);
+                if (!link->payload) {
+                        ret = -1;
+                        goto out;
+                }
+                link->payloadcnt = payloadcnt;
+        }
+
+        if (iobref)
+                iobref_merge (cc->iobref, iobref);
+
+        link->procnum = procnum;
+        link->cbkfn   = cbkfn;
+        link->frame   = frame;
+
+        ret = 0;
+out:
+        if (iobuf)
+                iobuf_unref (iobuf);
+
+        return ret;
+}
+
+
+void
+client_compound_destroy (clnt_compound_t *cc)
+{
+        int i = 0;
+
+        if (!cc)
+                return;
+
+        if (cc->links) {
+                for (i = 0; i < cc->count; i++)
+                        GF_FREE (cc->links[i].payload);
+                GF_FREE (cc->links);
+        }
+
+        if (cc->iobref)
+                iobref_unref (cc->iobref);
+
+        GF_FREE (cc);
+}
+
+
+/* reads and writes go over the extra connections if there are any, an fd
+   always over the same one so that its requests keep their order */
+struct rpc_clnt *
+client_pick_rpc (xlator_t *this, rpc_clnt_prog_t *prog, int procnum,
+                 void *req)
+{
+        clnt_conf_t      *conf = NULL;
+        clnt_data_conn_t *dc   = NULL;
+        int64_t           fd   = -1;
+
+        conf = this->private;
+
+        if (!conf->data_conns || !req || (prog != conf->fops))
+                return conf->rpc;
+
+        switch (procnum) {
+        case GFS3_OP_READ:
+                fd = ((gfs3_read_req *)req)->fd;
+                break;
+        case GFS3_OP_WRITE:
+                fd = ((gfs3_write_req *)req)->fd;
+                break;
+        default:
+                break;
+        }
+
+        if (fd < 0)
+                return conf->rpc;
+
+        dc = &conf->data_conns[fd % (conf->transport_count - 1)];
+        if (!dc->attached)
+                return conf->rpc;
+
+        return dc->rpc;
+}
+
+
 int
 client_submit_request (xlator_t *this, void *req, call_frame_t *frame,
                        rpc_clnt_prog_t *prog, int procnum, fop_cbk_fn_t cbkfn,
@@ -149,6 +283,27 @@ client_submit_request (xlator_t *this, void *req, call_frame_t *frame,
                        int rsphdr_count, struct iovec *rsp_payload,
                        int rsp_payload_count, struct iobref *rsp_iobref,
                        xdrproc_t xdrproc)
+{
+        struct rpc_clnt *rpc = NULL;
+
+        if (this && this->private)
+                rpc = client_pick_rpc (this, prog, procnum, req);
+
+        return client_submit_request_on (this, rpc, req, frame, prog, procnum,
+                                         cbkfn, iobref, rsphdr, rsphdr_count,
+                                         rsp_payload, rsp_payload_count,
+                                         rsp_iobref, xdrproc);
+}
+
+
+int
+client_submit_request_on (xlator_t *this, struct rpc_clnt *rpc, void *req,
+                          call_frame_t *frame, rpc_clnt_prog_t *prog,
+                          int procnum, fop_cbk_fn_t cbkfn,
+                          struct iobref *iobref,  struct iovec *rsphdr,
+                          int rsphdr_count, struct iovec *rsp_payload,
+                          int rsp_payload_count, struct iobref *rsp_iobref,
+                          xdrproc_t xdrproc)
 {
         int             ret        = -1;
         clnt_conf_t    *conf       = NULL;
@@ -159,13 +314,24 @@ client_submit_request (xlator_t *this, void *req, call_frame_t *frame,
         struct iobref  *new_iobref = NULL;
         ssize_t         xdr_size   = 0;
         struct rpc_req  rpcreq     = {0, };
+        clnt_compound_t *cc        = NULL;
 
         GF_VALIDATE_OR_GOTO ("client", this, out);
         GF_VALIDATE_OR_GOTO (this->name, prog, out);
         GF_VALIDATE_OR_GOTO (this->name, frame, out);
+        GF_VALIDATE_OR_GOTO (this->name, rpc, out);
 
         conf = this->private;
 
+        cc = client_compound_of (this, frame);
+        if (cc) {
+                ret = client_compound_capture (this, cc, frame, procnum, cbkfn,
+                                               req, xdrproc, NULL, 0, iobref);
+                if (ret)
+                        goto out;
+                return 0;
+        }
+
         /* If 'setvolume' is not successful, we should not send frames to
            server, mean time we should be able to send 'DUMP' and 'SETVOLUME'
            call itself even if its not connected */
@@ -226,7 +392,7 @@ client_submit_request (xlator_t *this, void *req, call_frame_t *frame,
         }
 
         /* Send the msg */
-        ret = rpc_clnt_submit (conf->rpc, prog, procnum, cbkfn, &iov, count,
+        ret = rpc_clnt_submit (rpc, prog, procnum, cbkfn, &iov, count,
                                NULL, 0, new_iobref, frame, rsphdr, rsphdr_count,
                                rsp_payload, rsp_payload_count, rsp_iobref);
 
@@ -477,6 +643,151 @@ out:
 }
 
 
+int32_t
+client_fallocate (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                  int32_t keep_size, off_t offset, size_t len,
+                  dict_t *xdata)
+{
+        int          ret  = -1;
+        clnt_conf_t *conf = NULL;
+        rpc_clnt_procedure_t *proc = NULL;
+        clnt_args_t  args = {0,};
+
+        conf = this->private;
+        if (!conf || !conf->fops)
+                goto out;
+
+        args.fd     = fd;
+        args.flags  = keep_size;
+        args.offset = offset;
+        args.size   = len;
+        args.xdata  = xdata;
+
+        proc = &conf->fops->proctable[GF_FOP_FALLOCATE];
+        if (!proc) {
+                gf_log (this->name, GF_LOG_ERROR,
+                        "rpc procedure not found for %s",
+                        gf_fop_list[GF_FOP_FALLOCATE]);
+                goto out;
+        }
+        if (proc->fn)
+                ret = proc->fn (frame, this, &args);
+out:
+        if (ret)
+                STACK_UNWIND_STRICT (fallocate, frame, -1, ENOTCONN, NULL, NULL,
+                                     NULL);
+
+        return 0;
+}
+
+
+int32_t
+client_discard (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                off_t offset, size_t len, dict_t *xdata)
+{
+        int          ret  = -1;
+        clnt_conf_t *conf = NULL;
+        rpc_clnt_procedure_t *proc = NULL;
+        clnt_args_t  args = {0,};
+
+        conf = this->private;
+        if (!conf || !conf->fops)
+                goto out;
+
+        args.fd     = fd;
+        args.offset = offset;
+        args.size   = len;
+        args.xdata  = xdata;
+
+        proc = &conf->fops->proctable[GF_FOP_DISCARD];
+        if (!proc) {
+                gf_log (this->name, GF_LOG_ERROR,
+                        "rpc procedure not found for %s",
+                        gf_fop_list[GF_FOP_DISCARD]);
+                goto out;
+        }
+        if (proc->fn)
+                ret = proc->fn (frame, this, &args);
+out:
+        if (ret)
+                STACK_UNWIND_STRICT (discard, frame, -1, ENOTCONN, NULL, NULL,
+                                     NULL);
+
+        return 0;
+}
+
+
+int32_t
+client_zerofill (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                 off_t offset, off_t len, dict_t *xdata)
+{
+        int          ret  = -1;
+        clnt_conf_t *conf = NULL;
+        rpc_clnt_procedure_t *proc = NULL;
+        clnt_args_t  args = {0,};
+
+        conf = this->private;
+        if (!conf || !conf->fops)
+                goto out;
+
+        args.fd     = fd;
+        args.offset = offset;
+        args.size   = len;
+        args.xdata  = xdata;
+
+        proc = &conf->fops->proctable[GF_FOP_ZEROFILL];
+        if (!proc) {
+                gf_log (this->name, GF_LOG_ERROR,
+                        "rpc procedure not found for %s",
+                        gf_fop_list[GF_FOP_ZEROFILL]);
+                goto out;
+        }
+        if (proc->fn)
+                ret = proc->fn (frame, this, &args);
+out:
+        if (ret)
+                STACK_UNWIND_STRICT (zerofill, frame, -1, ENOTCONN, NULL, NULL,
+                                     NULL);
+
+        return 0;
+}
+
+
+int32_t
+client_seek (call_frame_t *frame, xlator_t *this, fd_t *fd,
+             off_t offset, gf_seek_what_t what, dict_t *xdata)
+{
+        int          ret  = -1;
+        clnt_conf_t *conf = NULL;
+        rpc_clnt_procedure_t *proc = NULL;
+        clnt_args_t  args = {0,};
+
+        conf = this->private;
+        if (!conf || !conf->fops)
+                goto out;
+
+        args.fd     = fd;
+        args.offset = offset;
+        args.what   = what;
+        args.xdata  = xdata;
+
+        proc = &conf->fops->proctable[GF_FOP_SEEK];
+        if (!proc) {
+                gf_log (this->name, GF_LOG_ERROR,
+                        "rpc procedure not found for %s",
+                        gf_fop_list[GF_FOP_SEEK]);
+                goto out;
+        }
+        if (proc->fn)
+                ret = proc->fn (frame, this, &args);
+out:
+        if (ret)
+                STACK_UNWIND_STRICT (seek, frame, -1, ENOTCONN, 0, NULL);
+
+        return 0;
+}
+
+
 
 int32_t
 client_access (call_frame_t *frame, xlator_t *this, loc_t *loc,
@@ -1998,6 +2309,40 @@ out:
 }
 
 
+int32_t
+client_compound (call_frame_t *frame, xlator_t *this, compound_args_t *cargs,
+                 dict_t *xdata)
+{
+        int          ret  = -1;
+        clnt_conf_t *conf = NULL;
+        rpc_clnt_procedure_t *proc = NULL;
+        clnt_args_t  args = {0,};
+
+        conf = this->private;
+        if (!conf || !conf->fops)
+                goto out;
+
+        args.compound = cargs;
+        args.xdata = xdata;
+
+        proc = &conf->fops->proctable[GF_FOP_COMPOUND];
+        if (!proc) {
+                gf_log (this->name, GF_LOG_ERROR,
+                        "rpc procedure not found for %s",
+                        gf_fop_list[GF_FOP_COMPOUND]);
+                goto out;
+        }
+        if (proc->fn)
+                ret = proc->fn (frame, this, &args);
+out:
+        if (ret)
+                STACK_UNWIND_STRICT (compound, frame, -1, ENOTCONN, cargs,
+                                     NULL);
+
+	return 0;
+}
+
+
 int
 client_mark_fd_bad (xlator_t *this)
 {
@@ -2019,6 +2364,173 @@ client_mark_fd_bad (xlator_t *this)
 }
 
 
+static uint16_t
+client_peer_port (struct rpc_clnt *rpc)
+{
+        struct sockaddr_storage *sa = NULL;
+
+        sa = &rpc->conn.trans->peerinfo.sockaddr;
+
+        switch (sa->ss_family) {
+        case AF_INET:
+                return ntohs (((struct sockaddr_in *)sa)->sin_port);
+        case AF_INET6:
+                return ntohs (((struct sockaddr_in6 *)sa)->sin6_port);
+        default:
+                return 0;
+        }
+}
+
+
+/* a data connection would come back on the default port (glusterd) after
+   a disconnect, point it at the brick again */
+static void
+client_data_conn_set_port (clnt_conf_t *conf, clnt_data_conn_t *dc)
+{
+        struct rpc_clnt_config config = {0, };
+
+        if (!conf->data_port)
+                return;
+
+        config.remote_port = conf->data_port;
+        rpc_clnt_reconfig (dc->rpc, &config);
+}
+
+
+/* called once SETVOLUME succeeded on conf->rpc */
+void
+client_attach_data_conns (xlator_t *this)
+{
+        clnt_conf_t      *conf   = NULL;
+        clnt_data_conn_t *dc     = NULL;
+        char              start  = 0;
+        char              attach = 0;
+        int               i      = 0;
+
+        conf = this->private;
+
+        pthread_mutex_lock (&conf->lock);
+        {
+                conf->attached = 1;
+                conf->data_port = client_peer_port (conf->rpc);
+        }
+        pthread_mutex_unlock (&conf->lock);
+
+        if (!conf->data_conns)
+                return;
+
+        for (i = 0; i < conf->transport_count - 1; i++) {
+                dc = &conf->data_conns[i];
+
+                pthread_mutex_lock (&conf->lock);
+                {
+                        start = !dc->started;
+                        dc->started = 1;
+                        attach = dc->connected && !dc->attached;
+                        client_data_conn_set_port (conf, dc);
+                }
+                pthread_mutex_unlock (&conf->lock);
+
+                if (start)
+                        rpc_clnt_start (dc->rpc);
+                else if (attach)
+                        client_setvolume (this, dc->rpc);
+        }
+}
+
+
+/* the data connections go down with conf->rpc, so that the server side
+   connection they share goes away along with its fds and locks */
+static void
+client_detach_data_conns (xlator_t *this)
+{
+        clnt_conf_t      *conf       = NULL;
+        clnt_data_conn_t *dc         = NULL;
+        char              disconnect = 0;
+        int               i          = 0;
+
+        conf = this->private;
+
+        pthread_mutex_lock (&conf->lock);
+        {
+                conf->attached = 0;
+        }
+        pthread_mutex_unlock (&conf->lock);
+
+        if (!conf->data_conns)
+                return;
+
+        for (i = 0; i < conf->transport_count - 1; i++) {
+                dc = &conf->data_conns[i];
+
+                pthread_mutex_lock (&conf->lock);
+                {
+                        dc->attached = 0;
+                        disconnect = dc->connected;
+                }
+                pthread_mutex_unlock (&conf->lock);
+
+                if (disconnect)
+                        rpc_transport_disconnect (dc->rpc->conn.trans);
+        }
+}
+
+
+static int
+client_data_rpc_notify (struct rpc_clnt *rpc, void *mydata,
+                        rpc_clnt_event_t event, void *data)
+{
+        clnt_data_conn_t *dc     = NULL;
+        xlator_t         *this   = NULL;
+        clnt_conf_t      *conf   = NULL;
+        char              attach = 0;
+
+        dc = mydata;
+        this = dc->this;
+        conf = this->private;
+        if (!conf)
+                goto out;
+
+        switch (event) {
+        case RPC_CLNT_CONNECT:
+                gf_log (this->name, GF_LOG_DEBUG,
+                        "data connection %d connected", dc->index);
+
+                pthread_mutex_lock (&conf->lock);
+                {
+                        dc->connected = 1;
+                        attach = conf->attached;
+                }
+                pthread_mutex_unlock (&conf->lock);
+
+                /* else client_attach_data_conns () does it later */
+                if (attach)
+                        client_setvolume (this, dc->rpc);
+                break;
+
+        case RPC_CLNT_DISCONNECT:
+                pthread_mutex_lock (&conf->lock);
+                {
+                        if (dc->attached)
+                                gf_log (this->name, GF_LOG_INFO,
+                                        "data connection %d disconnected",
+                                        dc->index);
+                        dc->connected = 0;
+                        dc->attached = 0;
+                        client_data_conn_set_port (conf, dc);
+                }
+                pthread_mutex_unlock (&conf->lock);
+                break;
+
+        default:
+                break;
+        }
+
+out:
+        return 0;
+}
+
+
 int
 client_rpc_notify (struct rpc_clnt *rpc, void *mydata, rpc_clnt_event_t event,
                    void *data)
@@ -2118,6 +2630,8 @@ client_rpc_notify (struct rpc_clnt *rpc, void *mydata, rpc_clnt_event_t event,
                 conf->connected = 0;
                 conf->skip_notify = 0;
 
+                client_detach_data_conns (this);
+
 		if (conf->quick_reconnect) {
 			conf->quick_reconnect = 0;
 			rpc_clnt_start (conf->rpc);
@@ -2141,6 +2655,7 @@ int
 notify (xlator_t *this, int32_t event, void *data, ...)
 {
         clnt_conf_t     *conf  = NULL;
+        int              i     = 0;
 
         conf = this->private;
         if (!conf)
@@ -2169,6 +2684,9 @@ notify (xlator_t *this, int32_t event, void *data, ...)
                 pthread_mutex_unlock (&conf->lock);
 
                 rpc_clnt_disable (conf->rpc);
+                for (i = 0; conf->data_conns &&
+                             (i < conf->transport_count - 1); i++)
+                        rpc_clnt_disable (conf->data_conns[i].rpc);
                 break;
 
         default:
@@ -2209,6 +2727,16 @@ build_client_config (xlator_t *this, clnt_conf_t *conf)
         GF_OPTION_INIT ("filter-O_DIRECT", conf->filter_o_direct,
                         bool, out);
 
+        GF_OPTION_INIT ("event-threads", conf->event_threads,
+                        int32, out);
+
+        GF_OPTION_INIT ("transport-count", conf->transport_count,
+                        int32, out);
+        /* only an explicit setting may override --event-threads */
+        if (dict_get (this->options, "event-threads"))
+                event_pool_set_threadcount (this->ctx->event_pool,
+                                            conf->event_threads);
+
         ret = 0;
 out:
         return ret;
@@ -2234,6 +2762,85 @@ mem_acct_init (xlator_t *this)
         return ret;
 }
 
+static void
+client_destroy_data_conns (clnt_conf_t *conf)
+{
+        int i = 0;
+
+        if (!conf->data_conns)
+                return;
+
+        for (i = 0; i < conf->transport_count - 1; i++) {
+                if (!conf->data_conns[i].rpc)
+                        continue;
+
+                rpc_clnt_connection_cleanup (&conf->data_conns[i].rpc->conn);
+                rpc_clnt_unref (conf->data_conns[i].rpc);
+        }
+
+        GF_FREE (conf->data_conns);
+        conf->data_conns = NULL;
+}
+
+
+static int
+client_init_data_conns (xlator_t *this)
+{
+        clnt_conf_t      *conf = NULL;
+        clnt_data_conn_t *dc   = NULL;
+        int               ret  = -1;
+        int               i    = 0;
+
+        conf = this->private;
+
+        if (conf->transport_count <= 1)
+                return 0;
+
+        /* with lock healing a disconnect of any connection starts the
+           server's grace timer and drops the internal locks */
+        if (conf->lk_heal) {
+                gf_log (this->name, GF_LOG_WARNING, "lock healing is on, "
+                        "using a single connection to the brick");
+                return 0;
+        }
+
+        conf->data_conns = GF_CALLOC (conf->transport_count - 1,
+                                      sizeof (*conf->data_conns),
+                                      gf_client_mt_data_conn_t);
+        if (!conf->data_conns)
+                goto out;
+
+        for (i = 0; i < conf->transport_count - 1; i++) {
+                dc = &conf->data_conns[i];
+                dc->this = this;
+                dc->index = i;
+
+                dc->rpc = rpc_clnt_new (this->options, this->ctx, this->name,
+                                        0);
+                if (!dc->rpc) {
+                        gf_log (this->name, GF_LOG_ERROR,
+                                "failed to initialize data connection %d", i);
+                        goto out;
+                }
+
+                ret = rpc_clnt_register_notify (dc->rpc,
+                                                client_data_rpc_notify, dc);
+                if (ret) {
+                        gf_log (this->name, GF_LOG_ERROR,
+                                "failed to register notify");
+                        goto out;
+                }
+        }
+
+        ret = 0;
+out:
+        if (ret)
+                client_destroy_data_conns (conf);
+
+        return ret;
+}
+
+
 int
 client_destroy_rpc (xlator_t *this)
 {
@@ -2245,6 +2852,8 @@ client_destroy_rpc (xlator_t *this)
                 goto out;
 
         if (conf->rpc) {
+                client_destroy_data_conns (conf);
+
                 /* cleanup the saved-frames before last unref */
                 rpc_clnt_connection_cleanup (&conf->rpc->conn);
 
@@ -2301,7 +2910,9 @@ client_init_rpc (xlator_t *this)
                 goto out;
         }
 
-        ret = 0;
+        ret = client_init_data_conns (this);
+        if (ret)
+                goto out;
 
         gf_log (this->name, GF_LOG_DEBUG, "client init successful");
 out:
@@ -2356,6 +2967,8 @@ reconfigure (xlator_t *this, dict_t *options)
         char        *new_remote_subvol = NULL;
         char        *old_remote_host   = NULL;
         char        *new_remote_host   = NULL;
+        int32_t      event_threads     = 0;
+        int32_t      transport_count   = 0;
 
 	conf = this->private;
 
@@ -2393,9 +3006,25 @@ reconfigure (xlator_t *this, dict_t *options)
                 }
         }
 
+        /* the connections are set up in init, a new graph has to do it */
+        GF_OPTION_RECONF ("transport-count", transport_count,
+                          options, int32, out);
+        if (transport_count != conf->transport_count) {
+                ret = 1;
+                goto out;
+        }
+
         GF_OPTION_RECONF ("filter-O_DIRECT", conf->filter_o_direct,
                           options, bool, out);
 
+        GF_OPTION_RECONF ("event-threads", event_threads,
+                          options, int32, out);
+        if (event_threads != conf->event_threads) {
+                conf->event_threads = event_threads;
+                event_pool_set_threadcount (this->ctx->event_pool,
+                                            conf->event_threads);
+        }
+
         ret = client_init_grace_timer (this, options, conf);
         if (ret)
                 goto out;
@@ -2487,6 +3116,8 @@ fini (xlator_t *this)
         this->private = NULL;
 
         if (conf) {
+                client_destroy_data_conns (conf);
+
                 if (conf->rpc) {
                         /* cleanup the saved-frames before last unref */
                         rpc_clnt_connection_cleanup (&conf->rpc->conn);
@@ -2593,6 +3224,26 @@ client_priv_dump (xlator_t *this)
 
                 gf_proc_dump_write("total_bytes_written", "%"PRIu64,
                                    conf->rpc->conn.trans->total_bytes_write);
+
+                gf_proc_dump_write("total_msgs_written", "%"PRIu64,
+                                   conf->rpc->conn.trans->total_msgs_write);
+
+                gf_proc_dump_write("total_write_calls", "%"PRIu64,
+                                   conf->rpc->conn.trans->total_write_calls);
+        }
+
+        for (i = 0; conf->data_conns && (i < conf->transport_count - 1);
+             i++) {
+                sprintf (key, "data_conn.%d.attached", i);
+                gf_proc_dump_write (key, "%d", conf->data_conns[i].attached);
+
+                sprintf (key, "data_conn.%d.total_bytes_read", i);
+                gf_proc_dump_write (key, "%"PRIu64, conf->data_conns[i].rpc->
+                                    conn.trans->total_bytes_read);
+
+                sprintf (key, "data_conn.%d.total_bytes_written", i);
+                gf_proc_dump_write (key, "%"PRIu64, conf->data_conns[i].rpc->
+                                    conn.trans->total_bytes_write);
         }
         pthread_mutex_unlock(&conf->lock);
 
@@ -2666,6 +3317,11 @@ struct xlator_fops fops = {
         .setattr     = client_setattr,
         .fsetattr    = client_fsetattr,
         .getspec     = client_getspec,
+        .compound    = client_compound,
+        .fallocate   = client_fallocate,
+        .discard     = client_discard,
+        .zerofill    = client_zerofill,
+        .seek        = client_seek,
 };
 
 
@@ -2742,5 +3398,24 @@ struct volume_options options[] = {
           "still continue to cache the file. This works similar to NFS's "
           "behavior of O_DIRECT",
         },
+        { .key   = {"event-threads"},
+          .type  = GF_OPTION_TYPE_INT,
+          .min   = 1,
+          .max   = EVENT_MAX_THREADS,
+          .default_value = "1",
+          .description = "Number of threads dispatching network events in "
+                         "the client process. Raising it only adds threads, "
+                         "lowering it takes effect on the next restart."
+        },
+        { .key   = {"transport-count"},
+          .type  = GF_OPTION_TYPE_INT,
+          .min   = 1,
+          .max   = CLIENT_MAX_TRANSPORT_COUNT,
+          .default_value = "1",
+          .description = "Number of connections to the brick. Reads and "
+                         "writes are spread by file over all but the first, "
+                         "which carries everything else. Not used when "
+                         "lock healing is on."
+        },
         { .key   = {NULL} },
 };
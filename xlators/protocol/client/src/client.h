@@ -64,6 +64,20 @@ typedef enum {
         } while (0)
 
 
+#define CLIENT_MAX_TRANSPORT_COUNT 16
+
+/* an extra connection to the brick, carrying reads and writes. It attaches
+   to the same server side connection as conf->rpc, and goes down and comes
+   back up along with it. */
+typedef struct clnt_data_conn {
+        struct rpc_clnt       *rpc;
+        xlator_t              *this;
+        int                    index;
+        char                   started;   /* rpc_clnt_start () was called */
+        char                   connected; /* the transport is up */
+        char                   attached;  /* SETVOLUME succeeded on it */
+} clnt_data_conn_t;
+
 struct clnt_options {
         char *remote_subvolume;
         int   ping_timeout;
@@ -114,8 +128,23 @@ typedef struct clnt_conf {
 						   the reconnection happen after
 						   the usual 3-second wait
 						*/
+        int32_t                event_threads;
         gf_boolean_t           filter_o_direct; /* if set, filter O_DIRECT from
                                                    the flags list of open() */
+        int32_t                transport_count; /* connections to the brick,
+                                                   including rpc */
+        clnt_data_conn_t      *data_conns;      /* transport_count - 1 of
+                                                   them */
+        uint16_t               data_port;       /* port rpc attached on */
+        char                   attached;        /* SETVOLUME succeeded on
+                                                   rpc */
+        char                   readdirp2;       /* the brick takes
+                                                   GFS3_OP_READDIRP2 */
+        char                   fallocate;       /* the brick takes
+                                                   GFS3_OP_FALLOCATE,
+                                                   DISCARD and ZEROFILL */
+        char                   seek;            /* the brick takes
+                                                   GFS3_OP_SEEK */
 } clnt_conf_t;
 
 typedef struct _client_fd_ctx {
@@ -190,13 +219,34 @@ typedef struct client_args {
         entrylk_cmd         cmd_entrylk;
         entrylk_type        type;
         gf_xattrop_flags_t  optype;
+        gf_seek_what_t      what;
         int32_t             valid;
         int32_t             len;
 
         mode_t              umask;
         dict_t             *xdata;
+        compound_args_t    *compound;
 } clnt_args_t;
 
+/* a fop of a compound call: the request client3_3_<fop> () would have sent,
+   and what to hand the reply to once the compound reply is back */
+typedef struct client_compound_link {
+        call_frame_t       *frame;   /* NULL if the fop unwound right away */
+        int                 procnum;
+        fop_cbk_fn_t        cbkfn;
+        struct iovec        msg;     /* encoded gfs3_<fop>_req */
+        struct iovec       *payload;
+        int                 payloadcnt;
+} clnt_compound_link_t;
+
+typedef struct client_compound {
+        compound_args_t      *args;     /* the caller's, gone after unwind */
+        int                   count;
+        int                   current;  /* link being wound, -1 after */
+        struct iobref        *iobref;   /* holds all the links' buffers */
+        clnt_compound_link_t *links;
+} clnt_compound_t;
+
 typedef ssize_t (*gfs_serialize_t) (struct iovec outmsg, void *args);
 
 clnt_fd_ctx_t *this_fd_get_ctx (fd_t *file, xlator_t *this);
@@ -213,10 +263,33 @@ int client_submit_request (xlator_t *this, void *req,
                            struct iovec *rsp_payload, int rsp_count,
                            struct iobref *rsp_iobref, xdrproc_t xdrproc);
 
+int client_submit_request_on (xlator_t *this, struct rpc_clnt *rpc,
+                              void *req, call_frame_t *frame,
+                              rpc_clnt_prog_t *prog, int procnum,
+                              fop_cbk_fn_t cbk, struct iobref *iobref,
+                              struct iovec *rsphdr, int rsphdr_count,
+                              struct iovec *rsp_payload, int rsp_count,
+                              struct iobref *rsp_iobref, xdrproc_t xdrproc);
+struct rpc_clnt *client_pick_rpc (xlator_t *this, rpc_clnt_prog_t *prog,
+                                  int procnum, void *req);
+void client_attach_data_conns (xlator_t *this);
+int client_setvolume (xlator_t *this, struct rpc_clnt *rpc);
+
+clnt_compound_t *client_compound_of (xlator_t *this, call_frame_t *frame);
+int client_compound_capture (xlator_t *this, clnt_compound_t *cc,
+                             call_frame_t *frame, int procnum,
+                             fop_cbk_fn_t cbkfn, void *req, xdrproc_t xdrproc,
+                             struct iovec *payload, int payloadcnt,
+                             struct iobref *iobref);
+void client_compound_destroy (clnt_compound_t *cc);
+
 int unserialize_rsp_dirent (struct gfs3_readdir_rsp *rsp, gf_dirent_t *entries);
 int unserialize_rsp_direntp (xlator_t *this, fd_t *fd,
                              struct gfs3_readdirp_rsp *rsp, gf_dirent_t *entries);
 
+int unpack_rsp_direntp (xlator_t *this, fd_t *fd,
+                        struct gfs3_readdirp2_rsp *rsp, gf_dirent_t *entries);
+
 int clnt_readdir_rsp_cleanup (gfs3_readdir_rsp *rsp);
 int clnt_readdirp_rsp_cleanup (gfs3_readdirp_rsp *rsp);
 int client_attempt_lock_recovery (xlator_t *this, clnt_fd_ctx_t *fdctx);
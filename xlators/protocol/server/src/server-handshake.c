@@ -633,6 +633,24 @@ server_setvolume (rpcsvc_request_t *req)
                 gf_log (this->name, GF_LOG_DEBUG,
                         "failed to set 'transport-ptr'");
 
+        /* tells the client it can send GFS3_OP_READDIRP2 */
+        ret = dict_set_int32 (reply, "readdirp2", 1);
+        if (ret)
+                gf_log (this->name, GF_LOG_DEBUG,
+                        "failed to set 'readdirp2'");
+
+        /* and GFS3_OP_FALLOCATE, GFS3_OP_DISCARD and GFS3_OP_ZEROFILL */
+        ret = dict_set_int32 (reply, "fallocate", 1);
+        if (ret)
+                gf_log (this->name, GF_LOG_DEBUG,
+                        "failed to set 'fallocate'");
+
+        /* and GFS3_OP_SEEK */
+        ret = dict_set_int32 (reply, "seek", 1);
+        if (ret)
+                gf_log (this->name, GF_LOG_DEBUG,
+                        "failed to set 'seek'");
+
 fail:
         rsp.dict.dict_len = dict_serialized_length (reply);
         if (rsp.dict.dict_len < 0) {
@@ -749,11 +767,11 @@ fail:
 }
 
 rpcsvc_actor_t gluster_handshake_actors[] = {
-        [GF_HNDSK_NULL]       = {"NULL",      GF_HNDSK_NULL,      server_null, NULL, 0},
-        [GF_HNDSK_SETVOLUME]  = {"SETVOLUME", GF_HNDSK_SETVOLUME, server_setvolume, NULL, 0},
-        [GF_HNDSK_GETSPEC]    = {"GETSPEC",   GF_HNDSK_GETSPEC,   server_getspec, NULL, 0},
-        [GF_HNDSK_PING]       = {"PING",      GF_HNDSK_PING,      server_ping, NULL, 0},
-        [GF_HNDSK_SET_LK_VER] = {"SET_LK_VER", GF_HNDSK_SET_LK_VER, server_set_lk_version, NULL, 0},
+        [GF_HNDSK_NULL]       = {"NULL",      GF_HNDSK_NULL,      server_null, NULL, 0, _gf_true},
+        [GF_HNDSK_SETVOLUME]  = {"SETVOLUME", GF_HNDSK_SETVOLUME, server_setvolume, NULL, 0, _gf_true},
+        [GF_HNDSK_GETSPEC]    = {"GETSPEC",   GF_HNDSK_GETSPEC,   server_getspec, NULL, 0, _gf_true},
+        [GF_HNDSK_PING]       = {"PING",      GF_HNDSK_PING,      server_ping, NULL, 0, _gf_true},
+        [GF_HNDSK_SET_LK_VER] = {"SET_LK_VER", GF_HNDSK_SET_LK_VER, server_set_lk_version, NULL, 0, _gf_true},
 };
 
 
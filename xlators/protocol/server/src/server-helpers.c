@@ -21,20 +21,19 @@
 int
 server_decode_groups (call_frame_t *frame, rpcsvc_request_t *req)
 {
-        int     i = 0;
-
         GF_VALIDATE_OR_GOTO ("server", frame, out);
         GF_VALIDATE_OR_GOTO ("server", req, out);
 
-        frame->root->ngrps = req->auxgidcount;
-        if (frame->root->ngrps == 0)
+        frame->root->ngrps = 0;
+        if (req->auxgidcount == 0)
                 return 0;
 
-        if (frame->root->ngrps > GF_MAX_AUX_GROUPS)
+        if (req->auxgidcount > GF_MAX_AUX_GROUPS)
                 return -1;
 
-        for (; i < frame->root->ngrps; ++i)
-                frame->root->groups[i] = req->auxgids[i];
+        if (call_stack_set_groups (frame->root, req->auxgidcount,
+                                   req->auxgids))
+                return -1;
 out:
         return 0;
 }
@@ -20,7 +20,9 @@
 #include "server-helpers.h"
 #include "glusterfs3-xdr.h"
 #include "glusterfs3.h"
+#include "glusterfs3-dirent.h"
 #include "compat-errno.h"
+#include "call-stub.h"
 
 #include "xdr-nfs3.h"
 
@@ -1345,6 +1347,159 @@ out:
         return 0;
 }
 
+int
+server_fallocate_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                      int32_t op_ret, int32_t op_errno, struct iatt *statpre,
+                      struct iatt *statpost, dict_t *xdata)
+{
+        gfs3_fallocate_rsp rsp   = {0,};
+        server_state_t     *state = NULL;
+        rpcsvc_request_t   *req   = NULL;
+
+        req = frame->local;
+        state = CALL_STATE (frame);
+
+        GF_PROTOCOL_DICT_SERIALIZE (this, xdata, (&rsp.xdata.xdata_val),
+                                    rsp.xdata.xdata_len, op_errno, out);
+
+        if (op_ret) {
+                gf_log (this->name, GF_LOG_INFO,
+                        "%"PRId64": FALLOCATE %"PRId64" (%s) ==> (%s)",
+                        frame->root->unique, state->resolve.fd_no,
+                        uuid_utoa (state->resolve.gfid), strerror (op_errno));
+                goto out;
+        }
+
+        gf_stat_from_iatt (&rsp.statpre, statpre);
+        gf_stat_from_iatt (&rsp.statpost, statpost);
+
+out:
+        rsp.op_ret    = op_ret;
+        rsp.op_errno  = gf_errno_to_error (op_errno);
+
+        server_submit_reply (frame, req, &rsp, NULL, 0, NULL,
+                             (xdrproc_t)xdr_gfs3_fallocate_rsp);
+
+        GF_FREE (rsp.xdata.xdata_val);
+
+        return 0;
+}
+
+int
+server_discard_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                    int32_t op_ret, int32_t op_errno, struct iatt *statpre,
+                    struct iatt *statpost, dict_t *xdata)
+{
+        gfs3_discard_rsp   rsp   = {0,};
+        server_state_t     *state = NULL;
+        rpcsvc_request_t   *req   = NULL;
+
+        req = frame->local;
+        state = CALL_STATE (frame);
+
+        GF_PROTOCOL_DICT_SERIALIZE (this, xdata, (&rsp.xdata.xdata_val),
+                                    rsp.xdata.xdata_len, op_errno, out);
+
+        if (op_ret) {
+                gf_log (this->name, GF_LOG_INFO,
+                        "%"PRId64": DISCARD %"PRId64" (%s) ==> (%s)",
+                        frame->root->unique, state->resolve.fd_no,
+                        uuid_utoa (state->resolve.gfid), strerror (op_errno));
+                goto out;
+        }
+
+        gf_stat_from_iatt (&rsp.statpre, statpre);
+        gf_stat_from_iatt (&rsp.statpost, statpost);
+
+out:
+        rsp.op_ret    = op_ret;
+        rsp.op_errno  = gf_errno_to_error (op_errno);
+
+        server_submit_reply (frame, req, &rsp, NULL, 0, NULL,
+                             (xdrproc_t)xdr_gfs3_discard_rsp);
+
+        GF_FREE (rsp.xdata.xdata_val);
+
+        return 0;
+}
+
+int
+server_zerofill_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                     int32_t op_ret, int32_t op_errno, struct iatt *statpre,
+                     struct iatt *statpost, dict_t *xdata)
+{
+        gfs3_zerofill_rsp  rsp   = {0,};
+        server_state_t     *state = NULL;
+        rpcsvc_request_t   *req   = NULL;
+
+        req = frame->local;
+        state = CALL_STATE (frame);
+
+        GF_PROTOCOL_DICT_SERIALIZE (this, xdata, (&rsp.xdata.xdata_val),
+                                    rsp.xdata.xdata_len, op_errno, out);
+
+        if (op_ret) {
+                gf_log (this->name, GF_LOG_INFO,
+                        "%"PRId64": ZEROFILL %"PRId64" (%s) ==> (%s)",
+                        frame->root->unique, state->resolve.fd_no,
+                        uuid_utoa (state->resolve.gfid), strerror (op_errno));
+                goto out;
+        }
+
+        gf_stat_from_iatt (&rsp.statpre, statpre);
+        gf_stat_from_iatt (&rsp.statpost, statpost);
+
+out:
+        rsp.op_ret    = op_ret;
+        rsp.op_errno  = gf_errno_to_error (op_errno);
+
+        server_submit_reply (frame, req, &rsp, NULL, 0, NULL,
+                             (xdrproc_t)xdr_gfs3_zerofill_rsp);
+
+        GF_FREE (rsp.xdata.xdata_val);
+
+        return 0;
+}
+
+int
+server_seek_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                 int32_t op_ret, int32_t op_errno, off_t offset,
+                 dict_t *xdata)
+{
+        gfs3_seek_rsp       rsp   = {0,};
+        server_state_t     *state = NULL;
+        rpcsvc_request_t   *req   = NULL;
+
+        req = frame->local;
+        state = CALL_STATE (frame);
+
+        GF_PROTOCOL_DICT_SERIALIZE (this, xdata, (&rsp.xdata.xdata_val),
+                                    rsp.xdata.xdata_len, op_errno, out);
+
+        if (op_ret) {
+                /* ENXIO only says there is no more data (or hole) */
+                gf_log (this->name,
+                        (op_errno == ENXIO) ? GF_LOG_DEBUG : GF_LOG_INFO,
+                        "%"PRId64": SEEK %"PRId64" (%s) ==> (%s)",
+                        frame->root->unique, state->resolve.fd_no,
+                        uuid_utoa (state->resolve.gfid), strerror (op_errno));
+                goto out;
+        }
+
+        rsp.offset = offset;
+
+out:
+        rsp.op_ret    = op_ret;
+        rsp.op_errno  = gf_errno_to_error (op_errno);
+
+        server_submit_reply (frame, req, &rsp, NULL, 0, NULL,
+                             (xdrproc_t)xdr_gfs3_seek_rsp);
+
+        GF_FREE (rsp.xdata.xdata_val);
+
+        return 0;
+}
+
 int
 server_flush_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
                   int32_t op_ret, int32_t op_errno, dict_t *xdata)
@@ -1918,6 +2073,58 @@ out:
 }
 
 
+/* GFS3_OP_READDIRP2 is answered from here, with the entries packed into one
+   buffer, see glusterfs3-dirent.c */
+static int
+server_readdirp2_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
+                      int32_t op_ret, int32_t op_errno, gf_dirent_t *entries,
+                      dict_t *xdata)
+{
+        gfs3_readdirp2_rsp  rsp   = {0,};
+        server_state_t     *state = NULL;
+        rpcsvc_request_t   *req   = NULL;
+        int                 ret   = 0;
+
+        req = frame->local;
+        state = CALL_STATE(frame);
+
+        GF_PROTOCOL_DICT_SERIALIZE (this, xdata, (&rsp.xdata.xdata_val),
+                                    rsp.xdata.xdata_len, op_errno, out);
+
+        if (op_ret < 0) {
+                gf_log (this->name, GF_LOG_INFO,
+                        "%"PRId64": READDIRP %"PRId64" (%s) ==> (%s)",
+                        frame->root->unique, state->resolve.fd_no,
+                        uuid_utoa (state->resolve.gfid),
+                        strerror (op_errno));
+                goto out;
+        }
+
+        /* (op_ret == 0) is valid, and means EOF */
+        if (op_ret) {
+                ret = gf_dirent_pack (entries, &rsp.entries.entries_val,
+                                      &rsp.entries.entries_len, &rsp.count);
+                if (ret == -1) {
+                        op_ret   = -1;
+                        op_errno = errno;
+                        goto out;
+                }
+        }
+
+out:
+        rsp.op_ret    = op_ret;
+        rsp.op_errno  = gf_errno_to_error (op_errno);
+
+        server_submit_reply (frame, req, &rsp, NULL, 0, NULL,
+                             (xdrproc_t)xdr_gfs3_readdirp2_rsp);
+
+        GF_FREE (rsp.xdata.xdata_val);
+        GF_FREE (rsp.entries.entries_val);
+
+        return 0;
+}
+
+
 int
 server_readdirp_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
                      int32_t op_ret, int32_t op_errno, gf_dirent_t *entries, dict_t *xdata)
@@ -1930,6 +2137,10 @@ server_readdirp_cbk (call_frame_t *frame, void *cookie, xlator_t *this,
         req = frame->local;
         state = CALL_STATE(frame);
 
+        if (req->procnum == GFS3_OP_READDIRP2)
+                return server_readdirp2_cbk (frame, cookie, this, op_ret,
+                                             op_errno, entries, xdata);
+
         GF_PROTOCOL_DICT_SERIALIZE (this, xdata, (&rsp.xdata.xdata_val),
                                     rsp.xdata.xdata_len, op_errno, out);
 
@@ -2654,6 +2865,95 @@ err:
 }
 
 
+int
+server_fallocate_resume (call_frame_t *frame, xlator_t *bound_xl)
+{
+        server_state_t    *state = NULL;
+
+        state = CALL_STATE (frame);
+
+        if (state->resolve.op_ret != 0)
+                goto err;
+
+        STACK_WIND (frame, server_fallocate_cbk,
+                    bound_xl, bound_xl->fops->fallocate,
+                    state->fd, state->flags, state->offset, state->size,
+                    state->xdata);
+        return 0;
+err:
+        server_fallocate_cbk (frame, NULL, frame->this, state->resolve.op_ret,
+                              state->resolve.op_errno, NULL, NULL, NULL);
+
+        return 0;
+}
+
+
+int
+server_discard_resume (call_frame_t *frame, xlator_t *bound_xl)
+{
+        server_state_t    *state = NULL;
+
+        state = CALL_STATE (frame);
+
+        if (state->resolve.op_ret != 0)
+                goto err;
+
+        STACK_WIND (frame, server_discard_cbk,
+                    bound_xl, bound_xl->fops->discard,
+                    state->fd, state->offset, state->size, state->xdata);
+        return 0;
+err:
+        server_discard_cbk (frame, NULL, frame->this, state->resolve.op_ret,
+                            state->resolve.op_errno, NULL, NULL, NULL);
+
+        return 0;
+}
+
+
+int
+server_zerofill_resume (call_frame_t *frame, xlator_t *bound_xl)
+{
+        server_state_t    *state = NULL;
+
+        state = CALL_STATE (frame);
+
+        if (state->resolve.op_ret != 0)
+                goto err;
+
+        STACK_WIND (frame, server_zerofill_cbk,
+                    bound_xl, bound_xl->fops->zerofill,
+                    state->fd, state->offset, state->size, state->xdata);
+        return 0;
+err:
+        server_zerofill_cbk (frame, NULL, frame->this, state->resolve.op_ret,
+                             state->resolve.op_errno, NULL, NULL, NULL);
+
+        return 0;
+}
+
+
+int
+server_seek_resume (call_frame_t *frame, xlator_t *bound_xl)
+{
+        server_state_t    *state = NULL;
+
+        state = CALL_STATE (frame);
+
+        if (state->resolve.op_ret != 0)
+                goto err;
+
+        STACK_WIND (frame, server_seek_cbk,
+                    bound_xl, bound_xl->fops->seek,
+                    state->fd, state->offset, state->what, state->xdata);
+        return 0;
+err:
+        server_seek_cbk (frame, NULL, frame->this, state->resolve.op_ret,
+                         state->resolve.op_errno, 0, NULL);
+
+        return 0;
+}
+
+
 int
 server_flush_resume (call_frame_t *frame, xlator_t *bound_xl)
 {
@@ -2958,10 +3258,10 @@ server3_3_stat (rpcsvc_request_t *req)
         state->resolve.type  = RESOLVE_MUST;
         memcpy (state->resolve.gfid, args.gfid, 16);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
 
         ret = 0;
@@ -3018,10 +3318,10 @@ server3_3_setattr (rpcsvc_request_t *req)
         gf_stat_to_iatt (&args.stbuf, &state->stbuf);
         state->valid = args.valid;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_setattr_resume);
@@ -3077,10 +3377,10 @@ server3_3_fsetattr (rpcsvc_request_t *req)
         gf_stat_to_iatt (&args.stbuf, &state->stbuf);
         state->valid = args.valid;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_fsetattr_resume);
@@ -3135,10 +3435,10 @@ server3_3_readlink (rpcsvc_request_t *req)
 
         state->size  = args.size;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_readlink_resume);
@@ -3204,10 +3504,10 @@ server3_3_create (rpcsvc_request_t *req)
         }
 
         /* TODO: can do alloca for xdata field instead of stdalloc */
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_create_resume);
@@ -3262,10 +3562,10 @@ server3_3_open (rpcsvc_request_t *req)
 
         state->flags = gf_flags_to_flags (args.flags);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_open_resume);
@@ -3321,10 +3621,10 @@ server3_3_readv (rpcsvc_request_t *req)
 
         memcpy (state->resolve.gfid, args.gfid, 16);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_readv_resume);
@@ -3400,10 +3700,10 @@ server3_3_writev (rpcsvc_request_t *req)
                 state->size += state->payload_vector[i].iov_len;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
 #ifdef GF_TESTING_IO_XDATA
         dict_dump (state->xdata);
@@ -3583,10 +3883,10 @@ server3_3_fsync (rpcsvc_request_t *req)
         state->flags         = args.data;
         memcpy (state->resolve.gfid, args.gfid, 16);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_fsync_resume);
@@ -3640,10 +3940,10 @@ server3_3_flush (rpcsvc_request_t *req)
         state->resolve.fd_no = args.fd;
         memcpy (state->resolve.gfid, args.gfid, 16);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_flush_resume);
@@ -3698,10 +3998,10 @@ server3_3_ftruncate (rpcsvc_request_t *req)
         state->offset         = args.offset;
         memcpy (state->resolve.gfid, args.gfid, 16);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_ftruncate_resume);
@@ -3716,13 +4016,246 @@ out:
 
 
 int
-server3_3_fstat (rpcsvc_request_t *req)
+server3_3_fallocate (rpcsvc_request_t *req)
 {
-        server_state_t *state = NULL;
-        call_frame_t   *frame = NULL;
-        gfs3_fstat_req  args  = {{0,},};
-        int             ret   = -1;
-        int             op_errno = 0;
+        server_state_t     *state = NULL;
+        call_frame_t       *frame = NULL;
+        gfs3_fallocate_req args  = {{0,},};
+        int                 ret   = -1;
+        int                 op_errno = 0;
+
+        if (!req)
+                return ret;
+
+        ret = xdr_to_generic (req->msg[0], &args,
+                              (xdrproc_t)xdr_gfs3_fallocate_req);
+        if (ret < 0) {
+                //failed to decode msg;
+                req->rpc_err = GARBAGE_ARGS;
+                goto out;
+        }
+
+        frame = get_frame_from_request (req);
+        if (!frame) {
+                // something wrong, mostly insufficient memory
+                req->rpc_err = GARBAGE_ARGS; /* TODO */
+                goto out;
+        }
+        frame->root->op = GF_FOP_FALLOCATE;
+
+        state = CALL_STATE (frame);
+        if (!state->conn->bound_xl) {
+                /* auth failure, request on subvolume without setvolume */
+                req->rpc_err = GARBAGE_ARGS;
+                goto out;
+        }
+
+        state->resolve.type   = RESOLVE_MUST;
+        state->resolve.fd_no  = args.fd;
+        state->flags          = args.flags;
+        state->offset         = args.offset;
+        state->size           = args.size;
+        memcpy (state->resolve.gfid, args.gfid, 16);
+
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
+
+        ret = 0;
+        resolve_and_resume (frame, server_fallocate_resume);
+out:
+        free (args.xdata.xdata_val);
+
+        if (op_errno)
+                req->rpc_err = GARBAGE_ARGS;
+
+        return ret;
+}
+
+
+int
+server3_3_discard (rpcsvc_request_t *req)
+{
+        server_state_t     *state = NULL;
+        call_frame_t       *frame = NULL;
+        gfs3_discard_req   args  = {{0,},};
+        int                 ret   = -1;
+        int                 op_errno = 0;
+
+        if (!req)
+                return ret;
+
+        ret = xdr_to_generic (req->msg[0], &args,
+                              (xdrproc_t)xdr_gfs3_discard_req);
+        if (ret < 0) {
+                //failed to decode msg;
+                req->rpc_err = GARBAGE_ARGS;
+                goto out;
+        }
+
+        frame = get_frame_from_request (req);
+        if (!frame) {
+                // something wrong, mostly insufficient memory
+                req->rpc_err = GARBAGE_ARGS; /* TODO */
+                goto out;
+        }
+        frame->root->op = GF_FOP_DISCARD;
+
+        state = CALL_STATE (frame);
+        if (!state->conn->bound_xl) {
+                /* auth failure, request on subvolume without setvolume */
+                req->rpc_err = GARBAGE_ARGS;
+                goto out;
+        }
+
+        state->resolve.type   = RESOLVE_MUST;
+        state->resolve.fd_no  = args.fd;
+        state->offset         = args.offset;
+        state->size           = args.size;
+        memcpy (state->resolve.gfid, args.gfid, 16);
+
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
+
+        ret = 0;
+        resolve_and_resume (frame, server_discard_resume);
+out:
+        free (args.xdata.xdata_val);
+
+        if (op_errno)
+                req->rpc_err = GARBAGE_ARGS;
+
+        return ret;
+}
+
+
+int
+server3_3_zerofill (rpcsvc_request_t *req)
+{
+        server_state_t     *state = NULL;
+        call_frame_t       *frame = NULL;
+        gfs3_zerofill_req  args  = {{0,},};
+        int                 ret   = -1;
+        int                 op_errno = 0;
+
+        if (!req)
+                return ret;
+
+        ret = xdr_to_generic (req->msg[0], &args,
+                              (xdrproc_t)xdr_gfs3_zerofill_req);
+        if (ret < 0) {
+                //failed to decode msg;
+                req->rpc_err = GARBAGE_ARGS;
+                goto out;
+        }
+
+        frame = get_frame_from_request (req);
+        if (!frame) {
+                // something wrong, mostly insufficient memory
+                req->rpc_err = GARBAGE_ARGS; /* TODO */
+                goto out;
+        }
+        frame->root->op = GF_FOP_ZEROFILL;
+
+        state = CALL_STATE (frame);
+        if (!state->conn->bound_xl) {
+                /* auth failure, request on subvolume without setvolume */
+                req->rpc_err = GARBAGE_ARGS;
+                goto out;
+        }
+
+        state->resolve.type   = RESOLVE_MUST;
+        state->resolve.fd_no  = args.fd;
+        state->offset         = args.offset;
+        state->size           = args.size;
+        memcpy (state->resolve.gfid, args.gfid, 16);
+
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
+
+        ret = 0;
+        resolve_and_resume (frame, server_zerofill_resume);
+out:
+        free (args.xdata.xdata_val);
+
+        if (op_errno)
+                req->rpc_err = GARBAGE_ARGS;
+
+        return ret;
+}
+
+
+int
+server3_3_seek (rpcsvc_request_t *req)
+{
+        server_state_t     *state = NULL;
+        call_frame_t       *frame = NULL;
+        gfs3_seek_req       args  = {{0,},};
+        int                 ret   = -1;
+        int                 op_errno = 0;
+
+        if (!req)
+                return ret;
+
+        ret = xdr_to_generic (req->msg[0], &args,
+                              (xdrproc_t)xdr_gfs3_seek_req);
+        if (ret < 0) {
+                //failed to decode msg;
+                req->rpc_err = GARBAGE_ARGS;
+                goto out;
+        }
+
+        frame = get_frame_from_request (req);
+        if (!frame) {
+                // something wrong, mostly insufficient memory
+                req->rpc_err = GARBAGE_ARGS; /* TODO */
+                goto out;
+        }
+        frame->root->op = GF_FOP_SEEK;
+
+        state = CALL_STATE (frame);
+        if (!state->conn->bound_xl) {
+                /* auth failure, request on subvolume without setvolume */
+                req->rpc_err = GARBAGE_ARGS;
+                goto out;
+        }
+
+        state->resolve.type   = RESOLVE_MUST;
+        state->resolve.fd_no  = args.fd;
+        state->offset         = args.offset;
+        state->what           = args.what;
+        memcpy (state->resolve.gfid, args.gfid, 16);
+
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
+
+        ret = 0;
+        resolve_and_resume (frame, server_seek_resume);
+out:
+        free (args.xdata.xdata_val);
+
+        if (op_errno)
+                req->rpc_err = GARBAGE_ARGS;
+
+        return ret;
+}
+
+
+int
+server3_3_fstat (rpcsvc_request_t *req)
+{
+        server_state_t *state = NULL;
+        call_frame_t   *frame = NULL;
+        gfs3_fstat_req  args  = {{0,},};
+        int             ret   = -1;
+        int             op_errno = 0;
 
         if (!req)
                 return ret;
@@ -3754,10 +4287,10 @@ server3_3_fstat (rpcsvc_request_t *req)
         state->resolve.fd_no   = args.fd;
         memcpy (state->resolve.gfid, args.gfid, 16);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_fstat_resume);
@@ -3810,10 +4343,10 @@ server3_3_truncate (rpcsvc_request_t *req)
         memcpy (state->resolve.gfid, args.gfid, 16);
         state->offset        = args.offset;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_truncate_resume);
@@ -3871,10 +4404,10 @@ server3_3_unlink (rpcsvc_request_t *req)
 
         state->flags = args.xflags;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_unlink_resume);
@@ -3940,10 +4473,10 @@ server3_3_setxattr (rpcsvc_request_t *req)
         /* There can be some commands hidden in key, check and proceed */
         gf_server_check_setxattr_cmd (frame, dict);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_setxattr_resume);
@@ -4012,10 +4545,10 @@ server3_3_fsetxattr (rpcsvc_request_t *req)
 
         state->dict = dict;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_fsetxattr_resume);
@@ -4084,10 +4617,10 @@ server3_3_fxattrop (rpcsvc_request_t *req)
 
         state->dict = dict;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_fxattrop_resume);
@@ -4157,10 +4690,10 @@ server3_3_xattrop (rpcsvc_request_t *req)
 
         state->dict = dict;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_xattrop_resume);
@@ -4225,10 +4758,10 @@ server3_3_getxattr (rpcsvc_request_t *req)
                 gf_server_check_getxattr_cmd (frame, state->name);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_getxattr_resume);
@@ -4285,10 +4818,10 @@ server3_3_fgetxattr (rpcsvc_request_t *req)
         if (args.namelen)
                 state->name = gf_strdup (args.name);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_fgetxattr_resume);
@@ -4344,10 +4877,10 @@ server3_3_removexattr (rpcsvc_request_t *req)
         memcpy (state->resolve.gfid, args.gfid, 16);
         state->name           = gf_strdup (args.name);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_removexattr_resume);
@@ -4402,10 +4935,10 @@ server3_3_fremovexattr (rpcsvc_request_t *req)
         memcpy (state->resolve.gfid, args.gfid, 16);
         state->name           = gf_strdup (args.name);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_fremovexattr_resume);
@@ -4459,10 +4992,10 @@ server3_3_opendir (rpcsvc_request_t *req)
         state->resolve.type   = RESOLVE_MUST;
         memcpy (state->resolve.gfid, args.gfid, 16);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_opendir_resume);
@@ -4529,10 +5062,10 @@ server3_3_readdirp (rpcsvc_request_t *req)
         memcpy (state->resolve.gfid, args.gfid, 16);
 
         /* here, dict itself works as xdata */
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->dict,
-                                      (args.dict.dict_val),
-                                      (args.dict.dict_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->dict,
+                                             (args.dict.dict_val),
+                                             (args.dict.dict_len), ret,
+                                             op_errno, out);
 
 
         ret = 0;
@@ -4598,10 +5131,10 @@ server3_3_readdir (rpcsvc_request_t *req)
         state->offset = args.offset;
         memcpy (state->resolve.gfid, args.gfid, 16);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_readdir_resume);
@@ -4654,10 +5187,10 @@ server3_3_fsyncdir (rpcsvc_request_t *req)
         state->flags = args.data;
         memcpy (state->resolve.gfid, args.gfid, 16);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_fsyncdir_resume);
@@ -4717,10 +5250,10 @@ server3_3_mknod (rpcsvc_request_t *req)
         state->dev   = args.dev;
         state->umask = args.umask;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_mknod_resume);
@@ -4782,10 +5315,10 @@ server3_3_mkdir (rpcsvc_request_t *req)
         state->umask = args.umask;
 
         /* TODO: can do alloca for xdata field instead of stdalloc */
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_mkdir_resume);
@@ -4843,10 +5376,10 @@ server3_3_rmdir (rpcsvc_request_t *req)
 
         state->flags = args.xflags;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_rmdir_resume);
@@ -4932,10 +5465,10 @@ server3_3_inodelk (rpcsvc_request_t *req)
                 break;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_inodelk_resume);
@@ -5020,10 +5553,10 @@ server3_3_finodelk (rpcsvc_request_t *req)
                 break;
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_finodelk_resume);
@@ -5087,10 +5620,10 @@ server3_3_entrylk (rpcsvc_request_t *req)
         state->cmd            = args.cmd;
         state->type           = args.type;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_entrylk_resume);
@@ -5151,10 +5684,10 @@ server3_3_fentrylk (rpcsvc_request_t *req)
                 state->name = gf_strdup (args.name);
         state->volume = gf_strdup (args.volume);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_fentrylk_resume);
@@ -5206,10 +5739,10 @@ server3_3_access (rpcsvc_request_t *req)
         memcpy (state->resolve.gfid, args.gfid, 16);
         state->mask          = args.mask;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_access_resume);
@@ -5268,10 +5801,10 @@ server3_3_symlink (rpcsvc_request_t *req)
         state->name           = gf_strdup (args.linkname);
         state->umask          = args.umask;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_symlink_resume);
@@ -5331,10 +5864,10 @@ server3_3_link (rpcsvc_request_t *req)
         state->resolve2.bname  = gf_strdup (args.newbname);
         memcpy (state->resolve2.pargfid, args.newgfid, 16);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_link_resume);
@@ -5394,10 +5927,10 @@ server3_3_rename (rpcsvc_request_t *req)
         state->resolve2.bname = gf_strdup (args.newbname);
         memcpy (state->resolve2.pargfid, args.newgfid, 16);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_rename_resume);
@@ -5496,10 +6029,10 @@ server3_3_lk (rpcsvc_request_t *req)
         }
 
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_lk_resume);
@@ -5555,10 +6088,10 @@ server3_3_rchecksum (rpcsvc_request_t *req)
         state->offset        = args.offset;
         state->size          = args.len;
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_rchecksum_resume);
@@ -5597,7 +6130,6 @@ server3_3_lookup (rpcsvc_request_t *req)
         GF_VALIDATE_OR_GOTO ("server", req, err);
 
         args.bname           = alloca (req->msg[0].iov_len);
-        args.xdata.xdata_val = alloca (req->msg[0].iov_len);
 
         ret = xdr_to_generic (req->msg[0], &args,
                               (xdrproc_t)xdr_gfs3_lookup_req);
@@ -5635,14 +6167,17 @@ server3_3_lookup (rpcsvc_request_t *req)
                 memcpy (state->resolve.gfid, args.gfid, 16);
         }
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_lookup_resume);
 
+        /* memory allocated by libc, don't use GF_FREE */
+        free (args.xdata.xdata_val);
+
         return ret;
 out:
 
@@ -5650,6 +6185,8 @@ out:
                            NULL, NULL);
         ret = 0;
 err:
+        free (args.xdata.xdata_val);
+
         return ret;
 }
 
@@ -5691,10 +6228,10 @@ server3_3_statfs (rpcsvc_request_t *req)
         state->resolve.type   = RESOLVE_MUST;
         memcpy (state->resolve.gfid, args.gfid, 16);
 
-        GF_PROTOCOL_DICT_UNSERIALIZE (state->conn->bound_xl, state->xdata,
-                                      (args.xdata.xdata_val),
-                                      (args.xdata.xdata_len), ret,
-                                      op_errno, out);
+        GF_PROTOCOL_DICT_UNSERIALIZE_NOCOPY (state->conn->bound_xl, state->xdata,
+                                             (args.xdata.xdata_val),
+                                             (args.xdata.xdata_len), ret,
+                                             op_errno, out);
 
         ret = 0;
         resolve_and_resume (frame, server_statfs_resume);
@@ -5706,6 +6243,224 @@ out:
 }
 
 
+static void
+server_compound_unref (server_compound_t *compound)
+{
+        int refcount = 0;
+        int i        = 0;
+
+        LOCK (&compound->lock);
+        {
+                refcount = --compound->ref;
+        }
+        UNLOCK (&compound->lock);
+
+        if (refcount)
+                return;
+
+        for (i = 0; i < compound->args.links.links_len; i++)
+                free (compound->args.links.links_val[i].msg.msg_val);
+        free (compound->args.links.links_val);
+        free (compound->args.xdata.xdata_val);
+
+        if (compound->iobref)
+                iobref_unref (compound->iobref);
+
+        LOCK_DESTROY (&compound->lock);
+        GF_FREE (compound->payload);
+        GF_FREE (compound->replies);
+        GF_FREE (compound->subreqs);
+        GF_FREE (compound);
+}
+
+
+static void
+server_compound_reply (server_compound_t *compound)
+{
+        gfs3_compound_rsp  rsp    = {0,};
+        struct iobuf      *iobuf  = NULL;
+        size_t             size   = 0;
+
+        rsp.op_ret = compound->op_ret;
+        rsp.op_errno = compound->op_errno;
+        rsp.links.links_val = compound->replies;
+        rsp.links.links_len = compound->args.links.links_len;
+
+        /* the transport takes only so many vectors per message */
+        if (compound->payloadcnt > (MAX_IOVEC - 3)) {
+                size = iov_length (compound->payload, compound->payloadcnt);
+                iobuf = iobuf_get2 (compound->req->svc->ctx->iobuf_pool, size);
+                if (!iobuf) {
+                        rsp.op_ret = -1;
+                        rsp.op_errno = ENOMEM;
+                        rsp.links.links_len = 0;
+                        compound->payloadcnt = 0;
+                } else {
+                        iov_unload (iobuf_ptr (iobuf), compound->payload,
+                                    compound->payloadcnt);
+                        iobref_add (compound->iobref, iobuf);
+                        iobuf_unref (iobuf);
+                        compound->payload[0].iov_base = iobuf_ptr (iobuf);
+                        compound->payload[0].iov_len = size;
+                        compound->payloadcnt = 1;
+                }
+        }
+
+        rsp.op_errno = gf_errno_to_error (rsp.op_errno);
+
+        server_submit_reply (NULL, compound->req, &rsp, compound->payload,
+                             compound->payloadcnt, compound->iobref,
+                             (xdrproc_t)xdr_gfs3_compound_rsp);
+}
+
+
+/* Runs the links from compound->next on, returning as soon as one of them
+   is under way: its reply, through server_submit_reply (), resumes the
+   rest. The first link to fail stops the chain; it and the links after it
+   which did not run are sent with an empty reply, and the error of the
+   compound call is that of the failed link. */
+void
+server_compound_resume (server_compound_t *compound)
+{
+        rpcsvc_actor_t   *actor = NULL;
+        rpcsvc_request_t *sub   = NULL;
+        int               ret   = 0;
+
+        while ((compound->op_ret == 0) &&
+               (compound->next < compound->args.links.links_len)) {
+                sub = &compound->subreqs[compound->next++];
+
+                actor = NULL;
+                if ((sub->procnum > GFS3_OP_NULL) &&
+                    (sub->procnum < glusterfs3_3_fop_prog.numactors) &&
+                    (sub->procnum != GFS3_OP_COMPOUND))
+                        actor = &glusterfs3_3_fop_prog.actors[sub->procnum];
+
+                /* a lock waiting in the middle of a compound call would
+                   keep it counted against outstanding-rpc-limit */
+                if (actor && actor->unthrottled)
+                        actor = NULL;
+
+                if (!actor || !actor->actor) {
+                        gf_log (THIS->name, GF_LOG_WARNING,
+                                "procedure %d cannot be part of a compound "
+                                "call", sub->procnum);
+                        compound->op_ret = -1;
+                        compound->op_errno = gf_errno_to_error (ENOTSUP);
+                        break;
+                }
+
+                LOCK (&compound->lock);
+                {
+                        compound->ref++;
+                }
+                UNLOCK (&compound->lock);
+
+                ret = actor->actor (sub);
+
+                server_compound_unref (compound);
+                if (ret == 0)
+                        return;
+
+                /* the actor could not even decode the link */
+                compound->op_ret = -1;
+                compound->op_errno = gf_errno_to_error (EINVAL);
+        }
+
+        server_compound_reply (compound);
+        server_compound_unref (compound);
+}
+
+
+int
+server3_3_compound (rpcsvc_request_t *req)
+{
+        server_compound_t  *compound  = NULL;
+        gfs3_compound_link *link      = NULL;
+        rpcsvc_request_t   *sub       = NULL;
+        char               *payload   = NULL;
+        size_t              remaining = 0;
+        ssize_t             len       = 0;
+        int                 i         = 0;
+        int                 ret       = -1;
+
+        if (!req)
+                return ret;
+
+        compound = GF_CALLOC (1, sizeof (*compound), gf_server_mt_compound_t);
+        if (!compound) {
+                req->rpc_err = GARBAGE_ARGS;
+                goto out;
+        }
+
+        LOCK_INIT (&compound->lock);
+        compound->ref = 1;
+        compound->req = req;
+
+        len = xdr_to_generic (req->msg[0], &compound->args,
+                              (xdrproc_t)xdr_gfs3_compound_req);
+        if ((len < 0) || (req->count > 1) ||
+            (compound->args.links.links_len > GF_COMPOUND_MAX_LINKS)) {
+                //failed to decode msg;
+                req->rpc_err = GARBAGE_ARGS;
+                goto out;
+        }
+
+        /* write payloads follow the call, in the order of the links. They
+           stay in the record, which req->hdr_iobuf holds until the reply */
+        payload = req->msg[0].iov_base + len;
+        remaining = req->msg[0].iov_len - len;
+
+        compound->subreqs = GF_CALLOC (compound->args.links.links_len,
+                                       sizeof (*compound->subreqs),
+                                       gf_server_mt_compound_t);
+        compound->replies = GF_CALLOC (compound->args.links.links_len,
+                                       sizeof (*compound->replies),
+                                       gf_server_mt_compound_t);
+        compound->iobref = iobref_new ();
+        if (!compound->subreqs || !compound->replies || !compound->iobref) {
+                req->rpc_err = GARBAGE_ARGS;
+                goto out;
+        }
+
+        for (i = 0; i < compound->args.links.links_len; i++) {
+                link = &compound->args.links.links_val[i];
+                if (link->payload_len > remaining) {
+                        req->rpc_err = GARBAGE_ARGS;
+                        goto out;
+                }
+
+                sub = &compound->subreqs[i];
+                *sub = *req;
+                INIT_LIST_HEAD (&sub->txlist);
+                INIT_LIST_HEAD (&sub->dispatch);
+                sub->procnum = link->procnum;
+                sub->private = compound;
+                sub->msg[0].iov_base = link->msg.msg_val;
+                sub->msg[0].iov_len = link->msg.msg_len;
+                sub->count = 1;
+                if (link->payload_len) {
+                        sub->msg[1].iov_base = payload;
+                        sub->msg[1].iov_len = link->payload_len;
+                        sub->count = 2;
+                        payload += link->payload_len;
+                        remaining -= link->payload_len;
+                }
+
+                compound->replies[i].procnum = link->procnum;
+        }
+
+        ret = 0;
+        server_compound_resume (compound);
+        compound = NULL;
+out:
+        if (compound)
+                server_compound_unref (compound);
+
+        return ret;
+}
+
+
 rpcsvc_actor_t glusterfs3_3_fop_actors[] = {
         [GFS3_OP_NULL]        = { "NULL",       GFS3_OP_NULL, server_null, NULL, 0},
         [GFS3_OP_STAT]        = { "STAT",       GFS3_OP_STAT, server3_3_stat, NULL, 0},
@@ -5733,13 +6488,13 @@ rpcsvc_actor_t glusterfs3_3_fop_actors[] = {
         [GFS3_OP_CREATE]      = { "CREATE",     GFS3_OP_CREATE, server3_3_create, NULL, 0},
         [GFS3_OP_FTRUNCATE]   = { "FTRUNCATE",  GFS3_OP_FTRUNCATE, server3_3_ftruncate, NULL, 0},
         [GFS3_OP_FSTAT]       = { "FSTAT",      GFS3_OP_FSTAT, server3_3_fstat, NULL, 0},
-        [GFS3_OP_LK]          = { "LK",         GFS3_OP_LK, server3_3_lk, NULL, 0},
+        [GFS3_OP_LK]          = { "LK",         GFS3_OP_LK, server3_3_lk, NULL, 0, _gf_true},
         [GFS3_OP_LOOKUP]      = { "LOOKUP",     GFS3_OP_LOOKUP, server3_3_lookup, NULL, 0},
         [GFS3_OP_READDIR]     = { "READDIR",    GFS3_OP_READDIR, server3_3_readdir, NULL, 0},
-        [GFS3_OP_INODELK]     = { "INODELK",    GFS3_OP_INODELK, server3_3_inodelk, NULL, 0},
-        [GFS3_OP_FINODELK]    = { "FINODELK",   GFS3_OP_FINODELK, server3_3_finodelk, NULL, 0},
-        [GFS3_OP_ENTRYLK]     = { "ENTRYLK",    GFS3_OP_ENTRYLK, server3_3_entrylk, NULL, 0},
-        [GFS3_OP_FENTRYLK]    = { "FENTRYLK",   GFS3_OP_FENTRYLK, server3_3_fentrylk, NULL, 0},
+        [GFS3_OP_INODELK]     = { "INODELK",    GFS3_OP_INODELK, server3_3_inodelk, NULL, 0, _gf_true},
+        [GFS3_OP_FINODELK]    = { "FINODELK",   GFS3_OP_FINODELK, server3_3_finodelk, NULL, 0, _gf_true},
+        [GFS3_OP_ENTRYLK]     = { "ENTRYLK",    GFS3_OP_ENTRYLK, server3_3_entrylk, NULL, 0, _gf_true},
+        [GFS3_OP_FENTRYLK]    = { "FENTRYLK",   GFS3_OP_FENTRYLK, server3_3_fentrylk, NULL, 0, _gf_true},
         [GFS3_OP_XATTROP]     = { "XATTROP",    GFS3_OP_XATTROP, server3_3_xattrop, NULL, 0},
         [GFS3_OP_FXATTROP]    = { "FXATTROP",   GFS3_OP_FXATTROP, server3_3_fxattrop, NULL, 0},
         [GFS3_OP_FGETXATTR]   = { "FGETXATTR",  GFS3_OP_FGETXATTR, server3_3_fgetxattr, NULL, 0},
@@ -5751,6 +6506,12 @@ rpcsvc_actor_t glusterfs3_3_fop_actors[] = {
         [GFS3_OP_RELEASE]     = { "RELEASE",    GFS3_OP_RELEASE, server3_3_release, NULL, 0},
         [GFS3_OP_RELEASEDIR]  = { "RELEASEDIR", GFS3_OP_RELEASEDIR, server3_3_releasedir, NULL, 0},
         [GFS3_OP_FREMOVEXATTR] = { "FREMOVEXATTR", GFS3_OP_FREMOVEXATTR, server3_3_fremovexattr, NULL, 0},
+        [GFS3_OP_COMPOUND]    = { "COMPOUND",   GFS3_OP_COMPOUND, server3_3_compound, NULL, 0},
+        [GFS3_OP_READDIRP2]   = { "READDIRP2",  GFS3_OP_READDIRP2, server3_3_readdirp, NULL, 0},
+        [GFS3_OP_FALLOCATE]   = { "FALLOCATE",  GFS3_OP_FALLOCATE, server3_3_fallocate, NULL, 0},
+        [GFS3_OP_DISCARD]     = { "DISCARD",    GFS3_OP_DISCARD, server3_3_discard, NULL, 0},
+        [GFS3_OP_ZEROFILL]    = { "ZEROFILL",   GFS3_OP_ZEROFILL, server3_3_zerofill, NULL, 0},
+        [GFS3_OP_SEEK]        = { "SEEK",       GFS3_OP_SEEK, server3_3_seek, NULL, 0},
 };
 
 
@@ -25,6 +25,7 @@
 #include "statedump.h"
 #include "defaults.h"
 #include "authenticate.h"
+#include "event.h"
 #include "rpcsvc.h"
 
 void
@@ -121,6 +122,7 @@ server_submit_reply (call_frame_t *frame, rpcsvc_request_t *req, void *arg,
         char                    new_iobref = 0;
         server_connection_t    *conn       = NULL;
         gf_boolean_t            lk_heal    = _gf_false;
+        server_compound_t      *compound   = NULL;
 
         GF_VALIDATE_OR_GOTO ("server", req, ret);
 
@@ -133,6 +135,16 @@ server_submit_reply (call_frame_t *frame, rpcsvc_request_t *req, void *arg,
         if (conn)
                 lk_heal = ((server_conf_t *) conn->this->private)->lk_heal;
 
+        if (req->private) {
+                /* a link of a compound call, its reply goes out with the
+                   others once the last link is done */
+                compound = req->private;
+                ret = server_compound_link_reply (req, arg, payload,
+                                                  payloadcount, iobref,
+                                                  xdrproc);
+                goto ret;
+        }
+
         if (!iobref) {
                 iobref = iobref_new ();
                 if (!iobref) {
@@ -192,6 +204,67 @@ ret:
                 iobref_unref (iobref);
         }
 
+        if (compound)
+                server_compound_resume (compound);
+
+        return ret;
+}
+
+
+int
+server_compound_link_reply (rpcsvc_request_t *req, void *arg,
+                            struct iovec *payload, int payloadcount,
+                            struct iobref *iobref, xdrproc_t xdrproc)
+{
+        server_compound_t  *compound = NULL;
+        gfs3_compound_link *link     = NULL;
+        struct iobuf       *iob      = NULL;
+        struct iovec        rsp      = {0,};
+        struct iovec       *vector   = NULL;
+        int                 ret      = -1;
+
+        compound = req->private;
+        link = &compound->replies[req - compound->subreqs];
+
+        iob = gfs_serialize_reply (req, arg, &rsp, xdrproc);
+        if (!iob) {
+                gf_log ("", GF_LOG_ERROR, "Failed to serialize reply");
+                goto out;
+        }
+
+        iobref_add (compound->iobref, iob);
+        iobuf_unref (iob);
+
+        /* every fop reply starts like a gf_common_rsp */
+        if (((gf_common_rsp *)arg)->op_ret < 0) {
+                compound->op_ret = -1;
+                compound->op_errno = ((gf_common_rsp *)arg)->op_errno;
+        }
+
+        link->msg.msg_val = rsp.iov_base;
+        link->msg.msg_len = rsp.iov_len;
+
+        if (payloadcount) {
+                vector = GF_REALLOC (compound->payload,
+                                     (compound->payloadcnt + payloadcount) *
+                                     sizeof (*vector));
+                if (!vector) {
+                        link->msg.msg_len = 0;
+                        goto out;
+                }
+
+                memcpy (&vector[compound->payloadcnt], payload,
+                        payloadcount * sizeof (*vector));
+                compound->payload = vector;
+                compound->payloadcnt += payloadcount;
+                link->payload_len = iov_length (payload, payloadcount);
+
+                if (iobref)
+                        iobref_merge (compound->iobref, iobref);
+        }
+
+        ret = 0;
+out:
         return ret;
 }
 
@@ -408,6 +481,29 @@ server_priv_to_dict (xlator_t *this, dict_t *dict)
                         if (ret)
                                 goto unlock;
 
+                        memset (key, 0, sizeof (key));
+                        snprintf (key, sizeof (key), "client%d.requests",
+                                  count);
+                        ret = dict_set_uint64 (dict, key, xprt->total_rpcs);
+                        if (ret)
+                                goto unlock;
+
+                        memset (key, 0, sizeof (key));
+                        snprintf (key, sizeof (key), "client%d.outstanding",
+                                  count);
+                        ret = dict_set_int32 (dict, key,
+                                              xprt->outstanding_rpc_count);
+                        if (ret)
+                                goto unlock;
+
+                        memset (key, 0, sizeof (key));
+                        snprintf (key, sizeof (key), "client%d.throttled",
+                                  count);
+                        ret = dict_set_uint64 (dict, key,
+                                               xprt->throttle_count);
+                        if (ret)
+                                goto unlock;
+
                         count++;
                 }
         }
@@ -430,6 +526,9 @@ server_priv (xlator_t *this)
         char              key[GF_DUMP_MAX_BUF_LEN] = {0,};
         uint64_t          total_read = 0;
         uint64_t          total_write = 0;
+        uint64_t          total_msgs = 0;
+        uint64_t          total_calls = 0;
+        int               i    = 0;
         int32_t           ret  = -1;
 
         GF_VALIDATE_OR_GOTO ("server", this, out);
@@ -448,6 +547,25 @@ server_priv (xlator_t *this)
                 list_for_each_entry (xprt, &conf->xprt_list, list) {
                         total_read  += xprt->total_bytes_read;
                         total_write += xprt->total_bytes_write;
+                        total_msgs  += xprt->total_msgs_write;
+                        total_calls += xprt->total_write_calls;
+
+                        gf_proc_dump_build_key (key, "client", "%d.id", i);
+                        gf_proc_dump_write (key, "%s",
+                                            xprt->peerinfo.identifier);
+                        gf_proc_dump_build_key (key, "client",
+                                                "%d.requests", i);
+                        gf_proc_dump_write (key, "%"PRIu64,
+                                            xprt->total_rpcs);
+                        gf_proc_dump_build_key (key, "client",
+                                                "%d.outstanding", i);
+                        gf_proc_dump_write (key, "%d",
+                                            xprt->outstanding_rpc_count);
+                        gf_proc_dump_build_key (key, "client",
+                                                "%d.throttled", i);
+                        gf_proc_dump_write (key, "%"PRIu64,
+                                            xprt->throttle_count);
+                        i++;
                 }
         }
         pthread_mutex_unlock (&conf->mutex);
@@ -458,6 +576,16 @@ server_priv (xlator_t *this)
         gf_proc_dump_build_key(key, "server", "total-bytes-write");
         gf_proc_dump_write(key, "%"PRIu64, total_write);
 
+        gf_proc_dump_build_key(key, "server", "total-msgs-write");
+        gf_proc_dump_write(key, "%"PRIu64, total_msgs);
+
+        gf_proc_dump_build_key(key, "server", "total-write-calls");
+        gf_proc_dump_write(key, "%"PRIu64, total_calls);
+
+        gf_proc_dump_build_key(key, "server", "write-calls-per-msg");
+        gf_proc_dump_write(key, "%.3f",
+                           total_msgs ? (double)total_calls / total_msgs : 0);
+
         ret = 0;
 out:
         if (ret)
@@ -913,6 +1041,7 @@ reconfigure (xlator_t *this, dict_t *options)
         data_t                   *data;
         int                       ret = 0;
         char                     *statedump_path = NULL;
+        int32_t                   event_threads = 0;
         conf = this->private;
 
         if (!conf) {
@@ -959,6 +1088,14 @@ reconfigure (xlator_t *this, dict_t *options)
         GF_FREE (this->ctx->statedump_path);
         this->ctx->statedump_path = gf_strdup (statedump_path);
 
+        GF_OPTION_RECONF ("event-threads", event_threads,
+                          options, int32, out);
+        if (event_threads != conf->event_threads) {
+                conf->event_threads = event_threads;
+                event_pool_set_threadcount (this->ctx->event_pool,
+                                            conf->event_threads);
+        }
+
         if (!conf->auth_modules)
                 conf->auth_modules = dict_new ();
 
@@ -985,6 +1122,9 @@ reconfigure (xlator_t *this, dict_t *options)
 
         (void) rpcsvc_set_allow_insecure (rpc_conf, options);
         (void) rpcsvc_set_root_squash (rpc_conf, options);
+        (void) rpcsvc_set_worker_threads (rpc_conf, options);
+        (void) rpcsvc_set_outstanding_rpc_limit (rpc_conf, options,
+                                          RPCSVC_DEFAULT_OUTSTANDING_RPC_LIMIT);
         list_for_each_entry (listeners, &(rpc_conf->listeners), list) {
                 if (listeners->trans != NULL) {
                         if (listeners->trans->reconfigure )
@@ -1059,6 +1199,12 @@ init (xlator_t *this)
                 goto out;
         }
 
+        GF_OPTION_INIT ("event-threads", conf->event_threads, int32, out);
+        /* only an explicit setting may override --event-threads */
+        if (dict_get (this->options, "event-threads"))
+                event_pool_set_threadcount (this->ctx->event_pool,
+                                            conf->event_threads);
+
         /* Authentication modules */
         conf->auth_modules = dict_new ();
         GF_VALIDATE_OR_GOTO(this->name, conf->auth_modules, out);
@@ -1085,6 +1231,14 @@ init (xlator_t *this)
                 goto out;
         }
 
+        ret = rpcsvc_set_outstanding_rpc_limit (conf->rpc, this->options,
+                                          RPCSVC_DEFAULT_OUTSTANDING_RPC_LIMIT);
+        if (ret) {
+                gf_log (this->name, GF_LOG_ERROR,
+                        "Failed to configure outstanding-rpc-limit");
+                goto out;
+        }
+
         ret = rpcsvc_create_listeners (conf->rpc, this->options,
                                        this->name);
         if (ret < 1) {
@@ -1170,11 +1324,14 @@ out:
 void
 fini (xlator_t *this)
 {
-#if 0
         server_conf_t *conf = NULL;
 
         conf = this->private;
 
+        /* the rpc workers run the actors of this xlator */
+        if (conf && conf->rpc)
+                rpcsvc_stop_workers (conf->rpc);
+#if 0
         if (conf) {
                 if (conf->rpc) {
                         /* TODO: memory leak here, have to free RPC */
@@ -1295,6 +1452,36 @@ struct volume_options options[] = {
          .max  = GF_MAX_SOCKET_WINDOW_SIZE,
          .description = "Specifies the window size for tcp socket."
         },
+        { .key   = {"event-threads"},
+          .type  = GF_OPTION_TYPE_INT,
+          .min   = 1,
+          .max   = EVENT_MAX_THREADS,
+          .default_value = "1",
+          .description = "Number of threads dispatching network events in "
+                         "the brick process. Raising it only adds threads, "
+                         "lowering it takes effect on the next restart."
+        },
+        { .key   = {"rpc-worker-threads"},
+          .type  = GF_OPTION_TYPE_INT,
+          .min   = 0,
+          .max   = RPCSVC_MAX_WORKER_THREADS,
+          .default_value = "0",
+          .description = "Number of threads decoding and dispatching "
+                         "requests handed off by the network threads. With "
+                         "0 requests are dispatched on the network threads. "
+                         "Raising it only adds threads, lowering it takes "
+                         "effect on the next restart."
+        },
+        { .key   = {"outstanding-rpc-limit"},
+          .type  = GF_OPTION_TYPE_INT,
+          .min   = 0,
+          .max   = RPCSVC_MAX_OUTSTANDING_RPC_LIMIT,
+          .default_value = "64",
+          .description = "Number of requests of a client the brick accepts "
+                         "before it stops reading from that client until "
+                         "some of them are answered. Lock requests and pings "
+                         "are not counted. 0 means no limit."
+        },
 
         /*  The following two options are defined in addr.c, redifined here *
          * for the sake of validation during volume set from cli            */
@@ -107,6 +107,7 @@ struct server_conf {
         pthread_mutex_t         mutex;
         struct list_head        conns;
         struct list_head        xprt_list;
+        int32_t                 event_threads;
 };
 typedef struct server_conf server_conf_t;
 
@@ -173,6 +174,7 @@ struct _server_state {
 
         size_t            size;
         off_t             offset;
+        gf_seek_what_t    what;
         mode_t            mode;
         dev_t             dev;
         size_t            nr_count;
@@ -192,6 +194,24 @@ struct _server_state {
         mode_t            umask;
 };
 
+/* a GFS3_OP_COMPOUND call: its links run one after the other, each through
+   the usual actor with a request of its own whose private points here, and
+   server_submit_reply () keeps their replies instead of sending them */
+typedef struct server_compound {
+        rpcsvc_request_t    *req;
+        gfs3_compound_req    args;
+        gf_lock_t            lock;
+        int                  ref;
+        int                  next;      /* link to run next */
+        int                  op_ret;    /* -1 once a link failed, which */
+        int                  op_errno;  /* stops the rest of the chain */
+        rpcsvc_request_t    *subreqs;
+        gfs3_compound_link  *replies;
+        struct iovec        *payload;   /* read payloads, in link order */
+        int                  payloadcnt;
+        struct iobref       *iobref;    /* holds replies and payloads */
+} server_compound_t;
+
 extern struct rpcsvc_program gluster_handshake_prog;
 extern struct rpcsvc_program glusterfs3_3_fop_prog;
 extern struct rpcsvc_program gluster_ping_prog;
@@ -201,6 +221,11 @@ server_submit_reply (call_frame_t *frame, rpcsvc_request_t *req, void *arg,
                      struct iovec *payload, int payloadcount,
                      struct iobref *iobref, xdrproc_t xdrproc);
 
+int server_compound_link_reply (rpcsvc_request_t *req, void *arg,
+                                struct iovec *payload, int payloadcount,
+                                struct iobref *iobref, xdrproc_t xdrproc);
+void server_compound_resume (server_compound_t *compound);
+
 int gf_server_check_setxattr_cmd (call_frame_t *frame, dict_t *dict);
 int gf_server_check_getxattr_cmd (call_frame_t *frame, const char *name);
 
@@ -153,6 +153,322 @@ err:
 }
 
 
+static inline struct list_head *
+__posix_handle_cache_bucket (struct posix_handle_cache *cache, uuid_t gfid)
+{
+        return &cache->buckets[((gfid[14] << 8) | gfid[15]) %
+                               POSIX_HANDLE_CACHE_BUCKETS];
+}
+
+
+static struct posix_handle_cache_entry *
+__posix_handle_cache_lookup (struct posix_handle_cache *cache, uuid_t gfid)
+{
+        struct posix_handle_cache_entry *entry = NULL;
+
+        list_for_each_entry (entry, __posix_handle_cache_bucket (cache, gfid),
+                             hash) {
+                if (uuid_compare (entry->gfid, gfid) == 0)
+                        return entry;
+        }
+
+        return NULL;
+}
+
+
+static void
+__posix_handle_cache_drop (struct posix_handle_cache *cache,
+                           struct posix_handle_cache_entry *entry)
+{
+        list_del (&entry->hash);
+        list_del (&entry->lru);
+        cache->count--;
+        GF_FREE (entry);
+}
+
+
+static void
+__posix_handle_cache_trim (struct posix_handle_cache *cache)
+{
+        struct posix_handle_cache_entry *entry = NULL;
+
+        while (cache->count > cache->limit) {
+                entry = list_entry (cache->lru.prev,
+                                    struct posix_handle_cache_entry, lru);
+                __posix_handle_cache_drop (cache, entry);
+        }
+}
+
+
+/* called after the symlink-handle of @gfid is created or removed */
+static void
+posix_handle_cache_invalidate (xlator_t *this, uuid_t gfid)
+{
+        struct posix_private            *priv = NULL;
+        struct posix_handle_cache       *cache = NULL;
+        struct posix_handle_cache_entry *entry = NULL;
+
+        priv = this->private;
+        cache = priv->handle_cache;
+        if (!cache)
+                return;
+
+        LOCK (&cache->lock);
+        {
+                cache->gen++;
+                entry = __posix_handle_cache_lookup (cache, gfid);
+                if (entry)
+                        __posix_handle_cache_drop (cache, entry);
+        }
+        UNLOCK (&cache->lock);
+}
+
+
+/* read "../../xx/yy/<pargfid>/<name>" out of a directory's symlink-handle */
+static int
+posix_handle_cache_readlink (xlator_t *this, uuid_t gfid, uuid_t pargfid,
+                             char *name)
+{
+        char         *path = NULL;
+        char          linkname[512] = {0,};
+        char          uuid_str[GF_UUID_BUF_SIZE] = {0,};
+        struct stat   stbuf;
+        int           ret = -1;
+
+        MAKE_HANDLE_GFID_PATH (path, this, gfid, NULL);
+
+        /* hardlinked handles of symlinks are not directories */
+        ret = lstat (path, &stbuf);
+        if (ret || !S_ISLNK (stbuf.st_mode) || (stbuf.st_nlink != 1))
+                return -1;
+
+        ret = readlink (path, linkname, sizeof (linkname) - 1);
+        if ((ret < 50) || (ret - 49 > NAME_MAX))
+                return -1;
+        linkname[ret] = 0;
+
+        if ((memcmp (linkname, "../../", 6) != 0) || (linkname[8] != '/') ||
+            (linkname[11] != '/') || (linkname[48] != '/'))
+                return -1;
+
+        memcpy (uuid_str, linkname + 12, 36);
+        if (uuid_parse (uuid_str, pargfid))
+                return -1;
+
+        strcpy (name, linkname + 49);
+        if (strchr (name, '/'))
+                return -1;
+
+        return 0;
+}
+
+
+/* the parent and name of directory @gfid, read from its handle unless
+   cached (or, if @fill is false, not at all) */
+static int
+posix_handle_cache_get (xlator_t *this, uuid_t gfid, uuid_t pargfid,
+                        char *name, gf_boolean_t fill)
+{
+        struct posix_private            *priv = NULL;
+        struct posix_handle_cache       *cache = NULL;
+        struct posix_handle_cache_entry *entry = NULL;
+        uint64_t                         gen = 0;
+        int                              ret = -1;
+
+        priv = this->private;
+        cache = priv->handle_cache;
+
+        LOCK (&cache->lock);
+        {
+                entry = __posix_handle_cache_lookup (cache, gfid);
+                if (entry) {
+                        uuid_copy (pargfid, entry->pargfid);
+                        strcpy (name, entry->name);
+                        list_move (&entry->lru, &cache->lru);
+                        cache->hits++;
+                        ret = 0;
+                } else if (fill) {
+                        cache->misses++;
+                }
+                gen = cache->gen;
+        }
+        UNLOCK (&cache->lock);
+
+        if (entry || !fill)
+                return ret;
+
+        ret = posix_handle_cache_readlink (this, gfid, pargfid, name);
+        if (ret)
+                return -1;
+
+        entry = GF_CALLOC (1, sizeof (*entry) + strlen (name) + 1,
+                           gf_posix_mt_handle_cache_entry);
+        if (!entry)
+                return 0;
+
+        uuid_copy (entry->gfid, gfid);
+        uuid_copy (entry->pargfid, pargfid);
+        strcpy (entry->name, name);
+
+        LOCK (&cache->lock);
+        {
+                /* a handle changed while we read it, what we read may
+                   already be stale */
+                if ((gen != cache->gen) ||
+                    __posix_handle_cache_lookup (cache, gfid)) {
+                        GF_FREE (entry);
+                } else {
+                        list_add (&entry->hash,
+                                  __posix_handle_cache_bucket (cache, gfid));
+                        list_add (&entry->lru, &cache->lru);
+                        cache->count++;
+                        __posix_handle_cache_trim (cache);
+                }
+        }
+        UNLOCK (&cache->lock);
+
+        return 0;
+}
+
+
+/* Build the real path of @gfid (a directory) in @buf from the cache,
+   walking up to the root. Returns -1 when a directory on the way is not
+   cached and cannot be read, or the path does not fit. */
+static int
+posix_handle_cache_path (xlator_t *this, uuid_t gfid, const char *basename,
+                         char *buf, int maxlen, gf_boolean_t fill)
+{
+        struct posix_private *priv = NULL;
+        uuid_t                cur = {0,};
+        uuid_t                par = {0,};
+        char                  name[NAME_MAX + 1];
+        int                   pos = 0;
+        int                   len = 0;
+
+        priv = this->private;
+
+        if (!priv->handle_cache || !priv->handle_cache->limit)
+                return -1;
+
+        /* the path is assembled backwards from the end of @buf */
+        pos = maxlen - 1;
+        if (pos < 0)
+                return -1;
+        buf[pos] = '\0';
+
+        if (basename) {
+                len = strlen (basename);
+                if (pos < len + 1)
+                        return -1;
+                pos -= len;
+                memcpy (buf + pos, basename, len);
+                buf[--pos] = '/';
+        }
+
+        uuid_copy (cur, gfid);
+
+        while (!__is_root_gfid (cur)) {
+                if (posix_handle_cache_get (this, cur, par, name, fill))
+                        return -1;
+                /* only the first directory may be left to the caller */
+                fill = _gf_true;
+
+                len = strlen (name);
+                if (pos < len + 1)
+                        return -1;
+                pos -= len;
+                memcpy (buf + pos, name, len);
+                buf[--pos] = '/';
+
+                uuid_copy (cur, par);
+        }
+
+        if (pos < priv->base_path_length)
+                return -1;
+        pos -= priv->base_path_length;
+        memcpy (buf + pos, priv->base_path, priv->base_path_length);
+
+        len = maxlen - 1 - pos;
+        memmove (buf, buf + pos, len + 1);
+
+        return len;
+}
+
+
+int
+posix_handle_cache_init (xlator_t *this, uint32_t limit)
+{
+        struct posix_private      *priv = NULL;
+        struct posix_handle_cache *cache = NULL;
+        int                        i = 0;
+
+        priv = this->private;
+
+        cache = GF_CALLOC (1, sizeof (*cache), gf_posix_mt_handle_cache);
+        if (!cache)
+                return -1;
+
+        cache->buckets = GF_CALLOC (POSIX_HANDLE_CACHE_BUCKETS,
+                                    sizeof (*cache->buckets),
+                                    gf_posix_mt_handle_cache);
+        if (!cache->buckets) {
+                GF_FREE (cache);
+                return -1;
+        }
+
+        for (i = 0; i < POSIX_HANDLE_CACHE_BUCKETS; i++)
+                INIT_LIST_HEAD (&cache->buckets[i]);
+        INIT_LIST_HEAD (&cache->lru);
+        LOCK_INIT (&cache->lock);
+        cache->limit = limit;
+
+        priv->handle_cache = cache;
+
+        return 0;
+}
+
+
+void
+posix_handle_cache_resize (xlator_t *this, uint32_t limit)
+{
+        struct posix_private      *priv = NULL;
+        struct posix_handle_cache *cache = NULL;
+
+        priv = this->private;
+        cache = priv->handle_cache;
+        if (!cache)
+                return;
+
+        LOCK (&cache->lock);
+        {
+                cache->limit = limit;
+                __posix_handle_cache_trim (cache);
+        }
+        UNLOCK (&cache->lock);
+}
+
+
+/* takes @priv, fini has already detached it from the xlator */
+void
+posix_handle_cache_fini (struct posix_private *priv)
+{
+        struct posix_handle_cache *cache = NULL;
+
+        cache = priv->handle_cache;
+        if (!cache)
+                return;
+
+        priv->handle_cache = NULL;
+
+        cache->limit = 0;
+        __posix_handle_cache_trim (cache);
+
+        LOCK_DESTROY (&cache->lock);
+        GF_FREE (cache->buckets);
+        GF_FREE (cache);
+}
+
+
 /*
   posix_handle_path differs from posix_handle_gfid_path in the way that the
   path filled in @buf by posix_handle_path will return type IA_IFDIR when
@@ -197,6 +513,11 @@ posix_handle_path (xlator_t *this, uuid_t gfid, const char *basename,
 
         pfx_len = priv->base_path_length + 1 + SLEN(HANDLE_PFX) + 1;
 
+        ret = posix_handle_cache_path (this, gfid, basename, buf, maxlen,
+                                       _gf_false);
+        if (ret >= 0)
+                return ret + 1;
+
         if (basename) {
                 len = snprintf (buf, maxlen, "%s/%s", base_str, basename);
         } else {
@@ -208,6 +529,17 @@ posix_handle_path (xlator_t *this, uuid_t gfid, const char *basename,
         if (!(ret == 0 && S_ISLNK(stat.st_mode) && stat.st_nlink == 1))
                 goto out;
 
+        ret = posix_handle_cache_path (this, gfid, basename, buf, maxlen,
+                                       _gf_true);
+        if (ret >= 0)
+                return ret + 1;
+
+        if (basename) {
+                len = snprintf (buf, maxlen, "%s/%s", base_str, basename);
+        } else {
+                len = snprintf (buf, maxlen, "%s", base_str);
+        }
+
         do {
                 errno = 0;
                 ret = posix_handle_pump (this, buf, len, maxlen,
@@ -625,6 +957,8 @@ posix_handle_soft (xlator_t *this, const char *real_path, loc_t *loc,
                         return -1;
                 }
 
+                posix_handle_cache_invalidate (this, gfid);
+
                 ret = lstat (newpath, &newbuf);
                 if (ret) {
                         gf_log (this->name, GF_LOG_WARNING,
@@ -683,6 +1017,8 @@ posix_handle_unset_gfid (xlator_t *this, uuid_t gfid)
                         "unlink %s failed (%s)", path, strerror (errno));
         }
 
+        posix_handle_cache_invalidate (this, gfid);
+
 out:
         return ret;
 }
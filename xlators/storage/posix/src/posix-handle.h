@@ -19,6 +19,29 @@
 #include "xlator.h"
 
 
+#define POSIX_HANDLE_CACHE_BUCKETS 4096
+
+/* directory gfid -> (parent gfid, name), the contents of its symlink-handle,
+   so that real paths of hot directories are built without readlink()s */
+struct posix_handle_cache_entry {
+        struct list_head   hash;
+        struct list_head   lru;
+        uuid_t             gfid;
+        uuid_t             pargfid;
+        char               name[];
+};
+
+struct posix_handle_cache {
+        gf_lock_t          lock;
+        struct list_head  *buckets;
+        struct list_head   lru;
+        uint32_t           count;
+        uint32_t           limit;    /* 0 disables the cache */
+        uint64_t           gen;      /* bumped by every invalidation */
+        uint64_t           hits;
+        uint64_t           misses;
+};
+
 #define LOC_HAS_ABSPATH(loc) ((loc) && (loc->path) && (loc->path[0] == '/'))
 
 #define MAKE_REAL_PATH(var, this, path) do {                            \
@@ -140,4 +163,15 @@ int posix_create_link_if_gfid_exists (xlator_t *this, uuid_t gfid,
 
 int
 posix_handle_trash_init (xlator_t *this);
+
+int
+posix_handle_cache_init (xlator_t *this, uint32_t limit);
+
+void
+posix_handle_cache_resize (xlator_t *this, uint32_t limit);
+
+struct posix_private;
+
+void
+posix_handle_cache_fini (struct posix_private *priv);
 #endif /* !_POSIX_HANDLE_H */
@@ -99,6 +99,97 @@ out:
         return ignore;
 }
 
+static gf_boolean_t
+posix_xattr_listed (posix_xattr_filler_t *filler, const char *key)
+{
+        char    *name = NULL;
+
+        for (name = filler->list; name < filler->list + filler->list_size;
+             name += strlen (name) + 1) {
+                if (!strcmp (name, key))
+                        return _gf_true;
+        }
+
+        return _gf_false;
+}
+
+/* Value of @key, NUL terminated, in *value_p. In batch mode the names on
+   the file are listed once per filler: keys that are not set then cost no
+   syscall, and set ones a single getxattr unless the value is large. */
+static ssize_t
+posix_xattr_fetch (posix_xattr_filler_t *filler, const char *key,
+                   char **value_p)
+{
+        char      buf[POSIX_XATTR_FETCH_SIZE];
+        char     *value = NULL;
+        ssize_t   size  = -1;
+
+        if (filler->batch && !filler->list) {
+                filler->batch = _gf_false;
+
+                size = sys_llistxattr (filler->real_path, filler->listbuf,
+                                       POSIX_XATTR_LIST_SIZE);
+                if ((size == -1) && (errno == ERANGE)) {
+                        size = sys_llistxattr (filler->real_path, NULL, 0);
+                        if (size > 0)
+                                filler->list = GF_MALLOC (size,
+                                                          gf_posix_mt_char);
+                        if (filler->list)
+                                size = sys_llistxattr (filler->real_path,
+                                                       filler->list, size);
+                        if (filler->list && (size < 0)) {
+                                GF_FREE (filler->list);
+                                filler->list = NULL;
+                        }
+                } else if (size >= 0) {
+                        filler->list = filler->listbuf;
+                }
+
+                if (filler->list)
+                        filler->list_size = size;
+        }
+
+        if (filler->list) {
+                if (!posix_xattr_listed (filler, key))
+                        return 0;
+
+                size = sys_lgetxattr (filler->real_path, key, buf,
+                                      sizeof (buf));
+                if (size > 0) {
+                        value = GF_CALLOC (1, size + 1, gf_posix_mt_char);
+                        if (!value)
+                                return -1;
+                        memcpy (value, buf, size);
+                        goto out;
+                }
+
+                if ((size == 0) || (errno != ERANGE))
+                        return 0;
+        }
+
+        size = sys_lgetxattr (filler->real_path, key, NULL, 0);
+        if (size <= 0)
+                return 0;
+
+        value = GF_CALLOC (1, size + 1, gf_posix_mt_char);
+        if (!value)
+                return -1;
+
+        size = sys_lgetxattr (filler->real_path, key, value, size);
+        if (size <= 0) {
+                gf_log (filler->this->name, GF_LOG_WARNING,
+                        "getxattr failed. path: %s, key: %s",
+                        filler->real_path, key);
+                GF_FREE (value);
+                return -1;
+        }
+out:
+        value[size] = '\0';
+        *value_p = value;
+
+        return size;
+}
+
 static int
 _posix_xattr_get_set (dict_t *xattr_req,
                       char *key,
@@ -182,25 +273,11 @@ _posix_xattr_get_set (dict_t *xattr_req,
                                         key);
                 }
         } else {
-                xattr_size = sys_lgetxattr (filler->real_path, key, NULL, 0);
+                xattr_size = posix_xattr_fetch (filler, key, &value);
+                if (xattr_size < 0)
+                        return -1;
 
                 if (xattr_size > 0) {
-                        value = GF_CALLOC (1, xattr_size + 1,
-                                           gf_posix_mt_char);
-                        if (!value)
-                                return -1;
-
-                        xattr_size = sys_lgetxattr (filler->real_path, key, value,
-                                                    xattr_size);
-                        if (xattr_size <= 0) {
-                                gf_log (filler->this->name, GF_LOG_WARNING,
-                                        "getxattr failed. path: %s, key: %s",
-                                        filler->real_path, key);
-                                GF_FREE (value);
-                                return -1;
-                        }
-
-                        value[xattr_size] = '\0';
                         ret = dict_set_bin (filler->xattr, key,
                                             value, xattr_size);
                         if (ret < 0) {
@@ -428,8 +505,12 @@ dict_t *
 posix_lookup_xattr_fill (xlator_t *this, const char *real_path, loc_t *loc,
                          dict_t *xattr_req, struct iatt *buf)
 {
+        struct posix_private *priv    = NULL;
         dict_t     *xattr             = NULL;
         posix_xattr_filler_t filler   = {0, };
+        char        listbuf[POSIX_XATTR_LIST_SIZE];
+
+        priv = this->private;
 
         xattr = get_new_dict();
         if (!xattr) {
@@ -441,8 +522,13 @@ posix_lookup_xattr_fill (xlator_t *this, const char *real_path, loc_t *loc,
         filler.xattr     = xattr;
         filler.stbuf     = buf;
         filler.loc       = loc;
+        filler.batch     = priv->batch_xattr_fetch;
+        filler.listbuf   = listbuf;
 
         dict_foreach (xattr_req, _posix_xattr_get_set, &filler);
+
+        if (filler.list != listbuf)
+                GF_FREE (filler.list);
 out:
         return xattr;
 }
@@ -21,6 +21,10 @@ enum gf_posix_mem_types_ {
         gf_posix_mt_posix_dev_t,
         gf_posix_mt_trash_path,
 	gf_posix_mt_paiocb,
+        gf_posix_mt_paucb,
+        gf_posix_mt_posix_uring,
+        gf_posix_mt_handle_cache,
+        gf_posix_mt_handle_cache_entry,
         gf_posix_mt_end
 };
 #endif
@@ -0,0 +1,802 @@
+/*
+   Copyright (c) 2006-2012 Red Hat, Inc. <http://www.redhat.com>
+   This file is part of GlusterFS.
+
+   This file is licensed to you under your choice of the GNU Lesser
+   General Public License, version 3 or any later version (LGPLv3 or
+   later), or the GNU General Public License, version 2 (GPLv2), in all
+   cases as published by the Free Software Foundation.
+*/
+#ifndef _CONFIG_H
+#define _CONFIG_H
+#include "config.h"
+#endif
+
+#include "xlator.h"
+#include "glusterfs.h"
+#include "posix.h"
+#include "posix-aio.h"
+#include "posix-uring.h"
+#include <sys/uio.h>
+
+#ifdef HAVE_IO_URING
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+/*
+ * The ring is driven with the raw system calls. Submitters (the io-threads
+ * workers) fill in a submission queue entry under uring->lock and enter the
+ * kernel right away, a single reaper thread consumes the completion queue
+ * and unwinds the frames. The completion queue is twice the size of the
+ * submission queue, and no more than 'depth' operations are in flight, so it
+ * can not overflow.
+ *
+ * The kernel posts completions to the mapped queue whether or not waiting
+ * for them works, so the reaper keeps polling it when io_uring_enter ()
+ * fails. If the failure is one that will not go away, the ring is marked
+ * dead: new requests take the synchronous path, and the reaper exits once
+ * those in flight are unwound.
+ */
+
+#define POSIX_URING_RETRY_USEC  1000
+
+struct posix_uring {
+        int                   fd;
+        unsigned              depth;
+        int                   inflight;
+        gf_boolean_t          dead;     /* no more submissions */
+        pthread_mutex_t       lock;     /* submission side */
+        pthread_t             thread;
+
+        unsigned             *sq_tail;
+        unsigned             *sq_mask;
+        unsigned             *sq_array;
+        struct io_uring_sqe  *sqes;
+
+        unsigned             *cq_head;
+        unsigned             *cq_tail;
+        unsigned             *cq_mask;
+        struct io_uring_cqe  *cqes;
+
+        void                 *sq_ring;
+        size_t                sq_ring_size;
+        void                 *cq_ring;
+        size_t                cq_ring_size;
+        size_t                sqes_size;
+};
+
+struct posix_uring_cb {
+        call_frame_t   *frame;
+        fd_t           *fd;
+        int             _fd;
+        int             op;
+        off_t           offset;
+        size_t          size;
+        struct iobuf   *iobuf;
+        struct iobref  *iobref;
+        struct iovec    iov;
+        struct iatt     prebuf;
+};
+
+
+static void
+posix_uring_unmap (struct posix_uring *uring)
+{
+        if (uring->sqes)
+                munmap (uring->sqes, uring->sqes_size);
+        if (uring->cq_ring && (uring->cq_ring != uring->sq_ring))
+                munmap (uring->cq_ring, uring->cq_ring_size);
+        if (uring->sq_ring)
+                munmap (uring->sq_ring, uring->sq_ring_size);
+}
+
+
+/* returns 0, or -errno of io_uring_enter () */
+static int
+posix_uring_submit (struct posix_uring *uring, struct posix_uring_cb *paucb,
+                    uint8_t opcode, struct iovec *iov, int count,
+                    uint32_t op_flags)
+{
+        struct io_uring_sqe *sqe  = NULL;
+        unsigned             tail = 0;
+        unsigned             idx  = 0;
+        int                  ret  = 0;
+
+        pthread_mutex_lock (&uring->lock);
+        {
+                if (uring->dead) {
+                        ret = -EIO;
+                        goto unlock;
+                }
+
+                if (uring->inflight >= uring->depth) {
+                        ret = -EBUSY;
+                        goto unlock;
+                }
+
+                tail = *uring->sq_tail;
+                idx = tail & *uring->sq_mask;
+                sqe = &uring->sqes[idx];
+
+                memset (sqe, 0, sizeof (*sqe));
+                sqe->opcode = opcode;
+                sqe->fd = paucb->_fd;
+                sqe->off = paucb->offset;
+                sqe->addr = (unsigned long) iov;
+                sqe->len = count;
+                sqe->user_data = (unsigned long) paucb;
+                if (opcode == IORING_OP_FSYNC)
+                        sqe->fsync_flags = op_flags;
+                else
+                        sqe->rw_flags = op_flags;
+
+                uring->sq_array[idx] = idx;
+                __atomic_store_n (uring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+                ret = syscall (__NR_io_uring_enter, uring->fd, 1, 0, 0,
+                               NULL, 0);
+                if (ret != 1) {
+                        /* not consumed, take it back */
+                        ret = (ret < 0) ? -errno : -EAGAIN;
+                        __atomic_store_n (uring->sq_tail, tail,
+                                          __ATOMIC_RELEASE);
+                        goto unlock;
+                }
+
+                uring->inflight++;
+                ret = 0;
+        }
+unlock:
+        pthread_mutex_unlock (&uring->lock);
+
+        return ret;
+}
+
+
+static void
+posix_uring_cb_destroy (struct posix_uring_cb *paucb)
+{
+        if (paucb->iobuf)
+                iobuf_unref (paucb->iobuf);
+        if (paucb->iobref)
+                iobref_unref (paucb->iobref);
+        if (paucb->fd)
+                fd_unref (paucb->fd);
+        GF_FREE (paucb);
+}
+
+
+static struct posix_uring_cb *
+posix_uring_cb_new (call_frame_t *frame, xlator_t *this, fd_t *fd, int op,
+                    off_t offset, int *op_errno)
+{
+        struct posix_uring_cb *paucb = NULL;
+        struct posix_fd       *pfd   = NULL;
+        int                    ret   = -1;
+
+        ret = posix_fd_ctx_get (fd, this, &pfd);
+        if (ret < 0) {
+                *op_errno = -ret;
+                gf_log (this->name, GF_LOG_WARNING,
+                        "pfd is NULL from fd=%p", fd);
+                return NULL;
+        }
+
+        paucb = GF_CALLOC (1, sizeof (*paucb), gf_posix_mt_paucb);
+        if (!paucb) {
+                *op_errno = ENOMEM;
+                return NULL;
+        }
+
+        paucb->frame = frame;
+        paucb->fd = fd_ref (fd);
+        paucb->_fd = pfd->fd;
+        paucb->op = op;
+        paucb->offset = offset;
+
+        return paucb;
+}
+
+
+static void
+posix_uring_readv_complete (xlator_t *this, struct posix_uring_cb *paucb,
+                            int res)
+{
+        struct posix_private *priv     = NULL;
+        struct iatt           postbuf  = {0,};
+        struct iovec          iov      = {0,};
+        struct iobref        *iobref   = NULL;
+        int                   op_ret   = -1;
+        int                   op_errno = 0;
+        int                   ret      = 0;
+
+        priv = this->private;
+
+        if (res < 0) {
+                op_errno = -res;
+                gf_log (this->name, GF_LOG_ERROR,
+                        "readv(io_uring) failed fd=%d,size=%lu,offset=%llu "
+                        "(%s)", paucb->_fd, (unsigned long) paucb->size,
+                        (unsigned long long) paucb->offset,
+                        strerror (op_errno));
+                goto out;
+        }
+
+        ret = posix_fdstat (this, paucb->_fd, &postbuf);
+        if (ret != 0) {
+                op_errno = errno;
+                gf_log (this->name, GF_LOG_ERROR,
+                        "fstat failed on fd=%d: %s", paucb->_fd,
+                        strerror (op_errno));
+                goto out;
+        }
+
+        iobref = iobref_new ();
+        if (!iobref) {
+                op_errno = ENOMEM;
+                goto out;
+        }
+
+        iobref_add (iobref, paucb->iobuf);
+
+        iov.iov_base = iobuf_ptr (paucb->iobuf);
+        iov.iov_len = res;
+        op_ret = res;
+
+        /* Hack to notify higher layers of EOF. */
+        if (postbuf.ia_size == 0)
+                op_errno = ENOENT;
+        else if ((paucb->offset + iov.iov_len) == postbuf.ia_size)
+                op_errno = ENOENT;
+        else if (paucb->offset > postbuf.ia_size)
+                op_errno = ENOENT;
+
+        LOCK (&priv->lock);
+        {
+                priv->read_value += op_ret;
+        }
+        UNLOCK (&priv->lock);
+
+out:
+        STACK_UNWIND_STRICT (readv, paucb->frame, op_ret, op_errno, &iov, 1,
+                             &postbuf, iobref, NULL);
+        if (iobref)
+                iobref_unref (iobref);
+}
+
+
+static void
+posix_uring_writev_complete (xlator_t *this, struct posix_uring_cb *paucb,
+                             int res)
+{
+        struct posix_private *priv     = NULL;
+        struct iatt           postbuf  = {0,};
+        int                   op_ret   = -1;
+        int                   op_errno = 0;
+        int                   ret      = 0;
+
+        priv = this->private;
+
+        if (res < 0) {
+                op_errno = -res;
+                gf_log (this->name, GF_LOG_ERROR,
+                        "writev(io_uring) failed fd=%d,offset=%llu (%s)",
+                        paucb->_fd, (unsigned long long) paucb->offset,
+                        strerror (op_errno));
+                goto out;
+        }
+
+        ret = posix_fdstat (this, paucb->_fd, &postbuf);
+        if (ret != 0) {
+                op_errno = errno;
+                gf_log (this->name, GF_LOG_ERROR,
+                        "post-operation fstat failed on fd=%d: %s",
+                        paucb->_fd, strerror (op_errno));
+                goto out;
+        }
+
+        op_ret = res;
+
+        LOCK (&priv->lock);
+        {
+                priv->write_value += op_ret;
+        }
+        UNLOCK (&priv->lock);
+
+out:
+        STACK_UNWIND_STRICT (writev, paucb->frame, op_ret, op_errno,
+                             &paucb->prebuf, &postbuf, NULL);
+}
+
+
+static void
+posix_uring_fsync_complete (xlator_t *this, struct posix_uring_cb *paucb,
+                            int res)
+{
+        struct iatt  postbuf  = {0,};
+        int          op_ret   = -1;
+        int          op_errno = 0;
+        int          ret      = 0;
+
+        if (res < 0) {
+                op_errno = -res;
+                gf_log (this->name, GF_LOG_ERROR,
+                        "fsync(io_uring) on fd=%d failed: %s", paucb->_fd,
+                        strerror (op_errno));
+                goto out;
+        }
+
+        ret = posix_fdstat (this, paucb->_fd, &postbuf);
+        if (ret != 0) {
+                op_errno = errno;
+                gf_log (this->name, GF_LOG_WARNING,
+                        "post-operation fstat failed on fd=%d: %s",
+                        paucb->_fd, strerror (op_errno));
+                goto out;
+        }
+
+        op_ret = 0;
+out:
+        STACK_UNWIND_STRICT (fsync, paucb->frame, op_ret, op_errno,
+                             &paucb->prebuf, &postbuf, NULL);
+}
+
+
+int
+posix_uring_readv (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                   size_t size, off_t offset, uint32_t flags, dict_t *xdata)
+{
+        struct posix_private  *priv     = NULL;
+        struct posix_uring_cb *paucb    = NULL;
+        int32_t                op_errno = EINVAL;
+        int                    ret      = -1;
+
+        VALIDATE_OR_GOTO (frame, err);
+        VALIDATE_OR_GOTO (this, err);
+        VALIDATE_OR_GOTO (fd, err);
+
+        priv = this->private;
+
+        if (!size) {
+                gf_log (this->name, GF_LOG_WARNING, "size=%"GF_PRI_SIZET, size);
+                goto err;
+        }
+
+        paucb = posix_uring_cb_new (frame, this, fd, GF_FOP_READ, offset,
+                                    &op_errno);
+        if (!paucb)
+                goto err;
+
+        paucb->size = size;
+        paucb->iobuf = iobuf_get2 (this->ctx->iobuf_pool, size);
+        if (!paucb->iobuf) {
+                op_errno = ENOMEM;
+                goto err;
+        }
+
+        paucb->iov.iov_base = iobuf_ptr (paucb->iobuf);
+        paucb->iov.iov_len = size;
+
+        ret = posix_uring_submit (priv->uring, paucb, IORING_OP_READV,
+                                  &paucb->iov, 1, 0);
+        if (ret == 0)
+                return 0;
+
+        /* ring full, or refused: do it here */
+        posix_uring_cb_destroy (paucb);
+        return posix_readv (frame, this, fd, size, offset, flags, xdata);
+err:
+        STACK_UNWIND_STRICT (readv, frame, -1, op_errno, 0, 0, 0, 0, 0);
+        if (paucb)
+                posix_uring_cb_destroy (paucb);
+
+        return 0;
+}
+
+
+static gf_boolean_t
+posix_uring_direct_aligned (struct iovec *iov, int count, off_t offset)
+{
+        int i = 0;
+
+        if (offset % POSIX_URING_DIRECT_ALIGN)
+                return _gf_false;
+
+        for (i = 0; i < count; i++) {
+                if (((unsigned long) iov[i].iov_base |
+                     iov[i].iov_len) % POSIX_URING_DIRECT_ALIGN)
+                        return _gf_false;
+        }
+
+        return _gf_true;
+}
+
+
+int
+posix_uring_writev (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                    struct iovec *iov, int count, off_t offset,
+                    uint32_t flags, struct iobref *iobref, dict_t *xdata)
+{
+        struct posix_private  *priv     = NULL;
+        struct posix_uring_cb *paucb    = NULL;
+        struct posix_fd       *pfd      = NULL;
+        uint32_t               rw_flags = 0;
+        int32_t                op_errno = EINVAL;
+        int                    ret      = -1;
+
+        VALIDATE_OR_GOTO (frame, err);
+        VALIDATE_OR_GOTO (this, err);
+        VALIDATE_OR_GOTO (fd, err);
+        VALIDATE_OR_GOTO (iov, err);
+
+        priv = this->private;
+
+        ret = posix_fd_ctx_get (fd, this, &pfd);
+        if ((ret == 0) && (pfd->flags & O_DIRECT) &&
+            !posix_uring_direct_aligned (iov, count, offset)) {
+                /* __posix_writev () bounces these through an aligned
+                   buffer */
+                goto sync;
+        }
+
+        paucb = posix_uring_cb_new (frame, this, fd, GF_FOP_WRITE, offset,
+                                    &op_errno);
+        if (!paucb)
+                goto err;
+
+        paucb->size = iov_length (iov, count);
+        paucb->iobref = iobref_ref (iobref);
+
+        ret = posix_fdstat (this, paucb->_fd, &paucb->prebuf);
+        if (ret != 0) {
+                op_errno = errno;
+                gf_log (this->name, GF_LOG_ERROR,
+                        "pre-operation fstat failed on fd=%p: %s", fd,
+                        strerror (op_errno));
+                goto err;
+        }
+
+        if (flags & O_SYNC)
+                rw_flags = RWF_SYNC;
+        else if (flags & O_DSYNC)
+                rw_flags = RWF_DSYNC;
+
+        ret = posix_uring_submit (priv->uring, paucb, IORING_OP_WRITEV,
+                                  iov, count, rw_flags);
+        if (ret == 0)
+                return 0;
+
+        posix_uring_cb_destroy (paucb);
+sync:
+        return posix_writev (frame, this, fd, iov, count, offset, flags,
+                             iobref, xdata);
+err:
+        STACK_UNWIND_STRICT (writev, frame, -1, op_errno, 0, 0, 0);
+        if (paucb)
+                posix_uring_cb_destroy (paucb);
+
+        return 0;
+}
+
+
+int
+posix_uring_fsync (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                   int32_t datasync, dict_t *xdata)
+{
+        struct posix_private  *priv     = NULL;
+        struct posix_uring_cb *paucb    = NULL;
+        int32_t                op_errno = EINVAL;
+        int                    ret      = -1;
+
+        VALIDATE_OR_GOTO (frame, err);
+        VALIDATE_OR_GOTO (this, err);
+        VALIDATE_OR_GOTO (fd, err);
+
+        priv = this->private;
+
+        paucb = posix_uring_cb_new (frame, this, fd, GF_FOP_FSYNC, 0,
+                                    &op_errno);
+        if (!paucb)
+                goto err;
+
+        ret = posix_fdstat (this, paucb->_fd, &paucb->prebuf);
+        if (ret != 0) {
+                op_errno = errno;
+                gf_log (this->name, GF_LOG_WARNING,
+                        "pre-operation fstat failed on fd=%p: %s", fd,
+                        strerror (op_errno));
+                goto err;
+        }
+
+        ret = posix_uring_submit (priv->uring, paucb, IORING_OP_FSYNC, NULL,
+                                  0, datasync ? IORING_FSYNC_DATASYNC : 0);
+        if (ret == 0)
+                return 0;
+
+        posix_uring_cb_destroy (paucb);
+        return posix_fsync (frame, this, fd, datasync, xdata);
+err:
+        STACK_UNWIND_STRICT (fsync, frame, -1, op_errno, 0, 0, 0);
+        if (paucb)
+                posix_uring_cb_destroy (paucb);
+
+        return 0;
+}
+
+
+void *
+posix_uring_thread (void *data)
+{
+        xlator_t              *this  = NULL;
+        struct posix_private  *priv  = NULL;
+        struct posix_uring    *uring = NULL;
+        struct posix_uring_cb *paucb = NULL;
+        struct io_uring_cqe   *cqe   = NULL;
+        unsigned               head  = 0;
+        unsigned               tail  = 0;
+        unsigned               reaped = 0;
+        int                    failures = 0;
+        gf_boolean_t           done  = _gf_false;
+        int                    res   = 0;
+        int                    ret   = 0;
+        int                    err   = 0;
+
+        this = data;
+        THIS = this;
+        priv = this->private;
+        uring = priv->uring;
+
+        for (;;) {
+                head = *uring->cq_head;
+                tail = __atomic_load_n (uring->cq_tail, __ATOMIC_ACQUIRE);
+
+                if (head == tail) {
+                        ret = syscall (__NR_io_uring_enter, uring->fd, 0, 1,
+                                       IORING_ENTER_GETEVENTS, NULL, 0);
+                        if ((ret >= 0) || (errno == EINTR)) {
+                                failures = 0;
+                                continue;
+                        }
+
+                        err = errno;
+                        if (!failures++)
+                                gf_log (this->name, GF_LOG_ERROR,
+                                        "io_uring_enter() failed: %s",
+                                        strerror (err));
+
+                        pthread_mutex_lock (&uring->lock);
+                        {
+                                if ((err != EAGAIN) && (err != EBUSY) &&
+                                    (err != ENOMEM) && !uring->dead) {
+                                        gf_log (this->name, GF_LOG_ERROR,
+                                                "io_uring is unusable."
+                                                " Continuing with synchronous"
+                                                " IO");
+                                        uring->dead = _gf_true;
+                                }
+                                done = (uring->dead && !uring->inflight);
+                        }
+                        pthread_mutex_unlock (&uring->lock);
+
+                        if (done)
+                                break;
+
+                        usleep (POSIX_URING_RETRY_USEC);
+                        continue;
+                }
+
+                for (; head != tail; head++) {
+                        cqe = &uring->cqes[head & *uring->cq_mask];
+                        paucb = (void *) (unsigned long) cqe->user_data;
+                        res = cqe->res;
+
+                        switch (paucb->op) {
+                        case GF_FOP_READ:
+                                posix_uring_readv_complete (this, paucb, res);
+                                break;
+                        case GF_FOP_WRITE:
+                                posix_uring_writev_complete (this, paucb, res);
+                                break;
+                        case GF_FOP_FSYNC:
+                                posix_uring_fsync_complete (this, paucb, res);
+                                break;
+                        default:
+                                gf_log (this->name, GF_LOG_ERROR,
+                                        "unknown op %d found in paucb",
+                                        paucb->op);
+                                break;
+                        }
+
+                        posix_uring_cb_destroy (paucb);
+                }
+
+                reaped = head - *uring->cq_head;
+                __atomic_store_n (uring->cq_head, head, __ATOMIC_RELEASE);
+
+                pthread_mutex_lock (&uring->lock);
+                {
+                        uring->inflight -= reaped;
+                }
+                pthread_mutex_unlock (&uring->lock);
+        }
+
+        return NULL;
+}
+
+
+int
+posix_uring_init (xlator_t *this)
+{
+        struct posix_private   *priv   = NULL;
+        struct posix_uring     *uring  = NULL;
+        struct io_uring_params  params = {0,};
+        int                     ret    = -1;
+
+        priv = this->private;
+
+        uring = GF_CALLOC (1, sizeof (*uring), gf_posix_mt_posix_uring);
+        if (!uring)
+                goto out;
+        uring->fd = -1;
+
+        uring->fd = syscall (__NR_io_uring_setup, priv->uring_depth, &params);
+        if (uring->fd < 0) {
+                gf_log (this->name, GF_LOG_WARNING,
+                        "io_uring_setup() failed (%s)."
+                        " Continuing with synchronous IO", strerror (errno));
+                goto out;
+        }
+
+        if (!(params.features & IORING_FEAT_NODROP) ||
+            !(params.features & IORING_FEAT_SUBMIT_STABLE)) {
+                /* iovecs have to be consumed at submission */
+                gf_log (this->name, GF_LOG_WARNING,
+                        "io_uring of this kernel is too old."
+                        " Continuing with synchronous IO");
+                goto out;
+        }
+
+        uring->depth = params.sq_entries;
+        uring->sq_ring_size = params.sq_off.array +
+                params.sq_entries * sizeof (unsigned);
+        uring->cq_ring_size = params.cq_off.cqes +
+                params.cq_entries * sizeof (struct io_uring_cqe);
+        uring->sqes_size = params.sq_entries * sizeof (struct io_uring_sqe);
+
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+                if (uring->cq_ring_size > uring->sq_ring_size)
+                        uring->sq_ring_size = uring->cq_ring_size;
+                uring->cq_ring_size = uring->sq_ring_size;
+        }
+
+        uring->sq_ring = mmap (NULL, uring->sq_ring_size,
+                               PROT_READ | PROT_WRITE,
+                               MAP_SHARED | MAP_POPULATE, uring->fd,
+                               IORING_OFF_SQ_RING);
+        if (uring->sq_ring == MAP_FAILED) {
+                uring->sq_ring = NULL;
+                goto mmap_failed;
+        }
+
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+                uring->cq_ring = uring->sq_ring;
+        } else {
+                uring->cq_ring = mmap (NULL, uring->cq_ring_size,
+                                       PROT_READ | PROT_WRITE,
+                                       MAP_SHARED | MAP_POPULATE, uring->fd,
+                                       IORING_OFF_CQ_RING);
+                if (uring->cq_ring == MAP_FAILED) {
+                        uring->cq_ring = NULL;
+                        goto mmap_failed;
+                }
+        }
+
+        uring->sqes = mmap (NULL, uring->sqes_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, uring->fd,
+                            IORING_OFF_SQES);
+        if (uring->sqes == MAP_FAILED) {
+                uring->sqes = NULL;
+                goto mmap_failed;
+        }
+
+        uring->sq_tail = uring->sq_ring + params.sq_off.tail;
+        uring->sq_mask = uring->sq_ring + params.sq_off.ring_mask;
+        uring->sq_array = uring->sq_ring + params.sq_off.array;
+        uring->cq_head = uring->cq_ring + params.cq_off.head;
+        uring->cq_tail = uring->cq_ring + params.cq_off.tail;
+        uring->cq_mask = uring->cq_ring + params.cq_off.ring_mask;
+        uring->cqes = uring->cq_ring + params.cq_off.cqes;
+
+        pthread_mutex_init (&uring->lock, NULL);
+        priv->uring = uring;
+
+        ret = pthread_create (&uring->thread, NULL, posix_uring_thread, this);
+        if (ret != 0) {
+                priv->uring = NULL;
+                pthread_mutex_destroy (&uring->lock);
+                ret = -1;
+                goto out;
+        }
+
+        gf_log (this->name, GF_LOG_INFO,
+                "io_uring set up with %u entries", uring->depth);
+
+        ret = 0;
+        goto out;
+
+mmap_failed:
+        gf_log (this->name, GF_LOG_WARNING,
+                "mapping the io_uring failed (%s)."
+                " Continuing with synchronous IO", strerror (errno));
+out:
+        if (ret && uring) {
+                posix_uring_unmap (uring);
+                if (uring->fd >= 0)
+                        close (uring->fd);
+                GF_FREE (uring);
+        }
+
+        return ret;
+}
+
+
+int
+posix_uring_on (xlator_t *this)
+{
+        struct posix_private *priv = NULL;
+
+        priv = this->private;
+
+        if (!priv->uring_init_done) {
+                /* not being able to set it up is not fatal */
+                priv->uring_capable = (posix_uring_init (this) == 0);
+                priv->uring_init_done = _gf_true;
+        }
+
+        if (priv->uring_capable) {
+                this->fops->readv  = posix_uring_readv;
+                this->fops->writev = posix_uring_writev;
+                this->fops->fsync  = posix_uring_fsync;
+        }
+
+        return 0;
+}
+
+int
+posix_uring_off (xlator_t *this)
+{
+        struct posix_private *priv = NULL;
+
+        priv = this->private;
+
+        this->fops->readv  = posix_readv;
+        this->fops->writev = posix_writev;
+        this->fops->fsync  = posix_fsync;
+
+        /* give reads and writes back to linux-aio, if it is on */
+        if (priv->aio_configured)
+                posix_aio_on (this);
+
+        return 0;
+}
+
+
+#else
+
+
+int
+posix_uring_on (xlator_t *this)
+{
+        gf_log (this->name, GF_LOG_INFO,
+                "io_uring not available at build-time."
+                " Continuing with synchronous IO");
+        return 0;
+}
+
+int
+posix_uring_off (xlator_t *this)
+{
+        return 0;
+}
+#endif
@@ -0,0 +1,35 @@
+/*
+   Copyright (c) 2006-2012 Red Hat, Inc. <http://www.redhat.com>
+   This file is part of GlusterFS.
+
+   This file is licensed to you under your choice of the GNU Lesser
+   General Public License, version 3 or any later version (LGPLv3 or
+   later), or the GNU General Public License, version 2 (GPLv2), in all
+   cases as published by the Free Software Foundation.
+*/
+#ifndef _POSIX_URING_H
+#define _POSIX_URING_H
+
+#ifndef _CONFIG_H
+#define _CONFIG_H
+#include "config.h"
+#endif
+
+#include "xlator.h"
+#include "glusterfs.h"
+
+// Default number of submission queue entries, and so of IO operations in
+// flight. Requests beyond that are served synchronously.
+#define POSIX_URING_DEFAULT_DEPTH 256
+
+// O_DIRECT writes need buffers, lengths and offsets aligned to this
+#define POSIX_URING_DIRECT_ALIGN 512
+
+
+int posix_uring_on (xlator_t *this);
+int posix_uring_off (xlator_t *this);
+
+int posix_fsync (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                 int32_t datasync, dict_t *xdata);
+
+#endif /* !_POSIX_URING_H */
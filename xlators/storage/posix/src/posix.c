@@ -50,6 +50,7 @@
 #include "glusterfs3-xdr.h"
 #include "hashfn.h"
 #include "posix-aio.h"
+#include "posix-uring.h"
 
 extern char *marker_xattrs[];
 #define ALIGN_SIZE 4096
@@ -3542,6 +3543,295 @@ out:
 }
 
 
+/* fallocate (2) on the fd with the given mode, between a pre and a post
+   operation stat. Returns 0 or -errno. */
+static int
+posix_do_fallocate (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                    int mode, off_t offset, off_t len, struct iatt *statpre,
+                    struct iatt *statpost)
+{
+        struct posix_fd *pfd = NULL;
+        int              ret = -1;
+
+        DECLARE_OLD_FS_ID_VAR;
+        SET_FS_ID (frame->root->uid, frame->root->gid);
+
+        ret = posix_fd_ctx_get (fd, this, &pfd);
+        if (ret < 0) {
+                gf_log (this->name, GF_LOG_WARNING,
+                        "pfd is NULL, fd=%p", fd);
+                goto out;
+        }
+
+        ret = posix_fdstat (this, pfd->fd, statpre);
+        if (ret == -1) {
+                ret = -errno;
+                gf_log (this->name, GF_LOG_ERROR,
+                        "pre-operation fstat failed on fd=%p: %s", fd,
+                        strerror (-ret));
+                goto out;
+        }
+
+        ret = sys_fallocate (pfd->fd, mode, offset, len);
+        if (ret == -1) {
+                ret = -errno;
+                goto out;
+        }
+
+        ret = posix_fdstat (this, pfd->fd, statpost);
+        if (ret == -1) {
+                ret = -errno;
+                gf_log (this->name, GF_LOG_ERROR,
+                        "post-operation fstat failed on fd=%p: %s", fd,
+                        strerror (-ret));
+                goto out;
+        }
+
+out:
+        SET_TO_OLD_FS_ID ();
+
+        return ret;
+}
+
+
+/* zerofill where the filesystem cannot zero a range: write the zeroes */
+static int
+posix_do_zerofill_write (int fd, off_t offset, off_t len)
+{
+        static char zeroes[POSIX_ZEROFILL_BLOCK]
+                __attribute__ ((aligned (4096)));
+        ssize_t     ret   = 0;
+        size_t      chunk = 0;
+
+        while (len > 0) {
+                chunk = min (len, (off_t) sizeof (zeroes));
+                ret = pwrite (fd, zeroes, chunk, offset);
+                if (ret < 0)
+                        return -errno;
+
+                offset += ret;
+                len -= ret;
+        }
+
+        return 0;
+}
+
+
+int32_t
+posix_glfallocate (call_frame_t *frame, xlator_t *this, fd_t *fd,
+                   int32_t keep_size, off_t offset, size_t len,
+                   dict_t *xdata)
+{
+        struct iatt statpre  = {0,};
+        struct iatt statpost = {0,};
+        int32_t     op_ret   = -1;
+        int32_t     op_errno = 0;
+        int         mode     = 0;
+
+        VALIDATE_OR_GOTO (frame, out);
+        VALIDATE_OR_GOTO (this, out);
+        VALIDATE_OR_GOTO (fd, out);
+
+        if (keep_size)
+                mode = FALLOC_FL_KEEP_SIZE;
+
+        op_ret = posix_do_fallocate (frame, this, fd, mode, offset, len,
+                                     &statpre, &statpost);
+        if (op_ret < 0) {
+                op_errno = -op_ret;
+                op_ret = -1;
+                gf_log (this->name, GF_LOG_ERROR,
+                        "fallocate failed on fd=%p (%"PRId64", %"GF_PRI_SIZET
+                        "): %s", fd, offset, len, strerror (op_errno));
+        }
+
+out:
+        STACK_UNWIND_STRICT (fallocate, frame, op_ret, op_errno, &statpre,
+                             &statpost, NULL);
+
+        return 0;
+}
+
+
+int32_t
+posix_discard (call_frame_t *frame, xlator_t *this, fd_t *fd, off_t offset,
+               size_t len, dict_t *xdata)
+{
+        struct iatt statpre  = {0,};
+        struct iatt statpost = {0,};
+        int32_t     op_ret   = -1;
+        int32_t     op_errno = 0;
+
+        VALIDATE_OR_GOTO (frame, out);
+        VALIDATE_OR_GOTO (this, out);
+        VALIDATE_OR_GOTO (fd, out);
+
+        op_ret = posix_do_fallocate (frame, this, fd,
+                                     FALLOC_FL_PUNCH_HOLE |
+                                     FALLOC_FL_KEEP_SIZE,
+                                     offset, len, &statpre, &statpost);
+        if (op_ret < 0) {
+                op_errno = -op_ret;
+                op_ret = -1;
+                gf_log (this->name, (op_errno == EOPNOTSUPP) ?
+                        GF_LOG_DEBUG : GF_LOG_ERROR,
+                        "discard failed on fd=%p (%"PRId64", %"GF_PRI_SIZET
+                        "): %s", fd, offset, len, strerror (op_errno));
+        }
+
+out:
+        STACK_UNWIND_STRICT (discard, frame, op_ret, op_errno, &statpre,
+                             &statpost, NULL);
+
+        return 0;
+}
+
+
+int32_t
+posix_zerofill (call_frame_t *frame, xlator_t *this, fd_t *fd, off_t offset,
+                off_t len, dict_t *xdata)
+{
+        struct iatt      statpre  = {0,};
+        struct iatt      statpost = {0,};
+        struct posix_fd *pfd      = NULL;
+        int32_t          op_ret   = -1;
+        int32_t          op_errno = 0;
+
+        DECLARE_OLD_FS_ID_VAR;
+
+        VALIDATE_OR_GOTO (frame, out);
+        VALIDATE_OR_GOTO (this, out);
+        VALIDATE_OR_GOTO (fd, out);
+
+#ifdef FALLOC_FL_ZERO_RANGE
+        op_ret = posix_do_fallocate (frame, this, fd, FALLOC_FL_ZERO_RANGE,
+                                     offset, len, &statpre, &statpost);
+        if ((op_ret != -EOPNOTSUPP) && (op_ret != -ENOSYS))
+                goto done;
+#endif
+
+        SET_FS_ID (frame->root->uid, frame->root->gid);
+
+        op_ret = posix_fd_ctx_get (fd, this, &pfd);
+        if (op_ret < 0) {
+                gf_log (this->name, GF_LOG_WARNING,
+                        "pfd is NULL, fd=%p", fd);
+                goto unset;
+        }
+
+        op_ret = posix_fdstat (this, pfd->fd, &statpre);
+        if (op_ret == -1) {
+                op_ret = -errno;
+                goto unset;
+        }
+
+        op_ret = posix_do_zerofill_write (pfd->fd, offset, len);
+        if (op_ret < 0)
+                goto unset;
+
+        if (pfd->flags & (O_SYNC|O_DSYNC)) {
+                op_ret = fsync (pfd->fd);
+                if (op_ret == -1) {
+                        op_ret = -errno;
+                        goto unset;
+                }
+        }
+
+        op_ret = posix_fdstat (this, pfd->fd, &statpost);
+        if (op_ret == -1)
+                op_ret = -errno;
+unset:
+        SET_TO_OLD_FS_ID ();
+#ifdef FALLOC_FL_ZERO_RANGE
+done:
+#endif
+        if (op_ret < 0) {
+                op_errno = -op_ret;
+                op_ret = -1;
+                gf_log (this->name, GF_LOG_ERROR,
+                        "zerofill failed on fd=%p (%"PRId64", %"PRId64"): %s",
+                        fd, offset, len, strerror (op_errno));
+        }
+
+out:
+        STACK_UNWIND_STRICT (zerofill, frame, op_ret, op_errno, &statpre,
+                             &statpost, NULL);
+
+        return 0;
+}
+
+
+/* where lseek () cannot tell (no SEEK_DATA, or a filesystem refusing it)
+   the whole file is data followed by the hole at EOF */
+static off_t
+posix_seek_fallback (int fd, off_t offset, gf_seek_what_t what)
+{
+        struct stat stbuf = {0, };
+
+        if (fstat (fd, &stbuf) == -1)
+                return -1;
+
+        if (offset >= stbuf.st_size) {
+                errno = ENXIO;
+                return -1;
+        }
+
+        return (what == GF_SEEK_DATA) ? offset : stbuf.st_size;
+}
+
+
+int32_t
+posix_seek (call_frame_t *frame, xlator_t *this, fd_t *fd, off_t offset,
+            gf_seek_what_t what, dict_t *xdata)
+{
+        struct posix_fd *pfd      = NULL;
+        off_t            ret      = -1;
+        int32_t          op_ret   = -1;
+        int32_t          op_errno = 0;
+
+        DECLARE_OLD_FS_ID_VAR;
+        SET_FS_ID (frame->root->uid, frame->root->gid);
+
+        VALIDATE_OR_GOTO (frame, out);
+        VALIDATE_OR_GOTO (this, out);
+        VALIDATE_OR_GOTO (fd, out);
+
+        ret = posix_fd_ctx_get (fd, this, &pfd);
+        if (ret < 0) {
+                gf_log (this->name, GF_LOG_WARNING,
+                        "pfd is NULL, fd=%p", fd);
+                op_errno = -ret;
+                goto out;
+        }
+
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+        ret = sys_lseek (pfd->fd, offset,
+                         (what == GF_SEEK_DATA) ? SEEK_DATA : SEEK_HOLE);
+        if ((ret == -1) && (errno == EINVAL) && (offset >= 0))
+                ret = posix_seek_fallback (pfd->fd, offset, what);
+#else
+        ret = posix_seek_fallback (pfd->fd, offset, what);
+#endif
+        if (ret == -1) {
+                op_errno = errno;
+                if (op_errno != ENXIO)
+                        gf_log (this->name, GF_LOG_ERROR,
+                                "seek failed on fd=%p (%"PRId64"): %s",
+                                fd, offset, strerror (op_errno));
+                goto out;
+        }
+
+        op_ret = 0;
+out:
+        SET_TO_OLD_FS_ID ();
+
+        STACK_UNWIND_STRICT (seek, frame, op_ret, op_errno,
+                             (op_ret == 0) ? ret : 0, NULL);
+
+        return 0;
+}
+
+
 int32_t
 posix_fstat (call_frame_t *frame, xlator_t *this,
              fd_t *fd, dict_t *xdata)
@@ -3982,6 +4272,15 @@ posix_priv (xlator_t *this)
         gf_proc_dump_write("max_write","%d", priv->write_value);
         gf_proc_dump_write("nr_files","%ld", priv->nr_files);
 
+        if (priv->handle_cache) {
+                gf_proc_dump_write ("handle_cache_count", "%u",
+                                    priv->handle_cache->count);
+                gf_proc_dump_write ("handle_cache_hits", "%"PRIu64,
+                                    priv->handle_cache->hits);
+                gf_proc_dump_write ("handle_cache_misses", "%"PRIu64,
+                                    priv->handle_cache->misses);
+        }
+
         return 0;
 }
 
@@ -4131,6 +4430,7 @@ reconfigure (xlator_t *this, dict_t *options)
 	struct posix_private *priv = NULL;
         uid_t                 uid = -1;
         gid_t                 gid = -1;
+        uint32_t              cache_size = 0;
 
 	priv = this->private;
 
@@ -4146,6 +4446,22 @@ reconfigure (xlator_t *this, dict_t *options)
 	else
 		posix_aio_off (this);
 
+        /* after linux-aio, io_uring takes precedence */
+        GF_OPTION_RECONF ("io-uring", priv->uring_configured,
+                          options, bool, out);
+
+        if (priv->uring_configured)
+                posix_uring_on (this);
+        else if (priv->uring_init_done)
+                posix_uring_off (this);
+
+        GF_OPTION_RECONF ("handle-cache-size", cache_size, options, uint32,
+                          out);
+        posix_handle_cache_resize (this, cache_size);
+
+        GF_OPTION_RECONF ("batch-xattr-fetch", priv->batch_xattr_fetch,
+                          options, bool, out);
+
         GF_OPTION_RECONF ("node-uuid-pathinfo", priv->node_uuid_pathinfo,
                           options, bool, out);
 
@@ -4185,6 +4501,7 @@ init (xlator_t *this)
         char                 *guuid         = NULL;
         uid_t                 uid           = -1;
         gid_t                 gid           = -1;
+        uint32_t              cache_size    = 0;
 
         dir_data = dict_get (this->options, "directory");
 
@@ -4499,6 +4816,8 @@ init (xlator_t *this)
 
 	_private->aio_init_done = _gf_false;
 	_private->aio_capable = _gf_false;
+	_private->uring_init_done = _gf_false;
+	_private->uring_capable = _gf_false;
 
         GF_OPTION_INIT ("brick-uid", uid, uint32, out);
         GF_OPTION_INIT ("brick-gid", gid, uint32, out);
@@ -4517,8 +4836,23 @@ init (xlator_t *this)
 		}
 	}
 
+        GF_OPTION_INIT ("io-uring-depth", _private->uring_depth, uint32, out);
+        GF_OPTION_INIT ("io-uring", _private->uring_configured, bool, out);
+
+        if (_private->uring_configured)
+                posix_uring_on (this);
+
+        GF_OPTION_INIT ("handle-cache-size", cache_size, uint32, out);
+        if (posix_handle_cache_init (this, cache_size)) {
+                ret = -1;
+                goto out;
+        }
+
+        GF_OPTION_INIT ("batch-xattr-fetch", _private->batch_xattr_fetch,
+                        bool, err_cache);
+
         GF_OPTION_INIT ("node-uuid-pathinfo",
-                        _private->node_uuid_pathinfo, bool, out);
+                        _private->node_uuid_pathinfo, bool, err_cache);
         if (_private->node_uuid_pathinfo &&
             (uuid_is_null (_private->glusterd_uuid))) {
                         gf_log (this->name, GF_LOG_INFO,
@@ -4531,6 +4865,11 @@ init (xlator_t *this)
         INIT_LIST_HEAD (&_private->janitor_fds);
 
         posix_spawn_janitor_thread (this);
+        goto out;
+
+err_cache:
+        posix_handle_cache_fini (_private);
+        ret = -1;
 out:
         return ret;
 }
@@ -4545,6 +4884,7 @@ fini (xlator_t *this)
         /*unlock brick dir*/
         if (priv->mount_lock)
                 closedir (priv->mount_lock);
+        posix_handle_cache_fini (priv);
         GF_FREE (priv);
         return;
 }
@@ -4585,6 +4925,10 @@ struct xlator_fops fops = {
         .fsyncdir    = posix_fsyncdir,
         .access      = posix_access,
         .ftruncate   = posix_ftruncate,
+        .fallocate   = posix_glfallocate,
+        .discard     = posix_discard,
+        .zerofill    = posix_zerofill,
+        .seek        = posix_seek,
         .fstat       = posix_fstat,
         .lk          = posix_lk,
         .inodelk     = posix_inodelk,
@@ -4629,6 +4973,39 @@ struct volume_options options[] = {
 	  .default_value = "off",
           .description = "Support for native Linux AIO"
 	},
+        { .key  = {"io-uring"},
+          .type = GF_OPTION_TYPE_BOOL,
+          .default_value = "off",
+          .description = "Submit reads, writes and fsyncs through io_uring "
+                         "and unwind them from a completion thread, instead "
+                         "of blocking an io-threads worker on each"
+        },
+        { .key  = {"io-uring-depth"},
+          .type = GF_OPTION_TYPE_INT,
+          .min  = 16,
+          .max  = 4096,
+          .default_value = "256",
+          .description = "Number of IO operations the io_uring can have in "
+                         "flight. Takes effect when the ring is set up."
+        },
+        { .key  = {"handle-cache-size"},
+          .type = GF_OPTION_TYPE_INT,
+          .min  = 0,
+          .max  = 1048576,
+          .default_value = "16384",
+          .description = "Number of directories whose gfid-handle is kept "
+                         "in memory, so that their paths are built without "
+                         "reading the handle symlinks of every ancestor. "
+                         "0 disables the cache."
+        },
+        { .key  = {"batch-xattr-fetch"},
+          .type = GF_OPTION_TYPE_BOOL,
+          .default_value = "on",
+          .description = "In lookup and readdirp, list the extended "
+                         "attributes of an entry once and fetch only the "
+                         "requested keys it has, instead of probing every "
+                         "requested key with two getxattr calls"
+        },
         {
           .key = {"brick-uid"},
           .type = GF_OPTION_TYPE_INT,
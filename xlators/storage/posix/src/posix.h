@@ -44,6 +44,24 @@
 #include "posix-mem-types.h"
 #include "posix-handle.h"
 
+#include <fcntl.h>
+
+/* sys_fallocate () fails these with EOPNOTSUPP where there is no fallocate */
+#ifndef FALLOC_FL_KEEP_SIZE
+#define FALLOC_FL_KEEP_SIZE     0x01
+#endif
+#ifndef FALLOC_FL_PUNCH_HOLE
+#define FALLOC_FL_PUNCH_HOLE    0x02
+#endif
+
+/* size of the zero buffer zerofill falls back to writing */
+#define POSIX_ZEROFILL_BLOCK    (128 * GF_UNIT_KB)
+
+/* buffers of the batched xattr fetch in lookup and readdirp, larger lists
+   and values are sized with an extra syscall */
+#define POSIX_XATTR_LIST_SIZE   4096
+#define POSIX_XATTR_FETCH_SIZE  1024
+
 #ifdef HAVE_LIBAIO
 #include <libaio.h>
 #include "posix-aio.h"
@@ -125,6 +143,16 @@ struct posix_private {
         pthread_t       aiothread;
 #endif
 
+	gf_boolean_t    uring_configured;
+	gf_boolean_t    uring_init_done;
+	gf_boolean_t    uring_capable;
+        uint32_t        uring_depth;
+        struct posix_uring *uring;
+
+        struct posix_handle_cache *handle_cache;
+
+        gf_boolean_t    batch_xattr_fetch;
+
         /* node-uuid in pathinfo xattr */
         gf_boolean_t  node_uuid_pathinfo;
 };
@@ -139,6 +167,10 @@ typedef struct {
         int          fd;
         int          flags;
         int32_t     op_errno;
+        gf_boolean_t batch;    /* list the names before fetching values */
+        char        *listbuf;
+        char        *list;
+        ssize_t      list_size;
 } posix_xattr_filler_t;
 
 